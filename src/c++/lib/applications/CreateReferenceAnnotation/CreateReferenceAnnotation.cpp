@@ -0,0 +1,73 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "CreateReferenceAnnotation.hh"
+#include "ReferenceAnnotationOptions.hh"
+
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "htsapi/samtools_fasta_util.hh"
+#include "starling_common/ActiveRegionReadBuffer.hh"
+#include "starling_common/ReferenceAnnotationUtil.hh"
+
+
+
+static
+void
+createReferenceAnnotation(const ReferenceAnnotationOptions& opt)
+{
+    std::vector<std::pair<std::string,unsigned>> chromSizes;
+    getFastaChromSizes(opt.referenceFilename, chromSizes);
+
+    ReferenceAnnotationTrackWriter::contigs_t contigs;
+    for (const auto& chromSize : chromSizes)
+    {
+        contigs.emplace_back(chromSize.first, chromSize.second);
+    }
+
+    // anchor flags are computed with the same repeat finder parameters used for active region detection:
+    const unsigned maxRepeatUnitLength(ActiveRegionReadBuffer::MaxRepeatUnitLength);
+    const unsigned minRepeatSpan(ActiveRegionReadBuffer::MinRepeatSpan);
+    ReferenceAnnotationTrackWriter writer(opt.outputFilename, contigs, maxRepeatUnitLength, minRepeatSpan);
+
+    reference_contig_segment contig;
+    std::vector<ReferenceAnnotation> annotation;
+    for (const auto& chromSize : chromSizes)
+    {
+        contig.clear();
+        if (chromSize.second > 0)
+        {
+            get_standardized_region_seq(opt.referenceFilename, chromSize.first, 0, chromSize.second-1, contig.seq());
+        }
+        computeReferenceAnnotation(contig, maxRepeatUnitLength, minRepeatSpan, annotation);
+        writer.writeContig(chromSize.first, contig.seq(), annotation);
+    }
+    writer.close();
+}
+
+
+
+void
+CreateReferenceAnnotation::
+runInternal(int argc, char* argv[]) const
+{
+    ReferenceAnnotationOptions opt;
+
+    parseReferenceAnnotationOptions(*this,argc,argv,opt);
+    createReferenceAnnotation(opt);
+}
@@ -0,0 +1,116 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "ReferenceAnnotationOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "precompute the reference annotation track for a fasta reference", "", msg);
+}
+
+
+
+/// \brief Parse ReferenceAnnotationOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string content on
+///                 input is cleared
+///
+/// \return True if an error occurs while parsing options
+static
+bool
+parseOptions(
+    ReferenceAnnotationOptions& opt,
+    std::string& errorMsg)
+{
+    if (checkAndStandardizeRequiredInputFilePath(opt.referenceFilename, "reference fasta", errorMsg)) return true;
+
+    if (opt.outputFilename.empty())
+    {
+        errorMsg = "Must specify an output file";
+        return true;
+    }
+
+    return false;
+}
+
+
+
+void
+parseReferenceAnnotationOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    ReferenceAnnotationOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("ref", po::value(&opt.referenceFilename),
+     "fasta reference sequence, samtools index file must be present (required)")
+    ("output-file", po::value(&opt.outputFilename),
+     "write reference annotation track to filename (required)")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    std::string errorMsg;
+    if (parseOptions(opt, errorMsg))
+    {
+        usage(log_os, prog, visible, errorMsg.c_str());
+    }
+}
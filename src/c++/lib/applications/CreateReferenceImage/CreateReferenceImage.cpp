@@ -0,0 +1,69 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "CreateReferenceImage.hh"
+#include "ReferenceImageOptions.hh"
+
+#include "blt_util/ReferenceImage.hh"
+#include "htsapi/samtools_fasta_util.hh"
+
+#include <cctype>
+
+
+
+static
+void
+createReferenceImage(const ReferenceImageOptions& opt)
+{
+    std::vector<std::pair<std::string,unsigned>> chromSizes;
+    getFastaChromSizes(opt.referenceFilename, chromSizes);
+
+    ReferenceImageWriter writer(opt.outputFilename);
+
+    std::string seq;
+    for (const auto& chromSize : chromSizes)
+    {
+        seq.clear();
+        if (chromSize.second > 0)
+        {
+            get_region_seq(opt.referenceFilename, chromSize.first, 0, chromSize.second-1, seq);
+        }
+
+        // IUPAC ambiguity codes are retained so that the image has the same CRAM reference checksums as the
+        // original fasta, these are standardized when reference segments are read from the image:
+        for (char& c : seq)
+        {
+            c = std::toupper(c);
+        }
+        writer.writeContig(chromSize.first, seq);
+    }
+    writer.close();
+}
+
+
+
+void
+CreateReferenceImage::
+runInternal(int argc, char* argv[]) const
+{
+    ReferenceImageOptions opt;
+
+    parseReferenceImageOptions(*this,argc,argv,opt);
+    createReferenceImage(opt);
+}
@@ -54,6 +54,7 @@ parseEPACOptions(
     ("theta-file", po::value(&opt.thetaFilename),"select a json file with theta values")
     ("output-file", po::value(&opt.outputFilename),"select the location and name of the output json file")
     ("fallback-file", po::value(&opt.fallbackFilename),"select a json file with default error rate values")
+    ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),"maximum number of sequence contexts to fit concurrently")
     ;
 
     po::options_description help("help");
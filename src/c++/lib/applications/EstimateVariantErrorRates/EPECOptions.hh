@@ -31,6 +31,7 @@ struct EPACOptions
     std::string thetaFilename;
     std::string outputFilename;
     std::string fallbackFilename;
+    unsigned workerThreadCount = 1;
 };
 
 
@@ -37,7 +37,7 @@ runEPEC(
 
 
     IndelModelProduction indelModelProduction(counts, opt.thetaFilename, opt.outputFilename);
-    indelModelProduction.estimateIndelErrorRates();
+    indelModelProduction.estimateIndelErrorRates(opt.workerThreadCount);
     if (indelModelProduction.checkEstimatedModel())
     {
         indelModelProduction.exportIndelErrorModelJson();
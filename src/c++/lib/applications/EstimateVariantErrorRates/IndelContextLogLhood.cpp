@@ -0,0 +1,245 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "IndelContextLogLhood.hh"
+
+#include "blt_util/log.hh"
+#include "blt_util/logSumUtil.hh"
+
+#include <algorithm>
+#include <cassert>
+
+
+using namespace IndelCounts;
+
+
+
+ContextObservationArrays::
+ContextObservationArrays(
+    const SingleSampleContextDataExportFormat& exportedContextData)
+{
+    for (const auto& contextObservationInfo : exportedContextData.data)
+    {
+        const auto& altObservations(contextObservationInfo.altObservations);
+
+        unsigned totalInsertCount(0);
+        for (unsigned altIndex(INDEL_SIGNAL_TYPE::INSERT_1); altIndex<INDEL_SIGNAL_TYPE::DELETE_1; ++altIndex)
+        {
+            totalInsertCount += altObservations[altIndex];
+        }
+
+        unsigned totalDeleteCount(0);
+        for (unsigned altIndex(INDEL_SIGNAL_TYPE::DELETE_1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+        {
+            totalDeleteCount += altObservations[altIndex];
+        }
+
+        // approximate that the most frequent observations is the only potential variant allele for het and hom
+        // genotypes:
+        unsigned maxIndex(0);
+        for (unsigned altIndex(1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+        {
+            if (altObservations[altIndex] > altObservations[maxIndex]) maxIndex = altIndex;
+        }
+
+        // approximate that the two most frequent observations are the only potential variant alleles for the
+        // althet genotype:
+        assert(INDEL_SIGNAL_TYPE::SIZE>1);
+        unsigned maxIndex2(maxIndex==0 ? 1 : 0);
+        for (unsigned altIndex(maxIndex2+1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+        {
+            if (altIndex==maxIndex) continue;
+            if (altObservations[altIndex] > altObservations[maxIndex2]) maxIndex2 = altIndex;
+        }
+
+        const bool isMaxInsert(maxIndex < INDEL_SIGNAL_TYPE::DELETE_1);
+        const bool isMax2Insert(maxIndex2 < INDEL_SIGNAL_TYPE::DELETE_1);
+
+        const unsigned remainingInsertCount(totalInsertCount - (isMaxInsert ? altObservations[maxIndex] : 0));
+        const unsigned remainingDeleteCount(totalDeleteCount - (isMaxInsert ? 0 : altObservations[maxIndex]));
+
+        contextInstanceCount.push_back(contextObservationInfo.contextInstanceCount);
+        refObservations.push_back(contextObservationInfo.refObservations);
+        totalInsertObservations.push_back(totalInsertCount);
+        totalDeleteObservations.push_back(totalDeleteCount);
+        maxAltObservations.push_back(altObservations[maxIndex]);
+        remainingInsertObservations.push_back(remainingInsertCount);
+        remainingDeleteObservations.push_back(remainingDeleteCount);
+        altHetObservations.push_back(altObservations[maxIndex]+altObservations[maxIndex2]);
+        altHetRemainingInsertObservations.push_back(remainingInsertCount - (isMax2Insert ? altObservations[maxIndex2] : 0));
+        altHetRemainingDeleteObservations.push_back(remainingDeleteCount - (isMax2Insert ? 0 : altObservations[maxIndex2]));
+    }
+}
+
+
+
+void
+getObsLogLhoodBatch(
+    const ContextObservationArrays& obs,
+    const unsigned beginIndex,
+    const unsigned batchSize,
+    const GenotypeLogPriors& priors,
+    const double logInsertErrorRate,
+    const double logDeleteErrorRate,
+    const double logNoIndelRefRate,
+    double* obsLogLhood)
+{
+    static const double homAltRate(0.99);
+    static const double hetAltRate(0.5);
+
+    static const double logHomAltRate(std::log(homAltRate));
+    static const double logHomRefRate(std::log(1.-homAltRate));
+    static const double logHetRate(std::log(hetAltRate));
+
+    assert(batchSize <= observationBatchSize);
+
+    const double* refObservations(obs.refObservations.data() + beginIndex);
+    const double* totalInsertObservations(obs.totalInsertObservations.data() + beginIndex);
+    const double* totalDeleteObservations(obs.totalDeleteObservations.data() + beginIndex);
+    const double* maxAltObservations(obs.maxAltObservations.data() + beginIndex);
+    const double* remainingInsertObservations(obs.remainingInsertObservations.data() + beginIndex);
+    const double* remainingDeleteObservations(obs.remainingDeleteObservations.data() + beginIndex);
+    const double* altHetObservations(obs.altHetObservations.data() + beginIndex);
+    const double* altHetRemainingInsertObservations(obs.altHetRemainingInsertObservations.data() + beginIndex);
+    const double* altHetRemainingDeleteObservations(obs.altHetRemainingDeleteObservations.data() + beginIndex);
+
+    // get lhood of each genotype, given that the most frequent alt observations are the variant alleles:
+    double noindel[observationBatchSize];
+    double het[observationBatchSize];
+    double hom[observationBatchSize];
+    double althet[observationBatchSize];
+
+    for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+    {
+        noindel[obsIndex] = (
+                                logInsertErrorRate*totalInsertObservations[obsIndex] +
+                                logDeleteErrorRate*totalDeleteObservations[obsIndex] +
+                                logNoIndelRefRate*refObservations[obsIndex]);
+    }
+
+    for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+    {
+        het[obsIndex] = (logHetRate*(refObservations[obsIndex]+maxAltObservations[obsIndex]) +
+                         logInsertErrorRate*remainingInsertObservations[obsIndex] +
+                         logDeleteErrorRate*remainingDeleteObservations[obsIndex]);
+    }
+
+    for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+    {
+        hom[obsIndex] = (logHomAltRate*maxAltObservations[obsIndex] +
+                         logHomRefRate*refObservations[obsIndex] +
+                         logInsertErrorRate*remainingInsertObservations[obsIndex] +
+                         logDeleteErrorRate*remainingDeleteObservations[obsIndex]);
+    }
+
+    for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+    {
+        althet[obsIndex] = (logHetRate*altHetObservations[obsIndex] +
+                            logHomRefRate*refObservations[obsIndex] +
+                            logInsertErrorRate*altHetRemainingInsertObservations[obsIndex] +
+                            logDeleteErrorRate*altHetRemainingDeleteObservations[obsIndex]);
+    }
+
+    for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+    {
+        obsLogLhood[obsIndex] = getLogSum(priors.logHomPrior+hom[obsIndex], priors.logHetPrior+het[obsIndex],
+                                          priors.logNoIndelPrior+noindel[obsIndex],
+                                          priors.logAltHetPrior+althet[obsIndex]);
+    }
+}
+
+
+
+void
+ContextLogLhoodEvaluator::
+updateCleanLocusObsLogLhood(
+    const double logTheta,
+    const GenotypeLogPriors& priors)
+{
+    if (_isCleanLocusCacheSet && (logTheta == _cleanLocusCacheLogTheta)) return;
+
+    static const double cleanLocusIndelRate(1e-8);
+    static const double logCleanLocusIndelRate(std::log(cleanLocusIndelRate));
+    static const double logCleanLocusRefRate(std::log(1-cleanLocusIndelRate));
+
+    const unsigned obsCount(_obs.size());
+    for (unsigned beginIndex(0); beginIndex < obsCount; beginIndex += observationBatchSize)
+    {
+        const unsigned batchSize(std::min(observationBatchSize, obsCount-beginIndex));
+        getObsLogLhoodBatch(_obs, beginIndex, batchSize, priors, logCleanLocusIndelRate, logCleanLocusIndelRate,
+                            logCleanLocusRefRate, _cleanLocusObsLogLhood.data() + beginIndex);
+    }
+
+    _isCleanLocusCacheSet = true;
+    _cleanLocusCacheLogTheta = logTheta;
+}
+
+
+
+double
+ContextLogLhoodEvaluator::
+getLogLhood(
+    const double logInsertErrorRate,
+    const double logDeleteErrorRate,
+    const double logNoisyLocusRate,
+    const double logTheta)
+{
+#ifdef DEBUG_MODEL3
+    log_os << "MODEL3: loghood input:"
+           << " insert: " << std::exp(logInsertErrorRate)
+           << " delete: " << std::exp(logDeleteErrorRate)
+           << " noise: " << std::exp(logNoisyLocusRate)
+           << " theta: " << std::exp(logTheta)
+           << "\n";
+#endif
+
+    const GenotypeLogPriors priors(logTheta);
+
+    const double logNoIndelRefRate(std::log(1-std::exp(logInsertErrorRate)-std::exp(logDeleteErrorRate)));
+
+    const double logCleanLocusRate(std::log(1-std::exp(logNoisyLocusRate)));
+
+    updateCleanLocusObsLogLhood(logTheta, priors);
+
+    double noisyLocusObsLogLhood[observationBatchSize];
+
+    double logLhood(0.);
+    const unsigned obsCount(_obs.size());
+    for (unsigned beginIndex(0); beginIndex < obsCount; beginIndex += observationBatchSize)
+    {
+        const unsigned batchSize(std::min(observationBatchSize, obsCount-beginIndex));
+        getObsLogLhoodBatch(_obs, beginIndex, batchSize, priors, logInsertErrorRate, logDeleteErrorRate,
+                            logNoIndelRefRate, noisyLocusObsLogLhood);
+
+        const double* cleanLocusObsLogLhood(_cleanLocusObsLogLhood.data() + beginIndex);
+        const double* contextInstanceCount(_obs.contextInstanceCount.data() + beginIndex);
+        for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+        {
+            const double mix(getLogSum(logCleanLocusRate+cleanLocusObsLogLhood[obsIndex],
+                                       logNoisyLocusRate+noisyLocusObsLogLhood[obsIndex]));
+            logLhood += (mix*contextInstanceCount[obsIndex]);
+        }
+    }
+
+#ifdef DEBUG_MODEL3
+    log_os << "MODEL3: loghood output:" << logLhood << "\n";
+#endif
+
+    return logLhood;
+}
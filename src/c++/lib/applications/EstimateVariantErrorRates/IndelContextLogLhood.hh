@@ -0,0 +1,150 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Batched log likelihood of the indel observation patterns in one context
+///
+
+#pragma once
+
+#include "errorAnalysis/IndelCounts.hh"
+
+#include <cmath>
+#include <vector>
+
+
+/// \brief Indel observation patterns from one context in a structure-of-arrays layout
+///
+/// Each observation pattern is reduced to the observation counts used by the genotype likelihoods, so that the
+/// context likelihood can be evaluated over batches of observation patterns in simple loops which the compiler can
+/// vectorize.
+///
+struct ContextObservationArrays
+{
+    explicit
+    ContextObservationArrays(
+        const IndelCounts::SingleSampleContextDataExportFormat& exportedContextData);
+
+    unsigned
+    size() const
+    {
+        return contextInstanceCount.size();
+    }
+
+    std::vector<double> contextInstanceCount;
+    std::vector<double> refObservations;
+    std::vector<double> totalInsertObservations;
+    std::vector<double> totalDeleteObservations;
+
+    /// Observations of the most frequent alt allele
+    std::vector<double> maxAltObservations;
+
+    /// Insert and delete observations excluding the most frequent alt allele
+    std::vector<double> remainingInsertObservations;
+    std::vector<double> remainingDeleteObservations;
+
+    /// Observations of the two most frequent alt alleles
+    std::vector<double> altHetObservations;
+
+    /// Insert and delete observations excluding the two most frequent alt alleles
+    std::vector<double> altHetRemainingInsertObservations;
+    std::vector<double> altHetRemainingDeleteObservations;
+};
+
+
+
+/// Log genotype priors for one context
+struct GenotypeLogPriors
+{
+    explicit
+    GenotypeLogPriors(const double logTheta)
+    {
+        static const double log2(std::log(2));
+        logHomPrior = (logTheta-log2);
+        logHetPrior = logTheta;
+        logAltHetPrior = (logTheta*2);
+        const double theta(std::exp(logTheta));
+        logNoIndelPrior = std::log(1-(theta*3./2.+(theta*theta)));
+    }
+
+    double logHomPrior;
+    double logHetPrior;
+    double logAltHetPrior;
+    double logNoIndelPrior;
+};
+
+
+
+/// Observation patterns are evaluated in batches of this size
+static const unsigned observationBatchSize(256);
+
+
+
+/// \brief Get the log likelihood of each observation pattern in the batch starting at \p beginIndex
+///
+/// \param[in] batchSize number of observation patterns in the batch, no more than observationBatchSize
+/// \param[out] obsLogLhood log likelihood of each observation pattern in the batch
+///
+void
+getObsLogLhoodBatch(
+    const ContextObservationArrays& obs,
+    const unsigned beginIndex,
+    const unsigned batchSize,
+    const GenotypeLogPriors& priors,
+    const double logInsertErrorRate,
+    const double logDeleteErrorRate,
+    const double logNoIndelRefRate,
+    double* obsLogLhood);
+
+
+
+/// \brief Evaluates the log likelihood of all observation patterns in one context
+///
+/// The clean locus likelihood of each observation pattern only depends on theta, which is usually locked during
+/// parameter estimation, so it is cached and only recomputed when theta changes.
+///
+class ContextLogLhoodEvaluator
+{
+public:
+    explicit
+    ContextLogLhoodEvaluator(
+        const IndelCounts::SingleSampleContextDataExportFormat& exportedContextData)
+        : _obs(exportedContextData),
+          _cleanLocusObsLogLhood(_obs.size())
+    {}
+
+    double
+    getLogLhood(
+        const double logInsertErrorRate,
+        const double logDeleteErrorRate,
+        const double logNoisyLocusRate,
+        const double logTheta);
+
+private:
+    void
+    updateCleanLocusObsLogLhood(
+        const double logTheta,
+        const GenotypeLogPriors& priors);
+
+    const ContextObservationArrays _obs;
+
+    bool _isCleanLocusCacheSet = false;
+    double _cleanLocusCacheLogTheta = 0;
+    std::vector<double> _cleanLocusObsLogLhood;
+};
@@ -18,9 +18,9 @@
 //
 
 #include "IndelModelProduction.hh"
+#include "IndelContextLogLhood.hh"
 
 #include "blt_util/log.hh"
-#include "blt_util/logSumUtil.hh"
 #include "blt_util/prob_util.hh"
 #include "calibration/ThetaJson.hh"
 #include "common/Exceptions.hh"
@@ -34,9 +34,12 @@
 #define CODEMIN_USE_BOOST
 #include "minimize_conj_direction.h"
 
+#include <atomic>
+#include <exception>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <thread>
 
 namespace MIN_PARAMS3
 {
@@ -52,182 +55,6 @@ enum index_t
 
 using namespace IndelCounts;
 
-static
-double
-getObsLogLhood(
-    const double logHomPrior,
-    const double logHetPrior,
-    const double logAltHetPrior,
-    const double logNoIndelPrior,
-    const double logInsertErrorRate,
-    const double logDeleteErrorRate,
-    const double logNoIndelRefRate,
-    const SingleSampleContextObservationInfoExportFormat& contextObservationInfo)
-{
-    static const double log0(-std::numeric_limits<double>::infinity());
-
-    static const double homAltRate(0.99);
-    static const double hetAltRate(0.5);
-
-    static const double logHomAltRate(std::log(homAltRate));
-    static const double logHomRefRate(std::log(1.-homAltRate));
-    static const double logHetRate(std::log(hetAltRate));
-
-    // get lhood of homref GT:
-    double noindel(log0);
-    {
-        unsigned totalInsertObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::INSERT_1); altIndex<INDEL_SIGNAL_TYPE::DELETE_1; ++altIndex)
-        {
-            totalInsertObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        unsigned totalDeleteObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::DELETE_1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
-        {
-            totalDeleteObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        noindel = (
-                      logInsertErrorRate*totalInsertObservations +
-                      logDeleteErrorRate*totalDeleteObservations +
-                      logNoIndelRefRate*contextObservationInfo.refObservations);
-    }
-
-    unsigned maxIndex(0);
-    for (unsigned altIndex(1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
-    {
-        if (contextObservationInfo.altObservations[altIndex] > contextObservationInfo.altObservations[maxIndex]) maxIndex = altIndex;
-    }
-
-    // get lhood of het and hom GT:
-    double het(log0);
-    double hom(log0);
-    {
-        // approximate that the most frequent observations is the only potential variant allele:
-
-        unsigned remainingInsertObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::INSERT_1); altIndex<INDEL_SIGNAL_TYPE::DELETE_1; ++altIndex)
-        {
-            if (altIndex==maxIndex) continue;
-            remainingInsertObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        unsigned remainingDeleteObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::DELETE_1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
-        {
-            if (altIndex==maxIndex) continue;
-            remainingDeleteObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        // compute lhood of het/hom states given that maxIndex is the variant allele:
-        het =(logHetRate*(contextObservationInfo.refObservations+contextObservationInfo.altObservations[maxIndex]) +
-              logInsertErrorRate*remainingInsertObservations +
-              logDeleteErrorRate*remainingDeleteObservations);
-
-        hom = (logHomAltRate*contextObservationInfo.altObservations[maxIndex] +
-               logHomRefRate*contextObservationInfo.refObservations +
-               logInsertErrorRate*remainingInsertObservations +
-               logDeleteErrorRate*remainingDeleteObservations);
-    }
-
-    // get lhood of althet GT:
-    double althet(log0);
-    {
-        // approximate that the two most frequent observations are the only potential variant alleles:
-        assert(INDEL_SIGNAL_TYPE::SIZE>1);
-        unsigned maxIndex2(maxIndex==0 ? 1 : 0);
-        for (unsigned altIndex(maxIndex2+1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
-        {
-            if (altIndex==maxIndex) continue;
-            if (contextObservationInfo.altObservations[altIndex] > contextObservationInfo.altObservations[maxIndex2]) maxIndex2 = altIndex;
-        }
-
-        unsigned remainingInsertObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::INSERT_1); altIndex<INDEL_SIGNAL_TYPE::DELETE_1; ++altIndex)
-        {
-            if (altIndex==maxIndex) continue;
-            if (altIndex==maxIndex2) continue;
-            remainingInsertObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        unsigned remainingDeleteObservations(0);
-        for (unsigned altIndex(INDEL_SIGNAL_TYPE::DELETE_1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
-        {
-            if (altIndex==maxIndex) continue;
-            if (altIndex==maxIndex2) continue;
-            remainingDeleteObservations += contextObservationInfo.altObservations[altIndex];
-        }
-
-        // compute lhood of het/hom states given that maxIndex is the variant allele:
-        althet =(logHetRate*(contextObservationInfo.altObservations[maxIndex]+contextObservationInfo.altObservations[maxIndex2]) +
-                 logHomRefRate*contextObservationInfo.refObservations +
-                 logInsertErrorRate*remainingInsertObservations +
-                 logDeleteErrorRate*remainingDeleteObservations);
-    }
-
-    return getLogSum(logHomPrior+hom, logHetPrior+het, logNoIndelPrior+noindel,logAltHetPrior+althet);
-}
-
-
-
-static
-double
-contextLogLhood(
-    const SingleSampleContextDataExportFormat& exportedContextData,
-    const double logInsertErrorRate,
-    const double logDeleteErrorRate,
-    const double logNoisyLocusRate,
-    const double logTheta)
-{
-#ifdef DEBUG_MODEL3
-    log_os << "MODEL3: loghood input:"
-           << " insert: " << std::exp(logInsertErrorRate)
-           << " delete: " << std::exp(logDeleteErrorRate)
-           << " noise: " << std::exp(logNoisyLocusRate)
-           << " theta: " << std::exp(logTheta)
-           << "\n";
-#endif
-
-    static const double log2(std::log(2));
-    const double logHomPrior(logTheta-log2);
-    const double logHetPrior(logTheta);
-    const double logAltHetPrior(logTheta*2);
-    const double theta(std::exp(logTheta));
-    const double logNoIndelPrior(std::log(1-(theta*3./2.+(theta*theta))));
-
-    const double logNoIndelRefRate(std::log(1-std::exp(logInsertErrorRate)-std::exp(logDeleteErrorRate)));
-
-    const double logCleanLocusRate(std::log(1-std::exp(logNoisyLocusRate)));
-
-    static const double cleanLocusIndelRate(1e-8);
-    static const double logCleanLocusIndelRate(std::log(cleanLocusIndelRate));
-    static const double logCleanLocusRefRate(std::log(1-cleanLocusIndelRate));
-
-    double logLhood(0.);
-    for (const auto& contextObservationInfo : exportedContextData.data)
-    {
-        const double noisyMix(getObsLogLhood(logHomPrior, logHetPrior, logAltHetPrior, logNoIndelPrior,
-                                             logInsertErrorRate, logDeleteErrorRate, logNoIndelRefRate, contextObservationInfo));
-        const double cleanMix(getObsLogLhood(logHomPrior, logHetPrior, logAltHetPrior, logNoIndelPrior,
-                                             logCleanLocusIndelRate, logCleanLocusIndelRate, logCleanLocusRefRate, contextObservationInfo));
-
-        const double mix(getLogSum(logCleanLocusRate+cleanMix, logNoisyLocusRate+noisyMix));
-
-#ifdef DEBUG_MODEL3
-        log_os << "MODEL3: loghood obs: noisy/clean/mix/delta: " << noisyMix << " " << cleanMix << " " << mix << " " << (mix*obs.repeatCount) << "\n";
-#endif
-
-        logLhood += (mix*contextObservationInfo.contextInstanceCount);
-    }
-
-#ifdef DEBUG_MODEL3
-    log_os << "MODEL3: loghood output:" << logLhood << "\n";
-#endif
-
-    return logLhood;
-}
-
 
 
 struct error_minfunc_model3 : public codemin::minfunc_interface<double>
@@ -238,7 +65,7 @@ struct error_minfunc_model3 : public codemin::minfunc_interface<double>
         const double theta,
         const bool isLockTheta = false)
         : defaultLogTheta(theta),
-          _exportedContextData(exportedContextData),
+          _contextLogLhood(exportedContextData),
           _isLockTheta(isLockTheta)
     {}
 
@@ -250,11 +77,10 @@ struct error_minfunc_model3 : public codemin::minfunc_interface<double>
     double val(const double* in) override
     {
         argToParameters(in,_params);
-        return -contextLogLhood(_exportedContextData,
-                                _params[MIN_PARAMS3::LN_INSERT_ERROR_RATE],
-                                _params[MIN_PARAMS3::LN_DELETE_ERROR_RATE],
-                                _params[MIN_PARAMS3::LN_NOISY_LOCUS_RATE],
-                                (_isLockTheta ? defaultLogTheta : _params[MIN_PARAMS3::LN_THETA]));
+        return -_contextLogLhood.getLogLhood(_params[MIN_PARAMS3::LN_INSERT_ERROR_RATE],
+                                             _params[MIN_PARAMS3::LN_DELETE_ERROR_RATE],
+                                             _params[MIN_PARAMS3::LN_NOISY_LOCUS_RATE],
+                                             (_isLockTheta ? defaultLogTheta : _params[MIN_PARAMS3::LN_THETA]));
     }
 
     /// normalize the minimization values back to usable parameters
@@ -337,7 +163,7 @@ struct error_minfunc_model3 : public codemin::minfunc_interface<double>
     static const double maxLogLocusRate;
 
 private:
-    const SingleSampleContextDataExportFormat& _exportedContextData;
+    ContextLogLhoodEvaluator _contextLogLhood;
     bool _isLockTheta;
     double _params[MIN_PARAMS3::SIZE];
 };
@@ -457,31 +283,125 @@ IndelModelProduction(
 
 
 
+namespace
+{
+
+/// Parameter estimation task for one context
+struct ContextEstimationTask
+{
+    ContextEstimationTask(
+        const Context& initContext,
+        const double initLogTheta)
+        : context(initContext),
+          logTheta(initLogTheta)
+    {}
+
+    Context context;
+    double logTheta;
+    AdaptiveIndelErrorModelLogParams estimatedParams;
+    std::exception_ptr exceptionPtr;
+};
+
+}
+
+
+
+/// \brief Estimate model parameters for all tasks using up to \p workerThreadCount threads
+///
+/// Each context is fit independently, so the estimated parameters do not depend on the thread count.
+static
+void
+runContextEstimationTasks(
+    const SequenceAlleleCounts& counts,
+    const unsigned workerThreadCount,
+    std::vector<ContextEstimationTask>& tasks)
+{
+    for (const auto& task : tasks)
+    {
+        log_os << "INFO: computing rates for context: " << task.context << "\n";
+    }
+
+    std::atomic<unsigned> nextTaskIndex(0);
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            const unsigned taskIndex(nextTaskIndex.fetch_add(1));
+            if (taskIndex >= tasks.size()) break;
+            ContextEstimationTask& task(tasks[taskIndex]);
+            try
+            {
+                task.estimatedParams = estimateModelParams(counts, task.context, task.logTheta);
+            }
+            catch (...)
+            {
+                task.exceptionPtr = std::current_exception();
+            }
+        }
+    };
+
+    const unsigned threadCount(std::min(std::max(workerThreadCount, 1u), static_cast<unsigned>(tasks.size())));
+    std::vector<std::thread> workers;
+    for (unsigned threadIndex(1); threadIndex < threadCount; ++threadIndex)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers)
+    {
+        thread.join();
+    }
+
+    for (const auto& task : tasks)
+    {
+        if (task.exceptionPtr) std::rethrow_exception(task.exceptionPtr);
+    }
+}
+
+
+
 void
 IndelModelProduction::
-estimateIndelErrorRates()
+estimateIndelErrorRates(
+    const unsigned workerThreadCount)
 {
     const auto lowRepeatCount = AdaptiveIndelErrorModel::lowRepeatCount;
     assert(_repeatPatterns.size() == _maxRepeatCounts.size());
 
+    // enumerate all independent context estimation tasks, with the low and high repeat count contexts for each
+    // repeat pattern first, followed by the non-STR context:
+    std::vector<ContextEstimationTask> tasks;
     for (unsigned repeatPatternIndex = 0; repeatPatternIndex < _repeatPatterns.size(); repeatPatternIndex++)
     {
         auto repeatPatternSize = _repeatPatterns[repeatPatternIndex];
         auto theta = _thetas[repeatPatternSize];
         assert(theta.size() >= *std::max_element(_maxRepeatCounts.begin(), _maxRepeatCounts.end()));
 
-        // estimate low repeat count params
-        const auto highRepeatCount = _maxRepeatCounts[repeatPatternIndex];
+        // low repeat count params
         const Context lowCountContext(repeatPatternSize, lowRepeatCount);
-        log_os << "INFO: computing rates for context: " << lowCountContext << "\n";
-        const auto lowLogParams = estimateModelParams(_counts, lowCountContext, std::log(theta[lowRepeatCount - 1]));
-        // estimate high repeat count params
+        tasks.emplace_back(lowCountContext, std::log(theta[lowRepeatCount - 1]));
+        // high repeat count params
+        const auto highRepeatCount = _maxRepeatCounts[repeatPatternIndex];
         const Context highCountContext(repeatPatternSize, highRepeatCount);
-        log_os << "INFO: computing rates for context: " << highCountContext << "\n";
-        const auto highLogParams = estimateModelParams(_counts, highCountContext, std::log(theta[highRepeatCount - 1]));
+        tasks.emplace_back(highCountContext, std::log(theta[highRepeatCount - 1]));
+    }
+
+    // error rate for the non-STR context
+    const unsigned nonSTRRepeatPatternSize(1);
+    const unsigned nonSTRRepeatCount(1);
+    const Context targetContext(nonSTRRepeatPatternSize, nonSTRRepeatCount);
+    const auto nonSTRTheta = _thetas.at(nonSTRRepeatPatternSize)[0];
+    tasks.emplace_back(targetContext, std::log(nonSTRTheta));
+
+    runContextEstimationTasks(_counts, workerThreadCount, tasks);
 
-        _adaptiveIndelErrorModels.push_back(AdaptiveIndelErrorModel(repeatPatternSize,
-                                                                    highRepeatCount,
+    for (unsigned repeatPatternIndex = 0; repeatPatternIndex < _repeatPatterns.size(); repeatPatternIndex++)
+    {
+        const auto& lowLogParams(tasks[repeatPatternIndex*2].estimatedParams);
+        const auto& highLogParams(tasks[repeatPatternIndex*2+1].estimatedParams);
+
+        _adaptiveIndelErrorModels.push_back(AdaptiveIndelErrorModel(_repeatPatterns[repeatPatternIndex],
+                                                                    _maxRepeatCounts[repeatPatternIndex],
                                                                     lowLogParams,
                                                                     highLogParams));
         if (!lowLogParams.paramsAcceptable || !highLogParams.paramsAcceptable)
@@ -490,13 +410,7 @@ estimateIndelErrorRates()
         }
     }
 
-    // estimate error rate for the non-STR context
-    const unsigned nonSTRRepeatPatternSize(1);
-    const unsigned nonSTRRepeatCount(1);
-    const Context targetContext(nonSTRRepeatPatternSize, nonSTRRepeatCount);
-    const auto nonSTRTheta = _thetas.at(nonSTRRepeatPatternSize)[0];
-    log_os << "INFO: computing rates for context: " << targetContext << "\n";
-    _nonSTRModelParams = estimateModelParams(_counts, targetContext, std::log(nonSTRTheta));
+    _nonSTRModelParams = tasks.back().estimatedParams;
     _isEstimated = true;
 }
 
@@ -32,7 +32,9 @@ public:
         const std::string& thetaFilename,
         const std::string& outputFilename);
 
-    void estimateIndelErrorRates();
+    /// \param workerThreadCount maximum number of contexts to fit concurrently
+    void estimateIndelErrorRates(
+        const unsigned workerThreadCount = 1);
 
     IndelErrorModelJson generateIndelErrorModelJson() const;
 
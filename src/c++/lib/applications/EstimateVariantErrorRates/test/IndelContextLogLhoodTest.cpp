@@ -0,0 +1,254 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "IndelContextLogLhood.hh"
+
+#include "blt_util/logSumUtil.hh"
+
+#include "boost/random/mersenne_twister.hpp"
+#include "boost/random/uniform_int_distribution.hpp"
+
+
+using namespace IndelCounts;
+
+
+BOOST_AUTO_TEST_SUITE( IndelContextLogLhood_test )
+
+
+/// Reference per-observation likelihood, computed one observation pattern at a time directly from the exported
+/// alt allele counts
+static
+double
+getObsLogLhood(
+    const GenotypeLogPriors& priors,
+    const double logInsertErrorRate,
+    const double logDeleteErrorRate,
+    const double logNoIndelRefRate,
+    const SingleSampleContextObservationInfoExportFormat& obs)
+{
+    static const double logHomAltRate(std::log(0.99));
+    static const double logHomRefRate(std::log(1.-0.99));
+    static const double logHetRate(std::log(0.5));
+
+    const auto& alt(obs.altObservations);
+
+    unsigned totalInsertObservations(0);
+    for (unsigned altIndex(INDEL_SIGNAL_TYPE::INSERT_1); altIndex<INDEL_SIGNAL_TYPE::DELETE_1; ++altIndex)
+    {
+        totalInsertObservations += alt[altIndex];
+    }
+
+    unsigned totalDeleteObservations(0);
+    for (unsigned altIndex(INDEL_SIGNAL_TYPE::DELETE_1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+    {
+        totalDeleteObservations += alt[altIndex];
+    }
+
+    const double noindel(logInsertErrorRate*totalInsertObservations +
+                         logDeleteErrorRate*totalDeleteObservations +
+                         logNoIndelRefRate*obs.refObservations);
+
+    unsigned maxIndex(0);
+    for (unsigned altIndex(1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+    {
+        if (alt[altIndex] > alt[maxIndex]) maxIndex = altIndex;
+    }
+
+    unsigned maxIndex2(maxIndex==0 ? 1 : 0);
+    for (unsigned altIndex(maxIndex2+1); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+    {
+        if (altIndex==maxIndex) continue;
+        if (alt[altIndex] > alt[maxIndex2]) maxIndex2 = altIndex;
+    }
+
+    unsigned remainingInsertObservations(0);
+    unsigned remainingDeleteObservations(0);
+    unsigned altHetRemainingInsertObservations(0);
+    unsigned altHetRemainingDeleteObservations(0);
+    for (unsigned altIndex(0); altIndex<INDEL_SIGNAL_TYPE::SIZE; ++altIndex)
+    {
+        if (altIndex==maxIndex) continue;
+        const bool isInsert(altIndex<INDEL_SIGNAL_TYPE::DELETE_1);
+        (isInsert ? remainingInsertObservations : remainingDeleteObservations) += alt[altIndex];
+        if (altIndex==maxIndex2) continue;
+        (isInsert ? altHetRemainingInsertObservations : altHetRemainingDeleteObservations) += alt[altIndex];
+    }
+
+    const double het(logHetRate*(obs.refObservations+alt[maxIndex]) +
+                     logInsertErrorRate*remainingInsertObservations +
+                     logDeleteErrorRate*remainingDeleteObservations);
+
+    const double hom(logHomAltRate*alt[maxIndex] +
+                     logHomRefRate*obs.refObservations +
+                     logInsertErrorRate*remainingInsertObservations +
+                     logDeleteErrorRate*remainingDeleteObservations);
+
+    const double althet(logHetRate*(alt[maxIndex]+alt[maxIndex2]) +
+                        logHomRefRate*obs.refObservations +
+                        logInsertErrorRate*altHetRemainingInsertObservations +
+                        logDeleteErrorRate*altHetRemainingDeleteObservations);
+
+    return getLogSum(priors.logHomPrior+hom, priors.logHetPrior+het, priors.logNoIndelPrior+noindel,
+                     priors.logAltHetPrior+althet);
+}
+
+
+
+/// Reference context likelihood, computed one observation pattern at a time
+static
+double
+getContextLogLhood(
+    const SingleSampleContextDataExportFormat& exportedContextData,
+    const double logInsertErrorRate,
+    const double logDeleteErrorRate,
+    const double logNoisyLocusRate,
+    const double logTheta)
+{
+    const GenotypeLogPriors priors(logTheta);
+    const double logNoIndelRefRate(std::log(1-std::exp(logInsertErrorRate)-std::exp(logDeleteErrorRate)));
+    const double logCleanLocusRate(std::log(1-std::exp(logNoisyLocusRate)));
+
+    static const double logCleanLocusIndelRate(std::log(1e-8));
+    static const double logCleanLocusRefRate(std::log(1-1e-8));
+
+    double logLhood(0.);
+    for (const auto& obs : exportedContextData.data)
+    {
+        const double noisyMix(getObsLogLhood(priors, logInsertErrorRate, logDeleteErrorRate, logNoIndelRefRate, obs));
+        const double cleanMix(getObsLogLhood(priors, logCleanLocusIndelRate, logCleanLocusIndelRate,
+                                             logCleanLocusRefRate, obs));
+        const double mix(getLogSum(logCleanLocusRate+cleanMix, logNoisyLocusRate+noisyMix));
+        logLhood += (mix*obs.contextInstanceCount);
+    }
+    return logLhood;
+}
+
+
+
+/// Random observation patterns with many zero and tied alt allele counts
+static
+SingleSampleContextDataExportFormat
+getRandomContextData(
+    const unsigned patternCount,
+    const unsigned seed)
+{
+    boost::random::mt19937 rng(seed);
+    auto getRandom = [&](const unsigned maxVal)
+    {
+        return boost::random::uniform_int_distribution<unsigned>(0, maxVal)(rng);
+    };
+
+    SingleSampleContextDataExportFormat contextData;
+    for (unsigned patternIndex(0); patternIndex<patternCount; ++patternIndex)
+    {
+        SingleSampleContextObservationInfoExportFormat obs;
+        obs.contextInstanceCount = 1 + getRandom(1000);
+        obs.refObservations = getRandom(60);
+        const unsigned maxAltCount(getRandom(3) == 0 ? 40 : 3);
+        for (auto& altCount : obs.altObservations)
+        {
+            altCount = getRandom(maxAltCount);
+        }
+        contextData.data.push_back(obs);
+    }
+    return contextData;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_getObsLogLhoodBatch )
+{
+    // not a multiple of the batch size, so that a partial batch is evaluated:
+    const unsigned patternCount(observationBatchSize*3+17);
+    const SingleSampleContextDataExportFormat contextData(getRandomContextData(patternCount, 1));
+    const ContextObservationArrays obs(contextData);
+    BOOST_REQUIRE_EQUAL(obs.size(), patternCount);
+
+    const GenotypeLogPriors priors(std::log(1e-4));
+    const double logInsertErrorRate(std::log(2e-3));
+    const double logDeleteErrorRate(std::log(5e-3));
+    const double logNoIndelRefRate(std::log(1-2e-3-5e-3));
+
+    double obsLogLhood[observationBatchSize];
+    for (unsigned beginIndex(0); beginIndex < patternCount; beginIndex += observationBatchSize)
+    {
+        const unsigned batchSize(std::min(observationBatchSize, patternCount-beginIndex));
+        getObsLogLhoodBatch(obs, beginIndex, batchSize, priors, logInsertErrorRate, logDeleteErrorRate,
+                            logNoIndelRefRate, obsLogLhood);
+        for (unsigned obsIndex(0); obsIndex < batchSize; ++obsIndex)
+        {
+            // the batched computation is done in the same order as the scalar one, so the results are bit-identical:
+            BOOST_REQUIRE_EQUAL(obsLogLhood[obsIndex],
+                                getObsLogLhood(priors, logInsertErrorRate, logDeleteErrorRate, logNoIndelRefRate,
+                                               contextData.data[beginIndex+obsIndex]));
+        }
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_ContextLogLhoodEvaluator )
+{
+    const SingleSampleContextDataExportFormat contextData(getRandomContextData(observationBatchSize*2+101, 2));
+    ContextLogLhoodEvaluator evaluator(contextData);
+
+    struct Params
+    {
+        double insertErrorRate;
+        double deleteErrorRate;
+        double noisyLocusRate;
+        double theta;
+    };
+
+    // repeated theta values use the cached clean locus likelihoods, changed theta values must update them:
+    const std::vector<Params> paramsList =
+    {
+        { 1e-3, 1e-3, 0.1, 1e-4 },
+        { 5e-3, 2e-4, 0.3, 1e-4 },
+        { 2e-2, 3e-2, 0.7, 1e-4 },
+        { 2e-2, 3e-2, 0.7, 5e-3 },
+        { 1e-4, 1e-2, 0.05, 5e-3 },
+        { 1e-4, 1e-2, 0.05, 1e-4 }
+    };
+
+    for (const auto& params : paramsList)
+    {
+        const double logInsertErrorRate(std::log(params.insertErrorRate));
+        const double logDeleteErrorRate(std::log(params.deleteErrorRate));
+        const double logNoisyLocusRate(std::log(params.noisyLocusRate));
+        const double logTheta(std::log(params.theta));
+        BOOST_REQUIRE_EQUAL(
+            evaluator.getLogLhood(logInsertErrorRate, logDeleteErrorRate, logNoisyLocusRate, logTheta),
+            getContextLogLhood(contextData, logInsertErrorRate, logDeleteErrorRate, logNoisyLocusRate, logTheta));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_ContextLogLhoodEvaluatorEmpty )
+{
+    const SingleSampleContextDataExportFormat contextData;
+    ContextLogLhoodEvaluator evaluator(contextData);
+    BOOST_REQUIRE_EQUAL(evaluator.getLogLhood(std::log(1e-3), std::log(1e-3), std::log(0.1), std::log(1e-4)), 0.);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -101,6 +101,9 @@ parseChromDepthOptions(
      "write stats to filename (default: stdout)")
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence (required)")
+    ("index-sampling", po::value(&opt.isIndexSampling)->zero_tokens(),
+     "estimate depth by decoding a random sample of short windows selected with the alignment file index, "
+     "this is much faster than the default method for large alignment files")
     ;
 
     po::options_description help("help");
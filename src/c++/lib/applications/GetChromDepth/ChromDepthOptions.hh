@@ -33,6 +33,9 @@ struct ChromDepthOptions
 
     std::string referenceFilename;
     std::string outputFilename;
+
+    /// if true, estimate depth from a random sample of windows selected with the alignment file index
+    bool isIndexSampling = false;
 };
 
 
@@ -43,7 +43,15 @@ getChromDepth(const ChromDepthOptions& opt)
     std::vector<double> chromDepth;
     for (const std::string& chromName : opt.chromNames)
     {
-        chromDepth.push_back(readChromDepthFromAlignment(opt.referenceFilename, opt.alignmentFilename, chromName));
+        if (opt.isIndexSampling)
+        {
+            chromDepth.push_back(readChromDepthFromIndexSampledAlignment(opt.referenceFilename,
+                                                                         opt.alignmentFilename, chromName));
+        }
+        else
+        {
+            chromDepth.push_back(readChromDepthFromAlignment(opt.referenceFilename, opt.alignmentFilename, chromName));
+        }
     }
 
     OutStream outs(opt.outputFilename);
@@ -25,14 +25,17 @@
 #include "ReadChromDepthUtil.hh"
 
 #include "blt_util/log.hh"
-#include "blt_util/MedianDepthTracker.hh"
-#include "blt_util/depth_buffer.hh"
+#include "blt_util/DepthRunTracker.hh"
+#include "blt_util/known_pos_range2.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/bam_header_info.hh"
 #include "htsapi/bam_streamer.hh"
 #include "starling_common/starling_read_filter_shared.hh"
 
+#include "boost/random/mersenne_twister.hpp"
+#include "boost/random/uniform_int_distribution.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -51,35 +54,21 @@ struct DepthTracker
     void
     setNewRegion()
     {
-        if (! _isRegionInit) return;
-
-        flushPos(_maxPos);
-        _maxPos = 0;
-        _isRegionInit = false;
-        _depth.clear();
+        _depth.finishRegion();
     }
 
     void
     addRead(
         const bam_record& bamRead)
     {
-        const pos_t pos(bamRead.pos()-1);
-        const unsigned rsize(bamRead.read_size());
-        if (! _isRegionInit)
-        {
-            _maxPos=pos;
-            _isRegionInit=true;
-        }
-
-        for (; _maxPos<pos; ++_maxPos) flushPos(_maxPos);
-        _depth.inc(pos,rsize);
+        _depth.addRead(bamRead.pos()-1, bamRead.read_size());
         _count++;
     }
 
     double
     getDepth() const
     {
-        return _mtrack.getMedian();
+        return _depth.getDepthHistogram().getMedian();
     }
 
     uint64_t
@@ -89,22 +78,8 @@ struct DepthTracker
     }
 
 private:
-
-    // flush position from depth tracker
-    void
-    flushPos(
-        const pos_t pos)
-    {
-        const unsigned depth(_depth.val(pos));
-        _mtrack.addObs(depth);
-        _depth.clear_pos(pos);
-    }
-
-    depth_buffer_compressible _depth = depth_buffer_compressible(16); ///< track depth for the purpose of filtering high-depth regions
-    MedianDepthTracker _mtrack;
-
-    bool _isRegionInit = false;
-    pos_t _maxPos = 0;
+    /// depth is summarized in 16 base bins, which matches the depth estimate of prior releases
+    DepthRunTracker _depth{16};
 
     uint64_t _count = 0;
 };
@@ -359,17 +334,13 @@ getChromSegments(
 
 
 
-double
-readChromDepthFromAlignment(
-    const std::string& referenceFile,
+static
+int32_t
+getChromIndex(
+    const bam_header_info& bamHeader,
     const std::string& alignmentFile,
     const std::string& chromName)
 {
-    bam_streamer read_stream(alignmentFile.c_str(), referenceFile.c_str());
-
-    const bam_hdr_t& header(read_stream.get_header());
-    const bam_header_info bamHeader(header);
-
     const auto& chromToIndex(bamHeader.chrom_to_index);
     const auto chromIter(chromToIndex.find(chromName));
     if (chromIter == chromToIndex.end())
@@ -381,7 +352,21 @@ readChromDepthFromAlignment(
         BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
     }
 
-    const int32_t chromIndex(chromIter->second);
+    return chromIter->second;
+}
+
+
+
+double
+readChromDepthFromAlignment(
+    const std::string& referenceFile,
+    const std::string& alignmentFile,
+    const std::string& chromName)
+{
+    bam_streamer read_stream(alignmentFile.c_str(), referenceFile.c_str());
+
+    const bam_header_info bamHeader(read_stream.get_header());
+    const int32_t chromIndex(getChromIndex(bamHeader, alignmentFile, chromName));
 
     const unsigned chromSize(bamHeader.chrom_data[chromIndex].length);
     unsigned segmentSize(2000000);
@@ -503,3 +488,121 @@ readChromDepthFromAlignment(
 
     return cdTracker.getDepth();
 }
+
+
+
+double
+readChromDepthFromIndexSampledAlignment(
+    const std::string& referenceFile,
+    const std::string& alignmentFile,
+    const std::string& chromName)
+{
+    bam_streamer read_stream(alignmentFile.c_str(), referenceFile.c_str());
+
+    const bam_header_info bamHeader(read_stream.get_header());
+    const int32_t chromIndex(getChromIndex(bamHeader, alignmentFile, chromName));
+
+    const unsigned chromSize(bamHeader.chrom_data[chromIndex].length);
+
+    // an empty chromosome can be detected without decoding any reads if the index records mapped read counts:
+    uint64_t mappedReadCount(0);
+    if (read_stream.getIndexMappedReadCount(chromIndex, mappedReadCount) && (mappedReadCount == 0))
+    {
+        return 0.;
+    }
+
+    // Partition the chromosome into windows, and select one sample span at a random offset in each window.
+    // Sample spans without any data according to the index are dropped here so that they do not need to be
+    // queried again below. CRAM indices do not provide this information, so no spans are dropped in this case.
+    //
+    // The random number generator is seeded with a constant so that the depth estimate is reproducible. The boost
+    // random distributions are used because the standard library distributions and std::shuffle are
+    // implementation-defined, so these would select different spans for each standard library.
+    static const unsigned sampleWindowSize(1000000);
+    static const unsigned sampleSpanSize(20000);
+
+    std::vector<unsigned> windowStartPos;
+    getChromSegments(chromSize, sampleWindowSize, windowStartPos);
+    const unsigned windowCount(windowStartPos.size());
+
+    boost::random::mt19937 randomGenerator(chromSize);
+    std::vector<known_pos_range2> sampleSpans;
+    for (unsigned windowIndex(0); windowIndex<windowCount; ++windowIndex)
+    {
+        const unsigned windowBeginPos(windowStartPos[windowIndex]);
+        const unsigned windowEndPos(((windowIndex+1)<windowCount) ? windowStartPos[windowIndex+1]: chromSize);
+        unsigned spanBeginPos(windowBeginPos);
+        if ((windowEndPos - windowBeginPos) > sampleSpanSize)
+        {
+            const unsigned maxOffset((windowEndPos - windowBeginPos) - sampleSpanSize);
+            boost::random::uniform_int_distribution<unsigned> offsetDistro(0, maxOffset);
+            spanBeginPos += offsetDistro(randomGenerator);
+        }
+        const unsigned spanEndPos(std::min(spanBeginPos + sampleSpanSize, windowEndPos));
+
+        uint64_t compressedSize(0);
+        if (read_stream.estimateIndexedRegionSize(chromIndex, spanBeginPos, spanEndPos, compressedSize) &&
+            (compressedSize == 0)) continue;
+
+        sampleSpans.emplace_back(spanBeginPos, spanEndPos);
+    }
+
+    // visit sample spans in random order so that the depth estimate is taken from spans distributed over the
+    // whole chromosome when convergence is reached early:
+    for (unsigned spanIndex(sampleSpans.size()); spanIndex > 1; --spanIndex)
+    {
+        boost::random::uniform_int_distribution<unsigned> swapDistro(0, spanIndex-1);
+        std::swap(sampleSpans[spanIndex-1], sampleSpans[swapDistro(randomGenerator)]);
+    }
+
+    // Depth convergence is tested after each sample span. The median depth is often an integer, so a minimum
+    // number of spans and several consecutive matching estimates are required to avoid stopping on an early
+    // chance match.
+    static const unsigned minSampleSpanCount(10);
+    static const unsigned minConvergedSpanCount(3);
+
+    ChromDepthTracker cdTracker;
+
+    unsigned sampledSpanCount(0);
+    unsigned convergedSpanCount(0);
+    for (const auto& span : sampleSpans)
+    {
+#ifdef DEBUG_DPS
+        log_os << "scanning sample span: " << span.begin_pos() << "," << span.end_pos() << "\n";
+#endif
+        read_stream.resetRegion(chromIndex, span.begin_pos(), span.end_pos());
+
+        cdTracker.setNewRegion();
+
+        while (read_stream.next())
+        {
+            const bam_record& bamRead(*(read_stream.get_record_ptr()));
+            const int32_t readPos(bamRead.pos()-1);
+            if (readPos<span.begin_pos()) continue;
+
+            // apply all filters:
+            const READ_FILTER_TYPE::index_t filterId(starling_read_filter_shared(bamRead));
+            if (filterId != READ_FILTER_TYPE::NONE) continue;
+
+            cdTracker.addRead(bamRead);
+        }
+
+        sampledSpanCount++;
+        if (sampledSpanCount < minSampleSpanCount) continue;
+
+        cdTracker.updateDepthConvergenceTest();
+        if (cdTracker.isDepthConverged())
+        {
+            convergedSpanCount++;
+            if (convergedSpanCount >= minConvergedSpanCount) break;
+        }
+        else
+        {
+            convergedSpanCount = 0;
+        }
+    }
+
+    cdTracker.finalize();
+
+    return cdTracker.getDepth();
+}
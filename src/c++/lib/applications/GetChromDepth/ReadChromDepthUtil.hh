@@ -34,3 +34,15 @@ readChromDepthFromAlignment(
     const std::string& referenceFile,
     const std::string& alignmentFile,
     const std::string& chromName);
+
+
+/// \brief Estimate chromosome depth from a random sample of windows selected with the alignment file index
+///
+/// Only a short span of each window is decoded, and sampling stops once the depth estimate converges, so this
+/// is much faster than readChromDepthFromAlignment for large alignment files. For BAM/CSI indices, mapped read
+/// counts and chunk offsets are used to skip empty chromosomes and windows without decoding any reads.
+double
+readChromDepthFromIndexSampledAlignment(
+    const std::string& referenceFile,
+    const std::string& alignmentFile,
+    const std::string& chromName);
@@ -21,8 +21,7 @@
 #include "ReadRegionDepthUtil.hh"
 
 #include "blt_util/log.hh"
-#include "blt_util/MedianDepthTracker.hh"
-#include "blt_util/depth_buffer.hh"
+#include "blt_util/DepthRunTracker.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/bam_header_util.hh"
 #include "htsapi/bam_header_info.hh"
@@ -48,35 +47,21 @@ struct DepthTracker
     void
     setNewRegion()
     {
-        if (! _isRegionInit) return;
-
-        flushPos(_maxPos);
-        _maxPos = 0;
-        _isRegionInit = false;
-        _depth.clear();
+        _depth.finishRegion();
     }
 
     void
     addRead(
         const bam_record& bamRead)
     {
-        const pos_t pos(bamRead.pos()-1);
-        const unsigned rsize(bamRead.read_size());
-        if (! _isRegionInit)
-        {
-            _maxPos=pos;
-            _isRegionInit=true;
-        }
-
-        for (; _maxPos<pos; ++_maxPos) flushPos(_maxPos);
-        _depth.inc(pos,rsize);
+        _depth.addRead(bamRead.pos()-1, bamRead.read_size());
         _count++;
     }
 
     double
     getDepth() const
     {
-        return _mtrack.getMedian();
+        return _depth.getDepthHistogram().getMedian();
     }
 
     uint64_t
@@ -86,22 +71,8 @@ struct DepthTracker
     }
 
 private:
-
-    // flush position from depth tracker
-    void
-    flushPos(
-        const pos_t pos)
-    {
-        const unsigned depth(_depth.val(pos));
-        _mtrack.addObs(depth);
-        _depth.clear_pos(pos);
-    }
-
-    depth_buffer_compressible _depth = depth_buffer_compressible(16); ///< track depth for the purpose of filtering high-depth regions
-    MedianDepthTracker _mtrack;
-
-    bool _isRegionInit = false;
-    pos_t _maxPos = 0;
+    /// depth is summarized in 16 base bins, which matches the depth estimate of prior releases
+    DepthRunTracker _depth{16};
 
     uint64_t _count = 0;
 };
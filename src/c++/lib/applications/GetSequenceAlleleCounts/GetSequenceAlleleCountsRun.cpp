@@ -29,6 +29,7 @@
 #include "common/Exceptions.hh"
 #include "htsapi/align_path_bam_util.hh"
 #include "htsapi/bam_header_info.hh"
+#include "htsapi/bam_streamer.hh"
 #include "htsapi/vcf_record_util.hh"
 #include "starling_common/HtsMergeStreamerUtil.hh"
 #include "starling_common/ploidy_util.hh"
@@ -36,6 +37,11 @@
 #include "starling_common/starling_pos_processor_util.hh"
 #include "strelka_common/StrelkaSampleSetSummary.hh"
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
 
 
 namespace INPUT_TYPE
@@ -93,173 +99,338 @@ processTrueIndelVariantRecord(
 
 
 
-void
-getSequenceAlleleCountsRun(
-    const prog_info& pinfo,
-    const SequenceAlleleCountsOptions& opt)
+/// \brief Register all alignment, vcf and bed inputs with \p streamData
+///
+/// \return the alignment file headers
+static
+std::vector<std::reference_wrapper<const bam_hdr_t>>
+registerInputFiles(
+    const SequenceAlleleCountsOptions& opt,
+    HtsMergeStreamer& streamData)
 {
-    // ensure that this object is created first to improve accuracy of runtime benchmarking
-    RunStatsManager statsManager(opt.segmentStatsFilename);
+    std::vector<unsigned> registrationIndices(opt.alignFileOpt.alignmentFilenames.size(), 0);
+    const std::vector<std::reference_wrapper<const bam_hdr_t>> bamHeaders(
+        registerAlignments(opt.alignFileOpt.alignmentFilenames, registrationIndices, streamData));
 
-    opt.validate();
+    assert(! bamHeaders.empty());
+    const bam_hdr_t& referenceHeader(bamHeaders.front());
 
-    const SequenceAlleleCountsDerivOptions dopt(opt);
-    starling_read_counts readCounts;
-    reference_contig_segment ref;
+    static const bool noRequireNormalized(false);
+    registerVcfList(opt.input_candidate_indel_vcf, INPUT_TYPE::CANDIDATE_INDELS, referenceHeader,
+                    streamData, noRequireNormalized);
+    registerVcfList(opt.force_output_vcf, INPUT_TYPE::FORCED_GT_VARIANTS, referenceHeader, streamData);
 
-    ////////////////////////////////////////
-    // setup streamData:
-    //
-    HtsMergeStreamer streamData(opt.referenceFilename);
+    if (!opt.knownVariantsFile.empty())
+    {
+        const vcf_streamer& vcfStream(
+            streamData.registerVcf(opt.knownVariantsFile.c_str(), INPUT_TYPE::KNOWN_VARIANTS));
+        vcfStream.validateBamHeaderChromSync(referenceHeader);
+    }
 
-    // additional data structures required in the region loop below, which are filled in as a side effect of
-    // streamData initialization:
-    std::vector<std::reference_wrapper<const bam_hdr_t>> bamHeaders;
+    for (const std::string& excludeRegionFilename : opt.excludedRegionsFileList)
     {
-        if (opt.alignFileOpt.alignmentFilenames.size() > 1)
-        {
-            using namespace illumina::common;
-            std::ostringstream oss;
-            oss << "WARNING: Multiple bam file inputs. Will be treated as single sample (with sampleName: " << opt.alignFileOpt.alignmentFilenames[0] << ")\n";
-        }
-        std::vector<unsigned> registrationIndices(opt.alignFileOpt.alignmentFilenames.size(), 0);
-        bamHeaders = registerAlignments(opt.alignFileOpt.alignmentFilenames, registrationIndices, streamData);
+        streamData.registerBed(excludeRegionFilename.c_str(), INPUT_TYPE::EXCLUDE_REGION);
+    }
 
-        assert(! bamHeaders.empty());
-        const bam_hdr_t& referenceHeader(bamHeaders.front());
+    return bamHeaders;
+}
 
-        static const bool noRequireNormalized(false);
-        registerVcfList(opt.input_candidate_indel_vcf, INPUT_TYPE::CANDIDATE_INDELS, referenceHeader,
-                        streamData, noRequireNormalized);
-        registerVcfList(opt.force_output_vcf, INPUT_TYPE::FORCED_GT_VARIANTS, referenceHeader, streamData);
 
-        if (!opt.knownVariantsFile.empty())
-        {
-            const vcf_streamer& vcfStream(
-                streamData.registerVcf(opt.knownVariantsFile.c_str(), INPUT_TYPE::KNOWN_VARIANTS));
-            vcfStream.validateBamHeaderChromSync(referenceHeader);
-        }
 
-        for (const std::string& excludeRegionFilename : opt.excludedRegionsFileList)
-        {
-            streamData.registerBed(excludeRegionFilename.c_str(), INPUT_TYPE::EXCLUDE_REGION);
-        }
-    }
+/// \brief Stream all input records from one analysis region into the position processor
+///
+/// \return false if processing was stopped before the end of the region
+static
+bool
+processRegion(
+    const SequenceAlleleCountsOptions& opt,
+    const SequenceAlleleCountsDerivOptions& dopt,
+    const AnalysisRegionInfo& regionInfo,
+    reference_contig_segment& ref,
+    HtsMergeStreamer& streamData,
+    starling_read_counts& readCounts,
+    SequenceAlleleCountsPosProcessor& posProcessor)
+{
+    posProcessor.resetRegion(regionInfo.regionChrom, regionInfo.regionRange);
+    streamData.resetRegion(regionInfo.streamerRegion.c_str());
+    setRefSegment(opt, dopt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
 
-    const bam_hdr_t& referenceHeader(bamHeaders.front());
-    const bam_header_info referenceHeaderInfo(referenceHeader);
+    while (streamData.next())
+    {
+        // stop as soon as the global non-empty site target is reached, or another worker has failed:
+        if (posProcessor.isStopRequested()) return false;
 
-    SequenceAlleleCountsStreams fileStreams(opt, pinfo, referenceHeader);
-    SequenceAlleleCountsPosProcessor posProcessor(opt, dopt, ref, fileStreams, statsManager);
+        const pos_t currentPos(streamData.getCurrentPos());
+        const HTS_TYPE::index_t currentHtsType(streamData.getCurrentType());
+        const unsigned currentIndex(streamData.getCurrentIndex());
 
-    // parse and sanity check regions
-    assert ((! opt.isHaplotypingEnabled) && "Region border size must be updated if haplotyping is enabled");
-    const unsigned supplementalRegionBorderSize(opt.maxIndelSize);
+        if (currentPos >= regionInfo.streamerRegionRange.end_pos()) break;
 
-    const auto& referenceAlignmentFilename(opt.alignFileOpt.alignmentFilenames.front());
-    std::vector<AnalysisRegionInfo> regionInfoList;
-    getStrelkaAnalysisRegions(opt, referenceAlignmentFilename, referenceHeaderInfo, supplementalRegionBorderSize, regionInfoList);
+        // wind posProcessor forward to position behind buffer head:
+        posProcessor.set_head_pos(currentPos - 1);
 
-    for (const auto& regionInfo : regionInfoList)
-    {
-        posProcessor.resetRegion(regionInfo.regionChrom, regionInfo.regionRange);
-        streamData.resetRegion(regionInfo.streamerRegion.c_str());
-        setRefSegment(opt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
-
-        while (streamData.next())
+        if (HTS_TYPE::BAM == currentHtsType)
         {
-            const pos_t currentPos(streamData.getCurrentPos());
-            const HTS_TYPE::index_t currentHtsType(streamData.getCurrentType());
-            const unsigned currentIndex(streamData.getCurrentIndex());
+            // Remove the filter below because it's not valid for
+            // RNA-Seq case, reads should be selected for the report
+            // range by the bam reading functions
+            //
+            // /// get potential bounds of the read based only on current_pos:
+            // const known_pos_range any_read_bounds(current_pos-maxIndelSize,current_pos+MAX_READ_SIZE+maxIndelSize);
+            // if( posProcessor.is_range_outside_report_influence_zone(any_read_bounds) ) continue;
 
-            if (currentPos >= regionInfo.streamerRegionRange.end_pos()) break;
+            // Approximate begin range filter: (removed for RNA-Seq)
+            //if((current_pos+MAX_READ_SIZE+maxIndelSize) <= rlimit.begin_pos) continue;
 
-            // wind posProcessor forward to position behind buffer head:
-            posProcessor.set_head_pos(currentPos - 1);
+            const bam_record& read(streamData.getCurrentBam());
 
-            if (HTS_TYPE::BAM == currentHtsType)
+            // special read noise filter used in error counting only -- this isn't the ideal place for this logic:
             {
-                // Remove the filter below because it's not valid for
-                // RNA-Seq case, reads should be selected for the report
-                // range by the bam reading functions
-                //
-                // /// get potential bounds of the read based only on current_pos:
-                // const known_pos_range any_read_bounds(current_pos-maxIndelSize,current_pos+MAX_READ_SIZE+maxIndelSize);
-                // if( posProcessor.is_range_outside_report_influence_zone(any_read_bounds) ) continue;
+                using namespace ALIGNPATH;
+                path_t apath;
+                bam_cigar_to_apath(read.raw_cigar(), read.n_cigar(), apath);
 
-                // Approximate begin range filter: (removed for RNA-Seq)
-                //if((current_pos+MAX_READ_SIZE+maxIndelSize) <= rlimit.begin_pos) continue;
-
-                const bam_record& read(streamData.getCurrentBam());
+                if (apath_indel_count(apath) > 2) continue;
+            }
 
-                // special read noise filter used in error counting only -- this isn't the ideal place for this logic:
+            processInputReadAlignment(opt, ref, streamData.getCurrentBamStreamer(),
+                                      read, currentPos, readCounts, posProcessor);
+        }
+        else if (HTS_TYPE::VCF == currentHtsType)
+        {
+            assertExpectedVcfReference(ref, streamData.getCurrentVcfStreamer());
+            const vcf_record& vcfRecord(streamData.getCurrentVcf());
+            if (INPUT_TYPE::CANDIDATE_INDELS == currentIndex)     // process candidate indels input from vcf file(s)
+            {
+                if (vcfRecord.is_indel())
                 {
-                    using namespace ALIGNPATH;
-                    path_t apath;
-                    bam_cigar_to_apath(read.raw_cigar(), read.n_cigar(), apath);
-
-                    if (apath_indel_count(apath) > 2) continue;
+                    process_candidate_indel(opt.maxIndelSize, vcfRecord, posProcessor);
                 }
-
-                processInputReadAlignment(opt, ref, streamData.getCurrentBamStreamer(),
-                                          read, currentPos, readCounts, posProcessor);
             }
-            else if (HTS_TYPE::VCF == currentHtsType)
+            else if (INPUT_TYPE::FORCED_GT_VARIANTS ==
+                     currentIndex)     // process forced genotype tests from vcf file(s)
             {
-                assertExpectedVcfReference(ref, streamData.getCurrentVcfStreamer());
-                const vcf_record& vcfRecord(streamData.getCurrentVcf());
-                if (INPUT_TYPE::CANDIDATE_INDELS == currentIndex)     // process candidate indels input from vcf file(s)
+                if (vcfRecord.is_indel())
                 {
-                    if (vcfRecord.is_indel())
-                    {
-                        process_candidate_indel(opt.maxIndelSize, vcfRecord, posProcessor);
-                    }
+                    static const unsigned sample_no(0);
+                    static const bool is_forced_output(true);
+                    process_candidate_indel(opt.maxIndelSize, vcfRecord, posProcessor, sample_no, is_forced_output);
                 }
-                else if (INPUT_TYPE::FORCED_GT_VARIANTS ==
-                         currentIndex)     // process forced genotype tests from vcf file(s)
+                else if (vcfRecord.is_snv())
                 {
-                    if (vcfRecord.is_indel())
-                    {
-                        static const unsigned sample_no(0);
-                        static const bool is_forced_output(true);
-                        process_candidate_indel(opt.maxIndelSize, vcfRecord, posProcessor, sample_no, is_forced_output);
-                    }
-                    else if (vcfRecord.is_snv())
-                    {
-                        posProcessor.insert_forced_output_pos(vcfRecord.pos - 1);
-                    }
+                    posProcessor.insert_forced_output_pos(vcfRecord.pos - 1);
                 }
-                else if (INPUT_TYPE::KNOWN_VARIANTS == currentIndex)
+            }
+            else if (INPUT_TYPE::KNOWN_VARIANTS == currentIndex)
+            {
+                if (vcfRecord.is_indel())
                 {
-                    if (vcfRecord.is_indel())
-                    {
-                        processTrueIndelVariantRecord(opt.maxIndelSize, vcfRecord, posProcessor);
-                    }
+                    processTrueIndelVariantRecord(opt.maxIndelSize, vcfRecord, posProcessor);
                 }
+            }
 
-                else
-                {
-                    assert(false && "Unexpected hts index");
-                }
+            else
+            {
+                assert(false && "Unexpected hts index");
             }
-            else if (HTS_TYPE::BED == currentHtsType)
+        }
+        else if (HTS_TYPE::BED == currentHtsType)
+        {
+            const bed_record& bedRecord(streamData.getCurrentBed());
+            if (INPUT_TYPE::EXCLUDE_REGION == currentIndex)
             {
-                const bed_record& bedRecord(streamData.getCurrentBed());
-                if (INPUT_TYPE::EXCLUDE_REGION == currentIndex)
-                {
-                    const known_pos_range2 excludedRange(bedRecord.begin, bedRecord.end);
-                    posProcessor.insertExcludedRegion(excludedRange);
-                }
-                else
-                {
-                    assert(false && "Unexpected hts index");
-                }
+                const known_pos_range2 excludedRange(bedRecord.begin, bedRecord.end);
+                posProcessor.insertExcludedRegion(excludedRange);
             }
             else
             {
-                assert(false && "Invalid input condition");
+                assert(false && "Unexpected hts index");
             }
         }
+        else
+        {
+            assert(false && "Invalid input condition");
+        }
+    }
+
+    return true;
+}
+
+
+
+namespace
+{
+
+/// Results from one worker thread in the multithreaded counting mode
+struct SequenceAlleleCountsWorkerResult
+{
+    /// worker run stats, these are merged into the run stats of the main thread
+    std::unique_ptr<RunStatsManager> statsManagerPtr;
+    SequenceAlleleCounts counts;
+    unsigned long nonEmptySiteCount = 0;
+    std::exception_ptr exceptionPtr;
+};
+
+}
+
+
+
+/// \brief Process analysis regions in a worker thread until all regions are taken or a stop is requested
+///
+/// Each worker owns all input streams, reference and count tables, so that the only state shared between workers
+/// is the next region index and the global non-empty site count target.
+static
+void
+sequenceAlleleCountsWorker(
+    const prog_info& pinfo,
+    const SequenceAlleleCountsOptions& opt,
+    const SequenceAlleleCountsDerivOptions& dopt,
+    const std::vector<AnalysisRegionInfo>& regionInfoList,
+    std::atomic<unsigned>& nextRegionIndex,
+    NonEmptySiteCountTarget& siteCountTarget,
+    SequenceAlleleCountsWorkerResult& result)
+{
+    try
+    {
+        // stats are created in the worker thread so that any hardware counters are attributed to this thread:
+        result.statsManagerPtr.reset(new RunStatsManager("", opt.isHardwareCounters));
+        RunStatsManager& statsManager(*result.statsManagerPtr);
+        starling_read_counts readCounts;
+        reference_contig_segment ref;
+
+        HtsMergeStreamer streamData(opt.getAlignmentReferenceFilename());
+        const auto bamHeaders(registerInputFiles(opt, streamData));
+
+        SequenceAlleleCountsStreams fileStreams(opt, pinfo, bamHeaders.front());
+        SequenceAlleleCountsPosProcessor posProcessor(opt, dopt, ref, fileStreams, statsManager, &siteCountTarget);
+
+        const unsigned regionCount(regionInfoList.size());
+        while (true)
+        {
+            const unsigned regionIndex(nextRegionIndex.fetch_add(1));
+            if (regionIndex >= regionCount) break;
+            if (! processRegion(opt, dopt, regionInfoList[regionIndex], ref, streamData, readCounts, posProcessor)) break;
+        }
+        posProcessor.completeProcessingWithoutOutput();
+
+        result.counts = posProcessor.getCounts();
+        result.nonEmptySiteCount = posProcessor.getNonEmptySiteCount();
+    }
+    catch (...)
+    {
+        result.exceptionPtr = std::current_exception();
+        siteCountTarget.requestStop();
+    }
+}
+
+
+
+/// \brief Process all analysis regions with multiple worker threads and write the merged counts
+///
+/// \param[in,out] statsManager run stats from all workers are merged into this object
+static
+void
+getSequenceAlleleCountsMultithreaded(
+    const prog_info& pinfo,
+    const SequenceAlleleCountsOptions& opt,
+    const SequenceAlleleCountsDerivOptions& dopt,
+    const std::vector<AnalysisRegionInfo>& regionInfoList,
+    RunStatsManager& statsManager)
+{
+    NonEmptySiteCountTarget siteCountTarget(opt.targetNonEmptySiteCount);
+    std::atomic<unsigned> nextRegionIndex(0);
+
+    const unsigned workerCount(opt.workerThreadCount);
+    std::vector<SequenceAlleleCountsWorkerResult> workerResults(workerCount);
+    std::vector<std::thread> workers;
+    for (unsigned workerIndex(0); workerIndex < workerCount; ++workerIndex)
+    {
+        workers.emplace_back(sequenceAlleleCountsWorker, std::cref(pinfo), std::cref(opt), std::cref(dopt),
+                             std::cref(regionInfoList), std::ref(nextRegionIndex), std::ref(siteCountTarget),
+                             std::ref(workerResults[workerIndex]));
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    SequenceAlleleCounts counts;
+    unsigned long nonEmptySiteCount(0);
+    for (const SequenceAlleleCountsWorkerResult& workerResult : workerResults)
+    {
+        if (workerResult.exceptionPtr) std::rethrow_exception(workerResult.exceptionPtr);
+        statsManager.merge(*workerResult.statsManagerPtr);
+        counts.merge(workerResult.counts);
+        nonEmptySiteCount += workerResult.nonEmptySiteCount;
+    }
+
+    writeSequenceAlleleCountsOutput(opt, counts, nonEmptySiteCount);
+}
+
+
+
+void
+getSequenceAlleleCountsRun(
+    const prog_info& pinfo,
+    const SequenceAlleleCountsOptions& opt)
+{
+    // ensure that this object is created first to improve accuracy of runtime benchmarking
+    RunStatsManager statsManager(opt.segmentStatsFilename, opt.isHardwareCounters);
+
+    opt.validate();
+
+    const SequenceAlleleCountsDerivOptions dopt(opt);
+
+    if (opt.alignFileOpt.alignmentFilenames.size() > 1)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "WARNING: Multiple bam file inputs. Will be treated as single sample (with sampleName: " << opt.alignFileOpt.alignmentFilenames[0] << ")\n";
+    }
+
+    // parse and sanity check regions
+    assert ((! opt.isHaplotypingEnabled) && "Region border size must be updated if haplotyping is enabled");
+    const unsigned supplementalRegionBorderSize(opt.maxIndelSize);
+
+    const auto& referenceAlignmentFilename(opt.alignFileOpt.alignmentFilenames.front());
+    std::vector<AnalysisRegionInfo> regionInfoList;
+
+    if (opt.workerThreadCount > 1)
+    {
+        // each worker registers all input streams, so only the reference alignment header is read here:
+        {
+            const bam_streamer referenceAlignmentStream(referenceAlignmentFilename.c_str(),
+                                                        opt.getAlignmentReferenceFilename().c_str());
+            const bam_header_info referenceHeaderInfo(referenceAlignmentStream.get_header());
+            getStrelkaAnalysisRegions(opt, referenceAlignmentFilename, referenceHeaderInfo,
+                                      supplementalRegionBorderSize, regionInfoList);
+        }
+        getSequenceAlleleCountsMultithreaded(pinfo, opt, dopt, regionInfoList, statsManager);
+        return;
+    }
+
+    starling_read_counts readCounts;
+    reference_contig_segment ref;
+
+    ////////////////////////////////////////
+    // setup streamData:
+    //
+    HtsMergeStreamer streamData(opt.getAlignmentReferenceFilename());
+    const std::vector<std::reference_wrapper<const bam_hdr_t>> bamHeaders(registerInputFiles(opt, streamData));
+
+    const bam_hdr_t& referenceHeader(bamHeaders.front());
+    const bam_header_info referenceHeaderInfo(referenceHeader);
+
+    getStrelkaAnalysisRegions(opt, referenceAlignmentFilename, referenceHeaderInfo, supplementalRegionBorderSize, regionInfoList);
+
+    NonEmptySiteCountTarget siteCountTarget(opt.targetNonEmptySiteCount);
+    SequenceAlleleCountsStreams fileStreams(opt, pinfo, referenceHeader);
+    SequenceAlleleCountsPosProcessor posProcessor(opt, dopt, ref, fileStreams, statsManager, &siteCountTarget);
+
+    for (const auto& regionInfo : regionInfoList)
+    {
+        if (! processRegion(opt, dopt, regionInfo, ref, streamData, readCounts, posProcessor)) break;
     }
     posProcessor.completeProcessing();
 }
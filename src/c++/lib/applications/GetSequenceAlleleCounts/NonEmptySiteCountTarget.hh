@@ -0,0 +1,73 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+
+/// Tracks the total count of non-empty sites gathered by all position processors in the current process
+///
+/// Each position processor adds its new sites in batches, so that the shared count can be updated from several
+/// worker threads without any locking. All workers stop as soon as the count reaches the target, or when any
+/// worker requests a stop.
+struct NonEmptySiteCountTarget : private boost::noncopyable
+{
+    /// \param initTargetCount target non-empty site count, or zero to disable the target
+    explicit
+    NonEmptySiteCountTarget(const uint64_t initTargetCount)
+        : _targetCount(initTargetCount)
+    {}
+
+    void
+    addSites(const uint64_t siteCount)
+    {
+        const uint64_t totalCount(_siteCount.fetch_add(siteCount, std::memory_order_relaxed) + siteCount);
+        if ((_targetCount > 0) && (totalCount >= _targetCount))
+        {
+            requestStop();
+        }
+    }
+
+    /// Stop all workers, this is used when the target is reached or when a worker fails
+    void
+    requestStop()
+    {
+        _isStopRequested.store(true, std::memory_order_relaxed);
+    }
+
+    bool
+    isStopRequested() const
+    {
+        return _isStopRequested.load(std::memory_order_relaxed);
+    }
+
+    uint64_t
+    getSiteCount() const
+    {
+        return _siteCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    const uint64_t _targetCount;
+    std::atomic<uint64_t> _siteCount{0};
+    std::atomic<bool> _isStopRequested{false};
+};
@@ -94,6 +94,14 @@ struct SequenceAlleleCountsOptions : public starling_base_options
 
     /// optional evidence count indicating the number of non-empty sites considered during error counting
     std::string nonEmptySiteCountFilename;
+
+    //======== parallel processing:
+    /// Number of worker threads used to process the analysis regions, counts from all threads are merged
+    /// before the counts output is written
+    unsigned workerThreadCount = 1;
+
+    /// If non-zero, all workers stop processing regions once the total count of non-empty sites reaches this value
+    uint64_t targetNonEmptySiteCount = 0;
 };
 
 
@@ -57,6 +57,12 @@ getSequenceAlleleCountsOptionsParser(
     ("nonempty-site-count-file",
      po::value(&opt.nonEmptySiteCountFilename),
      "File used to report the total number of non-empty sites observed which are otherwise eligible for error counting purposes. This file is used to monitor the approximate amount of evidence gathered")
+    ("threads",
+     po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
+     "Number of worker threads used to process the analysis regions. Counts from all threads are merged into a single counts file.")
+    ("target-nonempty-site-count",
+     po::value(&opt.targetNonEmptySiteCount)->default_value(opt.targetNonEmptySiteCount),
+     "Stop counting in all threads once this total number of non-empty sites has been observed. Regions are processed in order, so with multiple threads the exact set of counted sites is not deterministic (0: no target)")
     ;
 
     // final assembly
@@ -96,6 +102,32 @@ finalizeSequenceAlleleCountsOptions(
         pinfo.usage("Must specify a filename for allele counts output");
     }
 
+    if (opt.workerThreadCount == 0)
+    {
+        pinfo.usage("Worker thread count must be greater than zero");
+    }
+
+    if ((opt.workerThreadCount > 1) && opt.is_write_observations())
+    {
+        pinfo.usage("Observation BED output is not supported with more than one worker thread");
+    }
+
+    // each worker thread has its own position processor, so all threads would write the same output files:
+    if ((opt.workerThreadCount > 1) && opt.isLocusProfile())
+    {
+        pinfo.usage("Locus profile output is not supported with more than one worker thread");
+    }
+
+    if ((opt.workerThreadCount > 1) && (not opt.throttledRegionsFilename.empty()))
+    {
+        pinfo.usage("Throttled region output is not supported with more than one worker thread");
+    }
+
+    if ((opt.workerThreadCount > 1) && opt.isProgressReport())
+    {
+        pinfo.usage("Progress reporting is not supported with more than one worker thread");
+    }
+
     // knownVariantsFile and excludedRegionsFileList are both checked in the Python config code,
     // so we're not duplicating the effort here
 
@@ -51,11 +51,13 @@ SequenceAlleleCountsPosProcessor(
     const SequenceAlleleCountsDerivOptions& dopt,
     const reference_contig_segment& ref,
     const SequenceAlleleCountsStreams& fileStreams,
-    RunStatsManager& statsManager)
+    RunStatsManager& statsManager,
+    NonEmptySiteCountTarget* siteCountTargetPtr)
     : base_t(opt, dopt, ref, fileStreams, opt.alignFileOpt.alignmentFilenames.size(), statsManager),
       _opt(opt),
       _dopt(dopt),
-      _streams(fileStreams)
+      _streams(fileStreams),
+      _siteCountTargetPtr(siteCountTargetPtr)
 {
     // not generalized to multi-sample yet:
     assert(getSampleCount()==1);
@@ -102,21 +104,55 @@ reset()
 
 
 
+void
+writeSequenceAlleleCountsOutput(
+    const SequenceAlleleCountsOptions& opt,
+    const SequenceAlleleCounts& counts,
+    const unsigned long nonEmptySiteCount)
+{
+    counts.save(opt.countsFilename.c_str());
+
+    if (! opt.nonEmptySiteCountFilename.empty())
+    {
+        OutStream outs(opt.nonEmptySiteCountFilename);
+        outs.getStream() << "nonEmptySiteCount\t" << nonEmptySiteCount << "\n";
+    }
+}
+
+
+
 void
 SequenceAlleleCountsPosProcessor::
 completeProcessing()
+{
+    completeProcessingWithoutOutput();
+
+    writeSequenceAlleleCountsOutput(_opt, _counts, _nonEmptySiteCount);
+
+    _nonEmptySiteCount = 0;
+}
+
+
+
+void
+SequenceAlleleCountsPosProcessor::
+completeProcessingWithoutOutput()
 {
     reset();
+    reportNonEmptySites();
+}
+
 
-    _counts.save(_opt.countsFilename.c_str());
 
-    if (! _opt.nonEmptySiteCountFilename.empty())
+void
+SequenceAlleleCountsPosProcessor::
+reportNonEmptySites()
+{
+    if (nullptr != _siteCountTargetPtr)
     {
-        OutStream outs(_opt.nonEmptySiteCountFilename);
-        outs.getStream() << "nonEmptySiteCount\t" << _nonEmptySiteCount << "\n";
+        _siteCountTargetPtr->addSites(_unreportedNonEmptySiteCount);
     }
-
-    _nonEmptySiteCount = 0;
+    _unreportedNonEmptySiteCount = 0;
 }
 
 
@@ -357,6 +393,51 @@ static const unsigned maxSTRRepeatCount(20);
 
 
 
+/// Derive the STR context for a given position from the reference annotation track
+///
+/// \return false if the STR context could not be derived from the annotation track
+static
+bool
+getAnnotatedReferenceSTRContext(
+    const reference_contig_segment& ref,
+    const pos_t pos,
+    ReferenceSTRContext& refSTRContext)
+{
+    static const unsigned maxPatternSize(2);
+    static_assert(maxSTRRepeatCount <= ReferenceAnnotation::MaxSTRRepeatCount,
+                  "STR repeat count exceeds annotation range");
+
+    if (not ref.isAnnotated()) return false;
+
+    // the annotation can be used if all bases read to search for the STR are in this segment:
+    static const pos_t maxSearchSize(2*ReferenceAnnotation::MaxSTRPeriod);
+    if (not ref.isRangeInSegment(pos-maxSearchSize, pos+maxSearchSize+1)) return false;
+
+    const ReferenceAnnotation annotation(ref.getAnnotation(pos));
+    const unsigned period(annotation.getSTRPeriod());
+    if ((period == 0) or (period > maxPatternSize))
+    {
+        refSTRContext = ReferenceSTRContext();
+        return true;
+    }
+
+    refSTRContext.isBaseInSTR = true;
+    refSTRContext.patternSize = period;
+    refSTRContext.isBaseLeftEndOfSTR = annotation.isLeftEndOfSTR();
+    if (refSTRContext.isBaseLeftEndOfSTR)
+    {
+        // the repeat count is only reused if the bases compared to find it are in this segment:
+        const unsigned repeatCount(annotation.getSTRRepeatCount());
+        const bool isSaturated(repeatCount == ReferenceAnnotation::MaxSTRRepeatCount);
+        const pos_t countEndPos(pos + (isSaturated ? repeatCount : (repeatCount+1))*period);
+        if (not ref.isRangeInSegment(pos, countEndPos)) return false;
+        refSTRContext.STRRepeatCount = std::min(maxSTRRepeatCount, repeatCount);
+    }
+    return true;
+}
+
+
+
 /// Derive the STR context for a given position in the reference
 static
 ReferenceSTRContext
@@ -369,6 +450,8 @@ getReferenceSTRContext(
 
     ReferenceSTRContext refSTRContext;
 
+    if (getAnnotatedReferenceSTRContext(ref, pos, refSTRContext)) return refSTRContext;
+
     // find the pattern size of the STR track the current base is in
     // use the smaller pattern size if the base is in two STR tracks (e.g., pos 2 in AAAGAG is in the hpol track
     for (const auto patternSize : referenceSTRPatternSizeVector)
@@ -491,6 +574,11 @@ process_pos_error_counts(
         // error estimation
         _nonEmptySiteCount += 1;
 
+        // shared site counts are updated in batches to minimize contention between worker threads:
+        static const unsigned long siteCountReportBatchSize(1000);
+        _unreportedNonEmptySiteCount += 1;
+        if (_unreportedNonEmptySiteCount >= siteCountReportBatchSize) reportNonEmptySites();
+
         // be relatively intolerant of anything interesting happening in the local sequence neighborhood:
         static const double snvMMDRMaxFrac(0.05);
 
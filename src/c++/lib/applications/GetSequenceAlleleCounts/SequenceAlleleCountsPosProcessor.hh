@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "NonEmptySiteCountTarget.hh"
 #include "SequenceAlleleCountsOptions.hh"
 #include "SequenceAlleleCountsStreams.hh"
 #include "errorAnalysis/SequenceAlleleCounts.hh"
@@ -41,7 +42,8 @@ struct SequenceAlleleCountsPosProcessor : public starling_pos_processor_base
         const SequenceAlleleCountsDerivOptions& dopt,
         const reference_contig_segment& ref,
         const SequenceAlleleCountsStreams& fileStreams,
-        RunStatsManager& statsManager);
+        RunStatsManager& statsManager,
+        NonEmptySiteCountTarget* siteCountTargetPtr = nullptr);
 
     /// Notify this object that the region is being reset
     void reset() override;
@@ -52,6 +54,29 @@ struct SequenceAlleleCountsPosProcessor : public starling_pos_processor_base
     /// may span multiple regions) are completed.
     void completeProcessing();
 
+    /// Complete processing without writing any output, so that the counts from several position processors
+    /// can be merged and written together with writeSequenceAlleleCountsOutput()
+    void completeProcessingWithoutOutput();
+
+    const SequenceAlleleCounts&
+    getCounts() const
+    {
+        return _counts;
+    }
+
+    unsigned long
+    getNonEmptySiteCount() const
+    {
+        return _nonEmptySiteCount;
+    }
+
+    /// \return true if the shared non-empty site count target has been reached, or a stop is otherwise requested
+    bool
+    isStopRequested() const
+    {
+        return ((nullptr != _siteCountTargetPtr) && _siteCountTargetPtr->isStopRequested());
+    }
+
     void resetRegion(
         const std::string& chromName,
         const known_pos_range2& reportRegion);
@@ -100,6 +125,23 @@ private:
     RegionTracker _excludedRegions;
     RecordTracker _knownVariants;
 
+    /// Add any non-empty sites not yet reported to the shared site count target
+    void
+    reportNonEmptySites();
+
     /// Count of all non-empty sites eligible to contribute to sequencing error stats
     unsigned long _nonEmptySiteCount = 0;
+
+    NonEmptySiteCountTarget* _siteCountTargetPtr;
+
+    /// Count of non-empty sites not yet added to the shared site count target
+    unsigned long _unreportedNonEmptySiteCount = 0;
 };
+
+
+/// Write the allele counts and the optional non-empty site count file specified in \p opt
+void
+writeSequenceAlleleCountsOutput(
+    const SequenceAlleleCountsOptions& opt,
+    const SequenceAlleleCounts& counts,
+    const unsigned long nonEmptySiteCount);
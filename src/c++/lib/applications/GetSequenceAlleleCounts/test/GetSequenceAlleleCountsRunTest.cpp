@@ -0,0 +1,156 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "testConfig.h"
+
+#include "boost/test/unit_test.hpp"
+
+#include "GetSequenceAlleleCountsInfo.hh"
+#include "GetSequenceAlleleCountsRun.hh"
+#include "SequenceAlleleCountsOptionsParser.hh"
+
+#include "test/TempPath.hh"
+
+#include <fstream>
+#include <iterator>
+
+
+BOOST_AUTO_TEST_SUITE( GetSequenceAlleleCountsRun_test )
+
+
+/// Output of one GetSequenceAlleleCounts run
+struct CountsRunResult
+{
+    /// serialized counts file contents
+    std::string counts;
+    unsigned long nonEmptySiteCount = 0;
+};
+
+
+
+/// Run GetSequenceAlleleCounts on several regions of the demo data with the given extra command-line arguments
+static
+CountsRunResult
+runSequenceAlleleCounts(
+    const std::vector<std::string>& extraArgs)
+{
+    const std::string dataPath(DEMO_DATA_PATH);
+    const TempDir outputDir("alleleCountsRun-%%%%-%%%%");
+    const std::string countsFilename(outputDir.getFilename("counts.bin"));
+    const std::string siteCountFilename(outputDir.getFilename("siteCount.txt"));
+
+    std::vector<std::string> args = {
+        "GetSequenceAlleleCounts",
+        "--ref", dataPath + "/demo20.fa",
+        "--align-file", dataPath + "/NA12891_demo20.bam",
+        "--region", "demo20:1-1500",
+        "--region", "demo20:1501-3200",
+        "--region", "demo20:3201-5000",
+        "--counts-file", countsFilename,
+        "--nonempty-site-count-file", siteCountFilename
+    };
+    args.insert(args.end(), extraArgs.begin(), extraArgs.end());
+
+    std::vector<char*> argv;
+    for (std::string& arg : args)
+    {
+        argv.push_back(&arg[0]);
+    }
+
+    const prog_info& pinfo(GetSequenceAlleleCountsInfo::get());
+    SequenceAlleleCountsOptions opt;
+    po::variables_map vm;
+    const po::options_description visible(getSequenceAlleleCountsOptionsParser(opt));
+    po::store(po::command_line_parser(argv.size(), argv.data()).options(visible).run(), vm);
+    po::notify(vm);
+    finalizeSequenceAlleleCountsOptions(pinfo, vm, opt);
+
+    getSequenceAlleleCountsRun(pinfo, opt);
+
+    CountsRunResult result;
+    {
+        std::ifstream ifs(countsFilename, std::ios::binary);
+        result.counts.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ifstream ifs(siteCountFilename);
+        std::string label;
+        ifs >> label >> result.nonEmptySiteCount;
+        BOOST_REQUIRE_EQUAL(label, "nonEmptySiteCount");
+    }
+    BOOST_REQUIRE(! result.counts.empty());
+    return result;
+}
+
+
+
+static
+void
+checkResultsEqual(
+    const CountsRunResult& result,
+    const CountsRunResult& expected)
+{
+    BOOST_REQUIRE_EQUAL(result.nonEmptySiteCount, expected.nonEmptySiteCount);
+    BOOST_REQUIRE(result.counts == expected.counts);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_GetSequenceAlleleCountsRun_threads )
+{
+    const CountsRunResult serialResult(runSequenceAlleleCounts({}));
+    BOOST_REQUIRE(serialResult.nonEmptySiteCount > 0);
+
+    // regions are distributed to workers in any order, but the merged counts must be the same:
+    for (const char* threadCount : { "2", "3", "5" })
+    {
+        checkResultsEqual(runSequenceAlleleCounts({ "--threads", threadCount }), serialResult);
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_GetSequenceAlleleCountsRun_siteCountTarget )
+{
+    const CountsRunResult serialResult(runSequenceAlleleCounts({}));
+    const unsigned long totalSiteCount(serialResult.nonEmptySiteCount);
+
+    // a target which is not reached has no effect:
+    const std::string highTarget(std::to_string(totalSiteCount+1));
+    checkResultsEqual(runSequenceAlleleCounts({ "--target-nonempty-site-count", highTarget }), serialResult);
+    checkResultsEqual(runSequenceAlleleCounts({ "--target-nonempty-site-count", highTarget, "--threads", "3" }),
+                      serialResult);
+
+    // a target which is reached stops counting early, the exact set of counted sites is only deterministic for
+    // the serial run:
+    const unsigned long lowTarget(totalSiteCount/4);
+    const CountsRunResult serialTargetResult(
+        runSequenceAlleleCounts({ "--target-nonempty-site-count", std::to_string(lowTarget) }));
+    BOOST_REQUIRE_GE(serialTargetResult.nonEmptySiteCount, lowTarget);
+    BOOST_REQUIRE_LT(serialTargetResult.nonEmptySiteCount, totalSiteCount);
+    checkResultsEqual(runSequenceAlleleCounts({ "--target-nonempty-site-count", std::to_string(lowTarget) }),
+                      serialTargetResult);
+
+    const CountsRunResult threadedTargetResult(
+        runSequenceAlleleCounts({ "--target-nonempty-site-count", std::to_string(lowTarget), "--threads", "3" }));
+    BOOST_REQUIRE_GE(threadedTargetResult.nonEmptySiteCount, lowTarget);
+    BOOST_REQUIRE_LE(threadedTargetResult.nonEmptySiteCount, totalSiteCount);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -64,7 +64,9 @@ parseMRSOptions(
     ("output-file", po::value(&opt.outputFilename),
      "merged output stats file (required)")
     ("report-file", po::value(&opt.reportFilename),
-     "provide a summary report based on the merged stats");
+     "provide a summary report based on the merged stats")
+    ("locus-profile-file", po::value(&opt.locusProfileFilename),
+     "write the merged locus profile windows reaching the report threshold to this BED file, in reference order");
 
     po::options_description help("help");
     help.add_options()
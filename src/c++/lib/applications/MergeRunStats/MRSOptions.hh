@@ -36,6 +36,7 @@ struct MRSOptions
     std::string statsFilenameList;
     std::string outputFilename;
     std::string reportFilename;
+    std::string locusProfileFilename;
 };
 
 
@@ -40,6 +40,10 @@ runMRS(const MRSOptions& opt)
         {
             OutStream reps(opt.reportFilename);
         }
+        if (! opt.locusProfileFilename.empty())
+        {
+            OutStream profs(opt.locusProfileFilename);
+        }
     }
 
     RunStats mergedStats;
@@ -65,6 +69,11 @@ runMRS(const MRSOptions& opt)
     {
         mergedStats.report(opt.reportFilename.c_str());
     }
+    if (! opt.locusProfileFilename.empty())
+    {
+        OutStream profs(opt.locusProfileFilename);
+        mergedStats.runStatsData.locusProfile.writeBed(profs.getStream());
+    }
 }
 
 
@@ -20,6 +20,7 @@
 #include "MergeSequenceAlleleCounts.hh"
 #include "MSACOptions.hh"
 #include "errorAnalysis/SequenceAlleleCounts.hh"
+#include "errorAnalysis/SequenceAlleleCountsColumnar.hh"
 
 #include "common/OutStream.hh"
 
@@ -34,6 +35,21 @@ runMSAC(const MSACOptions& opt)
         OutStream outs(opt.outputFilename);
     }
 
+    // columnar input files are merged in a single streaming pass:
+    bool isAllColumnar(true);
+    for (const std::string& countsFilename : opt.countsFilename)
+    {
+        if (isColumnarSequenceAlleleCountsFile(countsFilename.c_str())) continue;
+        isAllColumnar = false;
+        break;
+    }
+
+    if (isAllColumnar)
+    {
+        mergeColumnarSequenceAlleleCountsFiles(opt.countsFilename, opt.outputFilename.c_str());
+        return;
+    }
+
     SequenceAlleleCounts mergedCounts;
     bool isFirst(true);
     for (const std::string& countsFilename : opt.countsFilename)
@@ -0,0 +1,198 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "PlanGenomeSegments.hh"
+#include "SegmentCostModel.hh"
+#include "SegmentPlanOptions.hh"
+
+#include "blt_util/log.hh"
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "common/Exceptions.hh"
+#include "common/OutStream.hh"
+#include "htsapi/samtools_fasta_util.hh"
+
+#include <cmath>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+
+
+/// \return true if pos and anchorFlankSize positions on each side of it are anchors, so that a segment boundary at
+///         pos does not split any short tandem repeat or the low complexity sequence around it
+static
+bool
+isAnchorBoundary(
+    const ReferenceAnnotationContig& annotation,
+    const unsigned anchorFlankSize,
+    const pos_t pos)
+{
+    const pos_t flankSize(anchorFlankSize);
+    if (((pos - flankSize) < 0) or ((pos + flankSize) > annotation.size)) return false;
+    for (pos_t flankPos(pos - flankSize); flankPos < (pos + flankSize); ++flankPos)
+    {
+        if (not annotation.data[flankPos].isAnchor()) return false;
+    }
+    return true;
+}
+
+
+
+static
+void
+planGenomeSegments(const SegmentPlanOptions& opt)
+{
+    using namespace illumina::common;
+
+    // check that we have write permission on the output file early:
+    {
+        OutStream outs(opt.outputFilename);
+    }
+
+    std::vector<std::pair<std::string,unsigned>> chromSizes;
+    getFastaChromSizes(opt.referenceFilename, chromSizes);
+
+    if (not opt.chromNames.empty())
+    {
+        std::vector<std::pair<std::string,unsigned>> selectedChromSizes;
+        for (const auto& chromName : opt.chromNames)
+        {
+            const auto chromIter(std::find_if(chromSizes.begin(), chromSizes.end(),
+                                              [&](const std::pair<std::string,unsigned>& chromSize)
+            {
+                return (chromSize.first == chromName);
+            }));
+            if (chromIter == chromSizes.end())
+            {
+                std::ostringstream oss;
+                oss << "Chromosome '" << chromName << "' is not found in reference fasta '"
+                    << opt.referenceFilename << "'";
+                BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+            }
+            selectedChromSizes.push_back(*chromIter);
+        }
+        chromSizes = selectedChromSizes;
+    }
+
+    const ReferenceAnnotationTrack annotationTrack(opt.referenceAnnotationFilename);
+    SegmentCostModel costModel(opt);
+
+    // predict the cost of all chromosomes first, so that segments can be sized from the total cost:
+    std::vector<ReferenceAnnotationContig> chromAnnotations;
+    std::vector<WindowCostTrack> chromCosts;
+    double totalCost(0.);
+    for (const auto& chromSize : chromSizes)
+    {
+        const std::string& chrom(chromSize.first);
+        const ReferenceAnnotationContig annotation(annotationTrack.getContig(chrom));
+        if (annotation.empty() or (annotation.size != static_cast<pos_t>(chromSize.second)))
+        {
+            std::ostringstream oss;
+            oss << "Reference annotation track '" << opt.referenceAnnotationFilename
+                << "' is inconsistent with reference fasta '" << opt.referenceFilename
+                << "' for contig '" << chrom << "'";
+            BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+        }
+
+        chromAnnotations.push_back(annotation);
+        chromCosts.emplace_back(0, chromSize.second, opt.windowSize);
+        costModel.setChromCost(chrom, annotation, chromCosts.back());
+        totalCost += chromCosts.back().getTotalCost();
+    }
+
+    const double targetSegmentCost((opt.segmentCount > 0) ? (totalCost / opt.segmentCount) : opt.targetSegmentSeconds);
+
+    // segments can't be sized from a zero total cost, so each chromosome is planned as a single segment:
+    const bool isSegmentCostValid(std::isfinite(targetSegmentCost) and (targetSegmentCost > 0.));
+    if (not isSegmentCostValid)
+    {
+        log_os << "WARNING: Total predicted time is " << totalCost
+               << " seconds, planning one segment per chromosome\n";
+    }
+
+    OutStream outs(opt.outputFilename);
+    std::ostream& os(outs.getStream());
+    os << "#chrom\tstart\tend\tpredictedSeconds\n";
+    os << std::fixed << std::setprecision(2);
+
+    unsigned totalSegmentCount(0);
+    double maxSegmentCost(0.);
+    const unsigned chromCount(chromSizes.size());
+    for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex)
+    {
+        const std::string& chrom(chromSizes[chromIndex].first);
+        const ReferenceAnnotationContig& annotation(chromAnnotations[chromIndex]);
+        const WindowCostTrack& costTrack(chromCosts[chromIndex]);
+        if (costTrack.beginPos >= costTrack.endPos) continue;
+
+        const double chromCost(costTrack.getTotalCost());
+        const unsigned segmentCount(isSegmentCostValid ?
+                                    std::max(1l, std::lround(chromCost / targetSegmentCost)) : 1);
+        std::vector<ShiftedSegmentBoundary> shiftedBoundaries;
+        std::vector<pos_t> segmentEndPos(getSegmentBoundaries(costTrack, segmentCount, opt.maxBoundaryShift,
+                                                              [&](const pos_t pos)
+        {
+            return isAnchorBoundary(annotation, opt.anchorFlankSize, pos);
+        }, &shiftedBoundaries));
+        for (const ShiftedSegmentBoundary& shiftedBoundary : shiftedBoundaries)
+        {
+            log_os << "WARNING: No anchor position found within " << opt.maxBoundaryShift
+                   << " bases of segment boundary " << chrom << ":" << shiftedBoundary.idealPos;
+            if (shiftedBoundary.isDropped())
+            {
+                log_os << ", boundary is dropped\n";
+            }
+            else
+            {
+                log_os << ", boundary is moved to " << chrom << ":" << shiftedBoundary.pos << "\n";
+            }
+        }
+        segmentEndPos.push_back(costTrack.endPos);
+
+        pos_t segmentBeginPos(costTrack.beginPos);
+        double segmentBeginCost(0.);
+        for (const pos_t segmentEnd : segmentEndPos)
+        {
+            const double segmentEndCost(costTrack.getCumulativeCost(segmentEnd));
+            const double segmentCost(segmentEndCost - segmentBeginCost);
+            os << chrom << '\t' << segmentBeginPos << '\t' << segmentEnd << '\t' << segmentCost << '\n';
+
+            maxSegmentCost = std::max(maxSegmentCost, segmentCost);
+            totalSegmentCount++;
+            segmentBeginPos = segmentEnd;
+            segmentBeginCost = segmentEndCost;
+        }
+    }
+
+    log_os << "INFO: Planned " << totalSegmentCount << " segments with total predicted time " << totalCost
+           << " seconds, maximum predicted segment time " << maxSegmentCost << " seconds\n";
+}
+
+
+
+void
+PlanGenomeSegments::
+runInternal(int argc, char* argv[]) const
+{
+    SegmentPlanOptions opt;
+
+    parseSegmentPlanOptions(*this,argc,argv,opt);
+    planGenomeSegments(opt);
+}
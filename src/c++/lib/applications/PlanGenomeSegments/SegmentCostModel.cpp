@@ -0,0 +1,204 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "SegmentCostModel.hh"
+
+#include "blt_util/log.hh"
+#include "common/Exceptions.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+
+
+/// Read all windows from a locus profile BED file, see LocusProfileWindow::writeBedHeader
+static
+void
+readLocusProfile(
+    const std::string& filename,
+    std::map<std::string, std::vector<LocusProfileWindow>>& chromProfile)
+{
+    using namespace illumina::common;
+
+    std::ifstream ifs(filename);
+    if (not ifs)
+    {
+        std::ostringstream oss;
+        oss << "Can't open locus profile file: '" << filename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    std::string line;
+    unsigned lineNumber(0);
+    while (std::getline(ifs, line))
+    {
+        lineNumber++;
+        if (line.empty() or (line[0] == '#')) continue;
+
+        std::istringstream iss(line);
+        LocusProfileWindow window;
+        if (not (iss >> window.chrom >> window.beginPos >> window.endPos >> window.seconds) or
+            (window.beginPos < 0) or (window.endPos < window.beginPos))
+        {
+            std::ostringstream oss;
+            oss << "Can't parse record on line " << lineNumber << " of locus profile file: '" << filename << "'";
+            BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+        }
+        chromProfile[window.chrom].push_back(window);
+    }
+}
+
+
+
+SegmentCostModel::
+SegmentCostModel(const SegmentPlanOptions& opt)
+    : _opt(opt)
+{
+    for (const auto& alignmentFilename : opt.alignmentFilenames)
+    {
+        _alignmentStreams.emplace_back(new bam_streamer(alignmentFilename.c_str(), opt.referenceFilename.c_str()));
+        _alignmentHeaders.emplace_back(_alignmentStreams.back()->get_header());
+        _isAlignmentCostUnavailable.push_back(false);
+    }
+
+    for (const auto& locusProfileFilename : opt.locusProfileFilenames)
+    {
+        _locusProfiles.emplace_back();
+        readLocusProfile(locusProfileFilename, _locusProfiles.back());
+    }
+}
+
+
+
+void
+SegmentCostModel::
+setChromCost(
+    const std::string& chrom,
+    const ReferenceAnnotationContig& annotation,
+    WindowCostTrack& costTrack)
+{
+    assert(annotation.size >= costTrack.endPos);
+
+    const unsigned windowCount(costTrack.getWindowCount());
+    for (unsigned windowIndex(0); windowIndex < windowCount; ++windowIndex)
+    {
+        const pos_t windowBeginPos(costTrack.getWindowBeginPos(windowIndex));
+        const pos_t windowEndPos(costTrack.getWindowEndPos(windowIndex));
+        costTrack.costs[windowIndex] = ((windowEndPos - windowBeginPos) * _opt.secondsPerMegabase) / 1.e6;
+    }
+
+    addAlignmentCost(chrom, costTrack);
+
+    for (unsigned windowIndex(0); windowIndex < windowCount; ++windowIndex)
+    {
+        const pos_t windowBeginPos(costTrack.getWindowBeginPos(windowIndex));
+        const pos_t windowEndPos(costTrack.getWindowEndPos(windowIndex));
+        unsigned strPositionCount(0);
+        for (pos_t pos(windowBeginPos); pos < windowEndPos; ++pos)
+        {
+            if (annotation.data[pos].getSTRPeriod() > 0) strPositionCount++;
+        }
+        const double strFraction(static_cast<double>(strPositionCount) / (windowEndPos - windowBeginPos));
+        costTrack.costs[windowIndex] *= (1. + (_opt.strCostFactor * strFraction));
+    }
+
+    applyLocusProfiles(chrom, costTrack);
+}
+
+
+
+void
+SegmentCostModel::
+addAlignmentCost(
+    const std::string& chrom,
+    WindowCostTrack& costTrack)
+{
+    static const double bytesPerMegabyte(1024*1024);
+    const double secondsPerByte(_opt.secondsPerCompressedMegabyte / bytesPerMegabyte);
+
+    const unsigned alignmentCount(_alignmentStreams.size());
+    for (unsigned alignmentIndex(0); alignmentIndex < alignmentCount; ++alignmentIndex)
+    {
+        if (_isAlignmentCostUnavailable[alignmentIndex]) continue;
+
+        const auto& chromToIndex(_alignmentHeaders[alignmentIndex].chrom_to_index);
+        const auto chromIter(chromToIndex.find(chrom));
+        if (chromIter == chromToIndex.end()) continue;
+
+        bam_streamer& alignmentStream(*_alignmentStreams[alignmentIndex]);
+        const unsigned windowCount(costTrack.getWindowCount());
+        for (unsigned windowIndex(0); windowIndex < windowCount; ++windowIndex)
+        {
+            uint64_t compressedSize(0);
+            if (not alignmentStream.estimateIndexedRegionSize(chromIter->second,
+                                                              costTrack.getWindowBeginPos(windowIndex),
+                                                              costTrack.getWindowEndPos(windowIndex),
+                                                              compressedSize))
+            {
+                log_os << "WARNING: The index of alignment file '" << alignmentStream.name()
+                       << "' does not provide compressed size estimates, so it is not used to predict segment cost\n";
+                _isAlignmentCostUnavailable[alignmentIndex] = true;
+                break;
+            }
+            costTrack.costs[windowIndex] += compressedSize * secondsPerByte;
+        }
+    }
+}
+
+
+
+void
+SegmentCostModel::
+applyLocusProfiles(
+    const std::string& chrom,
+    WindowCostTrack& costTrack) const
+{
+    const unsigned windowCount(costTrack.getWindowCount());
+    std::vector<double> profileSeconds;
+    for (const auto& chromProfile : _locusProfiles)
+    {
+        const auto chromIter(chromProfile.find(chrom));
+        if (chromIter == chromProfile.end()) continue;
+
+        // distribute the time of each profiled window over the overlapping cost windows:
+        profileSeconds.assign(windowCount, 0.);
+        for (const auto& profileWindow : chromIter->second)
+        {
+            const pos_t beginPos(std::max(profileWindow.beginPos, costTrack.beginPos));
+            const pos_t endPos(std::min(profileWindow.endPos, costTrack.endPos));
+            if (beginPos >= endPos) continue;
+
+            const double secondsPerBase(profileWindow.seconds / (profileWindow.endPos - profileWindow.beginPos));
+            const unsigned firstWindowIndex((beginPos - costTrack.beginPos) / costTrack.windowSize);
+            const unsigned lastWindowIndex(((endPos - 1) - costTrack.beginPos) / costTrack.windowSize);
+            for (unsigned windowIndex(firstWindowIndex); windowIndex <= lastWindowIndex; ++windowIndex)
+            {
+                const pos_t overlapBeginPos(std::max(beginPos, costTrack.getWindowBeginPos(windowIndex)));
+                const pos_t overlapEndPos(std::min(endPos, costTrack.getWindowEndPos(windowIndex)));
+                profileSeconds[windowIndex] += secondsPerBase * (overlapEndPos - overlapBeginPos);
+            }
+        }
+
+        for (unsigned windowIndex(0); windowIndex < windowCount; ++windowIndex)
+        {
+            costTrack.costs[windowIndex] = std::max(costTrack.costs[windowIndex], profileSeconds[windowIndex]);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "SegmentPlanOptions.hh"
+
+#include "appstats/LocusProfile.hh"
+#include "blt_util/GenomeSegmentPlanner.hh"
+#include "blt_util/ReferenceAnnotation.hh"
+#include "htsapi/bam_header_info.hh"
+#include "htsapi/bam_streamer.hh"
+
+#include "boost/utility.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/// \brief Predicts the variant calling time of genome windows
+///
+/// The predicted time of each window is the sum of a fixed time per reference base and a time per compressed
+/// byte of alignment records, where the compressed size is estimated from the index of each alignment file without
+/// reading any records. This sum is multiplied by a factor which increases with the fraction of the window in short
+/// tandem repeats, from the reference annotation track, to account for the higher candidate indel density and
+/// realignment cost of these regions.
+///
+/// When locus profiles from previous runs are provided, the measured processing time of any profiled window is used
+/// in place of a lower predicted time.
+///
+struct SegmentCostModel : private boost::noncopyable
+{
+    explicit
+    SegmentCostModel(const SegmentPlanOptions& opt);
+
+    /// Set the predicted time of each window in costTrack, which covers contig chrom
+    void
+    setChromCost(
+        const std::string& chrom,
+        const ReferenceAnnotationContig& annotation,
+        WindowCostTrack& costTrack);
+
+private:
+    void
+    addAlignmentCost(
+        const std::string& chrom,
+        WindowCostTrack& costTrack);
+
+    void
+    applyLocusProfiles(
+        const std::string& chrom,
+        WindowCostTrack& costTrack) const;
+
+    const SegmentPlanOptions& _opt;
+
+    std::vector<std::unique_ptr<bam_streamer>> _alignmentStreams;
+    std::vector<bam_header_info> _alignmentHeaders;
+
+    /// true if the index of the alignment file can't provide compressed size estimates, such as for CRAM
+    std::vector<bool> _isAlignmentCostUnavailable;
+
+    typedef std::map<std::string, std::vector<LocusProfileWindow>> chromProfile_t;
+
+    /// profiled windows for each locus profile file, keyed on chromosome name
+    std::vector<chromProfile_t> _locusProfiles;
+};
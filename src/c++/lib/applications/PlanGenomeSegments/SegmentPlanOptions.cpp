@@ -0,0 +1,183 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "SegmentPlanOptions.hh"
+
+#include "blt_util/log.hh"
+#include "common/ProgramUtil.hh"
+#include "options/optionsUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "plan genome segments of approximately equal predicted variant calling cost",
+          " [ > output ]", msg);
+}
+
+
+
+/// \brief Parse SegmentPlanOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string content on
+///                 input is cleared
+///
+/// \return True if an error occurs while parsing options
+static
+bool
+parseOptions(
+    SegmentPlanOptions& opt,
+    std::string& errorMsg)
+{
+    if (checkAndStandardizeRequiredInputFilePath(opt.referenceFilename, "reference fasta", errorMsg)) return true;
+    if (checkAndStandardizeRequiredInputFilePath(opt.referenceAnnotationFilename, "reference annotation", errorMsg))
+    {
+        return true;
+    }
+
+    if (opt.alignmentFilenames.empty())
+    {
+        errorMsg = "Need at least one alignment file";
+        return true;
+    }
+
+    for (auto& alignmentFilename : opt.alignmentFilenames)
+    {
+        if (checkAndStandardizeRequiredInputFilePath(alignmentFilename, "alignment", errorMsg)) return true;
+    }
+
+    for (auto& locusProfileFilename : opt.locusProfileFilenames)
+    {
+        if (checkAndStandardizeRequiredInputFilePath(locusProfileFilename, "locus profile", errorMsg)) return true;
+    }
+
+    if (opt.windowSize == 0)
+    {
+        errorMsg = "Window size must be greater than zero";
+        return true;
+    }
+
+    if ((opt.segmentCount == 0) and (not (opt.targetSegmentSeconds > 0)))
+    {
+        errorMsg = "Target segment seconds must be greater than zero";
+        return true;
+    }
+
+    if ((opt.secondsPerMegabase < 0) or (opt.secondsPerCompressedMegabyte < 0) or (opt.strCostFactor < 0))
+    {
+        errorMsg = "Cost model parameters must not be negative";
+        return true;
+    }
+
+    return false;
+}
+
+
+
+void
+parseSegmentPlanOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    SegmentPlanOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+    req.add_options()
+    ("ref", po::value(&opt.referenceFilename),
+     "fasta reference sequence, samtools index file must be present (required)")
+    ("ref-annotation", po::value(&opt.referenceAnnotationFilename),
+     "reference annotation track for the fasta reference, see CreateReferenceAnnotation (required)")
+    ("align-file", po::value(&opt.alignmentFilenames),
+     "indexed alignment file in BAM format. May be supplied more than once. At least one entry required.")
+    ("locus-profile-file", po::value(&opt.locusProfileFilenames),
+     "locus profile BED file from a previous variant calling run. The processing time of each profiled window is used "
+     "in place of a lower predicted time. May be supplied more than once.")
+    ("chrom", po::value(&opt.chromNames),
+     "chromosome name. May be supplied more than once. If no chromosome is given, all chromosomes in the reference are "
+     "planned.")
+    ("output-file", po::value(&opt.outputFilename),
+     "write segment BED file to filename (default: stdout)")
+    ;
+
+    po::options_description plan("planning");
+    plan.add_options()
+    ("segment-count", po::value(&opt.segmentCount),
+     "number of segments to plan over all chromosomes. If not set, segments are planned from the target segment time.")
+    ("target-segment-seconds", po::value(&opt.targetSegmentSeconds)->default_value(opt.targetSegmentSeconds),
+     "predicted processing time of each segment")
+    ("window-size", po::value(&opt.windowSize)->default_value(opt.windowSize),
+     "genome window size used to accumulate predicted cost")
+    ("max-boundary-shift", po::value(&opt.maxBoundaryShift)->default_value(opt.maxBoundaryShift),
+     "maximum distance a segment boundary is moved from its equal cost position to reach an anchor position. If no "
+     "anchor position is found, the boundary is moved to the nearest anchor position between its neighboring "
+     "boundaries, or dropped if there is none.")
+    ("anchor-flank-size", po::value(&opt.anchorFlankSize)->default_value(opt.anchorFlankSize),
+     "number of anchor positions required on each side of a segment boundary")
+    ("seconds-per-megabase", po::value(&opt.secondsPerMegabase)->default_value(opt.secondsPerMegabase),
+     "cost model: predicted processing time per megabase of reference")
+    ("seconds-per-compressed-megabyte",
+     po::value(&opt.secondsPerCompressedMegabyte)->default_value(opt.secondsPerCompressedMegabyte),
+     "cost model: predicted processing time per megabyte of compressed alignment records, from the alignment index")
+    ("str-cost-factor", po::value(&opt.strCostFactor)->default_value(opt.strCostFactor),
+     "cost model: the predicted time of each window is multiplied by (1 + factor * f), where f is the fraction of the "
+     "window in short tandem repeats")
+    ;
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(plan).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((argc<=1) || (vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    std::string errorMsg;
+    if (parseOptions(opt, errorMsg))
+    {
+        usage(log_os, prog, visible, errorMsg.c_str());
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "common/Program.hh"
+
+#include <string>
+#include <vector>
+
+
+struct SegmentPlanOptions
+{
+    std::string referenceFilename;
+    std::string referenceAnnotationFilename;
+    std::vector<std::string> alignmentFilenames;
+
+    /// optional locus profile BED files from previous runs (see LocusProfiler)
+    std::vector<std::string> locusProfileFilenames;
+
+    /// optional list of chromosomes to plan, all reference chromosomes are planned if this is empty
+    std::vector<std::string> chromNames;
+
+    std::string outputFilename;
+
+    /// size of the genome windows used to accumulate predicted cost
+    unsigned windowSize = 10000;
+
+    /// if non-zero, the number of segments planned for the genome, otherwise the segment count is set from
+    /// targetSegmentSeconds
+    unsigned segmentCount = 0;
+
+    /// predicted processing time of each segment, used when segmentCount is not set
+    double targetSegmentSeconds = 600;
+
+    /// maximum distance a segment boundary is moved from the ideal equal cost position to reach an anchor
+    unsigned maxBoundaryShift = 10000;
+
+    /// a segment boundary must be flanked by at least this many anchor positions on each side
+    unsigned anchorFlankSize = 50;
+
+    /// cost model: predicted processing time for each megabase of reference, and for each megabyte of compressed
+    /// alignment records
+    double secondsPerMegabase = 1.0;
+    double secondsPerCompressedMegabyte = 0.6;
+
+    /// cost model: the predicted time of a window is multiplied by (1 + strCostFactor * f), where f is the fraction
+    /// of the window's reference positions which are in a short tandem repeat
+    double strCostFactor = 4.0;
+};
+
+
+void
+parseSegmentPlanOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    SegmentPlanOptions& opt);
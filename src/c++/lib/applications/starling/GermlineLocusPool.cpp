@@ -0,0 +1,102 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "GermlineLocusPool.hh"
+
+
+
+std::unique_ptr<GermlineDiploidSiteLocusInfo>
+GermlineLocusPool::
+getDiploidSiteLocus(
+    const pos_t pos,
+    const uint8_t refBaseIndex,
+    const bool isForcedOutput)
+{
+    _requestedLocusCount++;
+    _requestedSiteLocusCount++;
+    if (_freeSiteLoci.empty())
+    {
+        _allocatedLocusCount++;
+        return std::unique_ptr<GermlineDiploidSiteLocusInfo>(
+                   new GermlineDiploidSiteLocusInfo(_gvcfDerivedOptions, _sampleCount, pos, refBaseIndex, isForcedOutput));
+    }
+
+    std::unique_ptr<GermlineDiploidSiteLocusInfo> locusPtr(std::move(_freeSiteLoci.back()));
+    _freeSiteLoci.pop_back();
+    locusPtr->pos = pos;
+    locusPtr->refBaseIndex = refBaseIndex;
+    locusPtr->isForcedOutput = isForcedOutput;
+    return locusPtr;
+}
+
+
+
+std::unique_ptr<GermlineDiploidIndelLocusInfo>
+GermlineLocusPool::
+getDiploidIndelLocus()
+{
+    _requestedLocusCount++;
+    if (_freeIndelLoci.empty())
+    {
+        _allocatedLocusCount++;
+        return std::unique_ptr<GermlineDiploidIndelLocusInfo>(
+                   new GermlineDiploidIndelLocusInfo(_gvcfDerivedOptions, _sampleCount));
+    }
+
+    std::unique_ptr<GermlineDiploidIndelLocusInfo> locusPtr(std::move(_freeIndelLoci.back()));
+    _freeIndelLoci.pop_back();
+    return locusPtr;
+}
+
+
+
+void
+GermlineLocusPool::
+recycle(std::unique_ptr<GermlineSiteLocusInfo> locusPtr)
+{
+    if (not locusPtr) return;
+    if (_freeSiteLoci.size() >= _maxPoolSize) return;
+
+    // only the diploid type is reused, and the sample count must match to be handed out again:
+    GermlineDiploidSiteLocusInfo* diploidLocusPtr(dynamic_cast<GermlineDiploidSiteLocusInfo*>(locusPtr.get()));
+    if (diploidLocusPtr == nullptr) return;
+    if (diploidLocusPtr->getSampleCount() != _sampleCount) return;
+
+    locusPtr.release();
+    diploidLocusPtr->clear();
+    _freeSiteLoci.emplace_back(diploidLocusPtr);
+}
+
+
+
+void
+GermlineLocusPool::
+recycle(std::unique_ptr<GermlineIndelLocusInfo> locusPtr)
+{
+    if (not locusPtr) return;
+    if (_freeIndelLoci.size() >= _maxPoolSize) return;
+
+    GermlineDiploidIndelLocusInfo* diploidLocusPtr(dynamic_cast<GermlineDiploidIndelLocusInfo*>(locusPtr.get()));
+    if (diploidLocusPtr == nullptr) return;
+    if (diploidLocusPtr->getSampleCount() != _sampleCount) return;
+
+    locusPtr.release();
+    diploidLocusPtr->clear();
+    _freeIndelLoci.emplace_back(diploidLocusPtr);
+}
@@ -0,0 +1,106 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "gvcf_locus_info.hh"
+
+#include "boost/utility.hpp"
+
+#include <memory>
+#include <vector>
+
+
+/// Recycles diploid germline locus objects passed down the variant pipeline
+///
+/// Every reported position produces a site locus, each of which holds several per-sample
+/// and per-allele vectors and the EVS feature keepers. Instead of destroying these at the end
+/// of the pipeline, the final stage returns them here so that the next position can reuse all
+/// of the nested container storage.
+///
+/// Only the diploid locus types are pooled, any other locus type returned to the pool is
+/// simply destroyed.
+///
+struct GermlineLocusPool : private boost::noncopyable
+{
+    /// \param[in] maxPoolSize the maximum number of free loci retained per locus type
+    GermlineLocusPool(
+        const gvcf_deriv_options& gvcfDerivedOptions,
+        const unsigned sampleCount,
+        const unsigned maxPoolSize = 1024)
+        : _gvcfDerivedOptions(gvcfDerivedOptions),
+          _sampleCount(sampleCount),
+          _maxPoolSize(maxPoolSize)
+    {}
+
+    /// Get a site locus in the same state as a newly constructed object
+    std::unique_ptr<GermlineDiploidSiteLocusInfo>
+    getDiploidSiteLocus(
+        const pos_t pos,
+        const uint8_t refBaseIndex,
+        const bool isForcedOutput);
+
+    /// Get an indel locus in the same state as a newly constructed object
+    std::unique_ptr<GermlineDiploidIndelLocusInfo>
+    getDiploidIndelLocus();
+
+    /// Return a site locus to the pool
+    void
+    recycle(std::unique_ptr<GermlineSiteLocusInfo> locusPtr);
+
+    /// Return an indel locus to the pool
+    void
+    recycle(std::unique_ptr<GermlineIndelLocusInfo> locusPtr);
+
+    /// Total loci allocated from the heap by the pool
+    unsigned long
+    getAllocatedLocusCount() const
+    {
+        return _allocatedLocusCount;
+    }
+
+    /// Total loci handed out by the pool, whether allocated or reused
+    unsigned long
+    getRequestedLocusCount() const
+    {
+        return _requestedLocusCount;
+    }
+
+    /// Total site loci handed out by the pool
+    ///
+    /// In gVCF mode this is the number of reported positions, so it provides the denominator
+    /// for allocations per megabase.
+    unsigned long
+    getRequestedSiteLocusCount() const
+    {
+        return _requestedSiteLocusCount;
+    }
+
+private:
+    const gvcf_deriv_options& _gvcfDerivedOptions;
+    const unsigned _sampleCount;
+    const unsigned _maxPoolSize;
+
+    std::vector<std::unique_ptr<GermlineDiploidSiteLocusInfo>> _freeSiteLoci;
+    std::vector<std::unique_ptr<GermlineDiploidIndelLocusInfo>> _freeIndelLoci;
+
+    unsigned long _allocatedLocusCount = 0;
+    unsigned long _requestedLocusCount = 0;
+    unsigned long _requestedSiteLocusCount = 0;
+};
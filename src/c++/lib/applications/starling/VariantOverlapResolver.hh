@@ -71,6 +71,11 @@ private:
         clearBuffers();
     }
 
+    unsigned getBufferedLocusCount_impl() const override
+    {
+        return (_variantIndelBuffer.size() + _nonvariantIndelBuffer.size() + _siteBuffer.size());
+    }
+
     /// Adjust site record details for greater consistency with the overlapping indel
     ///
     /// The indel must be a variant and overlap the site.
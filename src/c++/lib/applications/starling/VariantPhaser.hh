@@ -57,6 +57,11 @@ private:
 
     void flush_impl() override;
 
+    unsigned getBufferedLocusCount_impl() const override
+    {
+        return _locusBuffer.size();
+    }
+
     template <class T>
     void processLocus(std::unique_ptr<T> locusPtr);
 
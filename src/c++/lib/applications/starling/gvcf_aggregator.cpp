@@ -33,13 +33,16 @@ gvcf_aggregator(
     const reference_contig_segment& ref,
     const RegionTracker& nocompressRegions,
     const RegionTracker& callRegions,
-    const unsigned sampleCount)
-    : _scoringModels(opt, dopt.gvcf)
+    const unsigned sampleCount,
+    StageTimer& stageTimer)
+    : _stageTimer(stageTimer),
+      _scoringModels(opt, dopt.gvcf),
+      _locusPool(dopt.gvcf, sampleCount)
 {
     if (! opt.gvcf.is_gvcf_output())
         throw std::invalid_argument("gvcf_aggregator cannot be constructed with nothing to do.");
 
-    _gvcfWriterPtr.reset(new gvcf_writer(opt, dopt, streams, ref, nocompressRegions, callRegions, _scoringModels));
+    _gvcfWriterPtr.reset(new gvcf_writer(opt, dopt, streams, ref, nocompressRegions, callRegions, _scoringModels, _locusPool));
     std::shared_ptr<variant_pipe_stage_base> nextPipeStage(_gvcfWriterPtr);
     if (opt.is_ploidy_prior)
     {
@@ -47,11 +50,12 @@ gvcf_aggregator(
         _variantPhaserPtr.reset(new VariantPhaser(opt, sampleCount, variantOverlapResolver));
         nextPipeStage = _variantPhaserPtr;
     }
-    _head.reset(new variant_prefilter_stage(_scoringModels, nextPipeStage));
+    _head.reset(new variant_prefilter_stage(_scoringModels, nextPipeStage, _stageTimer));
 }
 
 gvcf_aggregator::~gvcf_aggregator()
 {
+    const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::VARIANT_OUTPUT);
     _head->flush();
 }
 
@@ -59,17 +63,20 @@ void
 gvcf_aggregator::
 add_site(std::unique_ptr<GermlineSiteLocusInfo> si)
 {
+    const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::VARIANT_OUTPUT);
     _head->process(std::move(si));
 }
 
 void
 gvcf_aggregator::add_indel(std::unique_ptr<GermlineIndelLocusInfo> info)
 {
+    const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::VARIANT_OUTPUT);
     _head->process(std::move(info));
 }
 
 void gvcf_aggregator::reset()
 {
+    const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::VARIANT_OUTPUT);
     _head->flush();
 }
 
@@ -20,6 +20,7 @@
 #pragma once
 
 
+#include "GermlineLocusPool.hh"
 #include "VariantPhaser.hh"
 #include "gvcf_block_site_record.hh"
 #include "gvcf_locus_info.hh"
@@ -28,6 +29,9 @@
 #include "ScoringModelManager.hh"
 #include "starling_streams.hh"
 
+#include "appstats/BufferUsage.hh"
+#include "appstats/StageTimer.hh"
+
 #include <iosfwd>
 
 
@@ -44,7 +48,8 @@ public:
         const reference_contig_segment& ref,
         const RegionTracker& nocompressRegions,
         const RegionTracker& callRegions,
-        const unsigned sampleCount);
+        const unsigned sampleCount,
+        StageTimer& stageTimer);
 
     ~gvcf_aggregator();
 
@@ -63,15 +68,39 @@ public:
         _gvcfWriterPtr->resetRegion(chromName, reportRegion);
     }
 
+    /// \return count and estimated bytes of the loci buffered in all pipeline stages
+    BufferUsage
+    getBufferUsage() const
+    {
+        BufferUsage usage;
+        usage.items = _head->getBufferedLocusCount();
+        usage.bytes = usage.items * sizeof(GermlineDiploidSiteLocusInfo);
+        return usage;
+    }
+
     double
     getMaxDepth() const
     {
         return _scoringModels.getMaxDepth();
     }
 
+    /// Source of all diploid loci entering the pipeline, loci are returned here at the end of the pipeline
+    GermlineLocusPool&
+    getLocusPool()
+    {
+        return _locusPool;
+    }
+
 private:
+    /// all time spent in the variant pipeline is tracked as output time, except for time attributed to nested
+    /// stages such as EVS scoring
+    StageTimer& _stageTimer;
+
     ScoringModelManager _scoringModels;
 
+    /// the pool is declared ahead of the pipeline stages so that it outlives any locus they hold
+    GermlineLocusPool _locusPool;
+
     std::shared_ptr<VariantPhaser> _variantPhaserPtr;
     std::shared_ptr<gvcf_writer> _gvcfWriterPtr;
     std::shared_ptr<variant_pipe_stage_base> _head;
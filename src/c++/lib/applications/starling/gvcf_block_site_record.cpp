@@ -22,52 +22,23 @@
 ///
 
 #include "gvcf_block_site_record.hh"
-#include "blt_util/compat_util.hh"
 
 
 
 static
-bool
-check_block_single_tolerance(const stream_stat& ss,
-                             const int min,
-                             const int tol)
-{
-    return ((min + tol) >= ss.max()/2.0);       // hack to get nova vcfs into acceptable size range, make check less stringent across the board
-}
-
-
-
-static
-bool
-check_block_tolerance(const stream_stat& ss,
-                      const double frac_tol,
-                      const int abs_tol)
-{
-    const int min(static_cast<int>(compat_round(ss.min())));
-//    log_os << min << "\n";
-//    return true;
-    if (check_block_single_tolerance(ss,min,abs_tol)) return true;
-    const int ftol(static_cast<int>(std::floor(min * frac_tol)));
-    if (ftol <= abs_tol) return false;
-    return check_block_single_tolerance(ss, min, ftol);
-}
-
-
-
-static
-bool
-is_new_value_blockable(const int new_val,
-                       const stream_stat& ss,
-                       const double frac_tol,
-                       const int abs_tol,
-                       const bool is_new_val = true,
-                       const bool is_old_val = true)
+gvcf_block_site_values
+getBlockSiteValues(
+    const GermlineSiteLocusInfo& locus,
+    const unsigned sampleIndex)
 {
-    if (!(is_new_val && is_old_val)) return (is_new_val == is_old_val);
-
-    stream_stat ss2(ss);
-    ss2.add(new_val);
-    return check_block_tolerance(ss2,frac_tol,abs_tol);
+    const auto& siteSampleInfo(locus.getSiteSample(sampleIndex));
+
+    gvcf_block_site_values values;
+    values.usedBasecallCount = siteSampleInfo.usedBasecallCount;
+    values.unusedBasecallCount = siteSampleInfo.unusedBasecallCount;
+    values.isGqx = locus.is_gqx(sampleIndex);
+    values.gqx = locus.getSample(sampleIndex).gqx;
+    return values;
 }
 
 
@@ -82,11 +53,9 @@ testCanSiteJoinSampleBlockShared(
     if ((pos+count) != locus.pos) return false;
 
     const LocusSampleInfo& inputSampleInfo(locus.getSample(sampleIndex));
-    const auto& inputSiteSampleInfo(locus.getSiteSample(sampleIndex));
 
     static const unsigned blockSampleIndex(0);
     const LocusSampleInfo& blockSampleInfo(getSample(blockSampleIndex));
-    const auto& blockSiteSampleInfo(getSiteSample(blockSampleIndex));
 
     // filters must match:
     if (not (filters == locus.filters)) return false;
@@ -94,21 +63,6 @@ testCanSiteJoinSampleBlockShared(
 
     if (blockSampleInfo.isVariant() or inputSampleInfo.isVariant()) return false;
 
-    if (! is_new_value_blockable(
-            inputSiteSampleInfo.usedBasecallCount, block_dpu, frac_tol, abs_tol))
-    {
-        return false;
-    }
-    if (! is_new_value_blockable(
-            inputSiteSampleInfo.unusedBasecallCount, block_dpf, frac_tol, abs_tol))
-    {
-        return false;
-    }
-
-    // coverage states must match:
-    if (blockSiteSampleInfo.isAnyReadCoverage() != inputSiteSampleInfo.isAnyReadCoverage()) return false;
-    if (blockSiteSampleInfo.isUsedReadCoverage() != inputSiteSampleInfo.isUsedReadCoverage()) return false;
-
     // genotype must match
     if (not (blockSampleInfo.maxGenotypeIndexPolymorphic == inputSampleInfo.max_gt())) return false;
 
@@ -120,21 +74,68 @@ testCanSiteJoinSampleBlockShared(
 
 
 
+bool
+gvcf_block_site_record::
+testCanValuesJoinSampleBlock(
+    const gvcf_block_site_values& values) const
+{
+    static const unsigned blockSampleIndex(0);
+    const auto& blockSiteSampleInfo(getSiteSample(blockSampleIndex));
+
+    // coverage states must match:
+    const bool isUsedReadCoverage(values.usedBasecallCount != 0);
+    const bool isAnyReadCoverage(isUsedReadCoverage or (values.unusedBasecallCount != 0));
+    if (blockSiteSampleInfo.isAnyReadCoverage() != isAnyReadCoverage) return false;
+    if (blockSiteSampleInfo.isUsedReadCoverage() != isUsedReadCoverage) return false;
+
+    if (not tolerance.isNewValueBlockable(block_dpu, values.usedBasecallCount)) return false;
+    if (not tolerance.isNewValueBlockable(block_dpf, values.unusedBasecallCount)) return false;
+
+    // gqx must be either undefined for both block and site, or within tolerance:
+    if (values.isGqx != isBlockGqxDefined) return false;
+    if (values.isGqx)
+    {
+        if (not tolerance.isNewValueBlockable(block_gqx, values.gqx)) return false;
+    }
+
+    return true;
+}
+
+
+
+void
+gvcf_block_site_record::
+joinValuesToSampleBlock(
+    const gvcf_block_site_values& values)
+{
+    block_dpu.add(values.usedBasecallCount);
+    block_dpf.add(values.unusedBasecallCount);
+    if (values.isGqx)
+    {
+        block_gqx.add(values.gqx);
+    }
+
+    count += 1;
+}
+
+
+
 void
 gvcf_block_site_record::
 joinSiteToSampleBlock(
     const GermlineSiteLocusInfo& locus,
     const unsigned sampleIndex)
 {
-    const LocusSampleInfo& inputSampleInfo(locus.getSample(sampleIndex));
-    const auto& inputSiteSampleInfo(locus.getSiteSample(sampleIndex));
+    const gvcf_block_site_values values(getBlockSiteValues(locus, sampleIndex));
 
-    static const unsigned blockSampleIndex(0);
-    LocusSampleInfo& blockSampleInfo(getSample(blockSampleIndex));
-
-    const bool inputIsGqx(locus.is_gqx(sampleIndex));
     if (count == 0)
     {
+        const LocusSampleInfo& inputSampleInfo(locus.getSample(sampleIndex));
+        const auto& inputSiteSampleInfo(locus.getSiteSample(sampleIndex));
+
+        static const unsigned blockSampleIndex(0);
+        LocusSampleInfo& blockSampleInfo(getSample(blockSampleIndex));
+
         pos = locus.pos;
         refBaseIndex = locus.refBaseIndex;
 
@@ -144,17 +145,29 @@ joinSiteToSampleBlock(
         setSiteSampleInfo(blockSampleIndex, inputSiteSampleInfo);
         blockSampleInfo.maxGenotypeIndexPolymorphic = inputSampleInfo.max_gt();
         blockSampleInfo.setPloidy(inputSampleInfo.getPloidy().getPloidy());
-        isBlockGqxDefined = inputIsGqx;
+        isBlockGqxDefined = values.isGqx;
     }
 
-    block_dpu.add(inputSiteSampleInfo.usedBasecallCount);
-    block_dpf.add(inputSiteSampleInfo.unusedBasecallCount);
-    if (inputIsGqx)
+    joinValuesToSampleBlock(values);
+}
+
+
+
+unsigned
+gvcf_block_site_record::
+joinSiteRunToSampleBlock(
+    const std::vector<gvcf_block_site_values>& runValues)
+{
+    assert(count > 0);
+
+    unsigned joinCount(0);
+    for (const auto& values : runValues)
     {
-        block_gqx.add(inputSampleInfo.gqx);
+        if (not testCanValuesJoinSampleBlock(values)) break;
+        joinValuesToSampleBlock(values);
+        joinCount++;
     }
-
-    count += 1;
+    return joinCount;
 }
 
 
@@ -169,16 +182,5 @@ testCanSiteJoinSampleBlock(
 
     if (not testCanSiteJoinSampleBlockShared(locus,sampleIndex)) return false;
 
-    const LocusSampleInfo& inputSampleInfo(locus.getSample(sampleIndex));
-
-    // test blocking values:
-    if (! is_new_value_blockable(inputSampleInfo.gqx,
-                                 block_gqx,frac_tol,abs_tol,
-                                 locus.is_gqx(sampleIndex),
-                                 isBlockGqxDefined))
-    {
-        return false;
-    }
-
-    return true;
+    return testCanValuesJoinSampleBlock(getBlockSiteValues(locus, sampleIndex));
 }
@@ -26,7 +26,143 @@
 
 #include "gvcf_locus_info.hh"
 #include "gvcf_options.hh"
-#include "blt_util/stream_stat.hh"
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+
+/// integer running statistics for one value (GQX, DP or DPF) summarized over a gVCF block
+///
+struct gvcf_block_value_stat
+{
+    void
+    reset()
+    {
+        _count = 0;
+        _sum = 0;
+        _min = 0;
+        _max = 0;
+    }
+
+    void
+    add(const int x)
+    {
+        if ((_count == 0) or (x < _min)) _min = x;
+        if ((_count == 0) or (x > _max)) _max = x;
+        _sum += x;
+        _count++;
+    }
+
+    bool
+    empty() const
+    {
+        return (_count == 0);
+    }
+
+    unsigned
+    size() const
+    {
+        return _count;
+    }
+
+    int
+    min() const
+    {
+        assert(not empty());
+        return _min;
+    }
+
+    int
+    max() const
+    {
+        assert(not empty());
+        return _max;
+    }
+
+    double
+    mean() const
+    {
+        assert(not empty());
+        return static_cast<double>(_sum)/static_cast<double>(_count);
+    }
+
+private:
+    unsigned _count = 0;
+    int64_t _sum = 0;
+    int _min = 0;
+    int _max = 0;
+};
+
+
+
+/// fixed-point test of whether the range of a block value is small enough to report as a single block
+///
+struct gvcf_block_tolerance
+{
+    gvcf_block_tolerance(
+        const unsigned percentTol,
+        const unsigned absTol)
+        : _percentTol(percentTol),
+          _absTol(absTol)
+    {}
+
+    /// \return true if a block value with range [minValue,maxValue] is within tolerance
+    bool
+    isRangeBlockable(
+        const int minValue,
+        const int maxValue) const
+    {
+        // the max value is halved here, which makes the test less stringent than the
+        // tolerance described in the gVCF header, to reduce the size of the gVCF
+        if (isRangeWithinTolerance(minValue, maxValue, _absTol)) return true;
+        const int64_t fracTol((static_cast<int64_t>(minValue)*_percentTol)/100);
+        if (fracTol <= _absTol) return false;
+        return isRangeWithinTolerance(minValue, maxValue, fracTol);
+    }
+
+    /// \return true if stat remains within tolerance after adding newValue
+    bool
+    isNewValueBlockable(
+        const gvcf_block_value_stat& stat,
+        const int newValue) const
+    {
+        if (stat.empty()) return isRangeBlockable(newValue, newValue);
+        return isRangeBlockable(std::min(stat.min(), newValue), std::max(stat.max(), newValue));
+    }
+
+private:
+    static
+    bool
+    isRangeWithinTolerance(
+        const int64_t minValue,
+        const int64_t maxValue,
+        const int64_t tol)
+    {
+        return (2*(minValue + tol) >= maxValue);
+    }
+
+    const int64_t _percentTol;
+    const int64_t _absTol;
+};
+
+
+
+/// the subset of per-sample site values which vary within a non-variant block
+///
+/// This compact form allows a block to be extended over a run of positions without
+/// requiring a full locus object for each position.
+///
+struct gvcf_block_site_values
+{
+    int usedBasecallCount = 0;
+    int unusedBasecallCount = 0;
+    int gqx = 0;
+    bool isGqx = false;
+};
+
 
 
 /// manages compressed site record blocks output in the gVCF
@@ -39,8 +175,7 @@ struct gvcf_block_site_record : public GermlineSiteLocusInfo
     gvcf_block_site_record(
         const gvcf_options& opt)
         : base_t(1),
-          frac_tol(static_cast<double>(opt.block_percent_tol)/100.),
-          abs_tol(opt.block_abs_tol)
+          tolerance(opt.block_percent_tol, opt.block_abs_tol)
     {
         reset();
     }
@@ -69,6 +204,17 @@ struct gvcf_block_site_record : public GermlineSiteLocusInfo
         const GermlineSiteLocusInfo& locus,
         const unsigned sampleIndex);
 
+    /// extend a non-empty block over the run of positions starting immediately after the block end
+    ///
+    /// All positions in the run are assumed to match the block in every property other than those
+    /// included in gvcf_block_site_values (filters, genotype, ploidy, etc.). The run is joined up to
+    /// the first position which would take the block out of tolerance.
+    ///
+    /// \return the number of positions from the start of runValues joined to the block
+    unsigned
+    joinSiteRunToSampleBlock(
+        const std::vector<gvcf_block_site_values>& runValues);
+
 private:
 
     /// reduce diploid/continuous site logical duplication by putting common tests here
@@ -79,13 +225,21 @@ private:
         const GermlineSiteLocusInfo& locus,
         const unsigned sampleIndex) const;
 
+    /// \return true if the per-position block values could be joined to this block
+    bool
+    testCanValuesJoinSampleBlock(
+        const gvcf_block_site_values& values) const;
+
+    void
+    joinValuesToSampleBlock(
+        const gvcf_block_site_values& values);
+
 public:
-    const double frac_tol;
-    const int abs_tol;
+    const gvcf_block_tolerance tolerance;
     int count;
-    stream_stat block_gqx;
-    stream_stat block_dpu;
-    stream_stat block_dpf;
+    gvcf_block_value_stat block_gqx;
+    gvcf_block_value_stat block_dpu;
+    gvcf_block_value_stat block_dpf;
 
     bool isBlockGqxDefined;
     //stream_stat _blockMQ;
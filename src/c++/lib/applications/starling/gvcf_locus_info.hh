@@ -299,7 +299,8 @@ struct LocusSampleInfo
         empiricalVariantScore = -1;
         genotypePhredLoghood.clear();
         filters.clear();
-        supportCounts.clear();
+        // restore the default allele count as well as clearing counts:
+        supportCounts.setAltCount(1);
         _activeRegionId = -1;
         phaseSetId = -1;
         _ploidy.reset();
@@ -712,6 +713,20 @@ struct GermlineIndelLocusInfo : public LocusInfo
         return _doNotGenotype;
     }
 
+    void
+    clear()
+    {
+        LocusInfo::clear();
+        _indelAlleleInfo.clear();
+        for (auto& indelSample : _indelSampleInfo)
+        {
+            indelSample = GermlineIndelSampleInfo();
+        }
+        _range = known_pos_range2();
+        _commonPrefixLength = 0;
+        _doNotGenotype = false;
+    }
+
 private:
     std::vector<GermlineIndelAlleleInfo> _indelAlleleInfo;
     std::vector<GermlineIndelSampleInfo> _indelSampleInfo;
@@ -731,6 +746,8 @@ std::ostream& operator<<(std::ostream& os,const GermlineIndelLocusInfo& ii);
 /// specify that calling model is diploid
 struct GermlineDiploidIndelLocusInfo : public GermlineIndelLocusInfo
 {
+    typedef GermlineIndelLocusInfo base_t;
+
     GermlineDiploidIndelLocusInfo(
         const gvcf_deriv_options& gvcfDerivedOptions,
         const unsigned sampleCount)
@@ -752,6 +769,13 @@ struct GermlineDiploidIndelLocusInfo : public GermlineIndelLocusInfo
         VariantScoringFeatureKeeper& features,
         VariantScoringFeatureKeeper& developmentFeatures);
 
+    void
+    clear()
+    {
+        base_t::clear();
+        clearEVSFeatures();
+    }
+
     void
     clearEVSFeatures()
     {
@@ -852,6 +876,7 @@ struct GermlineSiteSampleInfo
         ReadPosRankSum = 0;
         BaseQRankSum = 0;
         MQRankSum = 0;
+        meanDistanceFromReadEdge = 0;
         avgBaseQ = 0;
         rawPos = 0;
         strandBias = 0;
@@ -1030,6 +1055,8 @@ std::ostream& operator<<(std::ostream& os,const GermlineSiteLocusInfo& si);
 /// specify that calling model is diploid
 struct GermlineDiploidSiteLocusInfo : public GermlineSiteLocusInfo
 {
+    typedef GermlineSiteLocusInfo base_t;
+
     GermlineDiploidSiteLocusInfo(
         const gvcf_deriv_options& gvcfDerivedOptions,
         const unsigned sampleCount,
@@ -1062,6 +1089,13 @@ struct GermlineDiploidSiteLocusInfo : public GermlineSiteLocusInfo
         VariantScoringFeatureKeeper& features,
         VariantScoringFeatureKeeper& developmentFeatures);
 
+    void
+    clear()
+    {
+        base_t::clear();
+        clearEVSFeatures();
+    }
+
     void
     clearEVSFeatures()
     {
@@ -51,7 +51,8 @@ gvcf_writer(
     const reference_contig_segment& ref,
     const RegionTracker& nocompressRegions,
     const RegionTracker& callRegions,
-    const ScoringModelManager& scoringModels)
+    const ScoringModelManager& scoringModels,
+    GermlineLocusPool& locusPool)
     : _opt(opt)
     , _streams(streams)
     , _ref(ref)
@@ -61,6 +62,7 @@ gvcf_writer(
     , _headPos(0)
     , _gvcf_comp(opt.gvcf,nocompressRegions)
     , _scoringModels(scoringModels)
+    , _locusPool(locusPool)
 {
     if (! opt.gvcf.is_gvcf_output())
         throw std::invalid_argument("gvcf_writer cannot be constructed with nothing to do.");
@@ -119,7 +121,7 @@ modifySiteForConsistencyWithUpstreamIndels(
     {
         if (locus.pos >= _lastVariantIndelWritten->end())
         {
-            _lastVariantIndelWritten.reset(nullptr);
+            _locusPool.recycle(std::move(_lastVariantIndelWritten));
         }
         else
         {
@@ -198,6 +200,7 @@ process(std::unique_ptr<GermlineSiteLocusInfo> locusPtr)
 
         skip_to_pos(locusPtr->pos);
         add_site_internal(*locusPtr);
+        _locusPool.recycle(std::move(locusPtr));
     }
     catch (...)
     {
@@ -225,9 +228,11 @@ process(std::unique_ptr<GermlineIndelLocusInfo> locusPtr)
         {
             if (dynamic_cast<GermlineDiploidIndelLocusInfo*>(locusPtr.get()) != nullptr)
             {
+                _locusPool.recycle(std::move(_lastVariantIndelWritten));
                 _lastVariantIndelWritten = std::move(locusPtr);
             }
         }
+        _locusPool.recycle(std::move(locusPtr));
     }
     catch (...)
     {
@@ -251,7 +256,7 @@ flush_impl()
 
     _chromName.clear();
     _headPos = 0;
-    _lastVariantIndelWritten.reset(nullptr);
+    _locusPool.recycle(std::move(_lastVariantIndelWritten));
 }
 
 
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "GermlineLocusPool.hh"
 #include "gvcf_block_site_record.hh"
 #include "gvcf_compressor.hh"
 #include "ScoringModelManager.hh"
@@ -43,7 +44,8 @@ struct gvcf_writer : public variant_pipe_stage_base
         const reference_contig_segment& ref,
         const RegionTracker& nocompressRegions,
         const RegionTracker& callRegions,
-        const ScoringModelManager& scoringModels);
+        const ScoringModelManager& scoringModels,
+        GermlineLocusPool& locusPool);
 
     void process(std::unique_ptr<GermlineSiteLocusInfo>) override;
     void process(std::unique_ptr<GermlineIndelLocusInfo>) override;
@@ -186,6 +188,9 @@ private:
     gvcf_compressor _gvcf_comp;
     const ScoringModelManager& _scoringModels;
 
+    /// all loci reaching the end of the pipeline are returned here for reuse
+    GermlineLocusPool& _locusPool;
+
     /// print output limits:
     const unsigned maxPL = 999;
 };
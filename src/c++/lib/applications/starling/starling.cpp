@@ -22,6 +22,8 @@
 #include "starling_option_parser.hh"
 #include "starling_run.hh"
 
+#include "starling_common/ReplayBundle.hh"
+
 
 namespace
 {
@@ -32,10 +34,15 @@ const prog_info& pinfo(starling_info::get());
 
 void
 starling::
-runInternal(int argc, char* argv[]) const
+runInternal(int inputArgc, char* inputArgv[]) const
 {
     starling_options opt;
 
+    // substitute replay bundle options into the command line before it is recorded and parsed:
+    ReplayBundleCommandLine replayCommandLine(opt.isSomaticCallingMode, inputArgc, inputArgv);
+    const int argc(replayCommandLine.argc());
+    char** argv(replayCommandLine.argv());
+
     for (int i(0); i<argc; ++i)
     {
         if (i) opt.cmdline += ' ';
@@ -48,6 +55,7 @@ runInternal(int argc, char* argv[]) const
         po::options_description visible(get_starling_option_parser(opt));
         po::parsed_options parsed(po::command_line_parser(argc,argv).options(visible).run());
         po::store(parsed,vm);
+        opt.commandLineOptions = getCommandLineOptions(parsed);
         po::notify(vm);
     }
     catch (const boost::program_options::error& e)
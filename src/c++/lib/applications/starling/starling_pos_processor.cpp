@@ -54,7 +54,8 @@ starling_pos_processor(
     if (_opt.gvcf.is_gvcf_output())
     {
         _gvcfer.reset(new gvcf_aggregator(
-                          _opt, _dopt, _streams, ref, _nocompress_regions, _callRegions, sampleCount));
+                          _opt, _dopt, _streams, ref, _nocompress_regions, _callRegions, sampleCount,
+                          getStageTimer()));
     }
 
     // setup indel buffer samples:
@@ -134,6 +135,11 @@ reset()
     if (_opt.gvcf.is_gvcf_output())
     {
         _gvcfer->reset();
+
+        const GermlineLocusPool& locusPool(_gvcfer->getLocusPool());
+        _statsManager.setGermlineLocusStats(locusPool.getRequestedLocusCount(),
+                                            locusPool.getAllocatedLocusCount(),
+                                            locusPool.getRequestedSiteLocusCount());
     }
     _nocompress_regions.clear();
     _variantLocusAlreadyOutputToPos = -1;
@@ -669,7 +675,8 @@ process_pos_snp_digt(
     // -----------------------------------------------
     // create site locus object:
     //
-    std::unique_ptr<GermlineDiploidSiteLocusInfo> locusPtr(new GermlineDiploidSiteLocusInfo(_dopt.gvcf, sampleCount, pos, refBaseIndex, isForcedOutput));
+    std::unique_ptr<GermlineDiploidSiteLocusInfo> locusPtr(
+        _gvcfer->getLocusPool().getDiploidSiteLocus(pos, refBaseIndex, isForcedOutput));
 
 
     // add all candidate alternate alleles:
@@ -1751,7 +1758,7 @@ process_pos_indel_digt(const pos_t pos)
 
             // setup new indel locus:
             std::unique_ptr<GermlineIndelLocusInfo> locusPtr(
-                new GermlineDiploidIndelLocusInfo(_dopt.gvcf, sampleCount));
+                _gvcfer->getLocusPool().getDiploidIndelLocus());
 
             // cycle through variant alleles and add them to locus
             // (the locus interface requires that this is done before any other locus information is added):
@@ -1924,7 +1931,7 @@ process_pos_indel_digt(const pos_t pos)
              forcedOutputAlleleIndex < forcedOutputAlleleCount; ++forcedOutputAlleleIndex)
         {
             // setup new indel locus:
-            std::unique_ptr<GermlineIndelLocusInfo> locusPtr(new GermlineDiploidIndelLocusInfo(_dopt.gvcf, sampleCount));
+            std::unique_ptr<GermlineIndelLocusInfo> locusPtr(_gvcfer->getLocusPool().getDiploidIndelLocus());
 
             // fake an allele group with only the forced output allele so that we can output using
             // standard data structures
@@ -59,6 +59,12 @@ private:
         return (_nocompress_regions.empty());
     }
 
+    BufferUsage
+    getVariantPipelineBufferUsage() const override
+    {
+        return _gvcfer->getBufferUsage();
+    }
+
     void
     process_pos_variants_impl(
         const pos_t pos,
@@ -67,9 +73,13 @@ private:
         /// TODO rm this legacy option:
         assert(_opt.gvcf.is_gvcf_output());
 
-        process_pos_indel(pos, isPosPrecedingReportableRange);
+        {
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::INDEL_GENOTYPE);
+            process_pos_indel(pos, isPosPrecedingReportableRange);
+        }
         if (not isPosPrecedingReportableRange)
         {
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::SNV_GENOTYPE);
             process_pos_snp(pos);
         }
     }
@@ -28,9 +28,13 @@
 #include "htsapi/bam_header_util.hh"
 #include "htsapi/vcf_record_util.hh"
 #include "starling_common/HtsMergeStreamerUtil.hh"
+#include "starling_common/LocusProfiler.hh"
 #include "starling_common/ploidy_util.hh"
+#include "starling_common/ReplayBundle.hh"
 #include "starling_common/starling_pos_processor_util.hh"
 
+#include <chrono>
+
 
 
 namespace INPUT_TYPE
@@ -99,10 +103,13 @@ mapVcfSampleIndices(
 
 
 
+/// \param[in] refCachePtr if non-null, regionInfo is entry regionListIndex of the region list already set on refCache
+///                        and streamData
 static
 void
 callRegion(
     const starling_options& opt,
+    const starling_deriv_options& dopt,
     const AnalysisRegionInfo& regionInfo,
     const starling_streams& fileStreams,
     const std::vector<unsigned>& sampleIndexToPloidyVcfSampleIndex,
@@ -110,15 +117,25 @@ callRegion(
     starling_read_counts& readCounts,
     reference_contig_segment& ref,
     HtsMergeStreamer& streamData,
-    starling_pos_processor& posProcessor)
+    starling_pos_processor& posProcessor,
+    ReferenceSegmentCache* refCachePtr = nullptr,
+    const unsigned regionListIndex = 0)
 {
     using namespace illumina::common;
 
     const unsigned sampleCount(opt.alignFileOpt.alignmentFilenames.size());
 
     posProcessor.resetRegion(regionInfo.regionChrom, regionInfo.regionRange);
-    streamData.resetRegion(regionInfo.streamerRegion.c_str());
-    setRefSegment(opt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
+    if (nullptr == refCachePtr)
+    {
+        streamData.resetRegion(regionInfo.streamerRegion.c_str());
+        setRefSegment(opt, dopt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
+    }
+    else
+    {
+        streamData.resetRegionListIndex(regionListIndex);
+        refCachePtr->setRefSegment(regionListIndex, ref);
+    }
 
     while (streamData.next())
     {
@@ -255,20 +272,21 @@ starling_run(
     using namespace illumina::common;
 
     // ensure that this object is created first for runtime benchmark
-    RunStatsManager statsManager(opt.segmentStatsFilename);
+    RunStatsManager statsManager(opt.segmentStatsFilename, opt.isHardwareCounters);
 
     opt.validate();
 
     const starling_deriv_options dopt(opt);
     starling_read_counts readCounts;
     reference_contig_segment ref;
+    ReferenceSegmentCache refCache(opt, dopt);
 
     const unsigned sampleCount(opt.getSampleCount());
 
     ////////////////////////////////////////
     // setup streamData:
     //
-    HtsMergeStreamer streamData(opt.referenceFilename);
+    HtsMergeStreamer streamData(opt.getAlignmentReferenceFilename());
 
     // additional data structures required in the region loop below, which are filled in as a side effect of
     // streamData initialization:
@@ -325,12 +343,14 @@ starling_run(
         }
     }
 
-    starling_streams fileStreams(opt, pinfo, bamHeaders, sampleNames);
-    starling_pos_processor posProcessor(opt, dopt, ref, fileStreams, statsManager);
-
     const bam_hdr_t& referenceHeader(bamHeaders.front());
     const bam_header_info referenceHeaderInfo(referenceHeader);
 
+    if (opt.isLocusProfile())
+    {
+        setLocusProfileStatsOptions(referenceHeaderInfo, opt.locusProfileMinSeconds, statsManager);
+    }
+
     // parse and sanity check regions
     unsigned supplementalRegionBorderSize(opt.maxIndelSize);
     if (opt.isHaplotypingEnabled)
@@ -341,27 +361,61 @@ starling_run(
     std::vector<AnalysisRegionInfo> regionInfoList;
     getStrelkaAnalysisRegions(opt, referenceAlignmentFilename, referenceHeaderInfo, supplementalRegionBorderSize, regionInfoList);
 
-    for (const auto& regionInfo : regionInfoList)
+    if (opt.isCaptureReplayBundle())
     {
-        if (not opt.isUseCallRegions())
-        {
-            callRegion(opt, regionInfo, fileStreams, sampleIndexToPloidyVcfSampleIndex, ploidyVcfSampleCount,
-                       readCounts, ref, streamData, posProcessor);
-        }
-        else
-        {
-            std::vector<known_pos_range2> subRegionRanges;
-            getSubRegionsFromBedTrack(opt.callRegionsBedFilename, regionInfo.regionChrom, regionInfo.regionRange, subRegionRanges);
+        captureReplayBundle(opt, dopt, regionInfoList.front());
+        return;
+    }
+
+    // all regions are called more than once only to profile replay bundles, the output of each iteration replaces
+    // the output of the previous iteration:
+    for (unsigned replayIteration(0); replayIteration < opt.replayIterations; ++replayIteration)
+    {
+        const auto iterationStartTime(std::chrono::steady_clock::now());
+
+        starling_streams fileStreams(opt, pinfo, bamHeaders, sampleNames);
+        starling_pos_processor posProcessor(opt, dopt, ref, fileStreams, statsManager);
 
-            for (const auto& subRegionRange : subRegionRanges)
+        for (const auto& regionInfo : regionInfoList)
+        {
+            if (not opt.isUseCallRegions())
             {
-                AnalysisRegionInfo subRegionInfo;
-                getStrelkaAnalysisRegionInfo(regionInfo.regionChrom, subRegionRange.begin_pos(), subRegionRange.end_pos(),
-                                             supplementalRegionBorderSize, subRegionInfo);
-                callRegion(opt, subRegionInfo, fileStreams, sampleIndexToPloidyVcfSampleIndex, ploidyVcfSampleCount,
+                callRegion(opt, dopt, regionInfo, fileStreams, sampleIndexToPloidyVcfSampleIndex, ploidyVcfSampleCount,
                            readCounts, ref, streamData, posProcessor);
             }
+            else
+            {
+                std::vector<AnalysisRegionInfo> subRegionInfoList;
+                getCallSubRegionInfo(opt.callRegionsBedFilename, regionInfo, supplementalRegionBorderSize, subRegionInfoList);
+                if (subRegionInfoList.empty()) continue;
+
+                if (not opt.isSinglePassCallRegions)
+                {
+                    for (const auto& subRegionInfo : subRegionInfoList)
+                    {
+                        callRegion(opt, dopt, subRegionInfo, fileStreams, sampleIndexToPloidyVcfSampleIndex, ploidyVcfSampleCount,
+                                   readCounts, ref, streamData, posProcessor);
+                    }
+                }
+                else
+                {
+                    resetCallSubRegionList(regionInfo.regionChrom, subRegionInfoList, streamData, refCache);
+                    const unsigned subRegionCount(subRegionInfoList.size());
+                    for (unsigned subRegionIndex(0); subRegionIndex < subRegionCount; ++subRegionIndex)
+                    {
+                        callRegion(opt, dopt, subRegionInfoList[subRegionIndex], fileStreams, sampleIndexToPloidyVcfSampleIndex,
+                                   ploidyVcfSampleCount, readCounts, ref, streamData, posProcessor, &refCache, subRegionIndex);
+                    }
+                }
+            }
+        }
+        posProcessor.reset();
+
+        if (opt.replayIterations > 1)
+        {
+            const std::chrono::duration<double> iterationTime(std::chrono::steady_clock::now() - iterationStartTime);
+            log_os << "INFO: Replay iteration " << (replayIteration+1) << " of " << opt.replayIterations
+                   << " completed in " << iterationTime.count() << " seconds\n";
         }
     }
-    posProcessor.reset();
 }
@@ -0,0 +1,117 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "GermlineLocusPool.hh"
+#include "starling_shared.hh"
+
+
+
+static
+starling_options
+getMockOptions()
+{
+    starling_options opt;
+    opt.alignFileOpt.alignmentFilenames.push_back("sample.bam");
+    return opt;
+}
+
+
+
+BOOST_AUTO_TEST_SUITE( GermlineLocusPool_test_suite )
+
+BOOST_AUTO_TEST_CASE( test_site_locus_recycle )
+{
+    const starling_options opt(getMockOptions());
+    const starling_deriv_options dopt(opt);
+    const unsigned sampleCount(2);
+
+    GermlineLocusPool locusPool(dopt.gvcf, sampleCount);
+
+    auto locusPtr(locusPool.getDiploidSiteLocus(10, BASE_ID::A, true));
+    locusPtr->addAltSiteAllele(BASE_ID::C);
+    locusPtr->getSample(1).gqx = 30;
+    locusPtr->hpol = 4;
+    const GermlineDiploidSiteLocusInfo* firstLocus(locusPtr.get());
+
+    locusPool.recycle(std::unique_ptr<GermlineSiteLocusInfo>(std::move(locusPtr)));
+
+    // the recycled locus should be handed out again in a newly-constructed state:
+    auto locusPtr2(locusPool.getDiploidSiteLocus(20, BASE_ID::G, false));
+    BOOST_REQUIRE_EQUAL(locusPtr2.get(), firstLocus);
+    BOOST_REQUIRE_EQUAL(locusPtr2->pos, 20);
+    BOOST_REQUIRE_EQUAL(locusPtr2->refBaseIndex, BASE_ID::G);
+    BOOST_REQUIRE(not locusPtr2->isForcedOutput);
+    BOOST_REQUIRE_EQUAL(locusPtr2->getAltAlleleCount(), 0u);
+    BOOST_REQUIRE(locusPtr2->getSiteAlleles().empty());
+    BOOST_REQUIRE_EQUAL(locusPtr2->getSample(1).gqx, 0);
+    BOOST_REQUIRE_EQUAL(locusPtr2->hpol, 0u);
+    BOOST_REQUIRE_EQUAL(locusPtr2->getSampleCount(), sampleCount);
+
+    BOOST_REQUIRE_EQUAL(locusPool.getRequestedLocusCount(), 2u);
+    BOOST_REQUIRE_EQUAL(locusPool.getRequestedSiteLocusCount(), 2u);
+    BOOST_REQUIRE_EQUAL(locusPool.getAllocatedLocusCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( test_indel_locus_recycle )
+{
+    const starling_options opt(getMockOptions());
+    const starling_deriv_options dopt(opt);
+    const unsigned sampleCount(1);
+
+    GermlineLocusPool locusPool(dopt.gvcf, sampleCount);
+
+    IndelKey indelKey(100, INDEL::INDEL, 2);
+    IndelData indelData(sampleCount, indelKey);
+
+    auto locusPtr(locusPool.getDiploidIndelLocus());
+    locusPtr->addAltIndelAllele(indelKey, indelData);
+    locusPtr->doNotGenotype();
+    locusPool.recycle(std::unique_ptr<GermlineIndelLocusInfo>(std::move(locusPtr)));
+
+    auto locusPtr2(locusPool.getDiploidIndelLocus());
+    BOOST_REQUIRE_EQUAL(locusPtr2->getAltAlleleCount(), 0u);
+    BOOST_REQUIRE(locusPtr2->getIndelAlleles().empty());
+    BOOST_REQUIRE(not locusPtr2->isNotGenotyped());
+    BOOST_REQUIRE_EQUAL(locusPtr2->getCommonPrefixLength(), 0u);
+    BOOST_REQUIRE_EQUAL(locusPool.getAllocatedLocusCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( test_locus_pool_size_limit )
+{
+    const starling_options opt(getMockOptions());
+    const starling_deriv_options dopt(opt);
+    const unsigned sampleCount(1);
+    const unsigned maxPoolSize(1);
+
+    GermlineLocusPool locusPool(dopt.gvcf, sampleCount, maxPoolSize);
+
+    auto locusPtr1(locusPool.getDiploidSiteLocus(1, BASE_ID::A, false));
+    auto locusPtr2(locusPool.getDiploidSiteLocus(2, BASE_ID::A, false));
+    locusPool.recycle(std::unique_ptr<GermlineSiteLocusInfo>(std::move(locusPtr1)));
+    locusPool.recycle(std::unique_ptr<GermlineSiteLocusInfo>(std::move(locusPtr2)));
+
+    // only one locus should have been retained:
+    locusPtr1 = locusPool.getDiploidSiteLocus(3, BASE_ID::A, false);
+    locusPtr2 = locusPool.getDiploidSiteLocus(4, BASE_ID::A, false);
+    BOOST_REQUIRE_EQUAL(locusPool.getAllocatedLocusCount(), 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+
+#include "boost/test/unit_test.hpp"
+
+#include "gvcf_block_site_record.hh"
+
+
+BOOST_AUTO_TEST_SUITE( gvcf_block_site_record_test_suite )
+
+BOOST_AUTO_TEST_CASE( test_block_value_stat )
+{
+    gvcf_block_value_stat stat;
+    BOOST_REQUIRE(stat.empty());
+
+    stat.add(10);
+    stat.add(4);
+    stat.add(13);
+    BOOST_REQUIRE_EQUAL(stat.size(), 3u);
+    BOOST_REQUIRE_EQUAL(stat.min(), 4);
+    BOOST_REQUIRE_EQUAL(stat.max(), 13);
+    BOOST_REQUIRE_CLOSE(stat.mean(), 9., 0.0001);
+
+    stat.reset();
+    BOOST_REQUIRE(stat.empty());
+}
+
+BOOST_AUTO_TEST_CASE( test_block_tolerance )
+{
+    const gvcf_block_tolerance tolerance(30,3);
+
+    // within absolute tolerance:
+    BOOST_REQUIRE(tolerance.isRangeBlockable(0,6));
+    BOOST_REQUIRE(! tolerance.isRangeBlockable(0,7));
+
+    // within fractional tolerance (min=100 -> tol=30):
+    BOOST_REQUIRE(tolerance.isRangeBlockable(100,260));
+    BOOST_REQUIRE(! tolerance.isRangeBlockable(100,261));
+
+    // fractional tolerance is computed in the integer domain, 29% of 100 must be exactly 29:
+    const gvcf_block_tolerance tolerance2(29,3);
+    BOOST_REQUIRE(tolerance2.isRangeBlockable(100,258));
+    BOOST_REQUIRE(! tolerance2.isRangeBlockable(100,259));
+
+    gvcf_block_value_stat stat;
+    stat.add(100);
+    BOOST_REQUIRE(tolerance.isNewValueBlockable(stat,260));
+    BOOST_REQUIRE(! tolerance.isNewValueBlockable(stat,261));
+}
+
+BOOST_AUTO_TEST_CASE( test_join_site_run )
+{
+    gvcf_options opt;
+    gvcf_block_site_record block(opt);
+
+    GermlineSiteLocusInfo locus(1, 10, 0, false);
+    GermlineSiteSampleInfo siteSampleInfo;
+    siteSampleInfo.usedBasecallCount = 30;
+    siteSampleInfo.unusedBasecallCount = 2;
+    locus.setSiteSampleInfo(0, siteSampleInfo);
+    locus.getSample(0).gqx = 40;
+    locus.getSample(0).setPloidy(2);
+    block.joinSiteToSampleBlock(locus, 0);
+    BOOST_REQUIRE_EQUAL(block.count, 1);
+
+    std::vector<gvcf_block_site_values> runValues(4);
+    for (auto& values : runValues)
+    {
+        values.usedBasecallCount = 32;
+        values.unusedBasecallCount = 1;
+        values.gqx = 45;
+        values.isGqx = locus.is_gqx(0);
+    }
+
+    // the third position breaks the coverage state of the block:
+    runValues[2].usedBasecallCount = 0;
+
+    BOOST_REQUIRE_EQUAL(block.joinSiteRunToSampleBlock(runValues), 2u);
+    BOOST_REQUIRE_EQUAL(block.count, 3);
+    BOOST_REQUIRE_EQUAL(block.block_dpu.min(), 30);
+    BOOST_REQUIRE_EQUAL(block.block_dpu.max(), 32);
+    BOOST_REQUIRE_EQUAL(block.block_dpf.max(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -51,6 +51,12 @@ public:
             _sink->flush();
     }
 
+    /// \return total loci buffered in this stage and all downstream stages
+    unsigned getBufferedLocusCount() const
+    {
+        return getBufferedLocusCount_impl() + (_sink ? _sink->getBufferedLocusCount() : 0u);
+    }
+
     explicit variant_pipe_stage_base(const std::shared_ptr<variant_pipe_stage_base>& sink) : _sink(sink) {}
 
     virtual ~variant_pipe_stage_base() {}
@@ -60,6 +66,11 @@ protected:
 
     virtual void flush_impl() {}
 
+    virtual unsigned getBufferedLocusCount_impl() const
+    {
+        return 0;
+    }
+
     template <class TDerived, class TBase>
     static std::unique_ptr<TDerived> downcast(std::unique_ptr<TBase> basePtr)
     {
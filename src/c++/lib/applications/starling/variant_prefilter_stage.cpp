@@ -50,19 +50,23 @@ void
 variant_prefilter_stage::
 process(std::unique_ptr<GermlineSiteLocusInfo> locusPtr)
 {
-    applySharedLocusFilters(*locusPtr);
+    {
+        const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::EVS_SCORING);
 
-    // apply depth filter
-    _model.applyDepthFilter(*locusPtr);
+        applySharedLocusFilters(*locusPtr);
 
-    // apply filtration/EVS model:
-    if (dynamic_cast<GermlineContinuousSiteLocusInfo*>(locusPtr.get()) != nullptr)
-    {
-        _model.default_classify_site_locus(*locusPtr);
-    }
-    else
-    {
-        _model.classify_site(dynamic_cast<GermlineDiploidSiteLocusInfo&>(*locusPtr));
+        // apply depth filter
+        _model.applyDepthFilter(*locusPtr);
+
+        // apply filtration/EVS model:
+        if (dynamic_cast<GermlineContinuousSiteLocusInfo*>(locusPtr.get()) != nullptr)
+        {
+            _model.default_classify_site_locus(*locusPtr);
+        }
+        else
+        {
+            _model.classify_site(dynamic_cast<GermlineDiploidSiteLocusInfo&>(*locusPtr));
+        }
     }
 
     _sink->process(std::move(locusPtr));
@@ -91,6 +95,8 @@ process(std::unique_ptr<GermlineIndelLocusInfo> locusPtr)
     }
     else
     {
+        const StageTimeScoper stageScoper(_stageTimer, TIMED_STAGE::EVS_SCORING);
+
         applySharedLocusFilters(*locusPtr);
 
         // apply depth filter
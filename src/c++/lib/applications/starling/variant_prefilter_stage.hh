@@ -24,6 +24,8 @@
 
 #include "variant_pipe_stage_base.hh"
 
+#include "appstats/StageTimer.hh"
+
 struct RegionTracker;
 struct ScoringModelManager;
 
@@ -31,9 +33,11 @@ struct variant_prefilter_stage : public variant_pipe_stage_base
 {
     variant_prefilter_stage(
         const ScoringModelManager& model,
-        const std::shared_ptr<variant_pipe_stage_base>& destination)
+        const std::shared_ptr<variant_pipe_stage_base>& destination,
+        StageTimer& stageTimer)
         : variant_pipe_stage_base(destination)
         , _model(model)
+        , _stageTimer(stageTimer)
     {}
 
 
@@ -46,4 +50,7 @@ private:
         LocusInfo& locus) const;
 
     const ScoringModelManager& _model;
+
+    /// filtration and EVS scoring time is tracked separately from the remainder of the pipeline
+    StageTimer& _stageTimer;
 };
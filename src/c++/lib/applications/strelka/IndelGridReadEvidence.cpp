@@ -0,0 +1,219 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Contiguous per-read indel evidence and the somatic indel grid likelihood kernel
+///
+
+#include "IndelGridReadEvidence.hh"
+
+#include "blt_util/logSumUtil.hh"
+#include "starling_common/readMappingAdjustmentUtil.hh"
+#include "starling_common/starling_indel_call_pprob_digt.hh"
+
+#include <cassert>
+#include <cmath>
+
+
+
+/// Tabulate the log probability of observing the reference and indel alleles at the canonical het ratio and each
+/// grid frequency for reads of length read_length
+///
+/// The order of operations follows get_indel_digt_lhood() and get_high_low_het_ratio_lhood() exactly, so that
+/// likelihoods computed from these tables are identical to those computed per read.
+static
+void
+setRatioTable(
+    const starling_sample_options& sample_opt,
+    const IndelKey& indelKey,
+    const uint16_t read_length,
+    IndelGridReadEvidence::ratio_lnp_t& logRefProb,
+    IndelGridReadEvidence::ratio_lnp_t& logIndelProb)
+{
+    static const double loghalf(-std::log(2.));
+    static const unsigned lsize(DIGT_GRID::HET_RES*2);
+
+    const bool is_breakpoint(indelKey.is_breakpoint());
+
+    logRefProb[0] = loghalf;
+    logIndelProb[0] = loghalf;
+    if (! is_breakpoint)
+    {
+        static const double het_allele_ratio(0.5);
+        get_het_observed_allele_ratio(read_length,sample_opt.min_read_bp_flank,
+                                      indelKey,het_allele_ratio,logRefProb[0],logIndelProb[0]);
+    }
+
+    for (unsigned i(0); i<DIGT_GRID::HET_RES; ++i)
+    {
+        const double het_ratio((i+1)*DIGT_GRID::RATIO_INCREMENT);
+        const double chet_ratio(1.-het_ratio);
+
+        const double log_het_ratio(std::log(het_ratio));
+        const double log_chet_ratio(std::log(chet_ratio));
+
+        const unsigned lowIndex(1+i);
+        logRefProb[lowIndex] = log_chet_ratio;
+        logIndelProb[lowIndex] = log_het_ratio;
+
+        const unsigned highIndex(1+lsize-(i+1));
+        logRefProb[highIndex] = log_het_ratio;
+        logIndelProb[highIndex] = log_chet_ratio;
+
+        if (! is_breakpoint)
+        {
+            get_het_observed_allele_ratio(read_length,sample_opt.min_read_bp_flank,
+                                          indelKey,het_ratio,logRefProb[lowIndex],logIndelProb[lowIndex]);
+            get_het_observed_allele_ratio(read_length,sample_opt.min_read_bp_flank,
+                                          indelKey,chet_ratio,logRefProb[highIndex],logIndelProb[highIndex]);
+        }
+    }
+}
+
+
+
+void
+IndelGridReadEvidence::
+clear()
+{
+    noindelLnp.clear();
+    indelLnp.clear();
+    nonAmbiguousBasesInRead.clear();
+    isTier1Read.clear();
+    ratioTableIndex.clear();
+    logRefProb.clear();
+    logIndelProb.clear();
+    _ratioTableReadLength.clear();
+}
+
+
+
+void
+IndelGridReadEvidence::
+setEvidence(
+    const starling_sample_options& sample_opt,
+    const IndelKey& indelKey,
+    const IndelSampleData& indelSampleData,
+    const bool is_use_alt_indel)
+{
+    clear();
+
+    const unsigned readCount(indelSampleData.read_path_lnp.size());
+    noindelLnp.reserve(readCount);
+    indelLnp.reserve(readCount);
+    nonAmbiguousBasesInRead.reserve(readCount);
+    isTier1Read.reserve(readCount);
+    ratioTableIndex.reserve(readCount);
+
+    // breakpoint ratios do not depend on read length, so all reads share a single table:
+    const bool is_breakpoint(indelKey.is_breakpoint());
+
+    for (const auto& score : indelSampleData.read_path_lnp)
+    {
+        const ReadPathScores& path_lnp(score.second);
+
+        double alt_path_lnp(path_lnp.ref);
+        if (is_use_alt_indel)
+        {
+            for (const auto& alt : path_lnp.alt_indel)
+            {
+                if (alt.second>alt_path_lnp) alt_path_lnp=alt.second;
+            }
+        }
+
+        noindelLnp.push_back(alt_path_lnp);
+        indelLnp.push_back(path_lnp.indel);
+        nonAmbiguousBasesInRead.push_back(path_lnp.nonAmbiguousBasesInRead);
+        isTier1Read.push_back(path_lnp.is_tier1_read);
+
+        // reads typically share a small number of distinct lengths, so a linear search is sufficient:
+        const uint16_t tableReadLength(is_breakpoint ? 0 : path_lnp.read_length);
+        const unsigned tableCount(_ratioTableReadLength.size());
+        unsigned tableIndex(0);
+        for (; tableIndex<tableCount; ++tableIndex)
+        {
+            if (_ratioTableReadLength[tableIndex] == tableReadLength) break;
+        }
+        if (tableIndex == tableCount)
+        {
+            _ratioTableReadLength.push_back(tableReadLength);
+            logRefProb.emplace_back();
+            logIndelProb.emplace_back();
+            setRatioTable(sample_opt, indelKey, path_lnp.read_length, logRefProb.back(), logIndelProb.back());
+        }
+        ratioTableIndex.push_back(tableIndex);
+    }
+}
+
+
+
+void
+getIndelGridLhood(
+    const starling_base_deriv_options& dopt,
+    const IndelGridReadEvidence& evidence,
+    const bool is_include_tier2,
+    double* const lhood)
+{
+    static_assert(static_cast<int>(STAR_DIINDEL::SIZE) == static_cast<int>(SOMATIC_DIGT::SIZE),
+                  "Unexpected somatic indel state layout");
+    static_assert(static_cast<int>(SOMATIC_DIGT::SIZE+DIGT_GRID::HET_RES*2) == static_cast<int>(DIGT_GRID::PRESTRAND_SIZE),
+                  "Unexpected somatic indel state layout");
+
+    double noindelLhood(0);
+    double homLhood(0);
+
+    // accumulate in a local fixed-size array so that the inner loop over frequencies has no aliasing or
+    // loop-carried dependencies:
+    IndelGridReadEvidence::ratio_lnp_t ratioLhood;
+    ratioLhood.fill(0.);
+
+    const double correctMappingLogPrior(dopt.correctMappingLogPrior);
+
+    const unsigned readCount(evidence.size());
+    for (unsigned readIndex(0); readIndex<readCount; ++readIndex)
+    {
+        // optionally skip tier2 data:
+        if ((! is_include_tier2) && (! evidence.isTier1Read[readIndex])) continue;
+
+        const double noindel_lnp(evidence.noindelLnp[readIndex]);
+        const double hom_lnp(evidence.indelLnp[readIndex]);
+        const uint16_t nonAmbiguousBasesInRead(evidence.nonAmbiguousBasesInRead[readIndex]);
+
+        noindelLhood += integrateOutMappingStatus(dopt, nonAmbiguousBasesInRead, noindel_lnp, is_include_tier2);
+        homLhood += integrateOutMappingStatus(dopt, nonAmbiguousBasesInRead, hom_lnp, is_include_tier2);
+
+        const double incorrectMappingLnp(getIncorrectMappingLogLikelihood(dopt, is_include_tier2, nonAmbiguousBasesInRead));
+        const unsigned tableIndex(evidence.ratioTableIndex[readIndex]);
+        const IndelGridReadEvidence::ratio_lnp_t& logRefProb(evidence.logRefProb[tableIndex]);
+        const IndelGridReadEvidence::ratio_lnp_t& logIndelProb(evidence.logIndelProb[tableIndex]);
+
+        for (unsigned ratioIndex(0); ratioIndex<IndelGridReadEvidence::RATIO_COUNT; ++ratioIndex)
+        {
+            const double het_lnp(getLogSum(noindel_lnp+logRefProb[ratioIndex], hom_lnp+logIndelProb[ratioIndex]));
+            ratioLhood[ratioIndex] += getLogSum(het_lnp+correctMappingLogPrior, incorrectMappingLnp);
+        }
+    }
+
+    lhood[STAR_DIINDEL::NOINDEL] = noindelLhood;
+    lhood[STAR_DIINDEL::HOM] = homLhood;
+    lhood[STAR_DIINDEL::HET] = ratioLhood[0];
+    for (unsigned gridIndex(0); gridIndex<(DIGT_GRID::HET_RES*2); ++gridIndex)
+    {
+        lhood[SOMATIC_DIGT::SIZE+gridIndex] = ratioLhood[1+gridIndex];
+    }
+}
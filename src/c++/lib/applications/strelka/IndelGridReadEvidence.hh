@@ -0,0 +1,94 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Contiguous per-read indel evidence and the somatic indel grid likelihood kernel
+///
+
+#pragma once
+
+#include "strelka_digt_states.hh"
+
+#include "starling_common/IndelData.hh"
+#include "starling_common/starling_base_shared.hh"
+
+#include <array>
+#include <vector>
+
+
+/// \brief Per-read indel path scores for one sample, extracted from IndelSampleData into contiguous arrays
+///
+/// The evidence is extracted once per indel and sample and is shared by the tier1 and tier2 likelihood
+/// evaluations. The observed allele ratio terms for each grid frequency only depend on read length for
+/// a given indel, so these are tabulated once per distinct read length rather than once per read.
+///
+struct IndelGridReadEvidence
+{
+    /// number of frequencies evaluated for each read: the canonical het ratio followed by the high/low grid
+    enum { RATIO_COUNT = 1+DIGT_GRID::HET_RES*2 };
+
+    typedef std::array<double,RATIO_COUNT> ratio_lnp_t;
+
+    /// \brief Replace all evidence with the read path scores of indelSampleData
+    void
+    setEvidence(
+        const starling_sample_options& sample_opt,
+        const IndelKey& indelKey,
+        const IndelSampleData& indelSampleData,
+        const bool is_use_alt_indel);
+
+    unsigned
+    size() const
+    {
+        return noindelLnp.size();
+    }
+
+    void
+    clear();
+
+    /// read likelihood without the indel: the max of the reference and any alternate indel path
+    std::vector<double> noindelLnp;
+    /// read likelihood with the indel
+    std::vector<double> indelLnp;
+    std::vector<uint16_t> nonAmbiguousBasesInRead;
+    std::vector<uint8_t> isTier1Read;
+    /// index of each read into the ratio tables below
+    std::vector<unsigned> ratioTableIndex;
+
+    /// log probability of observing the reference/indel allele at each frequency, per ratio table
+    std::vector<ratio_lnp_t> logRefProb;
+    std::vector<ratio_lnp_t> logIndelProb;
+
+private:
+    std::vector<uint16_t> _ratioTableReadLength;
+};
+
+
+/// \brief Fill all diploid and grid likelihoods for one sample and tier in a single pass over the reads
+///
+/// Results are identical to get_indel_digt_lhood() followed by get_high_low_het_ratio_lhood() for each grid
+/// frequency, written to the same lhood layout as the somatic indel caller (STAR_DIINDEL states followed by
+/// the DIGT_GRID low and high frequencies).
+///
+/// \param[out] lhood array of size DIGT_GRID::PRESTRAND_SIZE
+void
+getIndelGridLhood(
+    const starling_base_deriv_options& dopt,
+    const IndelGridReadEvidence& evidence,
+    const bool is_include_tier2,
+    double* const lhood);
@@ -23,9 +23,12 @@
 
 #pragma once
 
-#include "SiteNoise.hh"
 #include "blt_util/blt_types.hh"
 #include "blt_util/RangeMap.hh"
+#include "strelka_common/NoiseTrack.hh"
+#include "strelka_common/SiteNoise.hh"
+
+#include <algorithm>
 
 
 struct NoiseBuffer
@@ -38,13 +41,34 @@ struct NoiseBuffer
         _ndata.getRef(pos) = sn;
     }
 
+    /// \brief Load all sites from a binary noise track in \p range of \p chrom
+    ///
+    /// The track sites are held until the next call to clear(). Sites inserted individually take precedence
+    /// over track sites at the same position.
+    void
+    loadTrackRegion(
+        NoiseTrackReader& noiseTrack,
+        const std::string& chrom,
+        const known_pos_range2& range)
+    {
+        noiseTrack.getRegionSites(chrom, range, _trackSites);
+    }
+
     /// \returns nullptr for empty pos
     ///
     const SiteNoise*
     getPos(const pos_t pos) const
     {
-        if (! _ndata.isKeyPresent(pos)) return nullptr;
-        return &_ndata.getConstRef(pos);
+        if (_ndata.isKeyPresent(pos)) return &_ndata.getConstRef(pos);
+        if (_trackSites.empty()) return nullptr;
+
+        const auto siteIter(std::lower_bound(_trackSites.begin(), _trackSites.end(), pos,
+                                             [](const NoiseTrackSites::value_type& site, const pos_t val)
+        {
+            return (site.first < val);
+        }));
+        if ((siteIter == _trackSites.end()) || (siteIter->first != pos)) return nullptr;
+        return &(siteIter->second);
     }
 
     void
@@ -57,12 +81,13 @@ struct NoiseBuffer
     clear()
     {
         _ndata.clear();
+        _trackSites.clear();
     }
 
     bool
     empty() const
     {
-        return _ndata.empty();
+        return (_ndata.empty() && _trackSites.empty());
     }
 
 //    void
@@ -72,5 +97,8 @@ private:
     typedef RangeMap<pos_t,SiteNoise,ClearT<SiteNoise>> ndata_t;
 
     ndata_t _ndata;
+
+    /// sites loaded from a noise track for the current region, sorted by position
+    NoiseTrackSites _trackSites;
 };
 
@@ -26,6 +26,7 @@
 #include "somatic_result_set.hh"
 #include "strelka_shared.hh"
 
+#include "appstats/BufferUsage.hh"
 #include "starling_common/AlleleReportInfo.hh"
 #include "../../starling_common/LocalRegionStats.hh"
 
@@ -77,6 +78,20 @@ struct SomaticIndelVcfWriter
         _data.clear();
     }
 
+    /// \return cached indel position count, cached indel count and estimated bytes
+    BufferUsage
+    getBufferUsage() const
+    {
+        BufferUsage usage;
+        for (const auto& val : _data)
+        {
+            usage.items++;
+            usage.entries += val.second.size();
+            usage.bytes += sizeof(val) + (val.second.capacity() * sizeof(SomaticIndelVcfInfo));
+        }
+        return usage;
+    }
+
     /// store an indel call
     void
     cacheIndel(
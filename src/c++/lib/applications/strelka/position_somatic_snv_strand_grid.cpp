@@ -54,6 +54,29 @@ somatic_snv_caller_strand_grid(const strelka_options& opt)
     _ln_sse_rate = std::log(nostrand_sse_rate);
 }
 
+void
+NormalSnvLhood::
+computeTier(
+    const unsigned tierIndex,
+    const snp_pos_info& pi,
+    const unsigned ref_gt)
+{
+    assert(tierIndex < TIER_COUNT);
+    if (isSet[tierIndex]) return;
+
+    blt_float_t* tierLhood(lhood[tierIndex].data());
+
+    // get likelihood of each genotype (REF, HOM, HET)
+    get_diploid_gt_lhood_cached_simple(pi, ref_gt, tierLhood);
+
+    // get likelihood of non-canonical frequencies (0.05, 0.1, ..., 0.45, 0.55, ..., 0.95)
+    get_diploid_het_grid_lhood_cached(pi, ref_gt, DIGT_GRID::HET_RES, tierLhood+SOMATIC_DIGT::SIZE);
+
+    isSet[tierIndex] = true;
+}
+
+
+
 // Fill in the noise portions of the likelihood function for the
 // regions where we expect strand bias noise (a minor allele frequency
 // < 0.5 + reference allele):
@@ -233,6 +256,7 @@ position_somatic_snv_call(
     const extended_pos_info* normal_epi_t2_ptr,
     const extended_pos_info* tumor_epi_t2_ptr,
     const bool isComputeNonSomatic,
+    NormalSnvLhood& normalLhood,
     somatic_snv_genotype_grid& sgt) const
 {
     {
@@ -255,8 +279,7 @@ position_somatic_snv_call(
     }
 
     // strawman model treats normal and tumor as independent, so
-    // calculate separate lhoods:
-    blt_float_t normal_lhood[DIGT_GRID::SIZE];
+    // calculate separate lhoods. Only the pre-strand states are used for the normal sample:
     blt_float_t tumor_lhood[DIGT_GRID::SIZE];
 
     const bool is_tier2(nullptr != normal_epi_t2_ptr);
@@ -280,11 +303,12 @@ position_somatic_snv_call(
         const extended_pos_info& nepi(is_include_tier2 ? *normal_epi_t2_ptr : normal_epi );
         const extended_pos_info& tepi(is_include_tier2 ? *tumor_epi_t2_ptr : tumor_epi );
 
-        get_diploid_gt_lhood_cached_simple(nepi.pi, sgt.ref_gt, normal_lhood);
+        normalLhood.computeTier(i, nepi.pi, sgt.ref_gt);
+        const blt_float_t* normal_lhood(normalLhood.lhood[i].data());
+
         get_diploid_gt_lhood_cached_simple(tepi.pi, sgt.ref_gt, tumor_lhood);
 
         // get likelihood of non-canonical frequencies (0.05, 0.1, ..., 0.45, 0.55, ..., 0.95)
-        get_diploid_het_grid_lhood_cached(nepi.pi, sgt.ref_gt, DIGT_GRID::HET_RES, normal_lhood+SOMATIC_DIGT::SIZE);
         get_diploid_het_grid_lhood_cached(tepi.pi, sgt.ref_gt, DIGT_GRID::HET_RES, tumor_lhood+SOMATIC_DIGT::SIZE);
 
         // get likelihood of strand states (0.05, ..., 0.45)
@@ -34,6 +34,43 @@
 
 #include "blt_common/position_snp_call_pprob_digt.hh"
 
+#include <cassert>
+
+#include <algorithm>
+#include <array>
+
+
+/// \brief Normal sample snv genotype likelihoods at one position for each data tier
+///
+/// The normal sample likelihoods only depend on the normal sample pileup, so they are computed on demand, once per
+/// position, and shared by each tumor sample called against the normal.
+///
+struct NormalSnvLhood
+{
+    enum constants { TIER_COUNT = 2 };
+
+    NormalSnvLhood()
+    {
+        clear();
+    }
+
+    void
+    clear()
+    {
+        std::fill(isSet.begin(), isSet.end(), false);
+    }
+
+    /// compute the likelihoods for \p tierIndex from the normal sample pileup \p pi, if not already set
+    void
+    computeTier(
+        const unsigned tierIndex,
+        const snp_pos_info& pi,
+        const unsigned ref_gt);
+
+    std::array<bool, TIER_COUNT> isSet;
+    std::array<std::array<blt_float_t, DIGT_GRID::PRESTRAND_SIZE>, TIER_COUNT> lhood;
+};
+
 
 /// Object used to pre-compute somatic snv priors
 struct somatic_snv_caller_strand_grid
@@ -41,7 +78,8 @@ struct somatic_snv_caller_strand_grid
     explicit somatic_snv_caller_strand_grid(
         const strelka_options& opt);
 
-    //
+    /// \param[in,out] normalLhood normal sample likelihoods for this position, any tiers not already set are computed
+    ///                            here as required
     void
     position_somatic_snv_call(
         const extended_pos_info& normal_epi,
@@ -49,6 +87,7 @@ struct somatic_snv_caller_strand_grid
         const extended_pos_info* normal_epi_t2_ptr,
         const extended_pos_info* tumor_epi_t2_ptr,
         const bool isComputeNonSomatic,
+        NormalSnvLhood& normalLhood,
         somatic_snv_genotype_grid& sgt) const;
 
 private:
@@ -21,6 +21,7 @@
 /// \author Chris Saunders
 ///
 
+#include "IndelGridReadEvidence.hh"
 #include "somatic_call_shared.hh"
 #include "somatic_indel_grid.hh"
 #include "qscore_calculator.hh"
@@ -63,34 +64,6 @@ somatic_indel_caller_grid(const strelka_options& opt)
     calculateGermlineGenotypeLogPrior(opt.bindel_diploid_theta, _germlineGenotypeLogPrior);
 }
 
-static
-void
-get_indel_het_grid_lhood(const starling_base_options& opt,
-                         const starling_base_deriv_options& dopt,
-                         const starling_sample_options& sample_opt,
-                         const IndelKey& indelKey,
-                         const IndelSampleData& indelSampleData,
-                         const bool is_include_tier2,
-                         const bool is_use_alt_indel,
-                         double* const lhood)
-{
-    static const unsigned lsize(DIGT_GRID::HET_RES*2);
-    for (unsigned gt(0); gt<(lsize); ++gt) lhood[gt] = 0.;
-
-    for (unsigned i(0); i<DIGT_GRID::HET_RES; ++i)
-    {
-        const double het_ratio((i+1)*DIGT_GRID::RATIO_INCREMENT);
-        get_high_low_het_ratio_lhood(opt,dopt,
-                                     sample_opt,
-                                     indelKey,indelSampleData,het_ratio,
-                                     is_include_tier2,is_use_alt_indel,
-                                     lhood[lsize-(i+1)],
-                                     lhood[i]);
-    }
-}
-
-
-
 /// Test if the current target indel should be filtered because of other indels overlapping it.
 ///
 /// This function will return true if the indel is not one of the top two indels by read support at the locus,
@@ -201,6 +174,11 @@ get_somatic_indel(
     const IndelSampleData& normalIndelSampleData(indelData.getSampleData(normalSampleIndex));
     const IndelSampleData& tumorIndelSampleData(indelData.getSampleData(tumorSampleIndex));
 
+    // per-read evidence is extracted from each sample once, on first use, and shared by both tiers:
+    IndelGridReadEvidence normalEvidence;
+    IndelGridReadEvidence tumorEvidence;
+    bool isEvidenceSet(false);
+
     static const unsigned n_tier(2);
     std::array<indel_result_set,n_tier> tier_rs;
     for (unsigned i(0); i<n_tier; ++i)
@@ -240,23 +218,15 @@ get_somatic_indel(
             }
         }
 
-        get_indel_digt_lhood(opt,dopt,normal_opt,
-                             indelKey,normalIndelSampleData,
-                             is_include_tier2,is_use_alt_indel,
-                             normal_lhood);
-        get_indel_digt_lhood(opt,dopt,tumor_opt,
-                             indelKey,tumorIndelSampleData,
-                             is_include_tier2,is_use_alt_indel,
-                             tumor_lhood);
-
-        get_indel_het_grid_lhood(opt,dopt,normal_opt,
-                                 indelKey,normalIndelSampleData,
-                                 is_include_tier2,is_use_alt_indel,
-                                 normal_lhood+SOMATIC_DIGT::SIZE);
-        get_indel_het_grid_lhood(opt,dopt,tumor_opt,
-                                 indelKey,tumorIndelSampleData,
-                                 is_include_tier2,is_use_alt_indel,
-                                 tumor_lhood+SOMATIC_DIGT::SIZE);
+        if (not isEvidenceSet)
+        {
+            normalEvidence.setEvidence(normal_opt, indelKey, normalIndelSampleData, is_use_alt_indel);
+            tumorEvidence.setEvidence(tumor_opt, indelKey, tumorIndelSampleData, is_use_alt_indel);
+            isEvidenceSet = true;
+        }
+
+        getIndelGridLhood(dopt, normalEvidence, is_include_tier2, normal_lhood);
+        getIndelGridLhood(dopt, tumorEvidence, is_include_tier2, tumor_lhood);
 
         // TODO: this is a temporary solution
         blt_float_t normal_lhood_float[DIGT_GRID::PRESTRAND_SIZE];
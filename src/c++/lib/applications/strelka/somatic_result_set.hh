@@ -25,7 +25,7 @@
 #pragma once
 
 #include "boost/utility.hpp"
-#include "SiteNoise.hh"
+#include "strelka_common/SiteNoise.hh"
 
 #include <iosfwd>
 
@@ -22,6 +22,8 @@
 #include "strelka_run.hh"
 #include "strelka.hh"
 
+#include "starling_common/ReplayBundle.hh"
+
 
 
 namespace
@@ -33,10 +35,15 @@ const prog_info& pinfo(strelka_info::get());
 
 void
 strelka::
-runInternal(int argc,char* argv[]) const
+runInternal(int inputArgc,char* inputArgv[]) const
 {
     strelka_options opt;
 
+    // substitute replay bundle options into the command line before it is recorded and parsed:
+    ReplayBundleCommandLine replayCommandLine(opt.isSomaticCallingMode, inputArgc, inputArgv);
+    const int argc(replayCommandLine.argc());
+    char** argv(replayCommandLine.argv());
+
     for (int i(0); i<argc; ++i)
     {
         if (i) opt.cmdline += ' ';
@@ -49,6 +56,7 @@ runInternal(int argc,char* argv[]) const
         po::options_description visible(get_strelka_option_parser(opt));
         po::parsed_options parsed(po::command_line_parser(argc,argv).options(visible).run());
         po::store(parsed,vm);
+        opt.commandLineOptions = getCommandLineOptions(parsed);
         po::notify(vm);
     }
     catch (const boost::program_options::error& e)
@@ -37,13 +37,13 @@ get_strelka_option_parser(
     strelka_parse_opt_sv.add_options()
     ("somatic-snv-file",
      po::value(&opt.somatic_snv_filename),
-     "Output file for somatic snv-calls (note this uses settings from the bsnp diploid caller for the normal sample)")
+     "Output file for somatic snv-calls (note this uses settings from the bsnp diploid caller for the normal sample). With multiple tumor samples one file is written per tumor, with the tumor number inserted ahead of the file extension")
     ("somatic-snv-rate",
      po::value(&opt.somatic_snv_rate)->default_value(opt.somatic_snv_rate),
      "Expected rate of somatic snvs (allowed range: [0-1])")
     ("somatic-indel-file",
      po::value(&opt.somatic_indel_filename),
-     "Output file for somatic indel (note this uses settings from the bindel diploid caller for the normal sample)")
+     "Output file for somatic indel (note this uses settings from the bindel diploid caller for the normal sample). With multiple tumor samples one file is written per tumor, as for the snv output")
     ("somatic-indel-rate",
      po::value(&opt.somatic_indel_rate)->default_value(opt.somatic_indel_rate),
      "Expected rate of somatic indels (allowed range: [0-1])")
@@ -63,9 +63,11 @@ get_strelka_option_parser(
      po::value(&opt.indel_contam_tolerance)->default_value(opt.indel_contam_tolerance),
      "Tolerance of tumor contamination in the normal sample for indels (allowed range: [0-1]).")
     ("somatic-callable-regions-file", po::value(&opt.somatic_callable_filename),
-     "Output a bed file of regions which are confidently somatic or non-somatic for SNVs at allele frequencies of 10% or greater.")
+     "Output a bed file of regions which are confidently somatic or non-somatic for SNVs at allele frequencies of 10% or greater. With multiple tumor samples one file is written per tumor, as for the snv output")
     ("noise-vcf", po::value(&opt.noise_vcf)->multitoken(),
      "Noise panel VCF for low-frequency noise")
+    ("noise-track-file", po::value(&opt.noiseTrackFilename),
+     "Binary noise track for low-frequency noise, converted from a noise panel VCF with strelkaNoiseExtractor. This can be used in place of the noise panel VCF.")
     ;
 
     po::options_description strelka_parse_opt_filter("Somatic variant-calling filters");
@@ -152,9 +154,9 @@ finalize_strelka_options(
         {
             pinfo.usage("Must specify no more than one normal sample alignment file.");
         }
-        if (tumorCount != 1)
+        if (tumorCount < 1)
         {
-            pinfo.usage("Must specify exactly one tumor sample alignment file.");
+            pinfo.usage("Must specify at least one tumor sample alignment file.");
         }
     }
 
@@ -170,6 +172,12 @@ finalize_strelka_options(
         pinfo.usage("Strelka depth factor must not be less than 0");
     }
 
+    if ((not opt.noise_vcf.empty()) && (not opt.noiseTrackFilename.empty()))
+    {
+        pinfo.usage("Noise panel VCF and noise track file cannot both be specified");
+    }
+    checkOptionalInputFile(pinfo, opt.noiseTrackFilename, "noise track");
+
     checkOptionalInputFile(pinfo, opt.somatic_snv_scoring_model_filename, "somatic snv scoring model");
     checkOptionalInputFile(pinfo, opt.somatic_indel_scoring_model_filename, "somatic indel scoring model");
 
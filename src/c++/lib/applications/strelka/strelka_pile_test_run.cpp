@@ -86,11 +86,13 @@ call(
 
     //    somatic_snv_genotype sgt;
     somatic_snv_genotype_grid sgtg;
+    NormalSnvLhood normalLhood;
     _dopt_ptr->sscaller_strand_grid().position_somatic_snv_call(norm_cpi.getExtendedPosInfo(),
                                                                 tumor_cpi.getExtendedPosInfo(),
                                                                 nullptr,
                                                                 nullptr,
                                                                 is_somatic_gvcf,
+                                                                normalLhood,
                                                                 sgtg);
 
     if (! (sgtg.is_output() || is_somatic_gvcf)) return;
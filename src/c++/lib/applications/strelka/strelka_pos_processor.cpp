@@ -40,19 +40,18 @@ strelka_pos_processor(
     const reference_contig_segment& ref,
     const strelka_streams& fileStreams,
     RunStatsManager& statsManager)
-    : base_t(opt, dopt, ref, fileStreams, STRELKA_SAMPLE_TYPE::SIZE, statsManager)
+    : base_t(opt, dopt, ref, fileStreams, fileStreams.getSampleCount(), statsManager)
     , _opt(opt)
     , _dopt(dopt)
     , _streams(fileStreams)
-    , _scallProcessor(fileStreams.somatic_callable_osptr())
-    , _indelWriter(opt, dopt, fileStreams.somatic_indel_osptr())
-    , _indelRegionIndexNormal(0)
-    , _indelRegionIndexTumor(0)
+    , _tier2_cpi(getSampleCount())
 {
     using namespace STRELKA_SAMPLE_TYPE;
 
+    assert(getSampleCount() > TUMOR);
+    const unsigned tumorSampleCount(getTumorSampleCount());
+
     sample_info& normal_sif(sample(NORMAL));
-    sample_info& tumor_sif(sample(TUMOR));
 
     // set sample-specific parameter overrides:
     normal_sif.sampleOptions.min_read_bp_flank = opt.normal_sample_min_read_bp_flank;
@@ -65,16 +64,30 @@ strelka_pos_processor(
 
         assert(sample_id == NORMAL);
 
-        sample_id = getIndelBuffer().registerSample(tumor_sif.estdepth_buff, tumor_sif.estdepth_buff_tier2, false);
+        for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
+        {
+            sample_info& tumor_sif(sample(getTumorSampleIndex(tumorSampleIndex)));
+            sample_id = getIndelBuffer().registerSample(tumor_sif.estdepth_buff, tumor_sif.estdepth_buff_tier2, false);
 
-        assert(sample_id == TUMOR);
+            assert(sample_id == static_cast<sample_id_t>(getTumorSampleIndex(tumorSampleIndex)));
+        }
 
         getIndelBuffer().finalizeSamples();
     }
 
     // setup indel avg window:
-    _indelRegionIndexNormal= normal_sif.localRegionStatsCollection.addNewLocalRegionStatsSize(opt.sfilter.indelRegionFlankSize * 2);
-    _indelRegionIndexTumor= tumor_sif.localRegionStatsCollection.addNewLocalRegionStatsSize(opt.sfilter.indelRegionFlankSize * 2);
+    for (unsigned sampleIndex(0); sampleIndex < getSampleCount(); ++sampleIndex)
+    {
+        _indelRegionIndex.push_back(
+            sample(sampleIndex).localRegionStatsCollection.addNewLocalRegionStatsSize(opt.sfilter.indelRegionFlankSize * 2));
+    }
+
+    // setup per-tumor output:
+    for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
+    {
+        _scallProcessor.emplace_back(new SomaticCallableProcessor(fileStreams.somatic_callable_osptr(tumorSampleIndex)));
+        _indelWriter.emplace_back(new SomaticIndelVcfWriter(opt, dopt, fileStreams.somatic_indel_osptr(tumorSampleIndex)));
+    }
 }
 
 
@@ -85,7 +98,10 @@ reset()
 {
     base_t::reset();
 
-    _indelWriter.clear();
+    for (auto& indelWriter : _indelWriter)
+    {
+        indelWriter->clear();
+    }
     _noisePos.clear();
 }
 
@@ -170,92 +186,112 @@ process_pos_snp_somatic(const pos_t pos)
     const pos_t output_pos(pos+1);
 
     sample_info& normal_sif(sample(NORMAL));
-    sample_info& tumor_sif(sample(TUMOR));
 
     // TODO this is ridiculous -- if the tier2 data scheme works then come back and clean this up:
     static const unsigned n_tier(2);
     CleanedPileup* normal_cpi_ptr[n_tier] = { &(normal_sif.cleanedPileup), &(_tier2_cpi[NORMAL]) };
-    CleanedPileup* tumor_cpi_ptr[n_tier] = { &(tumor_sif.cleanedPileup), &(_tier2_cpi[TUMOR]) };
 
+    // the normal sample pileup is cleaned once and shared by all tumor samples:
     for (unsigned t(0); t<n_tier; ++t)
     {
         const bool is_include_tier2(t!=0);
         if (is_include_tier2 && (! _opt.useTier2Evidence)) continue;
         _pileupCleaner.CleanPileup(normal_sif.basecallBuffer.get_pos(pos),is_include_tier2,*(normal_cpi_ptr[t]));
-        _pileupCleaner.CleanPileup(tumor_sif.basecallBuffer.get_pos(pos),is_include_tier2,*(tumor_cpi_ptr[t]));
     }
 
-    // note single-sample anomaly filtration won't apply here (more of
-    // a vestigial blt feature anyway)
-    //
-
-    // retain original blt loop structure from the single-sample case
-    // to allow for multiple interacting tests at one site
-    //
-
-    //    somatic_snv_genotype sgt;
-    somatic_snv_genotype_grid sgtg;
+    // the normal sample likelihoods are likewise computed at most once:
+    _normalLhood.clear();
 
-    if (_opt.is_somatic_snv())
+    const unsigned tumorSampleCount(getTumorSampleCount());
+    for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
     {
-        sgtg.is_forced_output=is_forced_output_pos(pos);
+        const unsigned tumorSampleId(getTumorSampleIndex(tumorSampleIndex));
+        sample_info& tumor_sif(sample(tumorSampleId));
 
-        const extended_pos_info* normal_epi_t2_ptr(nullptr);
-        const extended_pos_info* tumor_epi_t2_ptr(nullptr);
-        if (_opt.useTier2Evidence)
+        CleanedPileup* tumor_cpi_ptr[n_tier] = { &(tumor_sif.cleanedPileup), &(_tier2_cpi[tumorSampleId]) };
+
+        for (unsigned t(0); t<n_tier; ++t)
         {
-            normal_epi_t2_ptr=&(normal_cpi_ptr[1]->getExtendedPosInfo());
-            tumor_epi_t2_ptr=&(tumor_cpi_ptr[1]->getExtendedPosInfo());
+            const bool is_include_tier2(t!=0);
+            if (is_include_tier2 && (! _opt.useTier2Evidence)) continue;
+            _pileupCleaner.CleanPileup(tumor_sif.basecallBuffer.get_pos(pos),is_include_tier2,*(tumor_cpi_ptr[t]));
         }
 
-        const bool isComputeNonSomatic(_opt.is_somatic_callable());
+        // note single-sample anomaly filtration won't apply here (more of
+        // a vestigial blt feature anyway)
+        //
 
-        _dopt.sscaller_strand_grid().position_somatic_snv_call(
-            normal_cpi_ptr[0]->getExtendedPosInfo(),
-            tumor_cpi_ptr[0]->getExtendedPosInfo(),
-            normal_epi_t2_ptr,
-            tumor_epi_t2_ptr,
-            isComputeNonSomatic,
-            sgtg);
+        // retain original blt loop structure from the single-sample case
+        // to allow for multiple interacting tests at one site
+        //
 
-        if (_opt.is_somatic_callable())
-        {
-            _scallProcessor.addToRegion(_chromName,output_pos,sgtg);
-        }
-    }
+        //    somatic_snv_genotype sgt;
+        somatic_snv_genotype_grid sgtg;
 
-    // report events:
-    //
-    if (sgtg.is_output())
-    {
+        if (_opt.is_somatic_snv())
         {
-            const SiteNoise* snp(_noisePos.getPos(pos));
-            if (snp == nullptr)
+            sgtg.is_forced_output=is_forced_output_pos(pos);
+
+            const extended_pos_info* normal_epi_t2_ptr(nullptr);
+            const extended_pos_info* tumor_epi_t2_ptr(nullptr);
+            if (_opt.useTier2Evidence)
             {
-                sgtg.sn.clear();
+                normal_epi_t2_ptr=&(normal_cpi_ptr[1]->getExtendedPosInfo());
+                tumor_epi_t2_ptr=&(tumor_cpi_ptr[1]->getExtendedPosInfo());
             }
-            else
+
+            const bool isComputeNonSomatic(_opt.is_somatic_callable());
+
+            _dopt.sscaller_strand_grid().position_somatic_snv_call(
+                normal_cpi_ptr[0]->getExtendedPosInfo(),
+                tumor_cpi_ptr[0]->getExtendedPosInfo(),
+                normal_epi_t2_ptr,
+                tumor_epi_t2_ptr,
+                isComputeNonSomatic,
+                _normalLhood,
+                sgtg);
+
+            if (_opt.is_somatic_callable())
             {
-                sgtg.sn = *snp;
+                _scallProcessor[tumorSampleIndex]->addToRegion(_chromName,output_pos,sgtg);
             }
         }
-        std::ostream& bos(*_streams.somatic_snv_osptr());
 
-        // have to keep tier1 counts for filtration purposes:
+        // report events:
+        //
+        if (sgtg.is_output())
+        {
+            {
+                const SiteNoise* snp(_noisePos.getPos(pos));
+                if (snp == nullptr)
+                {
+                    sgtg.sn.clear();
+                }
+                else
+                {
+                    sgtg.sn = *snp;
+                }
+            }
+            // somatic EVS scoring is interleaved with record formatting, so it is included in output time:
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::VARIANT_OUTPUT);
+            std::ostream& bos(*_streams.somatic_snv_osptr(tumorSampleIndex));
+
+            // have to keep tier1 counts for filtration purposes:
 #ifdef SOMATIC_DEBUG
-        write_snv_prefix_info_file(_chromName,output_pos,ref_base,normald,tumord,log_os);
-        log_os << "\n";
+            write_snv_prefix_info_file(_chromName,output_pos,ref_base,normald,tumord,log_os);
+            log_os << "\n";
 #endif
 
-        bos << _chromName << '\t'
-            << output_pos << '\t'
-            << ".";
+            bos << _chromName << '\t'
+                << output_pos << '\t'
+                << ".";
 
-        static const bool is_write_nqss(false);
-        write_vcf_somatic_snv_genotype_strand_grid(_opt, _dopt, sgtg, is_write_nqss, *(normal_cpi_ptr[0]),
-                                                   *(tumor_cpi_ptr[0]), *(normal_cpi_ptr[1]), *(tumor_cpi_ptr[1]),
-                                                   _normChromDepth, _maxChromDepth, bos);
-        bos << "\n";
+            static const bool is_write_nqss(false);
+            write_vcf_somatic_snv_genotype_strand_grid(_opt, _dopt, sgtg, is_write_nqss, *(normal_cpi_ptr[0]),
+                                                       *(tumor_cpi_ptr[0]), *(normal_cpi_ptr[1]), *(tumor_cpi_ptr[1]),
+                                                       _normChromDepth, _maxChromDepth, bos);
+            bos << "\n";
+        }
     }
 }
 
@@ -271,6 +307,7 @@ process_pos_variants_impl(
 
     try
     {
+        const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::SNV_GENOTYPE);
         process_pos_snp_somatic(pos);
     }
     catch (...)
@@ -281,6 +318,7 @@ process_pos_variants_impl(
 
     try
     {
+        const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::INDEL_GENOTYPE);
         process_pos_indel_somatic(pos);
     }
     catch (...)
@@ -300,7 +338,8 @@ process_pos_indel_somatic(const pos_t pos)
 
     //    std::ostream& report_os(get_report_os());
     sample_info& normal_sif(sample(NORMAL));
-    sample_info& tumor_sif(sample(TUMOR));
+
+    const unsigned tumorSampleCount(getTumorSampleCount());
 
     auto indelIter(getIndelBuffer().positionIterator(pos));
     const auto indelIterEnd(getIndelBuffer().positionIterator(pos + 1));
@@ -318,32 +357,45 @@ process_pos_indel_somatic(const pos_t pos)
 
         if (!getIndelBuffer().isCandidateIndel(indelKey, indelData)) continue;
 
+        if (! _opt.is_somatic_indel()) continue;
+
         const IndelSampleData& normalIndelSampleData(indelData.getSampleData(NORMAL));
-        const IndelSampleData& tumorIndelSampleData(indelData.getSampleData(TUMOR));
 
-        if (not indelData.isForcedOutput)
-        {
-            if (normalIndelSampleData.read_path_lnp.empty() && tumorIndelSampleData.read_path_lnp.empty()) continue;
-        }
+        // indel summary info shared by all tumor samples:
+        std::string vcf_indel_seq;
+        std::string vcf_ref_seq;
+        getSingleIndelAlleleVcfSummaryStrings(indelKey, indelData, _ref, vcf_indel_seq, vcf_ref_seq);
+
+        // STARKA-248 filter invalid indel. TODO: filter this issue earlier (occurs as, e.g. 1D1I which matches ref)
+        if (vcf_indel_seq == vcf_ref_seq) continue;
 
-        if (_opt.is_somatic_indel())
+        // normal sample report info is computed on demand and shared by all tumor samples:
+        bool isNormalReportInfoSet(false);
+        std::array<AlleleSampleReportInfo,2> nisri;
+
+        for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
         {
+            const unsigned tumorSampleId(getTumorSampleIndex(tumorSampleIndex));
+            sample_info& tumor_sif(sample(tumorSampleId));
+            const IndelSampleData& tumorIndelSampleData(indelData.getSampleData(tumorSampleId));
+
+            if (not indelData.isForcedOutput)
+            {
+                if (normalIndelSampleData.read_path_lnp.empty() && tumorIndelSampleData.read_path_lnp.empty()) continue;
+            }
+
             // indel_report_info needs to be run first now so that
             // local small repeat info is available to the indel
             // caller
-            // indel summary info
             SomaticIndelVcfInfo siInfo;
-
-            getSingleIndelAlleleVcfSummaryStrings(indelKey, indelData, _ref, siInfo.vcf_indel_seq, siInfo.vcf_ref_seq);
-
-            // STARKA-248 filter invalid indel. TODO: filter this issue earlier (occurs as, e.g. 1D1I which matches ref)
-            if (siInfo.vcf_indel_seq == siInfo.vcf_ref_seq) continue;
+            siInfo.vcf_indel_seq = vcf_indel_seq;
+            siInfo.vcf_ref_seq = vcf_ref_seq;
 
             static const bool is_use_alt_indel(true);
             _dopt.sicaller_grid().get_somatic_indel(_opt,_dopt,
                                                     normal_sif.sampleOptions,
                                                     tumor_sif.sampleOptions,
-                                                    indelKey, indelData, NORMAL,TUMOR,
+                                                    indelKey, indelData, NORMAL, tumorSampleId,
                                                     is_use_alt_indel,
                                                     siInfo.sindel);
 
@@ -355,13 +407,18 @@ process_pos_indel_somatic(const pos_t pos)
                 for (unsigned t(0); t<2; ++t)
                 {
                     const bool is_include_tier2(t!=0);
-                    getAlleleSampleReportInfo(_opt, _dopt, indelKey, normalIndelSampleData, normal_sif.basecallBuffer,
-                                              is_include_tier2, is_use_alt_indel,
-                                              siInfo.nisri[t]);
+                    if (not isNormalReportInfoSet)
+                    {
+                        getAlleleSampleReportInfo(_opt, _dopt, indelKey, normalIndelSampleData, normal_sif.basecallBuffer,
+                                                  is_include_tier2, is_use_alt_indel,
+                                                  nisri[t]);
+                    }
                     getAlleleSampleReportInfo(_opt, _dopt, indelKey, tumorIndelSampleData, tumor_sif.basecallBuffer,
                                               is_include_tier2, is_use_alt_indel,
                                               siInfo.tisri[t]);
                 }
+                isNormalReportInfoSet = true;
+                siInfo.nisri = nisri;
 
                 pos_t indel_pos(indelKey.pos);
                 if (indelKey.type != INDEL::BP_RIGHT)
@@ -369,39 +426,39 @@ process_pos_indel_somatic(const pos_t pos)
                     indel_pos -= 1;
                 }
 
-                _indelWriter.cacheIndel(indel_pos,siInfo);
+                _indelWriter[tumorSampleIndex]->cacheIndel(indel_pos,siInfo);
                 _is_skip_process_pos=false;
             }
+        }
 
 #if 0
-            /// TODO put this option under runtime control...
-            /// TODO setup option so that read keys persist longer when needed for this case...
-            ///
-            static const bool is_print_indel_evidence(false);
+        /// TODO put this option under runtime control...
+        /// TODO setup option so that read keys persist longer when needed for this case...
+        ///
+        static const bool is_print_indel_evidence(false);
 
-            if (is_print_indel_evidence and is_indel)
-            {
-                report_os << "INDEL_EVIDENCE " << ik;
+        if (is_print_indel_evidence and is_indel)
+        {
+            report_os << "INDEL_EVIDENCE " << ik;
 
-                typedef indel_data::score_t::const_iterator siter;
-                siter i(id.read_path_lnp.begin()), i_end(id.read_path_lnp.end());
-                for (; i!=i_end; ++i)
-                {
-                    const align_id_t read_id(i->first);
-                    const ReadPathScores& lnp(i->second);
-                    const ReadPathScores pprob(indel_lnp_to_pprob(_dopt,lnp));
-                    const starling_read* srptr(sif.readBuffer.get_read(read_id));
-
-                    report_os << "read key: ";
-                    if (nullptr==srptr) report_os << "UNKNOWN_KEY";
-                    else            report_os << srptr->key();
-                    report_os << "\n"
-                              << "read log_lhoods: " << lnp << "\n"
-                              << "read pprobs: " << pprob << "\n";
-                }
+            typedef indel_data::score_t::const_iterator siter;
+            siter i(id.read_path_lnp.begin()), i_end(id.read_path_lnp.end());
+            for (; i!=i_end; ++i)
+            {
+                const align_id_t read_id(i->first);
+                const ReadPathScores& lnp(i->second);
+                const ReadPathScores pprob(indel_lnp_to_pprob(_dopt,lnp));
+                const starling_read* srptr(sif.readBuffer.get_read(read_id));
+
+                report_os << "read key: ";
+                if (nullptr==srptr) report_os << "UNKNOWN_KEY";
+                else            report_os << srptr->key();
+                report_os << "\n"
+                          << "read log_lhoods: " << lnp << "\n"
+                          << "read pprobs: " << pprob << "\n";
             }
-#endif
         }
+#endif
     }
 }
 
@@ -419,12 +476,21 @@ run_post_call_step(
         return;
     }
 
-    if (! _indelWriter.testPos(pos)) return;
+    using namespace STRELKA_SAMPLE_TYPE;
 
-    const LocalRegionStats& was_normal(
-        sample(STRELKA_SAMPLE_TYPE::NORMAL).localRegionStatsCollection.getLocalRegionStats(_indelRegionIndexNormal));
-    const LocalRegionStats& was_tumor(sample(STRELKA_SAMPLE_TYPE::TUMOR).localRegionStatsCollection.getLocalRegionStats(_indelRegionIndexTumor));
+    const unsigned tumorSampleCount(getTumorSampleCount());
+    for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
+    {
+        SomaticIndelVcfWriter& indelWriter(*_indelWriter[tumorSampleIndex]);
+        if (! indelWriter.testPos(pos)) continue;
 
-    _indelWriter.addIndelWindowData(_chromName, pos, was_normal, was_tumor, _maxChromDepth);
-}
+        const unsigned tumorSampleId(getTumorSampleIndex(tumorSampleIndex));
+        const LocalRegionStats& was_normal(
+            sample(NORMAL).localRegionStatsCollection.getLocalRegionStats(_indelRegionIndex[NORMAL]));
+        const LocalRegionStats& was_tumor(
+            sample(tumorSampleId).localRegionStatsCollection.getLocalRegionStats(_indelRegionIndex[tumorSampleId]));
 
+        const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::VARIANT_OUTPUT);
+        indelWriter.addIndelWindowData(_chromName, pos, was_normal, was_tumor, _maxChromDepth);
+    }
+}
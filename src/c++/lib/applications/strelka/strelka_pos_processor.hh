@@ -25,6 +25,7 @@
 
 
 #include "NoiseBuffer.hh"
+#include "position_somatic_snv_strand_grid.hh"
 #include "strelka_shared.hh"
 #include "SomaticIndelVcfWriter.hh"
 #include "strelka_streams.hh"
@@ -34,8 +35,15 @@
 #include "SomaticCallableProcessor.hh"
 #include "strelka_common/StrelkaSampleSetSummary.hh"
 
+#include <memory>
+#include <vector>
 
+
+/// somatic variant caller position processor
 ///
+/// The normal sample is always sample index STRELKA_SAMPLE_TYPE::NORMAL. One or more tumor samples follow it, where in
+/// multi-tumor mode the normal sample reads are realigned and piled up once, and each tumor sample is called against
+/// this shared normal pileup, with results written to a separate set of output streams for each tumor.
 ///
 struct strelka_pos_processor : public starling_pos_processor_base
 {
@@ -60,6 +68,17 @@ struct strelka_pos_processor : public starling_pos_processor_base
         const pos_t pos,
         const SiteNoise& sn);
 
+    /// \brief Load noise track sites in \p range of the current region's chromosome
+    ///
+    /// This must be called after resetRegion() for each region.
+    void
+    loadNoiseTrackRegion(
+        NoiseTrackReader& noiseTrack,
+        const known_pos_range2& range)
+    {
+        _noisePos.loadTrackRegion(noiseTrack, _chromName, range);
+    }
+
 private:
 
     void
@@ -87,7 +106,29 @@ private:
     bool
     derived_empty() const override
     {
-        return _indelWriter.empty();
+        for (const auto& indelWriter : _indelWriter)
+        {
+            if (not indelWriter->empty()) return false;
+        }
+        return true;
+    }
+
+    BufferUsage
+    getVariantPipelineBufferUsage() const override
+    {
+        BufferUsage usage;
+        for (const auto& indelWriter : _indelWriter)
+        {
+            usage.add(indelWriter->getBufferUsage());
+        }
+        return usage;
+    }
+
+    /// \return the number of tumor samples, each of which is called against the shared normal sample
+    unsigned
+    getTumorSampleCount() const
+    {
+        return (getSampleCount() - STRELKA_SAMPLE_TYPE::TUMOR);
     }
 
     /////////////////////////////
@@ -101,15 +142,20 @@ private:
     double _normChromDepth = 0.;
     double _maxChromDepth = 0.;
 
-    CleanedPileup _tier2_cpi[STRELKA_SAMPLE_TYPE::SIZE];
+    /// tier2 cleaned pileup for each sample
+    std::vector<CleanedPileup> _tier2_cpi;
 
-    SomaticCallableProcessor _scallProcessor;
+    /// callable region and indel output is managed separately for each tumor sample:
+    std::vector<std::unique_ptr<SomaticCallableProcessor>> _scallProcessor;
 
     // enables delayed indel write:
-    SomaticIndelVcfWriter _indelWriter;
+    std::vector<std::unique_ptr<SomaticIndelVcfWriter>> _indelWriter;
 
-    unsigned _indelRegionIndexNormal;
-    unsigned _indelRegionIndexTumor;
+    /// index of the indel window stats for each sample
+    std::vector<unsigned> _indelRegionIndex;
 
     NoiseBuffer _noisePos;
+
+    /// normal sample snv likelihoods of the current position, shared by all tumor samples:
+    NormalSnvLhood _normalLhood;
 };
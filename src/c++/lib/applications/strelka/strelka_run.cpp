@@ -25,10 +25,16 @@
 #include "blt_util/log.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/bam_header_info.hh"
+#include "htsapi/bam_header_util.hh"
 #include "htsapi/vcf_record_util.hh"
 #include "starling_common/HtsMergeStreamerUtil.hh"
+#include "starling_common/LocusProfiler.hh"
+#include "starling_common/ReplayBundle.hh"
 #include "starling_common/starling_ref_seq.hh"
 #include "starling_common/starling_pos_processor_util.hh"
+#include "strelka_common/NoiseTrack.hh"
+
+#include <chrono>
 
 
 
@@ -45,21 +51,41 @@ enum index_t
 
 
 
+/// \param[in] noiseTrackPtr if non-null, noise sites for the region are loaded from this track
+/// \param[in] refCachePtr if non-null, regionInfo is entry regionListIndex of the region list already set on refCache
+///                        and streamData
 static
 void
 callRegion(
     const strelka_options& opt,
+    const strelka_deriv_options& dopt,
     const AnalysisRegionInfo& regionInfo,
     starling_read_counts& readCounts,
     reference_contig_segment& ref,
     HtsMergeStreamer& streamData,
-    strelka_pos_processor& posProcessor)
+    strelka_pos_processor& posProcessor,
+    NoiseTrackReader* noiseTrackPtr,
+    ReferenceSegmentCache* refCachePtr = nullptr,
+    const unsigned regionListIndex = 0)
 {
     using namespace illumina::common;
 
     posProcessor.resetRegion(regionInfo.regionChrom, regionInfo.regionRange);
-    streamData.resetRegion(regionInfo.streamerRegion.c_str());
-    setRefSegment(opt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
+    if (nullptr != noiseTrackPtr)
+    {
+        // query the same range used to stream noise panel vcf records:
+        posProcessor.loadNoiseTrackRegion(*noiseTrackPtr, regionInfo.streamerRegionRange);
+    }
+    if (nullptr == refCachePtr)
+    {
+        streamData.resetRegion(regionInfo.streamerRegion.c_str());
+        setRefSegment(opt, dopt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
+    }
+    else
+    {
+        streamData.resetRegionListIndex(regionListIndex);
+        refCachePtr->setRefSegment(regionListIndex, ref);
+    }
 
     while (streamData.next())
     {
@@ -167,28 +193,33 @@ strelka_run(
     using namespace illumina::common;
 
     // ensure that this object is created first for runtime benchmark
-    RunStatsManager statsManager(opt.segmentStatsFilename);
+    RunStatsManager statsManager(opt.segmentStatsFilename, opt.isHardwareCounters);
 
     opt.validate();
 
     const strelka_deriv_options dopt(opt);
-    const StrelkaSampleSetSummary ssi;
+    const StrelkaSampleSetSummary ssi(opt.getTumorSampleCount());
     starling_read_counts readCounts;
     reference_contig_segment ref;
+    ReferenceSegmentCache refCache(opt, dopt);
 
     ////////////////////////////////////////
     // setup streamData:
     //
-    HtsMergeStreamer streamData(opt.referenceFilename);
+    HtsMergeStreamer streamData(opt.getAlignmentReferenceFilename());
 
     // additional data structures required in the region loop below, which are filled in as a side effect of
     // streamData initialization:
     std::vector<std::reference_wrapper<const bam_hdr_t>> bamHeaders;
     {
+        // each tumor alignment file is registered as a separate tumor sample, all called against the same normal:
         std::vector<unsigned> registrationIndices;
+        unsigned tumorSampleIndex(0);
         for (const bool isTumor : opt.alignFileOpt.isAlignmentTumor)
         {
-            const unsigned rindex(isTumor ? STRELKA_SAMPLE_TYPE::TUMOR : STRELKA_SAMPLE_TYPE::NORMAL);
+            const unsigned rindex(isTumor ?
+                                  STRELKA_SAMPLE_TYPE::getTumorSampleIndex(tumorSampleIndex++) :
+                                  static_cast<unsigned>(STRELKA_SAMPLE_TYPE::NORMAL));
             registrationIndices.push_back(rindex);
         }
 
@@ -213,8 +244,24 @@ strelka_run(
     const bam_hdr_t& referenceHeader(bamHeaders.front());
     const bam_header_info referenceHeaderInfo(referenceHeader);
 
-    strelka_streams fileStreams(opt, dopt, pinfo, referenceHeader, ssi);
-    strelka_pos_processor posProcessor(opt, dopt, ref, fileStreams, statsManager);
+    if (opt.isLocusProfile())
+    {
+        setLocusProfileStatsOptions(referenceHeaderInfo, opt.locusProfileMinSeconds, statsManager);
+    }
+
+    // tumor sample names are only used to identify the tumor sample of each output file:
+    std::vector<std::string> tumorSampleNames;
+    for (unsigned fileIndex(0); fileIndex < bamHeaders.size(); ++fileIndex)
+    {
+        if (not opt.alignFileOpt.isAlignmentTumor[fileIndex]) continue;
+        tumorSampleNames.push_back(get_bam_header_sample_name(bamHeaders[fileIndex], "TUMOR"));
+    }
+
+    std::unique_ptr<NoiseTrackReader> noiseTrackPtr;
+    if (not opt.noiseTrackFilename.empty())
+    {
+        noiseTrackPtr.reset(new NoiseTrackReader(opt.noiseTrackFilename));
+    }
 
     // parse and sanity check regions
     assert ((! opt.isHaplotypingEnabled) && "Region border size must be updated if haplotyping is enabled");
@@ -225,25 +272,59 @@ strelka_run(
     getStrelkaAnalysisRegions(opt, referenceAlignmentFilename, referenceHeaderInfo, supplementalRegionBorderSize,
                               regionInfoList);
 
-    for (const auto& regionInfo : regionInfoList)
+    if (opt.isCaptureReplayBundle())
     {
-        if (not opt.isUseCallRegions())
-        {
-            callRegion(opt, regionInfo, readCounts, ref, streamData, posProcessor);
-        }
-        else
-        {
-            std::vector<known_pos_range2> subRegionRanges;
-            getSubRegionsFromBedTrack(opt.callRegionsBedFilename, regionInfo.regionChrom, regionInfo.regionRange, subRegionRanges);
+        captureReplayBundle(opt, dopt, regionInfoList.front());
+        return;
+    }
+
+    // all regions are called more than once only to profile replay bundles, the output of each iteration replaces
+    // the output of the previous iteration:
+    for (unsigned replayIteration(0); replayIteration < opt.replayIterations; ++replayIteration)
+    {
+        const auto iterationStartTime(std::chrono::steady_clock::now());
+
+        strelka_streams fileStreams(opt, dopt, pinfo, referenceHeader, ssi, tumorSampleNames);
+        strelka_pos_processor posProcessor(opt, dopt, ref, fileStreams, statsManager);
 
-            for (const auto& subRegionRange : subRegionRanges)
+        for (const auto& regionInfo : regionInfoList)
+        {
+            if (not opt.isUseCallRegions())
+            {
+                callRegion(opt, dopt, regionInfo, readCounts, ref, streamData, posProcessor, noiseTrackPtr.get());
+            }
+            else
             {
-                AnalysisRegionInfo subRegionInfo;
-                getStrelkaAnalysisRegionInfo(regionInfo.regionChrom, subRegionRange.begin_pos(), subRegionRange.end_pos(),
-                                             supplementalRegionBorderSize, subRegionInfo);
-                callRegion(opt, subRegionInfo, readCounts, ref, streamData, posProcessor);
+                std::vector<AnalysisRegionInfo> subRegionInfoList;
+                getCallSubRegionInfo(opt.callRegionsBedFilename, regionInfo, supplementalRegionBorderSize, subRegionInfoList);
+                if (subRegionInfoList.empty()) continue;
+
+                if (not opt.isSinglePassCallRegions)
+                {
+                    for (const auto& subRegionInfo : subRegionInfoList)
+                    {
+                        callRegion(opt, dopt, subRegionInfo, readCounts, ref, streamData, posProcessor, noiseTrackPtr.get());
+                    }
+                }
+                else
+                {
+                    resetCallSubRegionList(regionInfo.regionChrom, subRegionInfoList, streamData, refCache);
+                    const unsigned subRegionCount(subRegionInfoList.size());
+                    for (unsigned subRegionIndex(0); subRegionIndex < subRegionCount; ++subRegionIndex)
+                    {
+                        callRegion(opt, dopt, subRegionInfoList[subRegionIndex], readCounts, ref, streamData,
+                                   posProcessor, noiseTrackPtr.get(), &refCache, subRegionIndex);
+                    }
+                }
             }
         }
+        posProcessor.reset();
+
+        if (opt.replayIterations > 1)
+        {
+            const std::chrono::duration<double> iterationTime(std::chrono::steady_clock::now() - iterationStartTime);
+            log_os << "INFO: Replay iteration " << (replayIteration+1) << " of " << opt.replayIterations
+                   << " completed in " << iterationTime.count() << " seconds\n";
+        }
     }
-    posProcessor.reset();
 }
@@ -26,6 +26,7 @@
 #include "strelka_shared.hh"
 #include "blt_util/blt_exception.hh"
 
+#include <cassert>
 #include <sstream>
 #include "somaticVariantEmpiricalScoringFeatures.hh"
 
@@ -71,3 +72,33 @@ strelka_deriv_options(const strelka_options& opt)
 /// dtor required to be in the cpp so that unique ptr can access complete data type
 strelka_deriv_options::
 ~strelka_deriv_options() {}
+
+
+
+std::string
+getTumorSampleFilename(
+    const std::string& filename,
+    const unsigned tumorSampleIndex,
+    const unsigned tumorSampleCount)
+{
+    assert(tumorSampleIndex < tumorSampleCount);
+    if (tumorSampleCount == 1) return filename;
+
+    std::ostringstream oss;
+    oss << ".tumor" << (tumorSampleIndex+1);
+
+    // find the extension in the file name only, not in any directory name:
+    const size_t nameStart(filename.rfind('/'));
+    const size_t extStart(filename.rfind('.'));
+    std::string tumorFilename(filename);
+    if ((extStart == std::string::npos) or
+        ((nameStart != std::string::npos) and (extStart < nameStart)))
+    {
+        tumorFilename += oss.str();
+    }
+    else
+    {
+        tumorFilename.insert(extStart, oss.str());
+    }
+    return tumorFilename;
+}
@@ -120,6 +120,18 @@ struct strelka_options : public starling_base_options
         return alignFileOpt;
     }
 
+    /// \return the number of tumor samples, each of which is called against the same normal sample
+    unsigned
+    getTumorSampleCount() const
+    {
+        unsigned tumorSampleCount(0);
+        for (const bool isTumor : alignFileOpt.isAlignmentTumor)
+        {
+            if (isTumor) tumorSampleCount++;
+        }
+        return tumorSampleCount;
+    }
+
     TumorNormalAlignmentFileOptions alignFileOpt;
 
     /// Expected rate of somatic SNVs
@@ -163,6 +175,9 @@ struct strelka_options : public starling_base_options
     /// \brief Variants in these vcfs are used to indicate known systematic low-freqeuncy noise.
     std::vector<std::string> noise_vcf;
 
+    /// \brief Binary noise track converted from a noise panel vcf, used in place of noise_vcf
+    std::string noiseTrackFilename;
+
     somatic_filter_options sfilter;
 
     /// somatic scoring models:
@@ -194,6 +209,18 @@ struct somatic_filter_deriv_options
 
 
 
+/// \brief Get the output filename for one tumor sample in multi-tumor mode
+///
+/// With a single tumor sample \p filename is returned unchanged, otherwise the 1-based tumor number is inserted ahead
+/// of the file extension, such that "somatic.snvs.vcf" becomes "somatic.snvs.tumor2.vcf" for the second tumor.
+std::string
+getTumorSampleFilename(
+    const std::string& filename,
+    const unsigned tumorSampleIndex,
+    const unsigned tumorSampleCount);
+
+
+
 struct somatic_snv_caller_strand_grid;
 struct somatic_indel_caller_grid;
 
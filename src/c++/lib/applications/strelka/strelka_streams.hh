@@ -27,6 +27,13 @@
 #include "starling_common/starling_streams_base.hh"
 #include "strelka_common/StrelkaSampleSetSummary.hh"
 
+#include <cassert>
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
 
 
 struct strelka_streams : public starling_streams_base
@@ -38,28 +45,73 @@ struct strelka_streams : public starling_streams_base
         const strelka_deriv_options& dopt,
         const prog_info& pinfo,
         const bam_hdr_t& bam_header,
-        const StrelkaSampleSetSummary& ssi);
+        const StrelkaSampleSetSummary& ssi,
+        const std::vector<std::string>& tumorSampleNames);
 
+    /// \return the somatic snv output stream for tumor \p tumorSampleIndex, or nullptr if snvs are not being called
     std::ostream*
-    somatic_snv_osptr() const
+    somatic_snv_osptr(
+        const unsigned tumorSampleIndex = 0) const
     {
-        return _somatic_snv_osptr.get();
+        return getTumorSampleStream(_somatic_snv_osptr, tumorSampleIndex);
     }
 
     std::ostream*
-    somatic_indel_osptr() const
+    somatic_indel_osptr(
+        const unsigned tumorSampleIndex = 0) const
     {
-        return _somatic_indel_osptr.get();
+        return getTumorSampleStream(_somatic_indel_osptr, tumorSampleIndex);
     }
 
     std::ostream*
-    somatic_callable_osptr() const
+    somatic_callable_osptr(
+        const unsigned tumorSampleIndex = 0) const
     {
-        return _somatic_callable_osptr.get();
+        return getTumorSampleStream(_somatic_callable_osptr, tumorSampleIndex);
     }
 
 private:
-    std::unique_ptr<std::ostream> _somatic_snv_osptr;
-    std::unique_ptr<std::ostream> _somatic_indel_osptr;
-    std::unique_ptr<std::ostream> _somatic_callable_osptr;
+    /// write the header of a somatic snv vcf file
+    ///
+    /// \param[in] tumorSampleHeader header lines identifying the tumor sample of this file
+    static
+    void
+    writeSomaticSnvVcfHeader(
+        const strelka_options& opt,
+        const strelka_deriv_options& dopt,
+        const prog_info& pinfo,
+        const bam_hdr_t& header,
+        const std::string& tumorSampleHeader,
+        std::ofstream& fos);
+
+    /// write the header of a somatic indel vcf file
+    ///
+    /// \param[in] tumorSampleHeader header lines identifying the tumor sample of this file
+    static
+    void
+    writeSomaticIndelVcfHeader(
+        const strelka_options& opt,
+        const strelka_deriv_options& dopt,
+        const prog_info& pinfo,
+        const bam_hdr_t& header,
+        const std::string& tumorSampleHeader,
+        std::ofstream& fos);
+
+    typedef std::vector<std::unique_ptr<std::ostream>> tumor_streams_t;
+
+    static
+    std::ostream*
+    getTumorSampleStream(
+        const tumor_streams_t& streams,
+        const unsigned tumorSampleIndex)
+    {
+        if (streams.empty()) return nullptr;
+        assert(tumorSampleIndex < streams.size());
+        return streams[tumorSampleIndex].get();
+    }
+
+    /// each stream vector has one entry per tumor sample, or is empty if the output is not enabled:
+    tumor_streams_t _somatic_snv_osptr;
+    tumor_streams_t _somatic_indel_osptr;
+    tumor_streams_t _somatic_callable_osptr;
 };
@@ -0,0 +1,132 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "IndelGridReadEvidence.hh"
+
+#include "starling_common/starling_indel_call_pprob_digt.hh"
+#include "test/starling_base_options_test.hh"
+
+
+BOOST_AUTO_TEST_SUITE( IndelGridReadEvidence_test_suite )
+
+
+/// Build sample data with a mix of tiers, read lengths and alternate indel support
+static
+IndelSampleData
+getTestIndelSampleData()
+{
+    IndelSampleData indelSampleData;
+    const IndelKey altIndelKey(105,INDEL::INDEL,2);
+    for (unsigned readIndex(0); readIndex<40; ++readIndex)
+    {
+        const float ref(-0.5f*(readIndex%7)-0.1f);
+        const float indel(-0.3f*(readIndex%5)-0.2f);
+        const uint16_t nonAmbiguousBasesInRead(60+readIndex%30);
+        const uint16_t readLength((readIndex%3==0) ? 100 : 151);
+        const bool isTier1Read(readIndex%4 != 0);
+        ReadPathScores score(ref,indel,nonAmbiguousBasesInRead,readLength,isTier1Read);
+        if (readIndex%6 == 0)
+        {
+            score.insertAlt(altIndelKey,ref+0.4f);
+        }
+        indelSampleData.read_path_lnp[readIndex] = score;
+    }
+    return indelSampleData;
+}
+
+
+
+/// Check the grid likelihood kernel against the per-read scalar likelihood functions
+static
+void
+checkIndelGridLhood(
+    const IndelKey& indelKey)
+{
+    const starling_base_options_test opt;
+    const starling_base_deriv_options dopt(opt);
+    const starling_sample_options sample_opt(opt);
+    const IndelSampleData indelSampleData(getTestIndelSampleData());
+
+    for (const bool is_use_alt_indel : { false, true })
+    {
+        IndelGridReadEvidence evidence;
+        evidence.setEvidence(sample_opt,indelKey,indelSampleData,is_use_alt_indel);
+        BOOST_REQUIRE_EQUAL(evidence.size(), indelSampleData.read_path_lnp.size());
+
+        for (const bool is_include_tier2 : { false, true })
+        {
+            double expectLhood[DIGT_GRID::PRESTRAND_SIZE];
+            get_indel_digt_lhood(opt,dopt,sample_opt,indelKey,indelSampleData,is_include_tier2,is_use_alt_indel,
+                                 expectLhood);
+            static const unsigned lsize(DIGT_GRID::HET_RES*2);
+            double* gridLhood(expectLhood+SOMATIC_DIGT::SIZE);
+            for (unsigned i(0); i<DIGT_GRID::HET_RES; ++i)
+            {
+                const double het_ratio((i+1)*DIGT_GRID::RATIO_INCREMENT);
+                get_high_low_het_ratio_lhood(opt,dopt,sample_opt,indelKey,indelSampleData,het_ratio,
+                                             is_include_tier2,is_use_alt_indel,
+                                             gridLhood[lsize-(i+1)],gridLhood[i]);
+            }
+
+            double lhood[DIGT_GRID::PRESTRAND_SIZE];
+            getIndelGridLhood(dopt,evidence,is_include_tier2,lhood);
+
+            // the kernel follows the same order of operations, so results should be exact:
+            for (unsigned gt(0); gt<DIGT_GRID::PRESTRAND_SIZE; ++gt)
+            {
+                BOOST_REQUIRE_EQUAL(lhood[gt], expectLhood[gt]);
+            }
+        }
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_IndelGridLhoodDeletion )
+{
+    checkIndelGridLhood(IndelKey(100,INDEL::INDEL,30));
+}
+
+BOOST_AUTO_TEST_CASE( test_IndelGridLhoodInsertion )
+{
+    checkIndelGridLhood(IndelKey(100,INDEL::INDEL,0,"ACGTACGTACGTACGTACGT"));
+}
+
+BOOST_AUTO_TEST_CASE( test_IndelGridLhoodBreakpoint )
+{
+    checkIndelGridLhood(IndelKey(100,INDEL::BP_LEFT));
+}
+
+BOOST_AUTO_TEST_CASE( test_IndelGridLhoodEmpty )
+{
+    const starling_base_options_test opt;
+    const starling_base_deriv_options dopt(opt);
+
+    IndelGridReadEvidence evidence;
+    double lhood[DIGT_GRID::PRESTRAND_SIZE];
+    getIndelGridLhood(dopt,evidence,true,lhood);
+    for (unsigned gt(0); gt<DIGT_GRID::PRESTRAND_SIZE; ++gt)
+    {
+        BOOST_REQUIRE_EQUAL(lhood[gt], 0.);
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
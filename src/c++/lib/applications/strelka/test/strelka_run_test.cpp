@@ -0,0 +1,348 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "testConfig.h"
+
+#include "boost/test/unit_test.hpp"
+
+#include "strelka_info.hh"
+#include "strelka_option_parser.hh"
+#include "strelka_run.hh"
+#include "strelka_shared.hh"
+
+#include "starling_common/ReplayBundle.hh"
+#include "test/TempPath.hh"
+
+#include "boost/filesystem.hpp"
+
+#include <cstring>
+
+#include <fstream>
+
+
+BOOST_AUTO_TEST_SUITE( strelka_run_test )
+
+
+/// \return true for vcf header lines which change between runs or test environments
+static
+bool
+isVariableMetadata(
+    const std::string& line)
+{
+    for (const char* prefix : { "##fileDate", "##source_version", "##startTime", "##reference", "##cmdline" })
+    {
+        if (line.compare(0, std::strlen(prefix), prefix) == 0) return true;
+    }
+    return false;
+}
+
+
+
+/// \return lines of \p filename, excluding variable vcf metadata
+///
+/// \param[out] tumorSampleHeader tumor sample identification header lines, if not null these are removed from the
+///                               returned lines
+static
+std::vector<std::string>
+readOutputLines(
+    const std::string& filename,
+    std::vector<std::string>* tumorSampleHeader = nullptr)
+{
+    std::ifstream ifs(filename);
+    BOOST_REQUIRE_MESSAGE(ifs, "Can't open file: " + filename);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (isVariableMetadata(line)) continue;
+        if ((tumorSampleHeader != nullptr) && (line.compare(0, 7, "##tumor") == 0))
+        {
+            tumorSampleHeader->push_back(line);
+            continue;
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+
+
+/// Output filenames of one tumor sample
+struct TumorOutputFiles
+{
+    std::string snv;
+    std::string indel;
+    std::string callable;
+};
+
+
+
+/// Parse and run a strelka command line in the same way as the strelka2 program, including the substitution of
+/// replay bundle options
+///
+/// \return output filenames for each tumor sample
+static
+std::vector<TumorOutputFiles>
+runStrelkaCommandLine(
+    const std::vector<std::string>& inputArgs)
+{
+    std::vector<std::string> args(inputArgs);
+    std::vector<char*> inputArgv;
+    for (std::string& arg : args)
+    {
+        inputArgv.push_back(&arg[0]);
+    }
+
+    strelka_options opt;
+    ReplayBundleCommandLine commandLine(opt.isSomaticCallingMode, inputArgv.size(), inputArgv.data());
+
+    const prog_info& pinfo(strelka_info::get());
+    po::variables_map vm;
+    const po::options_description visible(get_strelka_option_parser(opt));
+    const po::parsed_options parsed(
+        po::command_line_parser(commandLine.argc(), commandLine.argv()).options(visible).run());
+    po::store(parsed, vm);
+    opt.commandLineOptions = getCommandLineOptions(parsed);
+    po::notify(vm);
+    finalize_strelka_options(pinfo, vm, opt);
+
+    strelka_run(pinfo, opt);
+
+    std::vector<TumorOutputFiles> outputFiles;
+    const unsigned tumorSampleCount(opt.alignFileOpt.alignmentFilenames.size()-1);
+    for (unsigned tumorSampleIndex(0); tumorSampleIndex < tumorSampleCount; ++tumorSampleIndex)
+    {
+        TumorOutputFiles files;
+        files.snv = getTumorSampleFilename(opt.somatic_snv_filename, tumorSampleIndex, tumorSampleCount);
+        files.indel = getTumorSampleFilename(opt.somatic_indel_filename, tumorSampleIndex, tumorSampleCount);
+        files.callable = getTumorSampleFilename(opt.somatic_callable_filename, tumorSampleIndex, tumorSampleCount);
+        outputFiles.push_back(files);
+    }
+    return outputFiles;
+}
+
+
+
+/// \return command line arguments to run somatic calling on the demo data with the given normal and tumor
+///         alignment files
+static
+std::vector<std::string>
+getStrelkaArgs(
+    const TempDir& outputDir,
+    const std::string& normalAlignmentFilename,
+    const std::vector<std::string>& tumorAlignmentFilenames)
+{
+    const std::string dataPath(DEMO_DATA_PATH);
+    const std::string configPath(CONFIG_PATH);
+
+    // these options match the somatic workflow defaults:
+    std::vector<std::string> args = {
+        "strelka2",
+        "--region", "demo20:1-1000000",
+        "--ref", dataPath + "/demo20.fa",
+        "--max-indel-size", "49",
+        "--min-mapping-quality", "20",
+        "--somatic-snv-rate", "0.0001",
+        "--shared-site-error-rate", "5e-07",
+        "--shared-site-error-strand-bias-fraction", "0.5",
+        "--somatic-indel-rate", "1e-06",
+        "--shared-indel-error-factor", "2.2",
+        "--tier2-min-mapping-quality", "0",
+        "--strelka-snv-max-filtered-basecall-frac", "0.4",
+        "--strelka-snv-max-spanning-deletion-frac", "0.75",
+        "--strelka-snv-min-qss-ref", "15",
+        "--strelka-indel-max-window-filtered-basecall-frac", "0.3",
+        "--strelka-indel-min-qsi-ref", "15",
+        "--ssnv-contam-tolerance", "0.15",
+        "--indel-contam-tolerance", "0.15",
+        "--somatic-snv-scoring-model-file", configPath + "/empiricalVariantScoring/models/somaticSNVScoringModels.json",
+        "--somatic-indel-scoring-model-file", configPath + "/empiricalVariantScoring/models/somaticIndelScoringModels.json",
+        "--indel-error-models-file", configPath + "/indelErrorModel/models/indelErrorModel.json",
+        "--theta-file", configPath + "/indelErrorModel/models/theta.json",
+        "--normal-align-file", normalAlignmentFilename,
+        "--somatic-snv-file", outputDir.getFilename("somatic.snvs.vcf"),
+        "--somatic-indel-file", outputDir.getFilename("somatic.indels.vcf"),
+        "--somatic-callable-regions-file", outputDir.getFilename("somatic.callable.bed")
+    };
+    for (const std::string& tumorAlignmentFilename : tumorAlignmentFilenames)
+    {
+        args.push_back("--tumor-align-file");
+        args.push_back(tumorAlignmentFilename);
+    }
+    return args;
+}
+
+
+
+/// Run somatic calling on the demo data with the given normal and tumor alignment files
+///
+/// \return output filenames for each tumor sample
+static
+std::vector<TumorOutputFiles>
+runStrelka(
+    const TempDir& outputDir,
+    const std::string& normalAlignmentFilename,
+    const std::vector<std::string>& tumorAlignmentFilenames)
+{
+    return runStrelkaCommandLine(getStrelkaArgs(outputDir, normalAlignmentFilename, tumorAlignmentFilenames));
+}
+
+
+
+static
+void
+checkLinesEqual(
+    const std::vector<std::string>& lines,
+    const std::vector<std::string>& expectedLines)
+{
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(lines.begin(), lines.end(), expectedLines.begin(), expectedLines.end());
+}
+
+
+
+/// Check that the output of one tumor matches the expected output of a tumor/normal pair
+///
+/// \param[in] isCheckCallable if true, also check the callable regions
+static
+void
+checkTumorOutputEqual(
+    const TumorOutputFiles& files,
+    const TumorOutputFiles& expectedFiles,
+    const bool isCheckCallable = true)
+{
+    std::vector<std::string> tumorSampleHeader;
+    checkLinesEqual(readOutputLines(files.snv, &tumorSampleHeader), readOutputLines(expectedFiles.snv));
+    checkLinesEqual(readOutputLines(files.indel, &tumorSampleHeader), readOutputLines(expectedFiles.indel));
+    if (isCheckCallable)
+    {
+        checkLinesEqual(readOutputLines(files.callable), readOutputLines(expectedFiles.callable));
+    }
+}
+
+
+
+/// \return the expected output of the demo tumor/normal pair, written by strelka before multiple tumor samples
+///         were supported
+static
+TumorOutputFiles
+getSingleTumorExpectedFiles()
+{
+    const std::string testDataPath(TEST_DATA_PATH);
+    TumorOutputFiles expectedFiles;
+    expectedFiles.snv = testDataPath + "/singleTumor.somatic.snvs.vcf";
+    expectedFiles.indel = testDataPath + "/singleTumor.somatic.indels.vcf";
+    expectedFiles.callable = testDataPath + "/singleTumor.somatic.callable.bed";
+    return expectedFiles;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_strelka_run_single_tumor )
+{
+    const std::string dataPath(DEMO_DATA_PATH);
+    const TempDir outputDir("strelkaRun-%%%%-%%%%");
+    const auto outputFiles(runStrelka(outputDir, dataPath + "/NA12892_demo20.bam", { dataPath + "/NA12891_demo20.bam" }));
+    BOOST_REQUIRE_EQUAL(outputFiles.size(), 1u);
+
+    // the output filenames, vcf headers and calls of a tumor/normal pair are unchanged:
+    BOOST_REQUIRE_EQUAL(outputFiles[0].snv, outputDir.getFilename("somatic.snvs.vcf"));
+    checkTumorOutputEqual(outputFiles[0], getSingleTumorExpectedFiles());
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_strelka_run_multi_tumor )
+{
+    const std::string dataPath(DEMO_DATA_PATH);
+    const std::string normalAlignmentFilename(dataPath + "/NA12892_demo20.bam");
+    const std::string tumor1AlignmentFilename(dataPath + "/NA12891_demo20.bam");
+
+    // the second tumor is a copy of the normal sample, the same alignment file can't be used twice:
+    const TempDir outputDir("strelkaRun-%%%%-%%%%");
+    const std::string tumor2AlignmentFilename(outputDir.getFilename("tumor2.bam"));
+    boost::filesystem::copy_file(normalAlignmentFilename, tumor2AlignmentFilename);
+    boost::filesystem::copy_file(normalAlignmentFilename + ".bai", tumor2AlignmentFilename + ".bai");
+
+    const auto outputFiles(runStrelka(outputDir, normalAlignmentFilename,
+                                      { tumor1AlignmentFilename, tumor2AlignmentFilename }));
+    BOOST_REQUIRE_EQUAL(outputFiles.size(), 2u);
+    BOOST_REQUIRE_EQUAL(outputFiles[1].snv, outputDir.getFilename("somatic.snvs.tumor2.vcf"));
+
+    // each vcf header identifies its tumor sample:
+    const std::vector<std::string> tumorAlignmentFilenames = { tumor1AlignmentFilename, tumor2AlignmentFilename };
+    const std::vector<std::string> tumorSampleNames = { "NA12891", "NA12892" };
+    for (unsigned tumorSampleIndex(0); tumorSampleIndex < 2; ++tumorSampleIndex)
+    {
+        const std::vector<std::string> expectedHeader = {
+            "##tumorSampleIndex=" + std::to_string(tumorSampleIndex+1),
+            "##tumorSampleCount=2",
+            "##tumorSampleName=" + tumorSampleNames[tumorSampleIndex],
+            "##tumorAlignmentFile=" + tumorAlignmentFilenames[tumorSampleIndex]
+        };
+        for (const std::string& filename : { outputFiles[tumorSampleIndex].snv, outputFiles[tumorSampleIndex].indel })
+        {
+            std::vector<std::string> tumorSampleHeader;
+            readOutputLines(filename, &tumorSampleHeader);
+            checkLinesEqual(tumorSampleHeader, expectedHeader);
+        }
+    }
+
+    // Candidate indels are pooled over all samples for realignment. The second tumor is a copy of the normal sample
+    // so it adds no candidates, and the first tumor's output is the same as for the tumor/normal pair:
+    checkTumorOutputEqual(outputFiles[0], getSingleTumorExpectedFiles());
+
+    // Compare the second tumor to a separate run of its tumor/normal pair. The first tumor's candidate indels change
+    // the realignment of the second tumor's reads, which changes the callable regions near those indels in this
+    // data, but not the calls:
+    const TempDir pairOutputDir("strelkaRun-%%%%-%%%%");
+    const auto pairOutputFiles(runStrelka(pairOutputDir, normalAlignmentFilename, { tumor2AlignmentFilename }));
+    static const bool isCheckCallable(false);
+    checkTumorOutputEqual(outputFiles[1], pairOutputFiles[0], isCheckCallable);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_strelka_run_replay_bundle )
+{
+    const std::string dataPath(DEMO_DATA_PATH);
+    const std::string normalAlignmentFilename(dataPath + "/NA12892_demo20.bam");
+    const std::string tumorAlignmentFilename(dataPath + "/NA12891_demo20.bam");
+
+    const TempDir outputDir("strelkaRun-%%%%-%%%%");
+    const auto outputFiles(runStrelka(outputDir, normalAlignmentFilename, { tumorAlignmentFilename }));
+
+    // capture a bundle of the same run, then replay the bundle with no other inputs:
+    const TempDir captureDir("strelkaRun-%%%%-%%%%");
+    const std::string bundleDir(captureDir.getFilename("bundle"));
+    std::vector<std::string> captureArgs(getStrelkaArgs(captureDir, normalAlignmentFilename,
+                                                        { tumorAlignmentFilename }));
+    captureArgs.push_back("--capture-replay-bundle");
+    captureArgs.push_back(bundleDir);
+    runStrelkaCommandLine(captureArgs);
+    BOOST_REQUIRE(not boost::filesystem::exists(captureDir.getFilename("somatic.snvs.vcf")));
+
+    const auto replayOutputFiles(runStrelkaCommandLine({ "strelka2", "--replay-bundle", bundleDir }));
+    BOOST_REQUIRE_EQUAL(replayOutputFiles.size(), 1u);
+    BOOST_REQUIRE_EQUAL(replayOutputFiles[0].snv, bundleDir + "/replay/somatic.snvs.vcf");
+
+    // the replayed output matches the direct run:
+    checkTumorOutputEqual(replayOutputFiles[0], outputFiles[0]);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
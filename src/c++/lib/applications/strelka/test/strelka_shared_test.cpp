@@ -0,0 +1,40 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "strelka_shared.hh"
+
+
+BOOST_AUTO_TEST_SUITE( strelka_shared_test )
+
+
+BOOST_AUTO_TEST_CASE( test_getTumorSampleFilename )
+{
+    // a single tumor sample keeps the original filename:
+    BOOST_REQUIRE_EQUAL(getTumorSampleFilename("out/somatic.snvs.vcf", 0, 1), "out/somatic.snvs.vcf");
+
+    BOOST_REQUIRE_EQUAL(getTumorSampleFilename("out/somatic.snvs.vcf", 0, 3), "out/somatic.snvs.tumor1.vcf");
+    BOOST_REQUIRE_EQUAL(getTumorSampleFilename("out/somatic.snvs.vcf", 2, 3), "out/somatic.snvs.tumor3.vcf");
+
+    // no extension in the file name:
+    BOOST_REQUIRE_EQUAL(getTumorSampleFilename("out.dir/callable", 1, 2), "out.dir/callable.tumor2");
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -36,8 +36,15 @@ get_snoise_option_parser(
      po::value(&opt.is_skip_header)->zero_tokens(),
      "Skip vcf output header");
 
+    po::options_description track_opt("Noise track conversion");
+    track_opt.add_options()
+    ("convert-noise-vcf", po::value(&opt.noiseTrackInputVcfFilename),
+     "Convert this tabix indexed noise panel VCF to a binary noise track for strelka, instead of extracting noise from alignments. Requires --noise-track-file.")
+    ("noise-track-file", po::value(&opt.noiseTrackFilename),
+     "Binary noise track output file for noise panel VCF conversion");
+
     po::options_description visible("Options");
-    visible.add(aligndesc).add(snoise_opt);
+    visible.add(aligndesc).add(snoise_opt).add(track_opt);
 
     // add starling base options:
     po::options_description visible2(get_starling_base_option_parser(opt));
@@ -54,6 +61,20 @@ finalize_snoise_options(
     const po::variables_map& vm,
     snoise_options& opt)
 {
+    if (opt.isConvertNoiseTrack() or (not opt.noiseTrackInputVcfFilename.empty()))
+    {
+        // no alignment or reference input is used to convert a noise panel vcf:
+        if (opt.noiseTrackInputVcfFilename.empty())
+        {
+            pinfo.usage("Must specify a noise panel VCF to convert to the noise track");
+        }
+        if (not opt.isConvertNoiseTrack())
+        {
+            pinfo.usage("Must specify a noise track output file to convert a noise panel VCF");
+        }
+        return;
+    }
+
     parseOptions(vm, opt.alignFileOpt);
     std::string errorMsg;
     if (checkOptions(opt.alignFileOpt, errorMsg))
@@ -48,7 +48,7 @@ snoise_run(
     const snoise_options& opt)
 {
     // ensure that this object is created first for runtime benchmark
-    RunStatsManager statsManager(opt.segmentStatsFilename);
+    RunStatsManager statsManager(opt.segmentStatsFilename, opt.isHardwareCounters);
 
     opt.validate();
 
@@ -59,7 +59,7 @@ snoise_run(
     ////////////////////////////////////////
     // setup streamData:
     //
-    HtsMergeStreamer streamData(opt.referenceFilename);
+    HtsMergeStreamer streamData(opt.getAlignmentReferenceFilename());
 
     // additional data structures required in the region loop below, which are filled in as a side effect of
     // streamData initialization:
@@ -94,7 +94,7 @@ snoise_run(
     {
         posProcessor.resetRegion(rinfo.regionChrom, rinfo.regionRange);
         streamData.resetRegion(rinfo.streamerRegion.c_str());
-        setRefSegment(opt, rinfo.regionChrom, rinfo.refRegionRange, ref);
+        setRefSegment(opt, dopt, rinfo.regionChrom, rinfo.refRegionRange, ref);
 
         while (streamData.next())
         {
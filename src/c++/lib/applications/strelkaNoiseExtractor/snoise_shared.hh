@@ -44,4 +44,16 @@ struct snoise_options : public starling_base_options
     AlignmentFileOptions alignFileOpt;
 
     bool is_skip_header = false;
+
+    /// If set, convert this noise panel vcf to a binary noise track instead of extracting noise from alignments
+    std::string noiseTrackInputVcfFilename;
+
+    /// Binary noise track output file used in noise panel vcf conversion mode
+    std::string noiseTrackFilename;
+
+    bool
+    isConvertNoiseTrack() const
+    {
+        return (not noiseTrackFilename.empty());
+    }
 };
@@ -0,0 +1,54 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "snoise_track_convert.hh"
+
+#include "blt_util/log.hh"
+#include "htsapi/vcf_streamer.hh"
+#include "strelka_common/NoiseTrack.hh"
+
+
+
+void
+convertNoiseVcfToTrack(
+    const std::string& noiseVcfFilename,
+    const std::string& noiseTrackFilename)
+{
+    vcf_streamer vcfStream(noiseVcfFilename.c_str(), nullptr);
+    NoiseTrackWriter trackWriter(noiseTrackFilename);
+
+    uint64_t siteCount(0);
+    for (const std::string& chrom : vcfStream.getIndexedChromNames())
+    {
+        vcfStream.resetRegion(chrom.c_str());
+        while (vcfStream.next())
+        {
+            const vcf_record& vcfRecord(*vcfStream.get_record_ptr());
+            if (not vcfRecord.is_snv()) continue;
+
+            SiteNoise sn;
+            set_noise_from_vcf(vcfRecord.line, sn);
+            trackWriter.addSite(chrom, vcfRecord.pos - 1, sn);
+            siteCount++;
+        }
+    }
+    trackWriter.close();
+
+    log_os << "INFO: converted " << siteCount << " noise panel sites from '" << noiseVcfFilename
+           << "' to noise track '" << noiseTrackFilename << "'\n";
+}
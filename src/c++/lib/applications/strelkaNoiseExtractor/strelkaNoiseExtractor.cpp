@@ -21,6 +21,7 @@
 #include "snoise_info.hh"
 #include "snoise_run.hh"
 #include "snoise_option_parser.hh"
+#include "snoise_track_convert.hh"
 
 
 
@@ -63,6 +64,12 @@ runInternal(int argc, char* argv[]) const
 
     finalize_snoise_options(pinfo,vm,opt);
 
+    if (opt.isConvertNoiseTrack())
+    {
+        convertNoiseVcfToTrack(opt.noiseTrackInputVcfFilename, opt.noiseTrackFilename);
+        return;
+    }
+
     snoise_run(pinfo,opt);
 }
 
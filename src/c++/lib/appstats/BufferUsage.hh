@@ -0,0 +1,193 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Occupancy and high-water marks of the major position-ordered buffers
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/serialization/nvp.hpp"
+#include "boost/serialization/string.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include <string>
+
+
+namespace TRACKED_BUFFER
+{
+
+/// Buffers with tracked memory usage
+///
+/// The items and entries counted for each buffer are:
+/// READ:               reads, read bases
+/// BASECALL:           positions, basecalls
+/// INDEL:              indels, read evidence entries
+/// ACTIVE_REGION_READ: positions, read observations
+/// CANDIDATE_SNV:      candidate SNV positions, (none)
+/// VARIANT_PIPELINE:   loci held in the variant output pipeline, (caller specific)
+///
+/// Buffers which are kept per sample are summed over all samples.
+enum index_t
+{
+    READ,
+    BASECALL,
+    INDEL,
+    ACTIVE_REGION_READ,
+    CANDIDATE_SNV,
+    VARIANT_PIPELINE,
+    SIZE
+};
+
+/// Labels are used as xml element names in RunStats, so these must not contain spaces
+inline
+const char*
+label(const index_t i)
+{
+    switch (i)
+    {
+    case READ:
+        return "readBuffer";
+    case BASECALL:
+        return "basecallBuffer";
+    case INDEL:
+        return "indelBuffer";
+    case ACTIVE_REGION_READ:
+        return "activeRegionReadBuffer";
+    case CANDIDATE_SNV:
+        return "candidateSnvBuffer";
+    case VARIANT_PIPELINE:
+        return "variantPipeline";
+    default:
+        assert(false && "Unknown tracked buffer");
+        return nullptr;
+    }
+}
+}
+
+
+
+/// Occupancy of one buffer at one point in time
+///
+/// Byte totals are estimates from the size of each buffered item and any storage the buffer holds independent of
+/// its contents. They are intended to rank buffers and loci by memory use, not to reproduce allocator totals.
+struct BufferUsage
+{
+    void
+    add(const BufferUsage& rhs)
+    {
+        items += rhs.items;
+        entries += rhs.entries;
+        bytes += rhs.bytes;
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(items);
+        ar& BOOST_SERIALIZATION_NVP(entries);
+        ar& BOOST_SERIALIZATION_NVP(bytes);
+    }
+
+    uint64_t items = 0;
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+};
+
+BOOST_CLASS_IMPLEMENTATION(BufferUsage, boost::serialization::object_serializable)
+
+
+
+/// Highest observed usage of one buffer, and the locus where it occurred
+struct BufferPeakData
+{
+    /// Replace the peak if usage is larger
+    void
+    update(
+        const BufferUsage& usage,
+        const std::string& chrom,
+        const pos_t pos)
+    {
+        if (usage.bytes <= peak.bytes) return;
+        peak = usage;
+        if (peakChrom != chrom) peakChrom = chrom;
+        peakPos = pos;
+    }
+
+    void
+    merge(const BufferPeakData& rhs)
+    {
+        update(rhs.peak, rhs.peakChrom, rhs.peakPos);
+    }
+
+    bool
+    empty() const
+    {
+        return (peak.bytes == 0);
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(peak);
+        ar& BOOST_SERIALIZATION_NVP(peakChrom);
+        ar& BOOST_SERIALIZATION_NVP(peakPos);
+    }
+
+    BufferUsage peak;
+    std::string peakChrom;
+
+    /// zero-indexed position of the peak
+    pos_t peakPos = -1;
+};
+
+BOOST_CLASS_IMPLEMENTATION(BufferPeakData, boost::serialization::object_serializable)
+
+
+
+/// Peak usage of all tracked buffers
+struct BufferPeaks
+{
+    void
+    merge(const BufferPeaks& rhs)
+    {
+        for (unsigned bufferIndex(0); bufferIndex<TRACKED_BUFFER::SIZE; ++bufferIndex)
+        {
+            buffers[bufferIndex].merge(rhs.buffers[bufferIndex]);
+        }
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        for (unsigned bufferIndex(0); bufferIndex<TRACKED_BUFFER::SIZE; ++bufferIndex)
+        {
+            const auto buffer(static_cast<TRACKED_BUFFER::index_t>(bufferIndex));
+            ar& boost::serialization::make_nvp(TRACKED_BUFFER::label(buffer), buffers[bufferIndex]);
+        }
+    }
+
+    std::array<BufferPeakData,TRACKED_BUFFER::SIZE> buffers;
+};
+
+BOOST_CLASS_IMPLEMENTATION(BufferPeaks, boost::serialization::object_serializable)
@@ -0,0 +1,271 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Optional hardware performance counters attributed to the timed variant calling stages
+///
+
+#include "HardwareCounters.hh"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+
+#ifdef __linux__
+
+/// \return perf_event hardware event config for counter
+static
+uint64_t
+getPerfEventConfig(const HW_COUNTER::index_t counter)
+{
+    using namespace HW_COUNTER;
+
+    switch (counter)
+    {
+    case CYCLES:
+        return PERF_COUNT_HW_CPU_CYCLES;
+    case INSTRUCTIONS:
+        return PERF_COUNT_HW_INSTRUCTIONS;
+    case LLC_MISSES:
+        return PERF_COUNT_HW_CACHE_MISSES;
+    case BRANCH_MISSES:
+        return PERF_COUNT_HW_BRANCH_MISSES;
+    default:
+        assert(false && "Unknown hardware counter");
+        return 0;
+    }
+}
+
+
+
+/// Open counter for the current thread as a member of the group led by groupFd, or as the group leader if
+/// groupFd is negative
+///
+/// \return counter file descriptor, or a negative value if the counter is not available
+static
+int
+openPerfEventCounter(
+    const HW_COUNTER::index_t counter,
+    const int groupFd)
+{
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = getPerfEventConfig(counter);
+    attr.read_format = (PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/// \return the raw value of hardware counter register counterIndex
+static
+inline
+uint64_t
+readPmc(const uint32_t counterIndex)
+{
+    uint32_t low;
+    uint32_t high;
+    asm volatile("rdpmc" : "=a" (low), "=d" (high) : "c" (counterIndex));
+    return ((static_cast<uint64_t>(high) << 32) | low);
+}
+
+
+
+/// Read the counter of one memory-mapped perf_event page with rdpmc, following the sequence lock protocol
+/// described in linux/perf_event.h
+///
+/// \return false if the counter can't be read with rdpmc, because this is not permitted or the counter is not
+///         currently scheduled
+static
+bool
+readMappedCounter(
+    const volatile perf_event_mmap_page* page,
+    uint64_t& value)
+{
+    uint32_t seq;
+    uint64_t count;
+    do
+    {
+        seq = page->lock;
+        asm volatile("" ::: "memory");
+
+        const uint32_t index(page->index);
+        const uint16_t width(page->pmc_width);
+        if ((not page->cap_user_rdpmc) or (index == 0) or (width == 0) or (width > 64)) return false;
+
+        // the register value is sign-extended from the counter width before it is added to the offset:
+        int64_t pmc(static_cast<int64_t>(readPmc(index - 1)));
+        pmc = static_cast<int64_t>(static_cast<uint64_t>(pmc) << (64 - width)) >> (64 - width);
+        count = static_cast<uint64_t>(page->offset + pmc);
+
+        asm volatile("" ::: "memory");
+    }
+    while (page->lock != seq);
+
+    value = count;
+    return true;
+}
+
+#endif
+
+#endif
+
+
+
+HardwareCounters::
+HardwareCounters()
+{
+    _counterFds.fill(-1);
+    _counterPages.fill(nullptr);
+    _groupIndex.fill(0);
+
+#ifdef __linux__
+    _pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+    {
+        const auto counter(static_cast<HW_COUNTER::index_t>(counterIndex));
+        const int fd(openPerfEventCounter(counter, _groupFd));
+        if (fd < 0) continue;
+
+        if (_groupFd < 0) _groupFd = fd;
+        _counterFds[counterIndex] = fd;
+        _groupIndex[counterIndex] = _groupSize++;
+
+        // counters without a mapped page are still read through the group:
+        void* page(mmap(nullptr, _pageSize, PROT_READ, MAP_SHARED, fd, 0));
+        if (page != MAP_FAILED) _counterPages[counterIndex] = page;
+    }
+#endif
+}
+
+
+
+HardwareCounters::
+~HardwareCounters()
+{
+#ifdef __linux__
+    for (void* page : _counterPages)
+    {
+        if (nullptr != page) munmap(page, _pageSize);
+    }
+    for (const int fd : _counterFds)
+    {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+
+
+void
+HardwareCounters::
+read(HardwareCounterValues& values) const
+{
+    if (not isAvailable()) return;
+
+    if (readMapped(values)) return;
+
+    uint64_t timeEnabled(0);
+    uint64_t timeRunning(0);
+    readGroup(values, timeEnabled, timeRunning);
+}
+
+
+
+bool
+HardwareCounters::
+readTimes(
+    uint64_t& timeEnabled,
+    uint64_t& timeRunning) const
+{
+    if (not isAvailable()) return false;
+
+    HardwareCounterValues values;
+    return readGroup(values, timeEnabled, timeRunning);
+}
+
+
+
+bool
+HardwareCounters::
+readMapped(HardwareCounterValues& values) const
+{
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+    HardwareCounterValues mappedValues;
+    for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+    {
+        mappedValues[counterIndex] = 0;
+        if (_counterFds[counterIndex] < 0) continue;
+        if (nullptr == _counterPages[counterIndex]) return false;
+
+        const auto page(static_cast<const volatile perf_event_mmap_page*>(_counterPages[counterIndex]));
+        if (not readMappedCounter(page, mappedValues[counterIndex])) return false;
+    }
+    values = mappedValues;
+    return true;
+#else
+    (void)(values);
+    return false;
+#endif
+}
+
+
+
+bool
+HardwareCounters::
+readGroup(
+    HardwareCounterValues& values,
+    uint64_t& timeEnabled,
+    uint64_t& timeRunning) const
+{
+#ifdef __linux__
+    // group read format is the number of counters, the enabled and running times, followed by each counter value:
+    static const unsigned headerSize(3);
+    std::array<uint64_t,HW_COUNTER::SIZE+headerSize> buffer;
+    const ssize_t expectedSize((_groupSize+headerSize)*sizeof(uint64_t));
+    const ssize_t readSize(::read(_groupFd, buffer.data(), expectedSize));
+    if ((readSize != expectedSize) or (buffer[0] != _groupSize)) return false;
+
+    timeEnabled = buffer[1];
+    timeRunning = buffer[2];
+    for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+    {
+        values[counterIndex] = ((_counterFds[counterIndex] >= 0) ? buffer[_groupIndex[counterIndex]+headerSize] : 0);
+    }
+    return true;
+#else
+    (void)(values);
+    (void)(timeEnabled);
+    (void)(timeRunning);
+    return false;
+#endif
+}
@@ -0,0 +1,184 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Optional hardware performance counters attributed to the timed variant calling stages
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace HW_COUNTER
+{
+
+enum index_t
+{
+    CYCLES,
+    INSTRUCTIONS,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    SIZE
+};
+
+/// Labels are used as xml element names in RunStats, so these must not contain spaces
+inline
+const char*
+label(const index_t i)
+{
+    switch (i)
+    {
+    case CYCLES:
+        return "cycles";
+    case INSTRUCTIONS:
+        return "instructions";
+    case LLC_MISSES:
+        return "llcMisses";
+    case BRANCH_MISSES:
+        return "branchMisses";
+    default:
+        assert(false && "Unknown hardware counter");
+        return nullptr;
+    }
+}
+
+/// Labels of the counter availability flags in RunStats
+inline
+const char*
+availableLabel(const index_t i)
+{
+    switch (i)
+    {
+    case CYCLES:
+        return "cyclesAvailable";
+    case INSTRUCTIONS:
+        return "instructionsAvailable";
+    case LLC_MISSES:
+        return "llcMissesAvailable";
+    case BRANCH_MISSES:
+        return "branchMissesAvailable";
+    default:
+        assert(false && "Unknown hardware counter");
+        return nullptr;
+    }
+}
+}
+
+
+typedef std::array<uint64_t,HW_COUNTER::SIZE> HardwareCounterValues;
+
+
+
+/// \return count scaled up to the full time the counter was enabled, as an estimate of the true count when the
+/// counter was only running for part of this time due to counter multiplexing
+///
+/// The count is returned unchanged if the counter was never running, in which case it is zero.
+inline
+uint64_t
+scaleHardwareCount(
+    const uint64_t count,
+    const uint64_t timeEnabled,
+    const uint64_t timeRunning)
+{
+    if ((timeRunning == 0) or (timeRunning >= timeEnabled)) return count;
+    return static_cast<uint64_t>((static_cast<double>(count) * timeEnabled) / timeRunning + 0.5);
+}
+
+
+
+/// \brief Self-monitoring hardware performance counters for the current thread
+///
+/// The counters are opened as a single Linux perf_event group counting user-space events only, so that they can
+/// be used without elevated privileges where the system perf_event_paranoid setting allows it. Any counter which
+/// can't be opened is left out, and if no counters can be opened the object is unavailable and reads return
+/// zero. This means that runs on systems without counter access silently fall back to timing only.
+///
+/// Where the kernel allows it, counters are read in user space with rdpmc through the memory-mapped perf_event page
+/// of each counter, so that a read does not require a system call. Otherwise the group is read with read().
+///
+/// Counter values are raw counts, which only accumulate while the group is scheduled on the hardware counters. The
+/// group enabled and running times from \ref readTimes are used to scale these counts when other perf_event users
+/// compete for the same hardware counters.
+///
+struct HardwareCounters : private boost::noncopyable
+{
+    HardwareCounters();
+
+    ~HardwareCounters();
+
+    /// \return true if any counter is available
+    bool
+    isAvailable() const
+    {
+        return (_groupFd >= 0);
+    }
+
+    bool
+    isCounterAvailable(const HW_COUNTER::index_t counter) const
+    {
+        return (_counterFds[counter] >= 0);
+    }
+
+    /// Read the current value of all counters, unavailable counters are set to zero
+    ///
+    /// If the counters can't be read, values is left unchanged.
+    void
+    read(HardwareCounterValues& values) const;
+
+    /// Read the total time in nanoseconds that the counter group has been enabled, and the part of this time that the
+    /// group was scheduled on the hardware counters
+    ///
+    /// \return false if the times can't be read, in which case the times are left unchanged
+    bool
+    readTimes(
+        uint64_t& timeEnabled,
+        uint64_t& timeRunning) const;
+
+private:
+    /// Read all counters through their memory-mapped pages
+    ///
+    /// \return false if any counter can't be read this way
+    bool
+    readMapped(HardwareCounterValues& values) const;
+
+    /// Read the group with the read() system call, including the enabled and running times
+    ///
+    /// \return false if the group can't be read
+    bool
+    readGroup(
+        HardwareCounterValues& values,
+        uint64_t& timeEnabled,
+        uint64_t& timeRunning) const;
+
+    int _groupFd = -1;
+    std::array<int,HW_COUNTER::SIZE> _counterFds;
+
+    /// memory-mapped perf_event page of each available counter, or nullptr if the page could not be mapped
+    std::array<void*,HW_COUNTER::SIZE> _counterPages;
+    std::size_t _pageSize = 0;
+
+    /// index of each counter in the group read format, for available counters
+    std::array<unsigned,HW_COUNTER::SIZE> _groupIndex;
+    unsigned _groupSize = 0;
+};
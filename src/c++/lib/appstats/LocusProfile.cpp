@@ -0,0 +1,141 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Summary of variant calling cost over fixed-size genome windows
+///
+
+#include "LocusProfile.hh"
+
+#include <cassert>
+
+#include <algorithm>
+#include <iostream>
+
+
+
+void
+LocusProfileWindow::
+writeBedHeader(std::ostream& os)
+{
+    os << "#chrom\tstart\tend\tseconds\trealignedReads\tscoredAlignments\tassemblies\n";
+}
+
+
+
+void
+LocusProfileWindow::
+writeBedRecord(std::ostream& os) const
+{
+    os << chrom
+       << '\t' << beginPos
+       << '\t' << endPos
+       << '\t' << seconds
+       << '\t' << realignedReads
+       << '\t' << scoredAlignments
+       << '\t' << assemblies
+       << '\n';
+}
+
+
+
+void
+LocusProfileData::
+addWindow(const LocusProfileWindow& window)
+{
+    const auto insertVal(windows.insert(std::make_pair(window_key_t(window.chrom, window.beginPos), window)));
+    if (insertVal.second) return;
+
+    LocusProfileWindow& existingWindow(insertVal.first->second);
+    assert(existingWindow.endPos == window.endPos);
+    existingWindow.merge(window);
+}
+
+
+
+void
+LocusProfileData::
+merge(const LocusProfileData& rhs)
+{
+    if (chromOrder.empty())
+    {
+        chromOrder = rhs.chromOrder;
+    }
+    minSeconds = std::max(minSeconds, rhs.minSeconds);
+
+    for (const auto& windowVal : rhs.windows)
+    {
+        addWindow(windowVal.second);
+    }
+}
+
+
+
+std::vector<const LocusProfileWindow*>
+LocusProfileData::
+getReportedWindows() const
+{
+    std::map<std::string,unsigned> chromRank;
+    const unsigned chromCount(chromOrder.size());
+    for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex)
+    {
+        chromRank.insert(std::make_pair(chromOrder[chromIndex], chromIndex));
+    }
+
+    auto getChromRank = [&](const std::string& chrom)
+    {
+        const auto iter(chromRank.find(chrom));
+        return ((iter == chromRank.end()) ? chromCount : iter->second);
+    };
+
+    // windows are already sorted by chromosome name and position, so a stable sort on chromosome rank is sufficient:
+    std::vector<std::pair<unsigned,const LocusProfileWindow*>> reportedWindows;
+    for (const auto& windowVal : windows)
+    {
+        const LocusProfileWindow& window(windowVal.second);
+        if (window.seconds < minSeconds) continue;
+        reportedWindows.emplace_back(getChromRank(window.chrom), &window);
+    }
+
+    std::stable_sort(reportedWindows.begin(), reportedWindows.end(),
+                     [](const std::pair<unsigned,const LocusProfileWindow*>& a,
+                        const std::pair<unsigned,const LocusProfileWindow*>& b)
+    {
+        return (a.first < b.first);
+    });
+
+    std::vector<const LocusProfileWindow*> sortedWindows;
+    for (const auto& rankedWindow : reportedWindows)
+    {
+        sortedWindows.push_back(rankedWindow.second);
+    }
+    return sortedWindows;
+}
+
+
+
+void
+LocusProfileData::
+writeBed(std::ostream& os) const
+{
+    LocusProfileWindow::writeBedHeader(os);
+    for (const auto windowPtr : getReportedWindows())
+    {
+        windowPtr->writeBedRecord(os);
+    }
+}
@@ -0,0 +1,141 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Summary of variant calling cost over fixed-size genome windows
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/serialization/map.hpp"
+#include "boost/serialization/nvp.hpp"
+#include "boost/serialization/string.hpp"
+#include "boost/serialization/utility.hpp"
+#include "boost/serialization/vector.hpp"
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// Processing cost accumulated over one genome window
+struct LocusProfileWindow
+{
+    void
+    merge(const LocusProfileWindow& rhs)
+    {
+        seconds += rhs.seconds;
+        realignedReads += rhs.realignedReads;
+        scoredAlignments += rhs.scoredAlignments;
+        assemblies += rhs.assemblies;
+    }
+
+    static
+    void
+    writeBedHeader(std::ostream& os);
+
+    /// Write window as one line of the BED format given by \ref writeBedHeader
+    void
+    writeBedRecord(std::ostream& os) const;
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(chrom);
+        ar& BOOST_SERIALIZATION_NVP(beginPos);
+        ar& BOOST_SERIALIZATION_NVP(endPos);
+        ar& BOOST_SERIALIZATION_NVP(seconds);
+        ar& BOOST_SERIALIZATION_NVP(realignedReads);
+        ar& BOOST_SERIALIZATION_NVP(scoredAlignments);
+        ar& BOOST_SERIALIZATION_NVP(assemblies);
+    }
+
+    std::string chrom;
+
+    /// zero-indexed window range [beginPos,endPos)
+    pos_t beginPos = 0;
+    pos_t endPos = 0;
+
+    /// Position processing time attributed to the window
+    double seconds = 0;
+
+    /// Number of read segments which had at least one candidate alignment scored during realignment
+    unsigned long realignedReads = 0;
+
+    /// Total candidate alignments scored during realignment
+    unsigned long scoredAlignments = 0;
+
+    /// Number of active regions which were assembled
+    unsigned long assemblies = 0;
+};
+
+BOOST_CLASS_IMPLEMENTATION(LocusProfileWindow, boost::serialization::object_serializable)
+
+
+
+/// \brief Genome windows profiled by the locus profiler
+///
+/// All profiled windows are stored, so that windows from different runs which cover the same range, such as a window
+/// split over two genome segments, are combined on merge before the time threshold is applied to the reported
+/// windows.
+///
+struct LocusProfileData
+{
+    /// windows are keyed on chromosome name and window begin position
+    typedef std::pair<std::string,pos_t> window_key_t;
+    typedef std::map<window_key_t,LocusProfileWindow> window_map_t;
+
+    /// Add window, combining it with any existing window over the same range
+    void
+    addWindow(const LocusProfileWindow& window);
+
+    void
+    merge(const LocusProfileData& rhs);
+
+    /// \return all windows reaching the time threshold, sorted by chromosome in reference order and then by position
+    ///
+    /// Chromosomes missing from the reference order are sorted after all others by name.
+    std::vector<const LocusProfileWindow*>
+    getReportedWindows() const;
+
+    /// Write all windows reaching the time threshold in BED format, sorted as for \ref getReportedWindows
+    void
+    writeBed(std::ostream& os) const;
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(chromOrder);
+        ar& BOOST_SERIALIZATION_NVP(minSeconds);
+        ar& BOOST_SERIALIZATION_NVP(windows);
+    }
+
+    /// Reference chromosome names in reference order, used to sort the reported windows
+    std::vector<std::string> chromOrder;
+
+    /// Minimum processing time for a window to be reported
+    double minSeconds = 0;
+
+    window_map_t windows;
+};
+
+BOOST_CLASS_IMPLEMENTATION(LocusProfileData, boost::serialization::object_serializable)
@@ -28,6 +28,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 
 
@@ -41,6 +42,98 @@ report(std::ostream& os) const
     os << "\n";
     os << "CallRegionCandidateIndels\t" << candidateIndels << "\n";
     os << "CallRegionNonCandidateIndels\t" << nonCandidateIndels << "\n";
+    if (germlineSiteLoci > 0)
+    {
+        os << "\n";
+        os << "GermlineLocusRequests\t" << germlineLocusRequests << "\n";
+        os << "GermlineLocusAllocations\t" << germlineLocusAllocations << "\n";
+        os << "GermlineLocusAllocationsPerMillionSiteLoci\t"
+           << (germlineLocusAllocations / (germlineSiteLoci / 1e6)) << "\n";
+    }
+    os << "\n";
+    for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+    {
+        const StageTimeData& stageData(stageTimes.stages[stageIndex]);
+        const char* stageLabel(TIMED_STAGE::label(static_cast<TIMED_STAGE::index_t>(stageIndex)));
+        os << "StageHours_" << stageLabel << '\t' << (stageData.seconds/3600.) << "\n";
+        os << "StageCalls_" << stageLabel << '\t' << stageData.calls << "\n";
+    }
+    if (not stageCounters.empty())
+    {
+        using namespace HW_COUNTER;
+
+        os << "\n";
+        os << "StageCounterRunningFraction\t" << stageCounters.getRunningFraction() << "\n";
+        if (stageCounters.timeRunning == 0)
+        {
+            // counters which were never scheduled on the hardware have no counts, rather than zero counts:
+            os << "StageCounterStatus\tnotScheduled\n";
+        }
+        else
+        {
+            for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+            {
+                const StageCounterData& stageData(stageCounters.stages[stageIndex]);
+                const char* stageLabel(TIMED_STAGE::label(static_cast<TIMED_STAGE::index_t>(stageIndex)));
+                for (unsigned counterIndex(0); counterIndex<SIZE; ++counterIndex)
+                {
+                    if (not stageCounters.isAvailable[counterIndex]) continue;
+                    os << "StageCounter_" << stageLabel << '_' << label(static_cast<index_t>(counterIndex))
+                       << '\t' << stageData.counts[counterIndex] << "\n";
+                }
+                if (stageCounters.isAvailable[CYCLES] and stageCounters.isAvailable[INSTRUCTIONS])
+                {
+                    const uint64_t cycles(stageData.counts[CYCLES]);
+                    os << "StageIPC_" << stageLabel << '\t'
+                       << ((cycles > 0) ? (static_cast<double>(stageData.counts[INSTRUCTIONS]) / cycles) : 0.) << "\n";
+                }
+            }
+        }
+    }
+    if (not locusProfile.windows.empty())
+    {
+        double profiledSeconds(0);
+        for (const auto& windowVal : locusProfile.windows)
+        {
+            profiledSeconds += windowVal.second.seconds;
+        }
+        os << "\n";
+        os << "LocusProfileWindows\t" << locusProfile.getReportedWindows().size() << "\n";
+        os << "LocusProfileHours\t" << (profiledSeconds/3600.) << "\n";
+    }
+    for (unsigned bufferIndex(0); bufferIndex<TRACKED_BUFFER::SIZE; ++bufferIndex)
+    {
+        const BufferPeakData& bufferData(bufferPeaks.buffers[bufferIndex]);
+        if (bufferData.empty()) continue;
+        const char* bufferLabel(TRACKED_BUFFER::label(static_cast<TRACKED_BUFFER::index_t>(bufferIndex)));
+        os << "\n";
+        os << "BufferPeakMb_" << bufferLabel << '\t' << (bufferData.peak.bytes/1e6) << "\n";
+        os << "BufferPeakItems_" << bufferLabel << '\t' << bufferData.peak.items << "\n";
+        os << "BufferPeakEntries_" << bufferLabel << '\t' << bufferData.peak.entries << "\n";
+        os << "BufferPeakLocus_" << bufferLabel << '\t' << bufferData.peakChrom << ':' << (bufferData.peakPos+1) << "\n";
+    }
+    if (throttledRegions > 0)
+    {
+        os << "\n";
+        os << "MemoryBudgetThrottledReads\t" << throttledReads << "\n";
+        os << "MemoryBudgetThrottledRegions\t" << throttledRegions << "\n";
+    }
+}
+
+
+
+/// \return true if the serialized runStatsData element in xml has no class version information, as written by
+///         earlier releases
+static
+bool
+isVersion0RunStatsXml(const std::string& xml)
+{
+    static const std::string startTag("<runStatsData");
+    const auto tagStart(xml.find(startTag));
+    if (tagStart == std::string::npos) return false;
+    const auto tagEnd(xml.find('>', tagStart));
+    const auto versionPos(xml.find(" version=", tagStart));
+    return ((versionPos == std::string::npos) or (versionPos > tagEnd));
 }
 
 
@@ -51,8 +144,22 @@ load(const char* filename)
 {
     assert(nullptr != filename);
     std::ifstream ifs(filename);
-    boost::archive::xml_iarchive ia(ifs);
-    ia >> BOOST_SERIALIZATION_NVP(runStatsData);
+    std::ostringstream xmlBuffer;
+    xmlBuffer << ifs.rdbuf();
+    const std::string xml(xmlBuffer.str());
+
+    std::istringstream iss(xml);
+    boost::archive::xml_iarchive ia(iss);
+    if (isVersion0RunStatsXml(xml))
+    {
+        // boost does not detect the change from an unversioned class, so this case is handled explicitly:
+        RunStatsDataVersion0 runStatsDataVersion0(runStatsData);
+        ia >> boost::serialization::make_nvp("runStatsData", runStatsDataVersion0);
+    }
+    else
+    {
+        ia >> BOOST_SERIALIZATION_NVP(runStatsData);
+    }
 }
 
 
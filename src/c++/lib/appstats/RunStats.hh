@@ -23,10 +23,14 @@
 
 #pragma once
 
+#include "BufferUsage.hh"
+#include "LocusProfile.hh"
+#include "StageTimer.hh"
 #include "blt_util/time_util.hh"
 
 #include "boost/serialization/nvp.hpp"
 #include "boost/serialization/vector.hpp"
+#include "boost/serialization/version.hpp"
 
 #include <cassert>
 #include <cstdint>
@@ -45,17 +49,38 @@ struct RunStatsData
         lifeTime.merge(rhs.lifeTime);
         candidateIndels += rhs.candidateIndels;
         nonCandidateIndels += rhs.nonCandidateIndels;
+        germlineLocusRequests += rhs.germlineLocusRequests;
+        germlineLocusAllocations += rhs.germlineLocusAllocations;
+        germlineSiteLoci += rhs.germlineSiteLoci;
+        stageTimes.merge(rhs.stageTimes);
+        stageCounters.merge(rhs.stageCounters);
+        locusProfile.merge(rhs.locusProfile);
+        bufferPeaks.merge(rhs.bufferPeaks);
+        throttledReads += rhs.throttledReads;
+        throttledRegions += rhs.throttledRegions;
     }
 
     void
     report(std::ostream& os) const;
 
+    /// Version 0 is the format written by earlier releases, which has no class version information. Fields added
+    /// since then are only read from version 1 or later.
     template<class Archive>
-    void serialize(Archive& ar, const unsigned /* version */)
+    void serialize(Archive& ar, const unsigned version)
     {
         ar& BOOST_SERIALIZATION_NVP(lifeTime);
         ar& BOOST_SERIALIZATION_NVP(candidateIndels);
         ar& BOOST_SERIALIZATION_NVP(nonCandidateIndels);
+        if (version < 1) return;
+        ar& BOOST_SERIALIZATION_NVP(germlineLocusRequests);
+        ar& BOOST_SERIALIZATION_NVP(germlineLocusAllocations);
+        ar& BOOST_SERIALIZATION_NVP(germlineSiteLoci);
+        ar& BOOST_SERIALIZATION_NVP(stageTimes);
+        ar& BOOST_SERIALIZATION_NVP(stageCounters);
+        ar& BOOST_SERIALIZATION_NVP(locusProfile);
+        ar& BOOST_SERIALIZATION_NVP(bufferPeaks);
+        ar& BOOST_SERIALIZATION_NVP(throttledReads);
+        ar& BOOST_SERIALIZATION_NVP(throttledRegions);
     }
 
     /// Total wall-time of each (single-thread) process, summed together
@@ -66,9 +91,59 @@ struct RunStatsData
 
     /// Total indels failing to reach candidate status in the report range and (if defined) call regions
     unsigned long nonCandidateIndels = 0;
+
+    /// Total germline locus objects requested by the variant calling pipeline
+    unsigned long germlineLocusRequests = 0;
+
+    /// Total germline locus objects allocated from the heap, ie. requests which could not be met by recycling
+    unsigned long germlineLocusAllocations = 0;
+
+    /// Total germline site loci requested, this approximates the number of reported positions in gVCF mode
+    unsigned long germlineSiteLoci = 0;
+
+    /// Total exclusive time and call count of each timed variant calling stage
+    StageTimes stageTimes;
+
+    /// Total hardware counter values of each timed variant calling stage, if enabled and available
+    StageCounters stageCounters;
+
+    /// Expensive genome windows found by the locus profiler, if enabled
+    LocusProfileData locusProfile;
+
+    /// Highest estimated memory use of each major buffer, with the locus where it occurred, if enabled
+    BufferPeaks bufferPeaks;
+
+    /// Total input reads dropped to keep read buffering within the memory budget, if enabled
+    unsigned long throttledReads = 0;
+
+    /// Total contiguous regions where input reads were dropped to keep read buffering within the memory budget
+    unsigned long throttledRegions = 0;
+};
+
+BOOST_CLASS_VERSION(RunStatsData, 1)
+
+
+
+/// Adapts RunStatsData to the unversioned format written by earlier releases
+struct RunStatsDataVersion0
+{
+    explicit
+    RunStatsDataVersion0(RunStatsData& initData)
+        : data(initData)
+    {}
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        data.serialize(ar, 0);
+    }
+
+    RunStatsData& data;
 };
 
-BOOST_CLASS_IMPLEMENTATION(RunStatsData, boost::serialization::object_serializable)
+BOOST_CLASS_IMPLEMENTATION(RunStatsDataVersion0, boost::serialization::object_serializable)
+
+
 
 struct RunStats
 {
@@ -28,19 +28,37 @@
 
 RunStatsManager::
 RunStatsManager(
-    const std::string& outputFile)
+    const std::string& outputFile,
+    const bool isHardwareCounters)
     : _osPtr(nullptr)
 {
-    if (outputFile.empty()) return;
-    _osPtr = new std::ofstream(outputFile.c_str());
-    if (! *_osPtr)
+    if (! outputFile.empty())
     {
-        std::ostringstream oss;
-        oss << "Can't open output file: '" << outputFile << "'";
-        BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+        _osPtr = new std::ofstream(outputFile.c_str());
+        if (! *_osPtr)
+        {
+            std::ostringstream oss;
+            oss << "Can't open output file: '" << outputFile << "'";
+            BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+        }
+    }
+
+    // hardware counters silently fall back to timing only when these are not available:
+    if (isHardwareCounters)
+    {
+        _hardwareCountersPtr.reset(new HardwareCounters);
+        if (_hardwareCountersPtr->isAvailable())
+        {
+            _stageTimer.setHardwareCounters(_hardwareCountersPtr.get());
+        }
+        else
+        {
+            _hardwareCountersPtr.reset();
+        }
     }
 
     lifeTime.resume();
+    _lifeTimeStartTicks = getStageTimerTicks();
 }
 
 
@@ -51,8 +69,26 @@ RunStatsManager::
     if (_osPtr != nullptr)
     {
         lifeTime.stop();
+        const uint64_t lifeTimeTicks(getStageTimerTicks() - _lifeTimeStartTicks);
         runStats.runStatsData.lifeTime=lifeTime.getTimes();
+
+        const double lifeTimeWall(runStats.runStatsData.lifeTime.wall);
+        const double ticksPerSecond((lifeTimeWall > 0) ? (lifeTimeTicks / lifeTimeWall) : 0.);
+        _stageTimer.getStageTimes(ticksPerSecond, runStats.runStatsData.stageTimes);
+        _stageTimer.getStageCounters(runStats.runStatsData.stageCounters);
         runStats.save(*_osPtr);
         delete _osPtr;
     }
 }
+
+
+
+void
+RunStatsManager::
+merge(const RunStatsManager& rhs)
+{
+    _stageTimer.merge(rhs._stageTimer);
+
+    // stage times and counters are only set from the stage timer when stats are written:
+    runStats.runStatsData.merge(rhs.runStats.runStatsData);
+}
@@ -25,7 +25,9 @@
 #include "boost/utility.hpp"
 
 #include <iosfwd>
+#include <memory>
 #include <string>
+#include <vector>
 
 
 /// \brief Handles all messy real world interaction for the stats module, while the stats module itself just
@@ -33,9 +35,15 @@
 ///
 struct RunStatsManager : private boost::noncopyable
 {
+    /// \param[in] outputFile stats are written to this file on destruction, if empty no stats are written, but stats
+    ///            can still be merged into another manager
+    ///
+    /// \param[in] isHardwareCounters if true, attribute hardware performance counters to the timed stages where
+    ///            these are available
     explicit
     RunStatsManager(
-        const std::string& outputFile);
+        const std::string& outputFile,
+        const bool isHardwareCounters = false);
 
     ~RunStatsManager();
 
@@ -52,6 +60,70 @@ struct RunStatsManager : private boost::noncopyable
         }
     }
 
+    /// update germline locus allocation totals with the current value of each counter
+    void
+    setGermlineLocusStats(
+        const unsigned long locusRequests,
+        const unsigned long locusAllocations,
+        const unsigned long siteLoci)
+    {
+        auto& data(runStats.runStatsData);
+        data.germlineLocusRequests = locusRequests;
+        data.germlineLocusAllocations = locusAllocations;
+        data.germlineSiteLoci = siteLoci;
+    }
+
+    /// \param[in] chromOrder reference chromosome names in reference order
+    /// \param[in] minSeconds minimum processing time for a window to be reported
+    void
+    setLocusProfileOptions(
+        const std::vector<std::string>& chromOrder,
+        const double minSeconds)
+    {
+        auto& locusProfile(runStats.runStatsData.locusProfile);
+        locusProfile.chromOrder = chromOrder;
+        locusProfile.minSeconds = minSeconds;
+    }
+
+    void
+    addLocusProfileWindow(const LocusProfileWindow& window)
+    {
+        runStats.runStatsData.locusProfile.addWindow(window);
+    }
+
+    /// update the peak usage of buffer if usage exceeds it
+    ///
+    /// \param[in] pos zero-indexed position where usage was observed
+    void
+    updateBufferUsage(
+        const TRACKED_BUFFER::index_t buffer,
+        const BufferUsage& usage,
+        const std::string& chrom,
+        const pos_t pos)
+    {
+        runStats.runStatsData.bufferPeaks.buffers[buffer].update(usage, chrom, pos);
+    }
+
+    /// add one region where readCount input reads were dropped to stay within the memory budget
+    void
+    addThrottledRegion(const unsigned long readCount)
+    {
+        runStats.runStatsData.throttledReads += readCount;
+        runStats.runStatsData.throttledRegions++;
+    }
+
+    /// Add all stats accumulated by another manager, such as the manager of a worker thread
+    ///
+    /// The lifetime of this manager is still used as the run time.
+    void
+    merge(const RunStatsManager& rhs);
+
+    StageTimer&
+    getStageTimer()
+    {
+        return _stageTimer;
+    }
+
 private:
     std::ostream* _osPtr;
 
@@ -59,6 +131,14 @@ private:
     /// program lifetime when RunStatsManager is appropriately scoped
     TimeTracker lifeTime;
 
+    /// stage timer clock value at the start of lifeTime, used to calibrate the stage timer clock rate
+    uint64_t _lifeTimeStartTicks = 0;
+
+    /// optional stage timer hardware counters, null unless requested and available
+    std::unique_ptr<HardwareCounters> _hardwareCountersPtr;
+
+    StageTimer _stageTimer;
+
     /// runStats is the primary stats data store
     RunStats runStats;
 };
@@ -0,0 +1,496 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Low-overhead exclusive timers for the major variant calling stages
+///
+
+#pragma once
+
+#include "HardwareCounters.hh"
+
+#include "boost/serialization/nvp.hpp"
+#include "boost/utility.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+namespace TIMED_STAGE
+{
+
+/// Variant calling stages which are separately timed.
+///
+/// Note these are unrelated to the position processing stages of the stage_manager, several of the stages below
+/// can run from within a single stage_manager stage.
+enum index_t
+{
+    REALIGN,
+    PILEUP,
+    ACTIVE_REGION,
+    SNV_GENOTYPE,
+    INDEL_GENOTYPE,
+    EVS_SCORING,
+    VARIANT_OUTPUT,
+    SIZE
+};
+
+/// Labels are used as xml element names in RunStats, so these must not contain spaces
+inline
+const char*
+label(const index_t i)
+{
+    switch (i)
+    {
+    case REALIGN:
+        return "realign";
+    case PILEUP:
+        return "pileup";
+    case ACTIVE_REGION:
+        return "activeRegion";
+    case SNV_GENOTYPE:
+        return "snvGenotype";
+    case INDEL_GENOTYPE:
+        return "indelGenotype";
+    case EVS_SCORING:
+        return "evsScoring";
+    case VARIANT_OUTPUT:
+        return "variantOutput";
+    default:
+        assert(false && "Unknown timed stage");
+        return nullptr;
+    }
+}
+}
+
+
+
+/// \brief Read the stage timer clock
+///
+/// This is the time-stamp counter where available, otherwise a monotonic nanosecond clock. Tick values are only
+/// meaningful as differences, and are converted to seconds by calibration against wall time over the process
+/// lifetime (see RunStatsManager).
+inline
+uint64_t
+getStageTimerTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+
+/// \brief Estimates the stage timer clock rate from the wall time elapsed since construction
+///
+/// This is for clients which need to convert ticks to seconds before the lifetime calibration in RunStatsManager
+/// is available.
+struct StageTimerClockCalibration
+{
+    StageTimerClockCalibration()
+        : _startTicks(getStageTimerTicks()),
+          _startTime(std::chrono::steady_clock::now())
+    {}
+
+    /// \return stage timer ticks per second, or zero if no wall time has elapsed
+    double
+    getTicksPerSecond() const
+    {
+        const uint64_t ticks(getStageTimerTicks() - _startTicks);
+        const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count());
+        return ((seconds > 0) ? (ticks / seconds) : 0.);
+    }
+
+private:
+    uint64_t _startTicks;
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+
+
+/// Total time and number of timed calls for one stage
+struct StageTimeData
+{
+    void
+    merge(const StageTimeData& rhs)
+    {
+        seconds += rhs.seconds;
+        calls += rhs.calls;
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        ar& BOOST_SERIALIZATION_NVP(seconds);
+        ar& BOOST_SERIALIZATION_NVP(calls);
+    }
+
+    double seconds = 0;
+    unsigned long calls = 0;
+};
+
+BOOST_CLASS_IMPLEMENTATION(StageTimeData, boost::serialization::object_serializable)
+
+
+
+/// Time and call count totals for all stages
+struct StageTimes
+{
+    void
+    merge(const StageTimes& rhs)
+    {
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            stages[stageIndex].merge(rhs.stages[stageIndex]);
+        }
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            const auto stage(static_cast<TIMED_STAGE::index_t>(stageIndex));
+            ar& boost::serialization::make_nvp(TIMED_STAGE::label(stage), stages[stageIndex]);
+        }
+    }
+
+    std::array<StageTimeData,TIMED_STAGE::SIZE> stages;
+};
+
+BOOST_CLASS_IMPLEMENTATION(StageTimes, boost::serialization::object_serializable)
+
+
+
+/// Hardware counter totals for one timed stage
+struct StageCounterData
+{
+    StageCounterData()
+    {
+        counts.fill(0);
+    }
+
+    void
+    merge(const StageCounterData& rhs)
+    {
+        for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+        {
+            counts[counterIndex] += rhs.counts[counterIndex];
+        }
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+        {
+            const auto counter(static_cast<HW_COUNTER::index_t>(counterIndex));
+            ar& boost::serialization::make_nvp(HW_COUNTER::label(counter), counts[counterIndex]);
+        }
+    }
+
+    HardwareCounterValues counts;
+};
+
+BOOST_CLASS_IMPLEMENTATION(StageCounterData, boost::serialization::object_serializable)
+
+
+
+/// Hardware counter totals for all stages
+struct StageCounters
+{
+    StageCounters()
+    {
+        isAvailable.fill(false);
+    }
+
+    bool
+    empty() const
+    {
+        for (const bool isCounterAvailable : isAvailable)
+        {
+            if (isCounterAvailable) return false;
+        }
+        return true;
+    }
+
+    /// Merge counter totals, a counter is treated as available if it was available in either run
+    void
+    merge(const StageCounters& rhs)
+    {
+        for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+        {
+            isAvailable[counterIndex] = (isAvailable[counterIndex] or rhs.isAvailable[counterIndex]);
+        }
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            stages[stageIndex].merge(rhs.stages[stageIndex]);
+        }
+        timeEnabled += rhs.timeEnabled;
+        timeRunning += rhs.timeRunning;
+    }
+
+    /// \return fraction of the enabled time that the counters were running, this is less than one when counters
+    /// were multiplexed with other perf_event users, and zero if the counters were never scheduled
+    double
+    getRunningFraction() const
+    {
+        return ((timeEnabled > 0) ? (static_cast<double>(timeRunning) / timeEnabled) : 0.);
+    }
+
+    template<class Archive>
+    void serialize(Archive& ar, const unsigned /* version */)
+    {
+        for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+        {
+            const auto counter(static_cast<HW_COUNTER::index_t>(counterIndex));
+            bool isCounterAvailable(isAvailable[counterIndex]);
+            ar& boost::serialization::make_nvp(HW_COUNTER::availableLabel(counter), isCounterAvailable);
+            isAvailable[counterIndex] = isCounterAvailable;
+        }
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            const auto stage(static_cast<TIMED_STAGE::index_t>(stageIndex));
+            ar& boost::serialization::make_nvp(TIMED_STAGE::label(stage), stages[stageIndex]);
+        }
+        ar& BOOST_SERIALIZATION_NVP(timeEnabled);
+        ar& BOOST_SERIALIZATION_NVP(timeRunning);
+    }
+
+    /// true for each counter which was available for at least one run
+    std::array<bool,HW_COUNTER::SIZE> isAvailable;
+
+    /// Counter totals of each stage, scaled for the fraction of time each run's counters were running
+    std::array<StageCounterData,TIMED_STAGE::SIZE> stages;
+
+    /// Total nanoseconds that counters were enabled, and the part of this time that counters were running
+    uint64_t timeEnabled = 0;
+    uint64_t timeRunning = 0;
+};
+
+BOOST_CLASS_IMPLEMENTATION(StageCounters, boost::serialization::object_serializable)
+
+
+
+/// \brief Accumulates exclusive clock ticks for each stage
+///
+/// Stages may nest: time spent in an inner stage is attributed only to the inner stage, and the outer stage
+/// resumes when the inner stage exits. Time outside of all stages is not attributed. This makes the stage
+/// totals additive, so that the sum over stages never exceeds the total run time.
+///
+/// Hardware counters can optionally be attributed to stages in the same way.
+///
+struct StageTimer : private boost::noncopyable
+{
+    StageTimer()
+    {
+        _ticks.fill(0);
+        _calls.fill(0);
+        _lastCounts.fill(0);
+        for (auto& stageCounts : _counts)
+        {
+            stageCounts.fill(0);
+        }
+    }
+
+    /// Attribute hardware counter values to stages in addition to clock ticks
+    ///
+    /// \param[in] countersPtr counters read at each stage transition, these must outlive the timer
+    void
+    setHardwareCounters(const HardwareCounters* countersPtr)
+    {
+        _countersPtr = countersPtr;
+        if (nullptr != _countersPtr) _countersPtr->read(_lastCounts);
+    }
+
+    /// Begin timing stage, and return the stage which was previously running
+    ///
+    /// Stages are normally entered through StageTimeScoper
+    unsigned
+    enter(const TIMED_STAGE::index_t stage)
+    {
+        const unsigned previousStage(_currentStage);
+        transition(stage);
+        _calls[stage]++;
+        return previousStage;
+    }
+
+    /// Finish timing the current stage and resume previousStage
+    void
+    exit(const unsigned previousStage)
+    {
+        transition(previousStage);
+    }
+
+    uint64_t
+    getTicks(const TIMED_STAGE::index_t stage) const
+    {
+        return _ticks[stage];
+    }
+
+    unsigned long
+    getCalls(const TIMED_STAGE::index_t stage) const
+    {
+        return _calls[stage];
+    }
+
+    /// Add all stage totals from another timer, such as the timer of a worker thread
+    ///
+    /// Stage totals merged from concurrent threads are summed, so these are no longer bounded by the run time.
+    /// Hardware counter totals are scaled with the other timer's counter running time when they are merged.
+    void
+    merge(const StageTimer& rhs)
+    {
+        for (unsigned stageIndex(0); stageIndex<=TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            _ticks[stageIndex] += rhs._ticks[stageIndex];
+        }
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            _calls[stageIndex] += rhs._calls[stageIndex];
+        }
+
+        StageCounters rhsStageCounters;
+        rhs.getStageCounters(rhsStageCounters);
+        _mergedStageCounters.merge(rhsStageCounters);
+    }
+
+    /// Convert all stage totals to seconds
+    ///
+    /// \param[in] ticksPerSecond stage timer clock rate
+    void
+    getStageTimes(
+        const double ticksPerSecond,
+        StageTimes& stageTimes) const
+    {
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            StageTimeData& stageData(stageTimes.stages[stageIndex]);
+            stageData.seconds = ((ticksPerSecond > 0) ? (_ticks[stageIndex] / ticksPerSecond) : 0.);
+            stageData.calls = _calls[stageIndex];
+        }
+    }
+
+    /// Get hardware counter totals for all stages, including totals merged from other timers
+    ///
+    /// Counts are scaled up for the fraction of the enabled time that the counters were running. If hardware
+    /// counters are not set and no counters have been merged, all counters are unavailable.
+    void
+    getStageCounters(StageCounters& stageCounters) const
+    {
+        stageCounters = _mergedStageCounters;
+        if (nullptr == _countersPtr) return;
+
+        StageCounters ownStageCounters;
+        for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+        {
+            const auto counter(static_cast<HW_COUNTER::index_t>(counterIndex));
+            ownStageCounters.isAvailable[counterIndex] = _countersPtr->isCounterAvailable(counter);
+        }
+
+        uint64_t timeEnabled(0);
+        uint64_t timeRunning(0);
+        if (_countersPtr->readTimes(timeEnabled, timeRunning))
+        {
+            ownStageCounters.timeEnabled = timeEnabled;
+            ownStageCounters.timeRunning = timeRunning;
+        }
+
+        for (unsigned stageIndex(0); stageIndex<TIMED_STAGE::SIZE; ++stageIndex)
+        {
+            HardwareCounterValues& stageCounts(ownStageCounters.stages[stageIndex].counts);
+            for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+            {
+                stageCounts[counterIndex] = scaleHardwareCount(_counts[stageIndex][counterIndex], timeEnabled,
+                                                               timeRunning);
+            }
+        }
+        stageCounters.merge(ownStageCounters);
+    }
+
+private:
+    void
+    transition(const unsigned nextStage)
+    {
+        const uint64_t ticks(getStageTimerTicks());
+        _ticks[_currentStage] += (ticks - _lastTicks);
+        _lastTicks = ticks;
+
+        if (nullptr != _countersPtr)
+        {
+            HardwareCounterValues counts(_lastCounts);
+            _countersPtr->read(counts);
+            HardwareCounterValues& stageCounts(_counts[_currentStage]);
+            for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+            {
+                stageCounts[counterIndex] += (counts[counterIndex] - _lastCounts[counterIndex]);
+            }
+            _lastCounts = counts;
+        }
+
+        _currentStage = nextStage;
+    }
+
+    /// index SIZE is used to accumulate time outside of all stages
+    static const unsigned noStage = TIMED_STAGE::SIZE;
+
+    unsigned _currentStage = noStage;
+    uint64_t _lastTicks = 0;
+    std::array<uint64_t,TIMED_STAGE::SIZE+1> _ticks;
+    std::array<unsigned long,TIMED_STAGE::SIZE> _calls;
+
+    /// optional hardware counters, null unless counters are enabled and available
+    const HardwareCounters* _countersPtr = nullptr;
+    HardwareCounterValues _lastCounts;
+    std::array<HardwareCounterValues,TIMED_STAGE::SIZE+1> _counts;
+
+    /// scaled hardware counter totals merged from other timers
+    StageCounters _mergedStageCounters;
+};
+
+
+
+/// Time a stage for the lifetime of this object
+struct StageTimeScoper : private boost::noncopyable
+{
+    StageTimeScoper(
+        StageTimer& timer,
+        const TIMED_STAGE::index_t stage)
+        : _timer(timer),
+          _previousStage(timer.enter(stage))
+    {}
+
+    ~StageTimeScoper()
+    {
+        _timer.exit(_previousStage);
+    }
+
+private:
+    StageTimer& _timer;
+    const unsigned _previousStage;
+};
@@ -0,0 +1,106 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "appstats/BufferUsage.hh"
+
+
+BOOST_AUTO_TEST_SUITE( BufferUsage_test )
+
+
+static
+BufferUsage
+getUsage(
+    const uint64_t items,
+    const uint64_t bytes)
+{
+    BufferUsage usage;
+    usage.items = items;
+    usage.entries = items*2;
+    usage.bytes = bytes;
+    return usage;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_BufferPeakData_update )
+{
+    BufferPeakData peakData;
+    BOOST_REQUIRE(peakData.empty());
+
+    // empty usage does not set a peak:
+    peakData.update(BufferUsage(), "chr1", 10);
+    BOOST_REQUIRE(peakData.empty());
+    BOOST_REQUIRE_EQUAL(peakData.peakPos, -1);
+
+    peakData.update(getUsage(5, 100), "chr1", 20);
+    BOOST_REQUIRE(not peakData.empty());
+    BOOST_REQUIRE_EQUAL(peakData.peak.items, 5u);
+    BOOST_REQUIRE_EQUAL(peakData.peak.entries, 10u);
+    BOOST_REQUIRE_EQUAL(peakData.peakChrom, "chr1");
+    BOOST_REQUIRE_EQUAL(peakData.peakPos, 20);
+
+    // peaks are ranked by bytes only, and the first locus reaching the peak is kept:
+    peakData.update(getUsage(50, 90), "chr1", 30);
+    peakData.update(getUsage(6, 100), "chr1", 40);
+    BOOST_REQUIRE_EQUAL(peakData.peak.items, 5u);
+    BOOST_REQUIRE_EQUAL(peakData.peakPos, 20);
+
+    peakData.update(getUsage(7, 200), "chr2", 5);
+    BOOST_REQUIRE_EQUAL(peakData.peak.items, 7u);
+    BOOST_REQUIRE_EQUAL(peakData.peak.bytes, 200u);
+    BOOST_REQUIRE_EQUAL(peakData.peakChrom, "chr2");
+    BOOST_REQUIRE_EQUAL(peakData.peakPos, 5);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_BufferPeaks_merge )
+{
+    BufferPeaks peaks1;
+    peaks1.buffers[TRACKED_BUFFER::READ].update(getUsage(10, 1000), "chr1", 100);
+    peaks1.buffers[TRACKED_BUFFER::INDEL].update(getUsage(2, 50), "chr1", 200);
+
+    BufferPeaks peaks2;
+    peaks2.buffers[TRACKED_BUFFER::READ].update(getUsage(20, 2000), "chr2", 300);
+    peaks2.buffers[TRACKED_BUFFER::INDEL].update(getUsage(1, 40), "chr2", 400);
+    peaks2.buffers[TRACKED_BUFFER::BASECALL].update(getUsage(3, 30), "chr2", 500);
+
+    peaks1.merge(peaks2);
+
+    // each buffer keeps the larger peak of either run, with its locus:
+    const BufferPeakData& readPeak(peaks1.buffers[TRACKED_BUFFER::READ]);
+    BOOST_REQUIRE_EQUAL(readPeak.peak.bytes, 2000u);
+    BOOST_REQUIRE_EQUAL(readPeak.peakChrom, "chr2");
+    BOOST_REQUIRE_EQUAL(readPeak.peakPos, 300);
+
+    const BufferPeakData& indelPeak(peaks1.buffers[TRACKED_BUFFER::INDEL]);
+    BOOST_REQUIRE_EQUAL(indelPeak.peak.bytes, 50u);
+    BOOST_REQUIRE_EQUAL(indelPeak.peakChrom, "chr1");
+    BOOST_REQUIRE_EQUAL(indelPeak.peakPos, 200);
+
+    const BufferPeakData& basecallPeak(peaks1.buffers[TRACKED_BUFFER::BASECALL]);
+    BOOST_REQUIRE_EQUAL(basecallPeak.peak.items, 3u);
+    BOOST_REQUIRE_EQUAL(basecallPeak.peakPos, 500);
+
+    BOOST_REQUIRE(peaks1.buffers[TRACKED_BUFFER::CANDIDATE_SNV].empty());
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "appstats/HardwareCounters.hh"
+#include "appstats/RunStats.hh"
+
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( HardwareCounters_test )
+
+
+BOOST_AUTO_TEST_CASE( test_scaleHardwareCount )
+{
+    // counters running for the whole enabled time are not scaled:
+    BOOST_REQUIRE_EQUAL(scaleHardwareCount(1000, 50, 50), 1000u);
+
+    // multiplexed counters are scaled up to the enabled time:
+    BOOST_REQUIRE_EQUAL(scaleHardwareCount(1000, 100, 50), 2000u);
+    BOOST_REQUIRE_EQUAL(scaleHardwareCount(1000, 300, 200), 1500u);
+
+    // counters which were never scheduled have no count to scale:
+    BOOST_REQUIRE_EQUAL(scaleHardwareCount(0, 100, 0), 0u);
+    BOOST_REQUIRE_EQUAL(scaleHardwareCount(0, 0, 0), 0u);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_HardwareCounters_read )
+{
+    // counters are only available on some systems, so check either case:
+    HardwareCounters counters;
+
+    HardwareCounterValues values;
+    values.fill(7);
+    uint64_t timeEnabled(3);
+    uint64_t timeRunning(5);
+    if (not counters.isAvailable())
+    {
+        counters.read(values);
+        for (const auto value : values)
+        {
+            BOOST_REQUIRE_EQUAL(value, 7u);
+        }
+        BOOST_REQUIRE(not counters.readTimes(timeEnabled, timeRunning));
+        BOOST_REQUIRE_EQUAL(timeEnabled, 3u);
+        BOOST_REQUIRE_EQUAL(timeRunning, 5u);
+        return;
+    }
+
+    counters.read(values);
+    double sum(0);
+    for (unsigned i(0); i<100000; ++i)
+    {
+        sum += (i*0.5);
+    }
+    BOOST_REQUIRE(sum > 0);
+
+    HardwareCounterValues values2(values);
+    counters.read(values2);
+    for (unsigned counterIndex(0); counterIndex<HW_COUNTER::SIZE; ++counterIndex)
+    {
+        const auto counter(static_cast<HW_COUNTER::index_t>(counterIndex));
+        if (not counters.isCounterAvailable(counter))
+        {
+            BOOST_REQUIRE_EQUAL(values2[counterIndex], 0u);
+            continue;
+        }
+        BOOST_REQUIRE_GE(values2[counterIndex], values[counterIndex]);
+    }
+
+    BOOST_REQUIRE(counters.readTimes(timeEnabled, timeRunning));
+    BOOST_REQUIRE_LE(timeRunning, timeEnabled);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_StageTimer_noCounters )
+{
+    StageTimer timer;
+    StageCounters stageCounters;
+    timer.getStageCounters(stageCounters);
+    BOOST_REQUIRE(stageCounters.empty());
+}
+
+
+
+/// \return stage counters from one run with cycle and instruction counts in the pileup stage
+static
+StageCounters
+getStageCounters(
+    const uint64_t cycles,
+    const uint64_t timeEnabled,
+    const uint64_t timeRunning)
+{
+    StageCounters stageCounters;
+    stageCounters.isAvailable[HW_COUNTER::CYCLES] = true;
+    stageCounters.isAvailable[HW_COUNTER::INSTRUCTIONS] = true;
+    stageCounters.stages[TIMED_STAGE::PILEUP].counts[HW_COUNTER::CYCLES] = cycles;
+    stageCounters.stages[TIMED_STAGE::PILEUP].counts[HW_COUNTER::INSTRUCTIONS] = cycles*2;
+    stageCounters.timeEnabled = timeEnabled;
+    stageCounters.timeRunning = timeRunning;
+    return stageCounters;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_StageCounters_merge )
+{
+    StageCounters stageCounters(getStageCounters(100, 1000, 1000));
+    stageCounters.merge(getStageCounters(300, 1000, 500));
+
+    BOOST_REQUIRE_EQUAL(stageCounters.stages[TIMED_STAGE::PILEUP].counts[HW_COUNTER::CYCLES], 400u);
+    BOOST_REQUIRE_EQUAL(stageCounters.timeEnabled, 2000u);
+    BOOST_REQUIRE_EQUAL(stageCounters.timeRunning, 1500u);
+    BOOST_REQUIRE_EQUAL(stageCounters.getRunningFraction(), 0.75);
+    BOOST_REQUIRE(not stageCounters.isAvailable[HW_COUNTER::LLC_MISSES]);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_StageCounters_report )
+{
+    {
+        RunStatsData data;
+        data.stageCounters = getStageCounters(100, 1000, 500);
+        std::ostringstream oss;
+        data.report(oss);
+        const std::string report(oss.str());
+        BOOST_REQUIRE(report.find("StageCounterRunningFraction\t0.5\n") != std::string::npos);
+        BOOST_REQUIRE(report.find("StageCounter_pileup_cycles\t100\n") != std::string::npos);
+        BOOST_REQUIRE(report.find("StageIPC_pileup\t2\n") != std::string::npos);
+        BOOST_REQUIRE(report.find("notScheduled") == std::string::npos);
+    }
+
+    // counters which were never scheduled are flagged instead of reporting zero counts:
+    {
+        RunStatsData data;
+        data.stageCounters = getStageCounters(0, 1000, 0);
+        std::ostringstream oss;
+        data.report(oss);
+        const std::string report(oss.str());
+        BOOST_REQUIRE(report.find("StageCounterStatus\tnotScheduled\n") != std::string::npos);
+        BOOST_REQUIRE(report.find("StageCounter_") == std::string::npos);
+        BOOST_REQUIRE(report.find("StageIPC_") == std::string::npos);
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
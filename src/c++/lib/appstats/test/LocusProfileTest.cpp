@@ -0,0 +1,126 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "appstats/LocusProfile.hh"
+
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( LocusProfile_test )
+
+
+static
+LocusProfileWindow
+getWindow(
+    const std::string& chrom,
+    const pos_t beginPos,
+    const double seconds,
+    const unsigned long realignedReads = 0)
+{
+    LocusProfileWindow window;
+    window.chrom = chrom;
+    window.beginPos = beginPos;
+    window.endPos = beginPos + 100;
+    window.seconds = seconds;
+    window.realignedReads = realignedReads;
+    return window;
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_LocusProfileData_addWindow )
+{
+    LocusProfileData data;
+    data.addWindow(getWindow("chr1", 100, 1, 2));
+    data.addWindow(getWindow("chr2", 100, 1, 2));
+    data.addWindow(getWindow("chr1", 0, 1, 2));
+    data.addWindow(getWindow("chr1", 100, 0.5, 3));
+
+    BOOST_REQUIRE_EQUAL(data.windows.size(), 3u);
+    const LocusProfileWindow& window(data.windows.at(LocusProfileData::window_key_t("chr1", 100)));
+    BOOST_REQUIRE_EQUAL(window.seconds, 1.5);
+    BOOST_REQUIRE_EQUAL(window.realignedReads, 5u);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_LocusProfileData_mergeThreshold )
+{
+    // one window is split between two segments, and is only reported when the segments are merged:
+    LocusProfileData segment1;
+    segment1.chromOrder = { "chr1", "chr2" };
+    segment1.minSeconds = 1;
+    segment1.addWindow(getWindow("chr1", 0, 2));
+    segment1.addWindow(getWindow("chr1", 100, 0.6));
+
+    LocusProfileData segment2;
+    segment2.chromOrder = segment1.chromOrder;
+    segment2.minSeconds = segment1.minSeconds;
+    segment2.addWindow(getWindow("chr1", 100, 0.6));
+    segment2.addWindow(getWindow("chr2", 0, 0.2));
+
+    BOOST_REQUIRE_EQUAL(segment1.getReportedWindows().size(), 1u);
+    BOOST_REQUIRE_EQUAL(segment2.getReportedWindows().size(), 0u);
+
+    LocusProfileData merged;
+    merged.merge(segment1);
+    merged.merge(segment2);
+    BOOST_REQUIRE_EQUAL(merged.minSeconds, 1.);
+    BOOST_REQUIRE_EQUAL(merged.windows.size(), 3u);
+
+    const auto reportedWindows(merged.getReportedWindows());
+    BOOST_REQUIRE_EQUAL(reportedWindows.size(), 2u);
+    BOOST_REQUIRE_EQUAL(reportedWindows[0]->beginPos, 0);
+    BOOST_REQUIRE_EQUAL(reportedWindows[1]->beginPos, 100);
+    BOOST_REQUIRE_CLOSE(reportedWindows[1]->seconds, 1.2, 0.0001);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_LocusProfileData_writeBed )
+{
+    LocusProfileData data;
+    data.chromOrder = { "chr2", "chr10", "chr1" };
+    data.addWindow(getWindow("chr1", 100, 1));
+    data.addWindow(getWindow("chrUn", 0, 1));
+    data.addWindow(getWindow("chr10", 0, 1));
+    data.addWindow(getWindow("chr1", 0, 1));
+    data.addWindow(getWindow("chr2", 200, 1));
+    data.addWindow(getWindow("chr2", 0, 1));
+    data.addWindow(getWindow("chrM", 0, 1));
+
+    std::ostringstream oss;
+    data.writeBed(oss);
+
+    // windows are written in reference chromosome order, followed by any unknown chromosomes in name order:
+    std::ostringstream expected;
+    LocusProfileWindow::writeBedHeader(expected);
+    expected << "chr2\t0\t100\t1\t0\t0\t0\n"
+             << "chr2\t200\t300\t1\t0\t0\t0\n"
+             << "chr10\t0\t100\t1\t0\t0\t0\n"
+             << "chr1\t0\t100\t1\t0\t0\t0\n"
+             << "chr1\t100\t200\t1\t0\t0\t0\n"
+             << "chrM\t0\t100\t1\t0\t0\t0\n"
+             << "chrUn\t0\t100\t1\t0\t0\t0\n";
+    BOOST_REQUIRE_EQUAL(oss.str(), expected.str());
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
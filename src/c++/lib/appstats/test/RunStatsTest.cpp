@@ -0,0 +1,155 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "appstats/RunStats.hh"
+#include "test/TempPath.hh"
+
+#include <fstream>
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( RunStats_test )
+
+
+BOOST_AUTO_TEST_CASE( test_RunStats_roundtrip )
+{
+    const TempFile statsFile("runStats-%%%%-%%%%.xml");
+
+    RunStats stats;
+    stats.runStatsData.candidateIndels = 3;
+    stats.runStatsData.germlineLocusRequests = 10;
+    stats.runStatsData.stageTimes.stages[TIMED_STAGE::PILEUP].calls = 4;
+    stats.runStatsData.throttledRegions = 2;
+    stats.runStatsData.locusProfile.chromOrder = { "chr2", "chr1" };
+    stats.runStatsData.locusProfile.minSeconds = 0.5;
+    LocusProfileWindow window;
+    window.chrom = "chr1";
+    window.beginPos = 1000;
+    window.endPos = 2000;
+    window.seconds = 0.25;
+    stats.runStatsData.locusProfile.addWindow(window);
+    stats.save(statsFile.name().c_str());
+
+    RunStats loadedStats;
+    loadedStats.load(statsFile.name().c_str());
+    const RunStatsData& data(loadedStats.runStatsData);
+    BOOST_REQUIRE_EQUAL(data.candidateIndels, 3u);
+    BOOST_REQUIRE_EQUAL(data.germlineLocusRequests, 10u);
+    BOOST_REQUIRE_EQUAL(data.stageTimes.stages[TIMED_STAGE::PILEUP].calls, 4u);
+    BOOST_REQUIRE_EQUAL(data.throttledRegions, 2u);
+    BOOST_REQUIRE_EQUAL(data.locusProfile.chromOrder.size(), 2u);
+    BOOST_REQUIRE_EQUAL(data.locusProfile.minSeconds, 0.5);
+    BOOST_REQUIRE_EQUAL(data.locusProfile.windows.size(), 1u);
+    const LocusProfileWindow& loadedWindow(data.locusProfile.windows.begin()->second);
+    BOOST_REQUIRE_EQUAL(loadedWindow.chrom, "chr1");
+    BOOST_REQUIRE_EQUAL(loadedWindow.endPos, 2000);
+    BOOST_REQUIRE_EQUAL(loadedWindow.seconds, 0.25);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_RunStats_merge )
+{
+    RunStatsData data1;
+    data1.lifeTime.wall = 2;
+    data1.candidateIndels = 3;
+    data1.nonCandidateIndels = 4;
+    data1.germlineLocusRequests = 5;
+    data1.germlineLocusAllocations = 6;
+    data1.germlineSiteLoci = 7;
+    data1.stageTimes.stages[TIMED_STAGE::PILEUP].seconds = 1.5;
+    data1.stageTimes.stages[TIMED_STAGE::PILEUP].calls = 8;
+    data1.bufferPeaks.buffers[TRACKED_BUFFER::READ].peak.bytes = 100;
+    data1.bufferPeaks.buffers[TRACKED_BUFFER::READ].peakPos = 10;
+    data1.throttledReads = 9;
+    data1.throttledRegions = 1;
+
+    RunStatsData data2;
+    data2.lifeTime.wall = 3;
+    data2.candidateIndels = 30;
+    data2.nonCandidateIndels = 40;
+    data2.germlineLocusRequests = 50;
+    data2.germlineLocusAllocations = 60;
+    data2.germlineSiteLoci = 70;
+    data2.stageTimes.stages[TIMED_STAGE::PILEUP].seconds = 0.5;
+    data2.stageTimes.stages[TIMED_STAGE::PILEUP].calls = 80;
+    data2.bufferPeaks.buffers[TRACKED_BUFFER::READ].peak.bytes = 200;
+    data2.bufferPeaks.buffers[TRACKED_BUFFER::READ].peakPos = 20;
+    data2.throttledReads = 90;
+    data2.throttledRegions = 2;
+
+    // totals are summed, and peaks take the larger value:
+    data1.merge(data2);
+    BOOST_REQUIRE_EQUAL(data1.lifeTime.wall, 5.);
+    BOOST_REQUIRE_EQUAL(data1.candidateIndels, 33u);
+    BOOST_REQUIRE_EQUAL(data1.nonCandidateIndels, 44u);
+    BOOST_REQUIRE_EQUAL(data1.germlineLocusRequests, 55u);
+    BOOST_REQUIRE_EQUAL(data1.germlineLocusAllocations, 66u);
+    BOOST_REQUIRE_EQUAL(data1.germlineSiteLoci, 77u);
+    BOOST_REQUIRE_EQUAL(data1.stageTimes.stages[TIMED_STAGE::PILEUP].seconds, 2.);
+    BOOST_REQUIRE_EQUAL(data1.stageTimes.stages[TIMED_STAGE::PILEUP].calls, 88u);
+    BOOST_REQUIRE_EQUAL(data1.bufferPeaks.buffers[TRACKED_BUFFER::READ].peak.bytes, 200u);
+    BOOST_REQUIRE_EQUAL(data1.bufferPeaks.buffers[TRACKED_BUFFER::READ].peakPos, 20);
+    BOOST_REQUIRE_EQUAL(data1.throttledReads, 99u);
+    BOOST_REQUIRE_EQUAL(data1.throttledRegions, 3u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_RunStats_loadVersion0 )
+{
+    const TempFile statsFile("runStats-%%%%-%%%%.xml");
+
+    // stats file in the unversioned format written by earlier releases:
+    {
+        std::ofstream ofs(statsFile.name());
+        ofs << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>\n"
+            << "<!DOCTYPE boost_serialization>\n"
+            << "<boost_serialization signature=\"serialization::archive\" version=\"12\">\n"
+            << "<runStatsData>\n"
+            << "\t<lifeTime>\n"
+            << "\t\t<wall>7.5</wall>\n"
+            << "\t\t<user>6.25</user>\n"
+            << "\t\t<system>0.5</system>\n"
+            << "\t</lifeTime>\n"
+            << "\t<candidateIndels>12</candidateIndels>\n"
+            << "\t<nonCandidateIndels>34</nonCandidateIndels>\n"
+            << "</runStatsData>\n"
+            << "</boost_serialization>\n";
+    }
+
+    RunStats stats;
+    stats.load(statsFile.name().c_str());
+    const RunStatsData& data(stats.runStatsData);
+    BOOST_REQUIRE_EQUAL(data.lifeTime.wall, 7.5);
+    BOOST_REQUIRE_EQUAL(data.candidateIndels, 12u);
+    BOOST_REQUIRE_EQUAL(data.nonCandidateIndels, 34u);
+    BOOST_REQUIRE_EQUAL(data.germlineLocusRequests, 0u);
+    BOOST_REQUIRE(data.locusProfile.windows.empty());
+
+    // earlier release stats merge with the current format:
+    RunStats mergedStats;
+    mergedStats.runStatsData.candidateIndels = 1;
+    mergedStats.runStatsData.germlineLocusRequests = 5;
+    mergedStats.merge(stats);
+    BOOST_REQUIRE_EQUAL(mergedStats.runStatsData.candidateIndels, 13u);
+    BOOST_REQUIRE_EQUAL(mergedStats.runStatsData.germlineLocusRequests, 5u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
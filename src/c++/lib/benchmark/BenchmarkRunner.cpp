@@ -0,0 +1,181 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Minimal harness to time small kernels and report results as JSON
+///
+
+#include "BenchmarkRunner.hh"
+
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+
+
+static volatile double benchmarkSink(0);
+
+
+
+/// FNV-1a hash of the benchmark name, used to derive a per-benchmark seed
+static
+uint32_t
+getNameHash(const std::string& name)
+{
+    uint32_t hash(2166136261u);
+    for (const char c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+
+
+void
+BenchmarkRunner::
+add(
+    const char* name,
+    const setup_t& setup)
+{
+    _benchmarks.emplace_back(name, setup);
+}
+
+
+
+void
+BenchmarkRunner::
+list(std::ostream& os) const
+{
+    for (const auto& benchmark : _benchmarks)
+    {
+        os << benchmark.first << "\n";
+    }
+}
+
+
+
+void
+BenchmarkRunner::
+runBenchmark(
+    const std::string& name,
+    const setup_t& setup,
+    BenchmarkResult& result) const
+{
+    typedef std::chrono::steady_clock BenchmarkClock;
+
+    BenchmarkRandom randomSource(_opt.seed ^ getNameHash(name));
+    const BenchmarkKernel kernel(setup(randomSource));
+    const unsigned inputCount(std::max(kernel.inputCount, 1u));
+
+    result.name = name;
+
+    // a single pass over all inputs provides the checksum and warms up the kernel:
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        result.checksum += kernel.run(inputIndex);
+    }
+
+    // each sample runs complete passes over the input until the sample duration is reached:
+    const unsigned sampleCount(std::max(_opt.sampleCount, 1u));
+    const double sampleSeconds(_opt.minSeconds / sampleCount);
+    std::vector<double> sampleNsPerOp;
+    double sink(0);
+    for (unsigned sampleIndex(0); sampleIndex < sampleCount; ++sampleIndex)
+    {
+        uint64_t iterations(0);
+        double elapsedSeconds(0);
+        const BenchmarkClock::time_point startTime(BenchmarkClock::now());
+        do
+        {
+            for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+            {
+                sink += kernel.run(inputIndex);
+            }
+            iterations += inputCount;
+            elapsedSeconds = std::chrono::duration<double>(BenchmarkClock::now() - startTime).count();
+        }
+        while (elapsedSeconds < sampleSeconds);
+
+        sampleNsPerOp.push_back((elapsedSeconds * 1e9) / iterations);
+        result.iterations += iterations;
+    }
+
+    // store the timed kernel results so that they can't be optimized away:
+    benchmarkSink = sink;
+
+    std::sort(sampleNsPerOp.begin(), sampleNsPerOp.end());
+    result.nsPerOp = sampleNsPerOp[sampleNsPerOp.size()/2];
+    result.minNsPerOp = sampleNsPerOp.front();
+}
+
+
+
+void
+BenchmarkRunner::
+run(
+    const char* version,
+    std::ostream& jsonOs,
+    std::ostream& logOs) const
+{
+    rapidjson::StringBuffer stringBuffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+
+    writer.StartObject();
+    writer.String("version");
+    writer.String(version);
+    writer.String("seed");
+    writer.Uint(_opt.seed);
+    writer.String("minSeconds");
+    writer.Double(_opt.minSeconds);
+    writer.String("sampleCount");
+    writer.Uint(_opt.sampleCount);
+    writer.String("benchmarks");
+    writer.StartArray();
+    for (const auto& benchmark : _benchmarks)
+    {
+        const std::string& name(benchmark.first);
+        if (name.find(_opt.filter) == std::string::npos) continue;
+
+        BenchmarkResult result;
+        runBenchmark(name, benchmark.second, result);
+
+        logOs << name << "\t" << result.nsPerOp << " ns/op\n";
+
+        writer.StartObject();
+        writer.String("name");
+        writer.String(result.name.c_str());
+        writer.String("iterations");
+        writer.Uint64(result.iterations);
+        writer.String("nsPerOp");
+        writer.Double(result.nsPerOp);
+        writer.String("minNsPerOp");
+        writer.Double(result.minNsPerOp);
+        writer.String("checksum");
+        writer.Double(result.checksum);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    jsonOs << stringBuffer.GetString() << "\n";
+}
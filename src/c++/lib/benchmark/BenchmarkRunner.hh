@@ -0,0 +1,175 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Minimal harness to time small kernels and report results as JSON
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+
+#include <functional>
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/// \brief Seeded random source for generating benchmark input
+///
+/// Only the raw mt19937 output is used, because the standard distribution classes are not required to produce
+/// the same values across standard library implementations.
+///
+struct BenchmarkRandom
+{
+    explicit
+    BenchmarkRandom(const uint32_t seed)
+        : _gen(seed)
+    {}
+
+    /// \return uniform integer in [0,n)
+    unsigned
+    getInt(const unsigned n)
+    {
+        return (_gen() % n);
+    }
+
+    /// \return uniform value in [0,1)
+    double
+    getUnit()
+    {
+        return (_gen() / 4294967296.);
+    }
+
+    char
+    getBase()
+    {
+        static const char bases[] = "ACGT";
+        return bases[getInt(4)];
+    }
+
+    std::string
+    getSequence(const unsigned length)
+    {
+        std::string seq(length,'N');
+        for (char& base : seq)
+        {
+            base = getBase();
+        }
+        return seq;
+    }
+
+private:
+    std::mt19937 _gen;
+};
+
+
+
+/// \brief A kernel prepared for timing
+///
+/// The kernel is called with an input index in [0,inputCount), and each call runs one operation on the
+/// corresponding pre-generated input. The returned value is accumulated into a checksum, which prevents the
+/// operation from being optimized away and can be compared across builds to check that kernel results are
+/// unchanged.
+///
+struct BenchmarkKernel
+{
+    std::function<double(unsigned)> run;
+    unsigned inputCount = 1;
+};
+
+
+
+struct BenchmarkOptions
+{
+    std::string outputFilename;
+
+    /// only run benchmarks whose name contains this string
+    std::string filter;
+
+    bool isListOnly = false;
+
+    uint32_t seed = 1;
+
+    /// minimum total timing duration for each benchmark
+    double minSeconds = 0.5;
+
+    /// number of timing samples taken for each benchmark, the timing duration is divided between samples
+    unsigned sampleCount = 5;
+};
+
+
+
+/// \brief Runs a set of registered kernel benchmarks
+///
+/// Input for each benchmark is generated from a random source seeded by the global seed combined with the
+/// benchmark name, so that the input to any one benchmark is not changed when other benchmarks are added.
+///
+struct BenchmarkRunner : private boost::noncopyable
+{
+    typedef std::function<BenchmarkKernel(BenchmarkRandom&)> setup_t;
+
+    explicit
+    BenchmarkRunner(const BenchmarkOptions& opt)
+        : _opt(opt)
+    {}
+
+    /// Register a benchmark
+    ///
+    /// \param[in] setup generates the benchmark input and returns the kernel to time. This is only run for
+    ///                  benchmarks selected by the filter.
+    void
+    add(
+        const char* name,
+        const setup_t& setup);
+
+    /// Run all selected benchmarks and write results as JSON
+    ///
+    /// \param[in] version version label included in the JSON output
+    void
+    run(
+        const char* version,
+        std::ostream& jsonOs,
+        std::ostream& logOs) const;
+
+    /// Write the names of all registered benchmarks
+    void
+    list(std::ostream& os) const;
+
+private:
+    struct BenchmarkResult
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        double nsPerOp = 0;
+        double minNsPerOp = 0;
+        double checksum = 0;
+    };
+
+    void
+    runBenchmark(
+        const std::string& name,
+        const setup_t& setup,
+        BenchmarkResult& result) const;
+
+    const BenchmarkOptions& _opt;
+    std::vector<std::pair<std::string,setup_t>> _benchmarks;
+};
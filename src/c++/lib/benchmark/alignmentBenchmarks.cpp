@@ -0,0 +1,227 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief GlobalAligner and candidate alignment scoring benchmarks
+///
+
+#include "KernelBenchmarks.hh"
+
+#include "alignment/GlobalAligner.hh"
+#include "blt_util/depth_buffer.hh"
+#include "htsapi/align_path_bam_util.hh"
+#include "starling_common/ActiveRegionDetector.hh"
+#include "starling_common/IndelBuffer.hh"
+#include "starling_common/starling_read.hh"
+#include "starling_common/starling_read_align_score.hh"
+#include "test/starling_base_options_test.hh"
+
+#include <memory>
+
+
+
+/// \return a copy of seq with random substitutions and small indels, approximating a haplotype sequence
+static
+std::string
+mutateSequence(
+    const std::string& seq,
+    BenchmarkRandom& randomSource)
+{
+    std::string mutatedSeq;
+    for (const char base : seq)
+    {
+        const double p(randomSource.getUnit());
+        if (p < 0.02)
+        {
+            mutatedSeq.push_back(randomSource.getBase());
+        }
+        else if (p < 0.025)
+        {
+            // skip base
+        }
+        else if (p < 0.03)
+        {
+            mutatedSeq.push_back(base);
+            mutatedSeq += randomSource.getSequence(1 + randomSource.getInt(3));
+        }
+        else
+        {
+            mutatedSeq.push_back(base);
+        }
+    }
+    return mutatedSeq;
+}
+
+
+
+/// Align haplotype-length sequences to an active region reference window, using the active region aligner
+/// configuration
+static
+BenchmarkKernel
+setupGlobalAligner(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(64);
+    static const unsigned refLength(250);
+    static const unsigned queryLength(150);
+
+    struct Input
+    {
+        std::string query;
+        std::string ref;
+    };
+    auto inputs(std::make_shared<std::vector<Input>>());
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        Input input;
+        input.ref = randomSource.getSequence(refLength);
+        const unsigned queryStart(randomSource.getInt(refLength - queryLength));
+        input.query = mutateSequence(input.ref.substr(queryStart, queryLength), randomSource);
+        inputs->push_back(input);
+    }
+
+    typedef ActiveRegionDetector ard;
+    auto aligner(std::make_shared<GlobalAligner<int>>(
+                     AlignmentScores<int>(ard::ScoreMatch, ard::ScoreMismatch, ard::ScoreOpen, ard::ScoreExtend,
+                                          ard::ScoreOffEdge, ard::ScoreOpen, true, true)));
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [inputs, aligner](const unsigned inputIndex)
+    {
+        const Input& input((*inputs)[inputIndex]);
+        AlignmentResult<int> result;
+        aligner->align(input.query.begin(), input.query.end(), input.ref.begin(), input.ref.end(), result);
+        return static_cast<double>(result.score);
+    };
+    return kernel;
+}
+
+
+
+/// Score ungapped and single-deletion candidate alignments of 100 base reads against a candidate indel set
+static
+BenchmarkKernel
+setupScoreCandidateAlignment(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(64);
+    static const unsigned refLength(2000);
+    static const unsigned readLength(100);
+    static const unsigned deleteLength(2);
+
+    struct ScoringData
+    {
+        ScoringData()
+            : dopt(opt),
+              indelBuffer(opt, dopt, ref)
+        {}
+
+        starling_base_options_test opt;
+        starling_base_deriv_options dopt;
+        reference_contig_segment ref;
+        depth_buffer db;
+        depth_buffer db2;
+        IndelBuffer indelBuffer;
+        std::vector<std::unique_ptr<starling_read>> reads;
+        std::vector<CandidateAlignment> candidateAlignments;
+    };
+    auto data(std::make_shared<ScoringData>());
+
+    data->ref.seq() = randomSource.getSequence(refLength);
+    data->indelBuffer.registerSample(data->db, data->db2, false);
+    data->indelBuffer.finalizeSamples();
+
+    static const unsigned sampleIndex(0);
+    std::vector<uint8_t> qual(readLength);
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        // every second read supports a candidate deletion:
+        const bool isDeletion((inputIndex % 2) == 1);
+        static const pos_t deleteOffset(readLength/2);
+
+        alignment al;
+        al.pos = randomSource.getInt(refLength - 2*readLength);
+        ALIGNPATH::cigar_to_apath("100M", al.path);
+
+        std::string read;
+        if (isDeletion)
+        {
+            std::string suffix;
+            data->ref.get_substring(al.pos, deleteOffset, read);
+            data->ref.get_substring(al.pos + deleteOffset + deleteLength, (readLength - deleteOffset), suffix);
+            read += suffix;
+        }
+        else
+        {
+            data->ref.get_substring(al.pos, readLength, read);
+        }
+
+        for (unsigned readPos(0); readPos < readLength; ++readPos)
+        {
+            if (randomSource.getUnit() < 0.01) read[readPos] = randomSource.getBase();
+            qual[readPos] = 20 + randomSource.getInt(21);
+        }
+
+        bam_record bamRead;
+        bamRead.set_qname("BENCHREAD");
+        bamRead.set_readqual(read.c_str(), qual.data());
+        bam1_t& br(*(bamRead.get_data()));
+        br.core.pos = al.pos;
+        edit_bam_cigar(al.path, br);
+
+        data->reads.emplace_back(new starling_read(bamRead, al, MAPLEVEL::UNKNOWN, inputIndex));
+
+        CandidateAlignment cal;
+        cal.al.pos = al.pos;
+        indel_set_t indels;
+        if (isDeletion)
+        {
+            ALIGNPATH::cigar_to_apath("50M2D50M", cal.al.path);
+            const IndelKey indelKey(al.pos + deleteOffset, INDEL::INDEL, deleteLength);
+            indels.insert(indelKey);
+
+            IndelObservation obs;
+            obs.key = indelKey;
+            obs.data.is_external_candidate = true;
+            data->indelBuffer.addIndelObservation(sampleIndex, obs);
+        }
+        else
+        {
+            cal.al.path = al.path;
+        }
+        cal.setIndels(indels);
+        data->candidateAlignments.push_back(cal);
+    }
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [data](const unsigned inputIndex)
+    {
+        return scoreCandidateAlignment(data->opt, data->indelBuffer, data->reads[inputIndex]->get_full_segment(),
+                                       data->candidateAlignments[inputIndex], data->ref);
+    };
+    return kernel;
+}
+
+
+
+void
+addAlignmentBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add("GlobalAligner::align", setupGlobalAligner);
+    runner.add("scoreCandidateAlignment", setupScoreCandidateAlignment);
+}
@@ -0,0 +1,98 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Iterative haplotype assembly benchmark
+///
+
+#include "KernelBenchmarks.hh"
+
+#include "assembly/IterativeAssembler.hh"
+
+#include <memory>
+
+
+
+/// Assemble the read segments of a small active region containing two haplotypes, using the active region
+/// assembly configuration
+static
+BenchmarkKernel
+setupIterativeAssembler(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(8);
+    static const unsigned haplotypeLength(120);
+    static const unsigned readCount(40);
+    static const unsigned minReadSegmentLength(20);
+
+    auto inputs(std::make_shared<std::vector<AssemblyReadInput>>());
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        // the second haplotype has a substitution and a small deletion relative to the first:
+        const std::string haplotype1(randomSource.getSequence(haplotypeLength));
+        std::string haplotype2(haplotype1);
+        haplotype2[haplotypeLength/3] = ((haplotype2[haplotypeLength/3] == 'A') ? 'C' : 'A');
+        haplotype2.erase((2*haplotypeLength)/3, 3);
+
+        AssemblyReadInput reads;
+        for (unsigned readIndex(0); readIndex < readCount; ++readIndex)
+        {
+            const std::string& haplotype(((readIndex % 2) == 0) ? haplotype1 : haplotype2);
+            const unsigned segmentStart(randomSource.getInt(haplotype.size()/3));
+            const unsigned segmentEnd(haplotype.size() - randomSource.getInt(haplotype.size()/3));
+            std::string segment(haplotype.substr(segmentStart, segmentEnd-segmentStart));
+            for (char& base : segment)
+            {
+                if (randomSource.getUnit() < 0.005) base = randomSource.getBase();
+            }
+            reads.push_back(segment);
+        }
+        inputs->push_back(reads);
+    }
+
+    // word size and coverage settings follow ActiveRegionProcessor:
+    IterativeAssemblerOptions assembleOption;
+    assembleOption.minWordLength = minReadSegmentLength;
+    assembleOption.maxWordLength = 76;
+    assembleOption.minCoverage = 3;
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [inputs, assembleOption](const unsigned inputIndex)
+    {
+        AssemblyReadInput reads((*inputs)[inputIndex]);
+        AssemblyReadOutput assemblyReadOutput;
+        Assembly contigs;
+        runIterativeAssembler(assembleOption, reads, assemblyReadOutput, contigs);
+
+        double contigLengthSum(0);
+        for (const auto& contig : contigs)
+        {
+            contigLengthSum += contig.seq.size();
+        }
+        return contigLengthSum;
+    };
+    return kernel;
+}
+
+
+
+void
+addAssemblyBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add("runIterativeAssembler", setupIterativeAssembler);
+}
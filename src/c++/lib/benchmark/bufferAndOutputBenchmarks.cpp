@@ -0,0 +1,200 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Position buffer and VCF record formatting benchmarks
+///
+
+#include "KernelBenchmarks.hh"
+
+#include "applications/strelka/position_somatic_snv_strand_grid_vcf.hh"
+#include "blt_util/blt_types.hh"
+#include "blt_util/RangeMap.hh"
+#include "blt_util/seq_util.hh"
+#include "starling_common/PileupCleaner.hh"
+
+#include <memory>
+#include <sstream>
+
+
+
+/// Each operation adds the depth contribution of one read to a sliding position buffer, and clears the
+/// position which has moved out of the buffer, following the use of RangeMap in the depth buffers
+static
+BenchmarkKernel
+setupRangeMapGetRef(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(1024);
+    static const pos_t readLength(100);
+
+    // read start offsets from the current head position:
+    auto offsets(std::make_shared<std::vector<pos_t>>());
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        offsets->push_back(randomSource.getInt(3));
+    }
+
+    struct BufferState
+    {
+        RangeMap<pos_t,unsigned> depth;
+        pos_t headPos = 0;
+    };
+    auto state(std::make_shared<BufferState>());
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [offsets, state](const unsigned inputIndex)
+    {
+        const pos_t readPos(state->headPos + (*offsets)[inputIndex]);
+        for (pos_t pos(readPos); pos < (readPos+readLength); ++pos)
+        {
+            state->depth.getRef(pos)++;
+        }
+        const unsigned headDepth(state->depth.getRef(state->headPos));
+        state->depth.eraseTo(state->headPos - readLength);
+        state->headPos++;
+        return static_cast<double>(headDepth);
+    };
+    return kernel;
+}
+
+
+
+/// Set pi to a basecall pileup with depth in [20,100) and approximately the given fraction of variant basecalls
+static
+void
+setPileup(
+    const char refBase,
+    const char altBase,
+    const double altFrac,
+    BenchmarkRandom& randomSource,
+    snp_pos_info& pi)
+{
+    pi.set_ref_base(refBase);
+
+    const unsigned depth(20 + randomSource.getInt(80));
+    for (unsigned readIndex(0); readIndex < depth; ++readIndex)
+    {
+        const double p(randomSource.getUnit());
+        const char base((p < 0.01) ? randomSource.getBase() : ((p < altFrac) ? altBase : refBase));
+        const uint8_t qscore(2 + randomSource.getInt(39));
+        const bool isFwdStrand(randomSource.getInt(2) == 0);
+        pi.calls.push_back(base_call(base_to_id(base), qscore, isFwdStrand, 0, 0, false, false, false));
+        pi.mapqTracker.add(40 + randomSource.getInt(21));
+    }
+}
+
+
+
+/// Write somatic SNV VCF records with the somatic SNV writer
+///
+/// Pileups, basecall cleaning and genotype calls are all prepared in setup, so that only the writer, including the
+/// filter and scoring feature computation it does for each record, is timed.
+static
+BenchmarkKernel
+setupVcfRecordFormat(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(256);
+
+    struct WriterInput
+    {
+        explicit
+        WriterInput(const strelka_options& initOpt)
+            : opt(initOpt),
+              dopt(opt),
+              normalPileups(inputCount),
+              tumorPileups(inputCount),
+              normalCleanedPileups(inputCount),
+              tumorCleanedPileups(inputCount),
+              genotypes(inputCount)
+        {}
+
+        const strelka_options opt;
+        const strelka_deriv_options dopt;
+
+        // cleaned pileups refer to the raw pileups, so neither vector is resized after construction:
+        std::vector<snp_pos_info> normalPileups;
+        std::vector<snp_pos_info> tumorPileups;
+        std::vector<CleanedPileup> normalCleanedPileups;
+        std::vector<CleanedPileup> tumorCleanedPileups;
+        std::vector<somatic_snv_genotype_grid> genotypes;
+    };
+
+    // the alignment files are only named here to size the per-sample indel error models, they are not read:
+    strelka_options opt;
+    opt.alignFileOpt.alignmentFilenames = { "normal.bam", "tumor.bam" };
+    opt.alignFileOpt.isAlignmentTumor = { false, true };
+    opt.somatic_snv_rate = 0.0001;
+    opt.shared_site_error_rate = 5e-07;
+    opt.shared_site_error_strand_bias_fraction = 0.5;
+    auto input(std::make_shared<WriterInput>(opt));
+
+    const PileupCleaner pileupCleaner(input->opt);
+    static const bool isIncludeTier2(false);
+    for (unsigned inputIndex(0); inputIndex < inputCount; ++inputIndex)
+    {
+        const char refBase(randomSource.getBase());
+        const char altBase((refBase == 'A') ? 'C' : 'A');
+        setPileup(refBase, altBase, 0., randomSource, input->normalPileups[inputIndex]);
+        setPileup(refBase, altBase, (0.05 + 0.45 * randomSource.getUnit()), randomSource,
+                  input->tumorPileups[inputIndex]);
+
+        CleanedPileup& normalCleanedPileup(input->normalCleanedPileups[inputIndex]);
+        CleanedPileup& tumorCleanedPileup(input->tumorCleanedPileups[inputIndex]);
+        pileupCleaner.CleanPileup(input->normalPileups[inputIndex], isIncludeTier2, normalCleanedPileup);
+        pileupCleaner.CleanPileup(input->tumorPileups[inputIndex], isIncludeTier2, tumorCleanedPileup);
+
+        // all records are written, as for somatic gVCF output:
+        static const bool isComputeNonSomatic(true);
+        NormalSnvLhood normalLhood;
+        input->dopt.sscaller_strand_grid().position_somatic_snv_call(
+            normalCleanedPileup.getExtendedPosInfo(), tumorCleanedPileup.getExtendedPosInfo(), nullptr, nullptr,
+            isComputeNonSomatic, normalLhood, input->genotypes[inputIndex]);
+    }
+
+    auto osPtr(std::make_shared<std::ostringstream>());
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [input, osPtr](const unsigned inputIndex)
+    {
+        std::ostringstream& os(*osPtr);
+        os.str("");
+
+        static const bool isWriteNqss(false);
+        const CleanedPileup& normalCleanedPileup(input->normalCleanedPileups[inputIndex]);
+        const CleanedPileup& tumorCleanedPileup(input->tumorCleanedPileups[inputIndex]);
+        os << "chr20" << '\t' << (1000000 + inputIndex) << "\t.";
+        write_vcf_somatic_snv_genotype_strand_grid(input->opt, input->dopt, input->genotypes[inputIndex],
+                                                   isWriteNqss, normalCleanedPileup, tumorCleanedPileup,
+                                                   normalCleanedPileup, tumorCleanedPileup, 0, 0, os);
+        os << '\n';
+
+        return static_cast<double>(os.tellp());
+    };
+    return kernel;
+}
+
+
+
+void
+addBufferAndOutputBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add("RangeMap::getRef", setupRangeMapGetRef);
+    runner.add("vcfRecordFormat", setupVcfRecordFormat);
+}
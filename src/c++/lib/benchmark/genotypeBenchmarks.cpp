@@ -0,0 +1,181 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief SNV genotype likelihood and supporting statistic benchmarks
+///
+
+#include "KernelBenchmarks.hh"
+
+#include "applications/strelka/position_somatic_snv_strand_grid_lhood_cached.hh"
+#include "applications/strelka/strelka_digt_states.hh"
+#include "blt_common/blt_shared.hh"
+#include "blt_util/digt.hh"
+#include "blt_util/fastRanksum.hh"
+#include "blt_util/logSumUtil.hh"
+#include "blt_util/seq_util.hh"
+#include "strelka_common/position_snp_call_grid_lhood_cached.hh"
+
+#include <array>
+#include <memory>
+
+
+
+/// \return basecall pileups with depth in [20,80) and a mixture of reference, variant and error basecalls
+static
+std::shared_ptr<std::vector<snp_pos_info>>
+getPileups(
+    const unsigned pileupCount,
+    BenchmarkRandom& randomSource)
+{
+    auto pileups(std::make_shared<std::vector<snp_pos_info>>(pileupCount));
+    for (snp_pos_info& pi : *pileups)
+    {
+        const char refBase(randomSource.getBase());
+        const char altBase(randomSource.getBase());
+        const double altFrac(randomSource.getUnit() * 0.5);
+        pi.set_ref_base(refBase);
+
+        const unsigned depth(20 + randomSource.getInt(60));
+        for (unsigned readIndex(0); readIndex < depth; ++readIndex)
+        {
+            const double p(randomSource.getUnit());
+            const char base((p < 0.02) ? randomSource.getBase() : ((p < altFrac) ? altBase : refBase));
+            const uint8_t qscore(2 + randomSource.getInt(39));
+            const bool isFwdStrand(randomSource.getInt(2) == 0);
+            pi.calls.push_back(base_call(base_to_id(base), qscore, isFwdStrand, 0, 0, false, false, false));
+        }
+    }
+    return pileups;
+}
+
+
+
+static
+BenchmarkKernel
+setupDiploidGtLhoodCached(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(256);
+    auto pileups(getPileups(inputCount, randomSource));
+    auto opt(std::make_shared<blt_options>());
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [pileups, opt](const unsigned inputIndex)
+    {
+        std::array<blt_float_t,DIGT::SIZE> lhood;
+        get_diploid_gt_lhood_cached(*opt, (*pileups)[inputIndex], lhood.data());
+        return static_cast<double>(lhood[0]);
+    };
+    return kernel;
+}
+
+
+
+/// Het ratio grid likelihoods at the somatic SNV caller's grid resolution
+static
+BenchmarkKernel
+setupDiploidHetGridLhoodCached(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(256);
+    auto pileups(getPileups(inputCount, randomSource));
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [pileups](const unsigned inputIndex)
+    {
+        const snp_pos_info& pi((*pileups)[inputIndex]);
+        std::array<blt_float_t,DIGT_GRID::HET_RES*2> lhood;
+        get_diploid_het_grid_lhood_cached(pi, base_to_id(pi.get_ref_base()), DIGT_GRID::HET_RES, lhood.data());
+        return static_cast<double>(lhood[0]);
+    };
+    return kernel;
+}
+
+
+
+/// Each operation is a sequence of 64 pairwise log sums
+static
+BenchmarkKernel
+setupGetLogSum(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(64);
+    static const unsigned sumCount(64);
+    auto values(std::make_shared<std::vector<double>>());
+    for (unsigned valueIndex(0); valueIndex < (inputCount*sumCount); ++valueIndex)
+    {
+        values->push_back(-50. * randomSource.getUnit());
+    }
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [values](const unsigned inputIndex)
+    {
+        const double* value(values->data() + inputIndex*sumCount);
+        double logSum(value[0]);
+        for (unsigned sumIndex(1); sumIndex < sumCount; ++sumIndex)
+        {
+            logSum = getLogSum(logSum, value[sumIndex]);
+        }
+        return logSum;
+    };
+    return kernel;
+}
+
+
+
+/// Each operation accumulates one locus worth of mapping quality observations and computes the ranksum z-score
+static
+BenchmarkKernel
+setupFastRanksum(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(64);
+    static const unsigned observationCount(60);
+    auto observations(std::make_shared<std::vector<std::pair<bool,unsigned>>>());
+    for (unsigned obsIndex(0); obsIndex < (inputCount*observationCount); ++obsIndex)
+    {
+        const bool isCategory1(randomSource.getInt(3) != 0);
+        const unsigned obs(isCategory1 ? (40 + randomSource.getInt(21)) : randomSource.getInt(61));
+        observations->emplace_back(isCategory1, obs);
+    }
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [observations](const unsigned inputIndex)
+    {
+        fastRanksum ranksum;
+        for (unsigned obsIndex(0); obsIndex < observationCount; ++obsIndex)
+        {
+            const auto& observation((*observations)[inputIndex*observationCount + obsIndex]);
+            ranksum.add_observation(observation.first, observation.second);
+        }
+        return ranksum.get_z_stat();
+    };
+    return kernel;
+}
+
+
+
+void
+addGenotypeBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add("get_diploid_gt_lhood_cached", setupDiploidGtLhoodCached);
+    runner.add("get_diploid_het_grid_lhood_cached", setupDiploidHetGridLhoodCached);
+    runner.add("getLogSum/64", setupGetLogSum);
+    runner.add("fastRanksum", setupFastRanksum);
+}
@@ -0,0 +1,139 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Empirical variant scoring model benchmark
+///
+
+#include "KernelBenchmarks.hh"
+
+#include "calibration/RandomForestModel.hh"
+
+#include "rapidjson/document.h"
+
+#include <memory>
+#include <string>
+
+
+
+/// Generate a random forest in the json scoring model file format
+///
+/// Each tree is a complete binary tree, node i has children 2i+1 and 2i+2. Tree count and size match the current
+/// somatic SNV scoring model.
+static
+void
+getRandomForestJson(
+    const unsigned treeCount,
+    const unsigned treeDepth,
+    const unsigned featureCount,
+    BenchmarkRandom& randomSource,
+    rapidjson::Document& document)
+{
+    auto& allocator(document.GetAllocator());
+
+    auto makePair = [&](const double left, const double right)
+    {
+        rapidjson::Value pair(rapidjson::kArrayType);
+        pair.PushBack(left, allocator);
+        pair.PushBack(right, allocator);
+        return pair;
+    };
+
+    const unsigned internalNodeCount((1u << treeDepth) - 1);
+    const unsigned nodeCount((1u << (treeDepth+1)) - 1);
+
+    rapidjson::Value model(rapidjson::kArrayType);
+    for (unsigned treeIndex(0); treeIndex < treeCount; ++treeIndex)
+    {
+        rapidjson::Value tree(rapidjson::kObjectType);
+        rapidjson::Value votes(rapidjson::kObjectType);
+        rapidjson::Value decisions(rapidjson::kObjectType);
+        for (unsigned nodeIndex(0); nodeIndex < nodeCount; ++nodeIndex)
+        {
+            const std::string nodeLabel(std::to_string(nodeIndex));
+            rapidjson::Value treeLabel(nodeLabel.c_str(), allocator);
+            rapidjson::Value voteLabel(nodeLabel.c_str(), allocator);
+            rapidjson::Value decisionLabel(nodeLabel.c_str(), allocator);
+
+            const bool isLeaf(nodeIndex >= internalNodeCount);
+            if (isLeaf)
+            {
+                tree.AddMember(treeLabel, makePair(-1, -1), allocator);
+            }
+            else
+            {
+                tree.AddMember(treeLabel, makePair(2*nodeIndex+1, 2*nodeIndex+2), allocator);
+            }
+            votes.AddMember(voteLabel, makePair(1 + randomSource.getInt(100), 1 + randomSource.getInt(100)),
+                            allocator);
+            decisions.AddMember(decisionLabel, makePair(randomSource.getInt(featureCount), randomSource.getUnit()),
+                                allocator);
+        }
+
+        rapidjson::Value treeValue(rapidjson::kObjectType);
+        treeValue.AddMember("tree", tree, allocator);
+        treeValue.AddMember("node_votes", votes, allocator);
+        treeValue.AddMember("decisions", decisions, allocator);
+        model.PushBack(treeValue, allocator);
+    }
+
+    document.SetObject();
+    document.AddMember("Model", model, allocator);
+}
+
+
+
+static
+BenchmarkKernel
+setupRandomForestGetProb(BenchmarkRandom& randomSource)
+{
+    static const unsigned inputCount(256);
+    static const unsigned treeCount(100);
+    static const unsigned treeDepth(6);
+    static const unsigned featureCount(20);
+
+    rapidjson::Document document;
+    getRandomForestJson(treeCount, treeDepth, featureCount, randomSource, document);
+    auto model(std::make_shared<RandomForestModel>());
+    model->Deserialize(featureCount, document);
+
+    auto features(std::make_shared<std::vector<VariantScoringModelBase::featureInput_t>>(inputCount));
+    for (auto& featureInput : *features)
+    {
+        for (unsigned featureIndex(0); featureIndex < featureCount; ++featureIndex)
+        {
+            featureInput.push_back(randomSource.getUnit());
+        }
+    }
+
+    BenchmarkKernel kernel;
+    kernel.inputCount = inputCount;
+    kernel.run = [model, features](const unsigned inputIndex)
+    {
+        return model->getProb((*features)[inputIndex]);
+    };
+    return kernel;
+}
+
+
+
+void
+addScoringModelBenchmarks(BenchmarkRunner& runner)
+{
+    runner.add("RandomForestModel::getProb", setupRandomForestGetProb);
+}
@@ -0,0 +1,151 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Microbenchmarks for the variant calling hot paths
+///
+
+#include "BenchmarkRunner.hh"
+#include "KernelBenchmarks.hh"
+
+#include "blt_util/log.hh"
+#include "common/OutStream.hh"
+#include "common/Program.hh"
+#include "common/ProgramUtil.hh"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+
+
+static
+void
+usage(
+    std::ostream& os,
+    const illumina::Program& prog,
+    const boost::program_options::options_description& visible,
+    const char* msg = nullptr)
+{
+    usage(os, prog, visible, "Run variant calling kernel microbenchmarks", "", msg);
+}
+
+
+
+static
+void
+parseBenchmarkOptions(
+    const illumina::Program& prog,
+    int argc, char* argv[],
+    BenchmarkOptions& opt)
+{
+    namespace po = boost::program_options;
+    po::options_description req("configuration");
+
+    req.add_options()
+    ("output-file", po::value(&opt.outputFilename),
+     "write JSON results to file (default: stdout)")
+    ("filter", po::value(&opt.filter),
+     "only run benchmarks with names containing this string")
+    ("list", po::value(&opt.isListOnly)->zero_tokens(),
+     "list all benchmark names and exit")
+    ("seed", po::value(&opt.seed)->default_value(opt.seed),
+     "random seed used to generate benchmark input")
+    ("min-seconds", po::value(&opt.minSeconds)->default_value(opt.minSeconds),
+     "minimum timing duration for each benchmark")
+    ("samples", po::value(&opt.sampleCount)->default_value(opt.sampleCount),
+     "number of timing samples for each benchmark, the reported time is the sample median");
+
+    po::options_description help("help");
+    help.add_options()
+    ("help,h","print this message");
+
+    po::options_description visible("options");
+    visible.add(req).add(help);
+
+    bool po_parse_fail(false);
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, visible,
+                                         po::command_line_style::unix_style ^ po::command_line_style::allow_short), vm);
+        po::notify(vm);
+    }
+    catch (const boost::program_options::error& e)
+    {
+        log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+        po_parse_fail=true;
+    }
+
+    if ((vm.count("help")) || po_parse_fail)
+    {
+        usage(log_os,prog,visible);
+    }
+
+    if (opt.minSeconds <= 0)
+    {
+        usage(log_os,prog,visible,"Minimum benchmark duration must be positive");
+    }
+
+    if (opt.sampleCount == 0)
+    {
+        usage(log_os,prog,visible,"Sample count must be positive");
+    }
+}
+
+
+
+struct StrelkaBenchmarks : public illumina::Program
+{
+    const char*
+    name() const
+    {
+        return "strelkaBenchmarks";
+    }
+
+    void
+    runInternal(int argc, char* argv[]) const
+    {
+        BenchmarkOptions opt;
+        parseBenchmarkOptions(*this,argc,argv,opt);
+
+        BenchmarkRunner runner(opt);
+        addAlignmentBenchmarks(runner);
+        addAssemblyBenchmarks(runner);
+        addGenotypeBenchmarks(runner);
+        addScoringModelBenchmarks(runner);
+        addBufferAndOutputBenchmarks(runner);
+
+        if (opt.isListOnly)
+        {
+            runner.list(std::cout);
+            return;
+        }
+
+        OutStream outs(opt.outputFilename);
+        runner.run(version(), outs.getStream(), log_os);
+    }
+};
+
+
+
+int
+main(int argc, char* argv[])
+{
+    return StrelkaBenchmarks().run(argc,argv);
+}
@@ -134,6 +134,17 @@ unsigned
 get_snp_hpol_size(const pos_t pos,
                   const reference_contig_segment& ref)
 {
+    if (ref.isAnnotated() and ref.isRangeInSegment(pos, pos+1))
+    {
+        // the precomputed value can be used if all bases read to compute it are in this segment:
+        const unsigned hpolSize(ref.getAnnotation(pos).getSnpHpolSize());
+        if ((hpolSize < ReferenceAnnotation::MaxHpolSize) and
+            ref.isRangeInSegment(pos-hpolSize, pos+hpolSize+1))
+        {
+            return hpolSize;
+        }
+    }
+
     // count upstream repeats:
     bool is_up_repeat(false);
     char up_repeat('N');
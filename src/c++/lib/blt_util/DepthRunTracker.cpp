@@ -0,0 +1,207 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "DepthRunTracker.hh"
+
+#include <cassert>
+
+#include <algorithm>
+
+
+
+static
+unsigned
+roundUpToPowerOfTwo(const unsigned val)
+{
+    unsigned result(1);
+    while (result < val) result <<= 1;
+    return result;
+}
+
+
+
+DepthRunTracker::
+DepthRunTracker(
+    const unsigned binSize,
+    const unsigned initialBufferBinCount)
+    : _binSize(binSize),
+      _binDiff(roundUpToPowerOfTwo(std::max(initialBufferBinCount,1u)),0),
+      _binPartial(_binDiff.size(),0),
+      _bufferMask(_binDiff.size()-1)
+{
+    assert(_binSize >= 1);
+}
+
+
+
+void
+DepthRunTracker::
+addRead(
+    const pos_t beginPos,
+    const unsigned size)
+{
+    assert(beginPos >= 0);
+    if (size == 0) return;
+
+    if (! _isRegionInit)
+    {
+        _headPos = beginPos;
+        _headBinFullSum = 0;
+        _maxEndPos = beginPos;
+        _isRegionInit = true;
+    }
+
+    assert(beginPos >= _lastBeginPos);
+    flushTo(beginPos);
+
+    const pos_t endPos(beginPos+size);
+    const pos_t beginBin(getBin(beginPos));
+    const pos_t lastBin(getBin(endPos-1));
+    const unsigned requiredBinCount(static_cast<unsigned>(lastBin-getBin(_headPos))+1);
+    if (requiredBinCount > _binDiff.size()) expandBuffer(requiredBinCount);
+
+    if (beginBin == lastBin)
+    {
+        _binPartial[bufferIndex(beginBin)] += size;
+    }
+    else
+    {
+        const pos_t binSize(_binSize);
+        _binPartial[bufferIndex(beginBin)] += ((beginBin+1)*binSize - beginPos);
+        _binPartial[bufferIndex(lastBin)] += (endPos - lastBin*binSize);
+        if ((beginBin+1) < lastBin)
+        {
+            _binDiff[bufferIndex(beginBin+1)] += binSize;
+            _binDiff[bufferIndex(lastBin)] -= binSize;
+        }
+    }
+
+    _maxEndPos = std::max(_maxEndPos, endPos);
+    _lastBeginPos = beginPos;
+}
+
+
+
+void
+DepthRunTracker::
+finishRegion()
+{
+    if (! _isRegionInit) return;
+
+    flushTo(_lastBeginPos+1);
+
+    std::fill(_binDiff.begin(), _binDiff.end(), 0);
+    std::fill(_binPartial.begin(), _binPartial.end(), 0);
+    _headPos = 0;
+    _headBinFullSum = 0;
+    _maxEndPos = 0;
+    _lastBeginPos = 0;
+    _isRegionInit = false;
+}
+
+
+
+void
+DepthRunTracker::
+flushTo(const pos_t endPos)
+{
+    if (endPos <= _headPos) return;
+
+    const pos_t binSize(_binSize);
+    const unsigned halfBinSize(_binSize/2);
+
+    // all coverage is recorded in bins before dataEndPos, so depth is zero from there:
+    const pos_t dataEndPos((getBin(_maxEndPos-1)+1)*binSize);
+
+    unsigned runDepth(0);
+    unsigned runLength(0);
+    while (_headPos < endPos)
+    {
+        if (_headPos >= dataEndPos)
+        {
+            assert(_headBinFullSum == 0);
+            if ((runLength > 0) && (runDepth != 0))
+            {
+                _depthHistogram.addObs(runDepth,runLength);
+                runLength = 0;
+            }
+            runDepth = 0;
+            runLength += (endPos-_headPos);
+            _headPos = endPos;
+            break;
+        }
+
+        const pos_t headBin(getBin(_headPos));
+        const pos_t binEndPos((headBin+1)*binSize);
+        const pos_t segmentEndPos(std::min(binEndPos,endPos));
+
+        unsigned& binPartial(_binPartial[bufferIndex(headBin)]);
+        assert(_headBinFullSum >= 0);
+        const unsigned depth((binPartial + static_cast<unsigned>(_headBinFullSum) + halfBinSize)/_binSize);
+        if ((runLength > 0) && (depth != runDepth))
+        {
+            _depthHistogram.addObs(runDepth,runLength);
+            runLength = 0;
+        }
+        runDepth = depth;
+        runLength += (segmentEndPos-_headPos);
+        _headPos = segmentEndPos;
+
+        if (segmentEndPos == binEndPos)
+        {
+            // move the head into the next bin:
+            binPartial = 0;
+            int& nextBinDiff(_binDiff[bufferIndex(headBin+1)]);
+            _headBinFullSum += nextBinDiff;
+            nextBinDiff = 0;
+        }
+    }
+
+    // positions are added to the histogram as soon as they are flushed, so that depth queries between reads
+    // reflect all flushed positions:
+    if (runLength > 0)
+    {
+        _depthHistogram.addObs(runDepth,runLength);
+    }
+}
+
+
+
+void
+DepthRunTracker::
+expandBuffer(const unsigned minBinCount)
+{
+    const unsigned oldSize(_binDiff.size());
+    const unsigned newSize(roundUpToPowerOfTwo(minBinCount));
+
+    std::vector<int> newBinDiff(newSize,0);
+    std::vector<unsigned> newBinPartial(newSize,0);
+    const unsigned newMask(newSize-1);
+    const pos_t headBin(getBin(_headPos));
+    for (unsigned offset(0); offset<oldSize; ++offset)
+    {
+        const pos_t bin(headBin+offset);
+        const unsigned newIndex(static_cast<unsigned>(bin) & newMask);
+        newBinDiff[newIndex] = _binDiff[bufferIndex(bin)];
+        newBinPartial[newIndex] = _binPartial[bufferIndex(bin)];
+    }
+
+    _binDiff.swap(newBinDiff);
+    _binPartial.swap(newBinPartial);
+    _bufferMask = newMask;
+}
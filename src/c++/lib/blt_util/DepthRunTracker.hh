@@ -0,0 +1,126 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+#include "blt_util/MedianDepthTracker.hh"
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+
+#include <vector>
+
+
+/// Accumulate per-position read depth from position-sorted reads, and summarize depth as a histogram
+///
+/// Positions are grouped into bins of binSize positions aligned to multiples of binSize. Each read is
+/// recorded by adding its partial coverage of its first and last bins to those bins directly, and its
+/// coverage of all bins in between as a +binSize/-binSize pair in a circular difference array, so the cost of
+/// a read does not depend on its length. Bin sums are recovered by a running sum as positions are flushed,
+/// and each run of positions with equal depth is added to the depth histogram as a single weighted
+/// observation.
+///
+/// The depth of a flushed position is its bin sum divided by binSize, rounded to the nearest integer, where
+/// the bin sum includes all reads beginning at or before that position. With the default binSize of one, this
+/// is the exact depth of each position. A binSize of 16 reproduces the depth estimate of the original
+/// depth_buffer_compressible(16) scheme used by the chromosome and region depth tools.
+///
+/// All depth positions are counted as observations, including any zero depth positions between reads.
+///
+struct DepthRunTracker : private boost::noncopyable
+{
+    /// \param binSize number of positions summarized by each depth value
+    ///
+    /// \param initialBufferBinCount initial size of the circular bin arrays, this is expanded as required to
+    ///                              cover the longest read
+    explicit
+    DepthRunTracker(
+        const unsigned binSize = 1,
+        const unsigned initialBufferBinCount = 1024);
+
+    /// add a read covering [beginPos,beginPos+size)
+    ///
+    /// Reads must be added in order of non-decreasing beginPos. All positions before beginPos are flushed
+    /// to the depth histogram.
+    void
+    addRead(
+        const pos_t beginPos,
+        const unsigned size);
+
+    /// flush all positions up to and including the begin position of the last read, and discard all depth
+    /// information from later positions
+    ///
+    /// This is used to end a region, when depth after the last read begin position is incomplete because
+    /// reads beginning after the region are not observed. Reads added after this call start a new region.
+    void
+    finishRegion();
+
+    const MedianDepthTracker&
+    getDepthHistogram() const
+    {
+        return _depthHistogram;
+    }
+
+private:
+    /// flush all positions before endPos to the depth histogram
+    void
+    flushTo(const pos_t endPos);
+
+    void
+    expandBuffer(const unsigned minBinCount);
+
+    pos_t
+    getBin(const pos_t pos) const
+    {
+        return (pos / static_cast<pos_t>(_binSize));
+    }
+
+    unsigned
+    bufferIndex(const pos_t bin) const
+    {
+        return (static_cast<unsigned>(bin) & _bufferMask);
+    }
+
+    const unsigned _binSize;
+
+    /// circular bin arrays covering bins [getBin(_headPos),getBin(_headPos)+_binDiff.size())
+    ///
+    /// _binDiff holds the difference array of whole-bin coverage, and _binPartial holds the partial bin
+    /// coverage at the ends of each read.
+    std::vector<int> _binDiff;
+    std::vector<unsigned> _binPartial;
+    unsigned _bufferMask;
+
+    bool _isRegionInit = false;
+
+    /// first position which has not been flushed
+    pos_t _headPos = 0;
+
+    /// whole-bin coverage of the bin containing _headPos
+    int _headBinFullSum = 0;
+
+    /// maximum read end position in the current region
+    pos_t _maxEndPos = 0;
+
+    /// begin position of the last read in the current region
+    pos_t _lastBeginPos = 0;
+
+    MedianDepthTracker _depthHistogram;
+};
@@ -0,0 +1,138 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "GenomeSegmentPlanner.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+
+
+double
+WindowCostTrack::
+getTotalCost() const
+{
+    return std::accumulate(costs.begin(), costs.end(), 0.);
+}
+
+
+
+double
+WindowCostTrack::
+getCumulativeCost(const pos_t pos) const
+{
+    if (pos <= beginPos) return 0.;
+    if (pos >= endPos) return getTotalCost();
+
+    const unsigned windowIndex((pos - beginPos) / windowSize);
+    const double precedingCost(std::accumulate(costs.begin(), costs.begin() + windowIndex, 0.));
+    const pos_t windowBeginPos(getWindowBeginPos(windowIndex));
+    const pos_t windowLength(getWindowEndPos(windowIndex) - windowBeginPos);
+    return precedingCost + (costs[windowIndex] * (pos - windowBeginPos)) / windowLength;
+}
+
+
+
+pos_t
+WindowCostTrack::
+getCumulativeCostPos(const double cost) const
+{
+    double precedingCost(0.);
+    const unsigned windowCount(getWindowCount());
+    for (unsigned windowIndex(0); windowIndex < windowCount; ++windowIndex)
+    {
+        const double windowCost(costs[windowIndex]);
+        if ((precedingCost + windowCost) < cost)
+        {
+            precedingCost += windowCost;
+            continue;
+        }
+
+        const pos_t windowBeginPos(getWindowBeginPos(windowIndex));
+        const pos_t windowLength(getWindowEndPos(windowIndex) - windowBeginPos);
+        if (windowCost <= 0.) return windowBeginPos;
+        const pos_t offset(static_cast<pos_t>(((cost - precedingCost) / windowCost) * windowLength));
+        return windowBeginPos + std::min(std::max(offset, 0), windowLength);
+    }
+    return endPos;
+}
+
+
+
+std::vector<pos_t>
+getSegmentBoundaries(
+    const WindowCostTrack& costTrack,
+    const unsigned segmentCount,
+    const pos_t maxCutShift,
+    const std::function<bool(pos_t)>& isCutAllowed,
+    std::vector<ShiftedSegmentBoundary>* shiftedBoundaries)
+{
+    std::vector<pos_t> boundaries;
+    if (segmentCount <= 1) return boundaries;
+
+    const double segmentCost(costTrack.getTotalCost() / segmentCount);
+    if (segmentCost <= 0.) return boundaries;
+
+    pos_t previousBoundary(costTrack.beginPos);
+    pos_t idealBoundary(costTrack.getCumulativeCostPos(segmentCost));
+    for (unsigned segmentIndex(1); segmentIndex < segmentCount; ++segmentIndex)
+    {
+        const pos_t nextIdealBoundary(((segmentIndex+1) < segmentCount) ?
+                                      costTrack.getCumulativeCostPos(segmentCost * (segmentIndex+1)) :
+                                      costTrack.endPos);
+
+        // search outward from the ideal boundary for the nearest allowed cut, every segment must be non-empty. Past
+        // maxCutShift, the search is widened up to the previous boundary and the next ideal boundary:
+        const pos_t minBoundary(previousBoundary + 1);
+        const pos_t maxBoundary(std::min(costTrack.endPos, std::max(idealBoundary + maxCutShift + 1,
+                                                                    nextIdealBoundary)) - 1);
+        pos_t boundary(-1);
+        for (pos_t shift(0); true; ++shift)
+        {
+            const pos_t rightPos(idealBoundary + shift);
+            if ((rightPos >= minBoundary) and (rightPos <= maxBoundary) and isCutAllowed(rightPos))
+            {
+                boundary = rightPos;
+                break;
+            }
+            const pos_t leftPos(idealBoundary - shift);
+            if ((shift > 0) and (leftPos >= minBoundary) and (leftPos <= maxBoundary) and isCutAllowed(leftPos))
+            {
+                boundary = leftPos;
+                break;
+            }
+            if ((rightPos >= maxBoundary) and (leftPos <= minBoundary)) break;
+        }
+
+        const bool isShifted((boundary < 0) or (std::abs(boundary - idealBoundary) > maxCutShift));
+        if (isShifted and (shiftedBoundaries != nullptr))
+        {
+            shiftedBoundaries->emplace_back(idealBoundary, boundary);
+        }
+        if (boundary >= 0)
+        {
+            boundaries.push_back(boundary);
+            previousBoundary = boundary;
+        }
+        idealBoundary = nextIdealBoundary;
+    }
+
+    return boundaries;
+}
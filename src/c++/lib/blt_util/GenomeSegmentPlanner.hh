@@ -0,0 +1,135 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include <cassert>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+
+/// \brief Predicted processing cost of consecutive fixed-size windows covering a contig range
+///
+/// Cost is assumed to be uniform within each window, so that the cost of any sub-range can be interpolated.
+///
+struct WindowCostTrack
+{
+    /// \param[in] initBeginPos zero-indexed begin of the covered range (closed)
+    /// \param[in] initEndPos zero-indexed end of the covered range (open)
+    /// \param[in] initWindowSize size of each window, the last window is truncated at initEndPos
+    WindowCostTrack(
+        const pos_t initBeginPos,
+        const pos_t initEndPos,
+        const pos_t initWindowSize)
+        : beginPos(initBeginPos),
+          endPos(initEndPos),
+          windowSize(initWindowSize),
+          costs(((initEndPos - initBeginPos) + (initWindowSize-1)) / initWindowSize, 0.)
+    {
+        assert(initBeginPos <= initEndPos);
+        assert(initWindowSize > 0);
+    }
+
+    unsigned
+    getWindowCount() const
+    {
+        return costs.size();
+    }
+
+    pos_t
+    getWindowBeginPos(const unsigned windowIndex) const
+    {
+        return beginPos + (windowIndex * windowSize);
+    }
+
+    pos_t
+    getWindowEndPos(const unsigned windowIndex) const
+    {
+        return std::min(getWindowBeginPos(windowIndex) + windowSize, endPos);
+    }
+
+    double
+    getTotalCost() const;
+
+    /// \return predicted cost of [beginPos, pos)
+    double
+    getCumulativeCost(const pos_t pos) const;
+
+    /// \return the first position at which the cumulative cost reaches cost
+    pos_t
+    getCumulativeCostPos(const double cost) const;
+
+    pos_t beginPos;
+    pos_t endPos;
+    pos_t windowSize;
+
+    /// predicted cost of each window
+    std::vector<double> costs;
+};
+
+
+
+/// \brief A segment boundary which could not be placed within the maximum cut shift of its ideal position
+struct ShiftedSegmentBoundary
+{
+    ShiftedSegmentBoundary(
+        const pos_t initIdealPos,
+        const pos_t initPos)
+        : idealPos(initIdealPos),
+          pos(initPos)
+    {}
+
+    bool
+    isDropped() const
+    {
+        return (pos < 0);
+    }
+
+    pos_t idealPos;
+
+    /// the boundary position chosen by the widened search, or -1 if the boundary was dropped
+    pos_t pos;
+};
+
+
+
+/// \brief Find the boundaries which split a contig range into segments of approximately equal predicted cost
+///
+/// The ideal boundary between segments is moved to the nearest position where a cut is allowed, searching up to
+/// maxCutShift positions in either direction. If there is no allowed position in this range, the search is widened
+/// up to the previous boundary on the left and the next ideal boundary on the right. A boundary is only dropped if
+/// there is no allowed position in this widened range, so the number of segments may be less than segmentCount.
+///
+/// \param[in] isCutAllowed returns true if a segment boundary can be placed at the given position, so that the
+///                         segment to the left ends at this position
+/// \param[out] shiftedBoundaries if not null, each boundary which was moved beyond maxCutShift or dropped is
+///                               appended
+///
+/// \return the end position of each segment except the last, in increasing order
+std::vector<pos_t>
+getSegmentBoundaries(
+    const WindowCostTrack& costTrack,
+    const unsigned segmentCount,
+    const pos_t maxCutShift,
+    const std::function<bool(pos_t)>& isCutAllowed,
+    std::vector<ShiftedSegmentBoundary>* shiftedBoundaries = nullptr);
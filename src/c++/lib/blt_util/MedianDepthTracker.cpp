@@ -0,0 +1,106 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "MedianDepthTracker.hh"
+
+#include <cmath>
+
+#include <algorithm>
+
+
+const unsigned MedianDepthTracker::maxDenseDepth;
+
+
+
+void
+MedianDepthTracker::
+addObsOutsideDenseCounts(
+    const unsigned val,
+    const uint64_t count)
+{
+    if (val < maxDenseDepth)
+    {
+        _denseCounts.resize(val+1,0);
+        _denseCounts[val] += count;
+    }
+    else
+    {
+        _overflowCounts[val] += count;
+    }
+    _total += count;
+}
+
+
+
+double
+MedianDepthTracker::
+getMedian() const
+{
+    const uint64_t nonZeroTotal(_total - getZeroDepthObsCount());
+    if (nonZeroTotal == 0) return 0.;
+
+    const uint64_t midRank(nonZeroTotal/2);
+    if ((nonZeroTotal % 2) == 1)
+    {
+        return getNonZeroDepthAtRank(midRank);
+    }
+
+    const unsigned lowDepth(getNonZeroDepthAtRank(midRank-1));
+    const unsigned highDepth(getNonZeroDepthAtRank(midRank));
+    if (lowDepth == highDepth) return lowDepth;
+    return (static_cast<double>(lowDepth + highDepth)/2.);
+}
+
+
+
+unsigned
+MedianDepthTracker::
+getPercentile(const double percentile) const
+{
+    assert((percentile >= 0.) && (percentile <= 1.));
+
+    const uint64_t nonZeroTotal(_total - getZeroDepthObsCount());
+    if (nonZeroTotal == 0) return 0;
+
+    const uint64_t rank(static_cast<uint64_t>(std::ceil(percentile*nonZeroTotal)));
+    return getNonZeroDepthAtRank(std::max(rank,static_cast<uint64_t>(1))-1);
+}
+
+
+
+unsigned
+MedianDepthTracker::
+getNonZeroDepthAtRank(const uint64_t rank) const
+{
+    uint64_t sum(0);
+    const unsigned denseSize(_denseCounts.size());
+    for (unsigned depth(1); depth<denseSize; ++depth)
+    {
+        sum += _denseCounts[depth];
+        if (sum > rank) return depth;
+    }
+
+    for (const auto& val : _overflowCounts)
+    {
+        sum += val.second;
+        if (sum > rank) return val.first;
+    }
+
+    assert(false && "Depth rank exceeds observation count");
+    return 0;
+}
@@ -15,7 +15,6 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
-//
 
 /// \file
 /// \author Chris Saunders
@@ -24,69 +23,81 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 
 #include <map>
+#include <vector>
 
 
-/// online median tracking obj assuming high repeat obs counts
+/// Track the distribution of depth observations to find the median or any other percentile
+///
+/// Zero depth observations are counted but excluded from all depth queries.
+///
+/// Observations are counted in a dense histogram up to maxDenseDepth, so that adding an observation is only an
+/// array increment. Any higher depth observations are counted in a sparse overflow map, so that all queries remain
+/// exact for any depth.
 ///
-/// Note that by design depth=0 is excluded from the median
 struct MedianDepthTracker
 {
+    /// add count observations of depth val
     void
-    addObs(const unsigned val)
+    addObs(
+        const unsigned val,
+        const uint64_t count = 1)
     {
-        auto iter(_cmap.find(val));
-        if (iter == _cmap.end())
+        if (val < _denseCounts.size())
         {
-            _cmap[val] = 1;
+            _denseCounts[val] += count;
+            _total += count;
         }
         else
         {
-            iter->second++;
+            addObsOutsideDenseCounts(val, count);
         }
-        _total++;
     }
 
+    /// \return median of all non-zero depth observations, or zero if there are no such observations
+    ///
+    /// For an even number of observations, this is the mean of the two central values.
     double
-    getMedian() const
-    {
-        // +1 makes the 1/2 case work out correctly...
-        unsigned ztotal(_total+1);
-        const auto ziter(_cmap.find(0));
-        if (ziter != _cmap.end())
-        {
-            ztotal -= ziter->second;
-        }
+    getMedian() const;
 
-        unsigned sum = 0;
-        unsigned lastBefore = 0;
-        unsigned firstAfter = 0;
-        for (const auto& val : _cmap)
-        {
-            if (val.first == 0) continue;
+    /// \return the nearest-rank percentile of all non-zero depth observations, or zero if there are no such
+    /// observations
+    ///
+    /// \param percentile requested percentile in [0,1]
+    unsigned
+    getPercentile(const double percentile) const;
 
-            // double instead of half so that we stay away from float math:
-            sum += (val.second*2);
-            if (sum >= ztotal)
-            {
-                firstAfter = val.first;
-                if ((ztotal + val.second*2) != (sum + 1))
-                {
-                    lastBefore = firstAfter;
-                }
-                break;
-            }
-            lastBefore = val.first;
-        }
+    /// \return total observations, including zero depth observations
+    uint64_t
+    getObsCount() const
+    {
+        return _total;
+    }
 
-        assert ((sum+1) >= ztotal);
+private:
+    /// add observations of a depth beyond the current dense histogram size
+    ///
+    /// This is kept out of line so that the rare histogram expansion does not enlarge the inlined addObs
+    void
+    addObsOutsideDenseCounts(
+        const unsigned val,
+        const uint64_t count);
 
-        if (lastBefore == firstAfter) return lastBefore;
-        return (static_cast<double>(lastBefore + firstAfter)/2.);
+    uint64_t
+    getZeroDepthObsCount() const
+    {
+        return (_denseCounts.empty() ? 0 : _denseCounts[0]);
     }
 
-private:
-    unsigned _total = 0;
-    std::map<unsigned,unsigned> _cmap;
+    /// \return the depth value at zero-indexed rank among the sorted non-zero depth observations
+    unsigned
+    getNonZeroDepthAtRank(const uint64_t rank) const;
+
+    static const unsigned maxDenseDepth = 100000;
+
+    uint64_t _total = 0;
+    std::vector<uint64_t> _denseCounts;
+    std::map<unsigned,uint64_t> _overflowCounts;
 };
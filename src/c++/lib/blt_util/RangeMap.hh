@@ -28,6 +28,7 @@
 #include "boost/dynamic_bitset.hpp"
 
 #include <algorithm>
+#include <cassert>
 #include <sstream>
 #include <vector>
 
@@ -100,6 +101,36 @@ struct RangeMap
         return _isEmpty;
     }
 
+    /// \return the number of keys present
+    unsigned
+    size() const
+    {
+        return (_isEmpty ? 0 : _occup.count());
+    }
+
+    /// \return the number of values stored, this only grows until the object is destroyed
+    unsigned
+    capacity() const
+    {
+        return _data.size();
+    }
+
+    /// \return the lowest key present, only valid when the map is not empty
+    const KeyType&
+    getMinKey() const
+    {
+        assert(not _isEmpty);
+        return _minKey;
+    }
+
+    /// \return the highest key present, only valid when the map is not empty
+    const KeyType&
+    getMaxKey() const
+    {
+        assert(not _isEmpty);
+        return _maxKey;
+    }
+
     bool
     isKeyPresent(
         const KeyType& k) const
@@ -0,0 +1,187 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include <cstdint>
+
+
+/// \brief Bit-packed reference sequence context for a single base
+///
+/// Each value describes the homopolymer and short tandem repeat (STR) context of one reference
+/// position, precomputed over a full contig so that it can be looked up in O(1) during variant calling.
+///
+/// Bit layout:
+///  - [0,6)   SNP homopolymer size (as returned by get_snp_hpol_size), saturated at MaxHpolSize
+///  - [6,9)   smallest STR period in [1,MaxSTRPeriod] the base is part of, 0 if none
+///  - [9,14)  repeat count of the STR starting at this base, saturated at MaxSTRRepeatCount, only
+///            defined if the base is the left end of an STR
+///  - 14      the base is the left end of an STR with the above period
+///  - 15      the base is an active region anchor (see ReferenceRepeatFinder)
+///
+struct ReferenceAnnotation
+{
+    typedef uint16_t value_type;
+
+    static const unsigned MaxHpolSize = 63;
+    static const unsigned MaxSTRPeriod = 7;
+    static const unsigned MaxSTRRepeatCount = 31;
+
+    explicit
+    ReferenceAnnotation(
+        const value_type initValue = 0)
+        : _value(initValue)
+    {}
+
+    value_type
+    getValue() const
+    {
+        return _value;
+    }
+
+    /// \return SNP homopolymer size, a return value of MaxHpolSize means the size could be MaxHpolSize or greater
+    unsigned
+    getSnpHpolSize() const
+    {
+        return getField(HpolShift, HpolBits);
+    }
+
+    void
+    setSnpHpolSize(const unsigned hpolSize)
+    {
+        setField(HpolShift, HpolBits, (hpolSize > MaxHpolSize ? MaxHpolSize : hpolSize));
+    }
+
+    /// \return smallest STR period containing this base, or 0 if the base is not in an STR with period up to MaxSTRPeriod
+    unsigned
+    getSTRPeriod() const
+    {
+        return getField(PeriodShift, PeriodBits);
+    }
+
+    void
+    setSTRPeriod(const unsigned period)
+    {
+        setField(PeriodShift, PeriodBits, period);
+    }
+
+    /// \return repeat count of the STR starting at this position, a return value of MaxSTRRepeatCount
+    /// means the count could be MaxSTRRepeatCount or greater
+    unsigned
+    getSTRRepeatCount() const
+    {
+        return getField(RepeatCountShift, RepeatCountBits);
+    }
+
+    void
+    setSTRRepeatCount(const unsigned repeatCount)
+    {
+        setField(RepeatCountShift, RepeatCountBits,
+                 (repeatCount > MaxSTRRepeatCount ? MaxSTRRepeatCount : repeatCount));
+    }
+
+    bool
+    isLeftEndOfSTR() const
+    {
+        return getField(LeftEndShift, 1);
+    }
+
+    void
+    setLeftEndOfSTR(const bool isLeftEnd)
+    {
+        setField(LeftEndShift, 1, isLeftEnd);
+    }
+
+    bool
+    isAnchor() const
+    {
+        return getField(AnchorShift, 1);
+    }
+
+    void
+    setAnchor(const bool isAnchor)
+    {
+        setField(AnchorShift, 1, isAnchor);
+    }
+
+private:
+    enum
+    {
+        HpolShift = 0,
+        HpolBits = 6,
+        PeriodShift = 6,
+        PeriodBits = 3,
+        RepeatCountShift = 9,
+        RepeatCountBits = 5,
+        LeftEndShift = 14,
+        AnchorShift = 15
+    };
+
+    unsigned
+    getField(
+        const unsigned shift,
+        const unsigned bits) const
+    {
+        return ((_value >> shift) & ((1u << bits) - 1));
+    }
+
+    void
+    setField(
+        const unsigned shift,
+        const unsigned bits,
+        const unsigned fieldValue)
+    {
+        const unsigned mask(((1u << bits) - 1) << shift);
+        _value = static_cast<value_type>((_value & ~mask) | ((fieldValue << shift) & mask));
+    }
+
+    value_type _value;
+};
+
+
+
+/// \brief Precomputed annotation for all positions of a single contig
+///
+/// The annotation data is not owned by this object, it typically points into a memory-mapped
+/// ReferenceAnnotationTrack.
+///
+struct ReferenceAnnotationContig
+{
+    bool
+    empty() const
+    {
+        return (data == nullptr);
+    }
+
+    /// Number of reference bases covered by each value in blockChecksums
+    static const unsigned ChecksumBlockSize = 256;
+
+    const ReferenceAnnotation* data = nullptr;
+    pos_t size = 0;
+
+    /// Checksum of the reference sequence of each block of ChecksumBlockSize bases (the last block may be shorter),
+    /// used to detect an annotation computed from a different reference
+    const uint32_t* blockChecksums = nullptr;
+
+    /// ReferenceRepeatFinder parameters used to compute the anchor flags
+    unsigned maxRepeatUnitLength = 0;
+    unsigned minRepeatSpan = 0;
+};
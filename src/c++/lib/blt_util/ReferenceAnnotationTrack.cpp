@@ -0,0 +1,397 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "blt_util/blt_exception.hh"
+
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <limits>
+#include <sstream>
+
+
+const unsigned ReferenceAnnotation::MaxHpolSize;
+const unsigned ReferenceAnnotation::MaxSTRPeriod;
+const unsigned ReferenceAnnotation::MaxSTRRepeatCount;
+const unsigned ReferenceAnnotationContig::ChecksumBlockSize;
+
+
+static_assert(sizeof(ReferenceAnnotation) == sizeof(ReferenceAnnotation::value_type),
+              "Unexpected ReferenceAnnotation size");
+
+
+static const char trackMagic[8] = {'S','T','R','K','A','N','N','\0'};
+static const uint32_t trackVersion = 2;
+static const uint64_t trackAlignment = 8;
+
+
+
+static
+uint64_t
+alignOffset(const uint64_t offset)
+{
+    return ((offset + trackAlignment - 1) / trackAlignment) * trackAlignment;
+}
+
+
+
+/// \return number of checksum blocks for a contig of size contigSize
+static
+uint64_t
+getChecksumBlockCount(const uint64_t contigSize)
+{
+    static const uint64_t blockSize(ReferenceAnnotationContig::ChecksumBlockSize);
+    return ((contigSize + blockSize - 1) / blockSize);
+}
+
+
+
+uint32_t
+getReferenceBlockChecksum(
+    const char* seq,
+    const unsigned size)
+{
+    // 32-bit FNV-1a
+    uint32_t checksum(2166136261u);
+    for (unsigned seqIndex(0); seqIndex < size; ++seqIndex)
+    {
+        checksum ^= static_cast<uint8_t>(seq[seqIndex]);
+        checksum *= 16777619u;
+    }
+    return checksum;
+}
+
+
+
+bool
+isReferenceAnnotationChecksumMatch(const reference_contig_segment& ref)
+{
+    if (not ref.isAnnotated()) return true;
+
+    static const pos_t blockSize(ReferenceAnnotationContig::ChecksumBlockSize);
+    const ReferenceAnnotationContig& annotation(ref.getAnnotationContig());
+    const pos_t endPos(std::min(ref.end(), annotation.size));
+
+    std::string blockSeq;
+    for (pos_t blockIndex((ref.get_offset() + blockSize - 1) / blockSize); ; ++blockIndex)
+    {
+        const pos_t blockBeginPos(blockIndex * blockSize);
+        const pos_t blockEndPos(std::min(blockBeginPos + blockSize, annotation.size));
+        if ((blockBeginPos >= endPos) or (blockEndPos > endPos)) break;
+
+        ref.get_substring(blockBeginPos, (blockEndPos - blockBeginPos), blockSeq);
+        if (getReferenceBlockChecksum(blockSeq.data(), blockSeq.size()) != annotation.blockChecksums[blockIndex])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+static
+void
+throwTrackError(
+    const std::string& filename,
+    const char* msg)
+{
+    std::ostringstream oss;
+    oss << "Reference annotation track file '" << filename << "': " << msg;
+    throw blt_exception(oss.str().c_str());
+}
+
+
+
+struct ReferenceAnnotationTrack::MappedFile
+{
+    explicit
+    MappedFile(const std::string& filename)
+        : mapping(filename.c_str(), boost::interprocess::read_only),
+          region(mapping, boost::interprocess::read_only)
+    {}
+
+    const char*
+    data() const
+    {
+        return static_cast<const char*>(region.get_address());
+    }
+
+    uint64_t
+    size() const
+    {
+        return region.get_size();
+    }
+
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+
+
+namespace
+{
+
+/// bounds-checked reader for the track file header
+struct TrackHeaderReader
+{
+    TrackHeaderReader(
+        const std::string& filename,
+        const char* data,
+        const uint64_t size)
+        : _filename(filename), _data(data), _size(size)
+    {}
+
+    template <typename T>
+    T
+    read()
+    {
+        T val;
+        readBytes(&val, sizeof(T));
+        return val;
+    }
+
+    void
+    readBytes(
+        void* dest,
+        const uint64_t length)
+    {
+        if ((_offset + length) > _size) throwTrackError(_filename, "unexpected end of file");
+        std::memcpy(dest, _data + _offset, length);
+        _offset += length;
+    }
+
+    uint64_t
+    offset() const
+    {
+        return _offset;
+    }
+
+private:
+    const std::string& _filename;
+    const char* _data;
+    const uint64_t _size;
+    uint64_t _offset = 0;
+};
+
+}
+
+
+
+ReferenceAnnotationTrack::
+ReferenceAnnotationTrack(
+    const std::string& filename)
+    : _filename(filename)
+{
+    try
+    {
+        _mappedFile.reset(new MappedFile(filename));
+    }
+    catch (const boost::interprocess::interprocess_exception& e)
+    {
+        throwTrackError(filename, e.what());
+    }
+
+    TrackHeaderReader reader(filename, _mappedFile->data(), _mappedFile->size());
+
+    char magic[sizeof(trackMagic)];
+    reader.readBytes(magic, sizeof(magic));
+    if (std::memcmp(magic, trackMagic, sizeof(trackMagic)) != 0)
+    {
+        throwTrackError(filename, "not a reference annotation track");
+    }
+    if (reader.read<uint32_t>() != trackVersion)
+    {
+        throwTrackError(filename, "unsupported track version");
+    }
+    _maxRepeatUnitLength = reader.read<uint32_t>();
+    _minRepeatSpan = reader.read<uint32_t>();
+    const uint32_t contigCount(reader.read<uint32_t>());
+
+    std::vector<std::pair<std::string, uint64_t>> contigs;
+    for (uint32_t contigIndex(0); contigIndex < contigCount; ++contigIndex)
+    {
+        const uint32_t nameLength(reader.read<uint32_t>());
+        std::string name(nameLength, '\0');
+        reader.readBytes(&name[0], nameLength);
+        const uint64_t contigSize(reader.read<uint64_t>());
+        contigs.emplace_back(name, contigSize);
+    }
+
+    // contig sizes are checked against the remaining file size before computing any offset from them, so that a
+    // corrupt size can't overflow the offset calculation:
+    const uint64_t fileSize(_mappedFile->size());
+    uint64_t dataOffset(alignOffset(reader.offset()));
+    for (const auto& contig : contigs)
+    {
+        if (contig.second > static_cast<uint64_t>(std::numeric_limits<pos_t>::max()))
+        {
+            throwTrackError(filename, "invalid contig size");
+        }
+        if ((dataOffset > fileSize) or (contig.second > ((fileSize - dataOffset) / sizeof(ReferenceAnnotation))))
+        {
+            throwTrackError(filename, "unexpected end of file");
+        }
+        const uint64_t dataSize(contig.second * sizeof(ReferenceAnnotation));
+        const uint64_t checksumOffset(alignOffset(dataOffset + dataSize));
+        const uint64_t checksumSize(getChecksumBlockCount(contig.second) * sizeof(uint32_t));
+        if ((checksumOffset > fileSize) or (checksumSize > (fileSize - checksumOffset)))
+        {
+            throwTrackError(filename, "unexpected end of file");
+        }
+
+        ReferenceAnnotationContig& annotation(_contigs[contig.first]);
+        annotation.data = reinterpret_cast<const ReferenceAnnotation*>(_mappedFile->data() + dataOffset);
+        annotation.size = static_cast<pos_t>(contig.second);
+        annotation.blockChecksums = reinterpret_cast<const uint32_t*>(_mappedFile->data() + checksumOffset);
+        annotation.maxRepeatUnitLength = _maxRepeatUnitLength;
+        annotation.minRepeatSpan = _minRepeatSpan;
+        dataOffset = alignOffset(checksumOffset + checksumSize);
+    }
+}
+
+
+
+// dtor is required here for unique_ptr
+ReferenceAnnotationTrack::
+~ReferenceAnnotationTrack() {}
+
+
+
+ReferenceAnnotationContig
+ReferenceAnnotationTrack::
+getContig(
+    const std::string& chrom) const
+{
+    const auto iter(_contigs.find(chrom));
+    if (iter == _contigs.end()) return ReferenceAnnotationContig();
+    return iter->second;
+}
+
+
+
+template <typename T>
+static
+void
+writeValue(
+    std::ostream& os,
+    const T& val)
+{
+    os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+
+ReferenceAnnotationTrackWriter::
+ReferenceAnnotationTrackWriter(
+    const std::string& filename,
+    const contigs_t& contigs,
+    const unsigned maxRepeatUnitLength,
+    const unsigned minRepeatSpan)
+    : _filename(filename),
+      _contigs(contigs),
+      _ofs(filename.c_str(), std::ios::binary)
+{
+    if (not _ofs) throwTrackError(filename, "can't open file for writing");
+
+    _ofs.write(trackMagic, sizeof(trackMagic));
+    writeValue<uint32_t>(_ofs, trackVersion);
+    writeValue<uint32_t>(_ofs, maxRepeatUnitLength);
+    writeValue<uint32_t>(_ofs, minRepeatSpan);
+    writeValue<uint32_t>(_ofs, _contigs.size());
+    for (const auto& contig : _contigs)
+    {
+        writeValue<uint32_t>(_ofs, contig.first.size());
+        _ofs.write(contig.first.data(), contig.first.size());
+        writeValue<uint64_t>(_ofs, contig.second);
+    }
+    writePadding();
+}
+
+
+
+void
+ReferenceAnnotationTrackWriter::
+writePadding()
+{
+    const uint64_t offset(_ofs.tellp());
+    const uint64_t padSize(alignOffset(offset) - offset);
+    for (uint64_t padIndex(0); padIndex < padSize; ++padIndex)
+    {
+        _ofs.put('\0');
+    }
+}
+
+
+
+void
+ReferenceAnnotationTrackWriter::
+writeContig(
+    const std::string& chrom,
+    const std::string& seq,
+    const std::vector<ReferenceAnnotation>& annotation)
+{
+    if (_contigIndex >= _contigs.size())
+    {
+        throwTrackError(_filename, "attempting to write more contigs than specified in header");
+    }
+
+    const auto& contig(_contigs[_contigIndex]);
+    if ((contig.first != chrom) or (contig.second != static_cast<pos_t>(annotation.size())) or
+        (seq.size() != annotation.size()))
+    {
+        std::ostringstream oss;
+        oss << "unexpected contig '" << chrom << "' of size " << annotation.size()
+            << ", expected contig '" << contig.first << "' of size " << contig.second;
+        throwTrackError(_filename, oss.str().c_str());
+    }
+
+    _ofs.write(reinterpret_cast<const char*>(annotation.data()), annotation.size()*sizeof(ReferenceAnnotation));
+    writePadding();
+
+    static const uint64_t blockSize(ReferenceAnnotationContig::ChecksumBlockSize);
+    const uint64_t blockCount(getChecksumBlockCount(seq.size()));
+    for (uint64_t blockIndex(0); blockIndex < blockCount; ++blockIndex)
+    {
+        const uint64_t blockBeginPos(blockIndex * blockSize);
+        const uint64_t blockLength(std::min<uint64_t>(blockSize, seq.size() - blockBeginPos));
+        writeValue<uint32_t>(_ofs, getReferenceBlockChecksum(seq.data() + blockBeginPos, blockLength));
+    }
+    writePadding();
+    _contigIndex++;
+}
+
+
+
+void
+ReferenceAnnotationTrackWriter::
+close()
+{
+    if (_contigIndex != _contigs.size())
+    {
+        throwTrackError(_filename, "not all contigs were written");
+    }
+    _ofs.close();
+    if (_ofs.fail()) throwTrackError(_filename, "error writing file");
+}
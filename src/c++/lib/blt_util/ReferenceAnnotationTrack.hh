@@ -0,0 +1,132 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "blt_util/ReferenceAnnotation.hh"
+#include "blt_util/reference_contig_segment.hh"
+
+#include "boost/utility.hpp"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// \return checksum of the reference sequence of one annotation checksum block
+uint32_t
+getReferenceBlockChecksum(
+    const char* seq,
+    const unsigned size);
+
+
+
+/// \return false if ref is annotated and the sequence of any annotation checksum block lying entirely within ref
+///         does not match the checksum stored in the annotation
+bool
+isReferenceAnnotationChecksumMatch(const reference_contig_segment& ref);
+
+
+
+/// \brief Read-only access to a memory-mapped reference annotation track file
+///
+/// The track file holds a ReferenceAnnotation value for every base of every contig in a reference,
+/// and is produced offline by the CreateReferenceAnnotation tool. Because the file is memory-mapped
+/// read-only, the pages are shared between all processes using the same track.
+///
+/// The track also holds checksums of the reference sequence in fixed size blocks, so that each reference segment
+/// can be checked against the reference the track was computed from (see isReferenceAnnotationChecksumMatch).
+///
+struct ReferenceAnnotationTrack : private boost::noncopyable
+{
+    explicit
+    ReferenceAnnotationTrack(
+        const std::string& filename);
+
+    ~ReferenceAnnotationTrack();
+
+    /// \return the annotation of contig chrom, or an empty object if chrom is not in the track
+    ReferenceAnnotationContig
+    getContig(
+        const std::string& chrom) const;
+
+    unsigned
+    getMaxRepeatUnitLength() const
+    {
+        return _maxRepeatUnitLength;
+    }
+
+    unsigned
+    getMinRepeatSpan() const
+    {
+        return _minRepeatSpan;
+    }
+
+private:
+    struct MappedFile;
+
+    std::string _filename;
+    std::unique_ptr<MappedFile> _mappedFile;
+    unsigned _maxRepeatUnitLength = 0;
+    unsigned _minRepeatSpan = 0;
+
+    /// map from contig name to annotation
+    std::map<std::string, ReferenceAnnotationContig> _contigs;
+};
+
+
+
+/// \brief Write a reference annotation track file
+///
+/// The complete list of contigs is provided up front, after which the annotation for each contig
+/// must be written in the same order.
+///
+struct ReferenceAnnotationTrackWriter : private boost::noncopyable
+{
+    typedef std::vector<std::pair<std::string, pos_t>> contigs_t;
+
+    ReferenceAnnotationTrackWriter(
+        const std::string& filename,
+        const contigs_t& contigs,
+        const unsigned maxRepeatUnitLength,
+        const unsigned minRepeatSpan);
+
+    /// \param[in] seq standardized reference sequence of the contig, used to compute the block checksums
+    void
+    writeContig(
+        const std::string& chrom,
+        const std::string& seq,
+        const std::vector<ReferenceAnnotation>& annotation);
+
+    /// complete the track file, it is an error if any contigs have not been written
+    void
+    close();
+
+private:
+    void
+    writePadding();
+
+    std::string _filename;
+    contigs_t _contigs;
+    unsigned _contigIndex = 0;
+    std::ofstream _ofs;
+};
@@ -0,0 +1,185 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "blt_util/ReferenceImage.hh"
+
+#include "blt_util/blt_exception.hh"
+#include "blt_util/parse_util.hh"
+#include "blt_util/string_util.hh"
+
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include <sstream>
+#include <vector>
+
+
+
+static
+void
+throwImageError(
+    const std::string& filename,
+    const char* msg)
+{
+    std::ostringstream oss;
+    oss << "Reference image file '" << filename << "': " << msg;
+    throw blt_exception(oss.str().c_str());
+}
+
+
+
+struct ReferenceImage::MappedFile
+{
+    explicit
+    MappedFile(const std::string& filename)
+        : mapping(filename.c_str(), boost::interprocess::read_only),
+          region(mapping, boost::interprocess::read_only)
+    {}
+
+    const char*
+    data() const
+    {
+        return static_cast<const char*>(region.get_address());
+    }
+
+    uint64_t
+    size() const
+    {
+        return region.get_size();
+    }
+
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+
+
+ReferenceImage::
+ReferenceImage(
+    const std::string& filename)
+    : _filename(filename)
+{
+    try
+    {
+        _mappedFile.reset(new MappedFile(filename));
+    }
+    catch (const boost::interprocess::interprocess_exception& e)
+    {
+        throwImageError(filename, e.what());
+    }
+
+    const std::string faiFilename(filename + ".fai");
+    std::ifstream fais(faiFilename.c_str());
+    if (not fais) throwImageError(filename, "can't open fasta index");
+
+    using namespace illumina::blt_util;
+
+    std::string line;
+    std::vector<std::string> words;
+    while (std::getline(fais, line))
+    {
+        if (line.empty()) continue;
+        split_string(line, '\t', words);
+        if (words.size() < 5) throwImageError(filename, "unexpected fasta index format");
+
+        const long contigSize(parse_long_str(words[1]));
+        const long offset(parse_long_str(words[2]));
+        const long lineBases(parse_long_str(words[3]));
+        if ((contigSize < 0) or (offset < 0))
+        {
+            throwImageError(filename, "unexpected fasta index format");
+        }
+        if ((contigSize > 0) and (lineBases != contigSize))
+        {
+            std::ostringstream oss;
+            oss << "contig '" << words[0] << "' is not stored on a single line";
+            throwImageError(filename, oss.str().c_str());
+        }
+        if (static_cast<uint64_t>(offset + contigSize) > _mappedFile->size())
+        {
+            throwImageError(filename, "unexpected end of file");
+        }
+        _contigs[words[0]] = std::make_pair(_mappedFile->data() + offset, static_cast<pos_t>(contigSize));
+    }
+}
+
+
+
+// dtor is required here for unique_ptr
+ReferenceImage::
+~ReferenceImage() {}
+
+
+
+const char*
+ReferenceImage::
+getContig(
+    const std::string& chrom,
+    pos_t& contigSize) const
+{
+    const auto iter(_contigs.find(chrom));
+    if (iter == _contigs.end())
+    {
+        contigSize = 0;
+        return nullptr;
+    }
+
+    contigSize = iter->second.second;
+    return iter->second.first;
+}
+
+
+
+ReferenceImageWriter::
+ReferenceImageWriter(
+    const std::string& filename)
+    : _filename(filename),
+      _ofs(filename.c_str(), std::ios::binary),
+      _faiOfs((filename + ".fai").c_str())
+{
+    if (not _ofs) throwImageError(filename, "can't open file for writing");
+    if (not _faiOfs) throwImageError(filename, "can't open fasta index for writing");
+}
+
+
+
+void
+ReferenceImageWriter::
+writeContig(
+    const std::string& chrom,
+    const std::string& seq)
+{
+    const std::string header('>' + chrom + '\n');
+    _ofs << header << seq << '\n';
+    _offset += header.size();
+
+    _faiOfs << chrom << '\t' << seq.size() << '\t' << _offset << '\t' << seq.size() << '\t' << (seq.size()+1) << '\n';
+    _offset += seq.size() + 1;
+}
+
+
+
+void
+ReferenceImageWriter::
+close()
+{
+    _ofs.close();
+    _faiOfs.close();
+    if (_ofs.fail() or _faiOfs.fail()) throwImageError(_filename, "error writing file");
+}
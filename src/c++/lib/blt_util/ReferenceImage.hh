@@ -0,0 +1,100 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/utility.hpp"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+
+/// \brief Read-only access to a memory-mapped reference image
+///
+/// The reference image is a FASTA file with each contig sequence uppercased and written on a single
+/// line, accompanied by a standard samtools fasta index. It is produced offline by the CreateReferenceImage
+/// tool. Because every contig is stored contiguously, reference segments can be served directly from the
+/// read-only mapping without copying, so that all calling processes on a host share one copy of the reference
+/// in the page cache.
+///
+/// The image is still a valid indexed FASTA file, so it can be given to htslib in place of the original
+/// reference to decode CRAM input. Uppercasing does not change the CRAM reference MD5 checksums.
+///
+struct ReferenceImage : private boost::noncopyable
+{
+    /// \param filename reference image fasta file, the corresponding index is expected at filename + ".fai"
+    explicit
+    ReferenceImage(
+        const std::string& filename);
+
+    ~ReferenceImage();
+
+    /// \return a pointer to the full sequence of contig chrom, or nullptr if chrom is not in the image
+    const char*
+    getContig(
+        const std::string& chrom,
+        pos_t& contigSize) const;
+
+    const std::string&
+    getFilename() const
+    {
+        return _filename;
+    }
+
+private:
+    struct MappedFile;
+
+    std::string _filename;
+    std::unique_ptr<MappedFile> _mappedFile;
+
+    /// map from contig name to (data, size)
+    std::map<std::string, std::pair<const char*, pos_t>> _contigs;
+};
+
+
+
+/// \brief Write a reference image and its fasta index
+///
+/// Contig sequences are expected to be uppercased by the caller
+///
+struct ReferenceImageWriter : private boost::noncopyable
+{
+    explicit
+    ReferenceImageWriter(
+        const std::string& filename);
+
+    void
+    writeContig(
+        const std::string& chrom,
+        const std::string& seq);
+
+    void
+    close();
+
+private:
+    std::string _filename;
+    std::ofstream _ofs;
+    std::ofstream _faiOfs;
+    uint64_t _offset = 0;
+};
@@ -0,0 +1,222 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Compact ordered set and map containers backed by a single sorted vector
+///
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+/// \brief A subset of the std::set interface stored as a sorted vector
+///
+/// This is intended for small-valued keys such as read ids which are usually inserted in increasing order. An
+/// insertion beyond the current last key is a simple append, other insertions cost a move of all greater keys.
+/// Compared to a std::set, this stores all keys in one contiguous allocation without per-node overhead, and
+/// iteration is a linear scan.
+///
+template <typename K, typename COMPARE = std::less<K>>
+struct SortedVectorSet
+{
+    typedef K key_type;
+    typedef K value_type;
+    typedef typename std::vector<K>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    /// \brief Insert key if not already present
+    ///
+    /// \return an iterator to the key in the set and true if the key was inserted
+    std::pair<iterator,bool>
+    insert(const K& key)
+    {
+        if (_data.empty() or _comp(_data.back(), key))
+        {
+            _data.push_back(key);
+            return std::make_pair(_data.cend()-1, true);
+        }
+        const auto iter(std::lower_bound(_data.begin(), _data.end(), key, _comp));
+        if ((iter != _data.end()) and (not _comp(key, *iter)))
+        {
+            return std::make_pair(const_iterator(iter), false);
+        }
+        return std::make_pair(const_iterator(_data.insert(iter, key)), true);
+    }
+
+    const_iterator
+    find(const K& key) const
+    {
+        const const_iterator iter(std::lower_bound(_data.cbegin(), _data.cend(), key, _comp));
+        if ((iter == _data.cend()) or _comp(key, *iter)) return _data.cend();
+        return iter;
+    }
+
+    unsigned
+    count(const K& key) const
+    {
+        return ((find(key) == _data.cend()) ? 0 : 1);
+    }
+
+    const_iterator
+    begin() const
+    {
+        return _data.cbegin();
+    }
+
+    const_iterator
+    end() const
+    {
+        return _data.cend();
+    }
+
+    unsigned
+    size() const
+    {
+        return _data.size();
+    }
+
+    bool
+    empty() const
+    {
+        return _data.empty();
+    }
+
+    void
+    clear()
+    {
+        _data.clear();
+    }
+
+private:
+    std::vector<K> _data;
+    COMPARE _comp;
+};
+
+
+
+/// \brief A subset of the std::map interface stored as a sorted vector of key/value pairs
+///
+/// Insertion and storage follow SortedVectorSet. Iterators and references to values are invalidated by any
+/// insertion.
+///
+template <typename K, typename V, typename COMPARE = std::less<K>>
+struct SortedVectorMap
+{
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K,V> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    /// \brief Return the value for key, inserting a default value if the key is not present
+    V&
+    operator[](const K& key)
+    {
+        if (_data.empty() or _comp(_data.back().first, key))
+        {
+            _data.emplace_back(key, V());
+            return _data.back().second;
+        }
+        const iterator iter(lowerBound(key));
+        if ((iter != _data.end()) and (not _comp(key, iter->first)))
+        {
+            return iter->second;
+        }
+        return _data.insert(iter, value_type(key, V()))->second;
+    }
+
+    iterator
+    find(const K& key)
+    {
+        const iterator iter(lowerBound(key));
+        if ((iter == _data.end()) or _comp(key, iter->first)) return _data.end();
+        return iter;
+    }
+
+    const_iterator
+    find(const K& key) const
+    {
+        return const_cast<SortedVectorMap*>(this)->find(key);
+    }
+
+    unsigned
+    count(const K& key) const
+    {
+        return ((find(key) == _data.cend()) ? 0 : 1);
+    }
+
+    iterator
+    begin()
+    {
+        return _data.begin();
+    }
+
+    iterator
+    end()
+    {
+        return _data.end();
+    }
+
+    const_iterator
+    begin() const
+    {
+        return _data.cbegin();
+    }
+
+    const_iterator
+    end() const
+    {
+        return _data.cend();
+    }
+
+    unsigned
+    size() const
+    {
+        return _data.size();
+    }
+
+    bool
+    empty() const
+    {
+        return _data.empty();
+    }
+
+    void
+    clear()
+    {
+        _data.clear();
+    }
+
+private:
+    iterator
+    lowerBound(const K& key)
+    {
+        return std::lower_bound(_data.begin(), _data.end(), key,
+                                [this](const value_type& val, const K& k)
+        {
+            return _comp(val.first, k);
+        });
+    }
+
+    std::vector<value_type> _data;
+    COMPARE _comp;
+};
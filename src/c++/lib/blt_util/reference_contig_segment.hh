@@ -24,6 +24,9 @@
 #pragma once
 
 #include "blt_util/blt_types.hh"
+#include "blt_util/ReferenceAnnotation.hh"
+
+#include <cassert>
 
 #include <string>
 
@@ -35,6 +38,9 @@
 /// the reference that is currently required (to save memory), but access the reference using
 /// the regular position coordinates of the full reference sequence.
 ///
+/// The segment can either own a copy of its sequence, or act as a read-only view of sequence owned
+/// elsewhere, such as a memory-mapped reference image (see \ref setView).
+///
 /// \TODO Do not expose internal reference storage object type.
 ///
 struct reference_contig_segment
@@ -47,7 +53,7 @@ struct reference_contig_segment
     get_base(const pos_t pos) const
     {
         if (pos<_offset || pos>=end()) return 'N';
-        return _seq[pos-_offset];
+        return data()[pos-_offset];
     }
 
     void
@@ -68,19 +74,46 @@ struct reference_contig_segment
         else
         {
             //fast path
-            substr.assign(_seq,pos-_offset,length);
+            substr.assign(data()+(pos-_offset),length);
         }
     }
 
+    /// \return modifiable sequence storage, this discards any view set on the segment
     std::string& seq()
     {
+        clearView();
         return _seq;
     }
+
+    /// \return sequence storage, only valid when the segment is not a view
     const std::string& seq() const
     {
+        assert(not isView());
         return _seq;
     }
 
+    /// \brief Set the segment sequence to a read-only view of [seqPtr,seqPtr+size)
+    ///
+    /// The viewed sequence is not copied, so it must outlive the view and must already be standardized
+    /// (see \ref standardize_ref_seq).
+    void
+    setView(
+        const char* seqPtr,
+        const pos_t size)
+    {
+        assert(nullptr != seqPtr);
+        assert(size >= 0);
+        _seq.clear();
+        _viewPtr = seqPtr;
+        _viewSize = size;
+    }
+
+    bool
+    isView() const
+    {
+        return (nullptr != _viewPtr);
+    }
+
     pos_t
     get_offset() const
     {
@@ -96,7 +129,47 @@ struct reference_contig_segment
     pos_t
     end() const
     {
-        return _offset+_seq.size();
+        return _offset+size();
+    }
+
+    /// \return true if [beginPos,endPos) is entirely contained in this segment
+    bool
+    isRangeInSegment(
+        const pos_t beginPos,
+        const pos_t endPos) const
+    {
+        return ((beginPos >= _offset) and (endPos <= end()));
+    }
+
+    /// attach the precomputed annotation track for the full contig this segment is taken from
+    void
+    setAnnotation(const ReferenceAnnotationContig& annotation)
+    {
+        _annotation = annotation;
+    }
+
+    bool
+    isAnnotated() const
+    {
+        return (not _annotation.empty());
+    }
+
+    const ReferenceAnnotationContig&
+    getAnnotationContig() const
+    {
+        return _annotation;
+    }
+
+    /// \return the precomputed annotation for pos
+    ///
+    /// Annotation values are computed over the full contig, so any value which depends on sequence context
+    /// extending beyond this segment may differ from the value computed directly from the segment.
+    ReferenceAnnotation
+    getAnnotation(const pos_t pos) const
+    {
+        assert(isAnnotated());
+        assert((pos >= 0) and (pos < _annotation.size));
+        return _annotation.data[pos];
     }
 
     void
@@ -104,10 +177,34 @@ struct reference_contig_segment
     {
         _offset=0;
         _seq.clear();
+        clearView();
+        _annotation = ReferenceAnnotationContig();
     }
 
 private:
 
+    const char*
+    data() const
+    {
+        return (isView() ? _viewPtr : _seq.data());
+    }
+
+    pos_t
+    size() const
+    {
+        return (isView() ? _viewSize : static_cast<pos_t>(_seq.size()));
+    }
+
+    void
+    clearView()
+    {
+        _viewPtr = nullptr;
+        _viewSize = 0;
+    }
+
     pos_t _offset;
     std::string _seq;
+    const char* _viewPtr = nullptr;
+    pos_t _viewSize = 0;
+    ReferenceAnnotationContig _annotation;
 };
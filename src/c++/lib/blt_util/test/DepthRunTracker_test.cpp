@@ -0,0 +1,176 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "DepthRunTracker.hh"
+#include "depth_buffer.hh"
+
+#include <map>
+
+
+BOOST_AUTO_TEST_SUITE( test_DepthRunTracker )
+
+
+typedef std::vector<std::pair<pos_t,unsigned>> reads_t;
+
+
+/// compute the expected depth histogram by adding each read position directly
+static
+void
+getExpectedHistogram(
+    const reads_t& reads,
+    MedianDepthTracker& expected)
+{
+    std::map<pos_t,unsigned> depth;
+    for (const auto& read : reads)
+    {
+        for (unsigned offset(0); offset<read.second; ++offset) depth[read.first+offset]++;
+    }
+
+    const pos_t beginPos(reads.front().first);
+    const pos_t endPos(reads.back().first);
+    for (pos_t pos(beginPos); pos<=endPos; ++pos)
+    {
+        expected.addObs(depth[pos]);
+    }
+}
+
+
+
+/// compute the expected depth histogram with the binned depth_buffer_compressible scheme, flushing each position
+/// when the first read beginning after it is added
+static
+void
+getExpectedBinnedHistogram(
+    const reads_t& reads,
+    const unsigned binSize,
+    MedianDepthTracker& expected)
+{
+    depth_buffer_compressible depth(binSize);
+    pos_t maxPos(reads.front().first);
+    for (const auto& read : reads)
+    {
+        for (; maxPos<read.first; ++maxPos)
+        {
+            expected.addObs(depth.val(maxPos));
+            depth.clear_pos(maxPos);
+        }
+        depth.inc(read.first,read.second);
+    }
+    expected.addObs(depth.val(maxPos));
+}
+
+
+
+static
+void
+checkHistogram(
+    const MedianDepthTracker& result,
+    const MedianDepthTracker& expected)
+{
+    static const double eps(0.00001);
+
+    BOOST_REQUIRE_EQUAL(result.getObsCount(),expected.getObsCount());
+    BOOST_REQUIRE_CLOSE(result.getMedian(),expected.getMedian(),eps);
+    for (const double percentile : { 0., 0.1, 0.25, 0.75, 0.9, 1. })
+    {
+        BOOST_REQUIRE_EQUAL(result.getPercentile(percentile),expected.getPercentile(percentile));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_DepthRunTrackerEmpty )
+{
+    DepthRunTracker tracker;
+    tracker.finishRegion();
+
+    BOOST_REQUIRE_EQUAL(tracker.getDepthHistogram().getObsCount(),0u);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_DepthRunTrackerSimple )
+{
+    // reads include a gap, and reads longer than the initial buffer size:
+    const reads_t reads = { {10,5}, {10,3}, {12,1}, {12,6}, {20,4}, {40,10}, {41,2}, {41,20}, {45,3} };
+
+    DepthRunTracker tracker(1,4);
+    for (const auto& read : reads)
+    {
+        tracker.addRead(read.first, read.second);
+    }
+    tracker.finishRegion();
+
+    MedianDepthTracker expected;
+    getExpectedHistogram(reads, expected);
+    checkHistogram(tracker.getDepthHistogram(), expected);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_DepthRunTrackerRegions )
+{
+    const reads_t reads1 = { {100,50}, {110,50}, {120,50} };
+    const reads_t reads2 = { {10,5}, {11,5} };
+
+    // test that regions are independent, and may be added out of order:
+    DepthRunTracker tracker(1,8);
+    for (const auto& reads : { reads1, reads2 })
+    {
+        for (const auto& read : reads)
+        {
+            tracker.addRead(read.first, read.second);
+        }
+        tracker.finishRegion();
+    }
+
+    MedianDepthTracker expected;
+    getExpectedHistogram(reads1, expected);
+    getExpectedHistogram(reads2, expected);
+    checkHistogram(tracker.getDepthHistogram(), expected);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_DepthRunTrackerBinned )
+{
+    // reads include partial bins, reads spanning many bins, a gap of several empty bins, and reads longer than
+    // the initial buffer size:
+    const reads_t reads = { {3,5}, {3,40}, {7,1}, {12,6}, {15,2}, {16,16}, {20,4}, {90,10}, {91,2}, {91,60},
+        {95,3}, {95,17}, {110,1}, {111,30}
+    };
+
+    for (const unsigned binSize : { 1u, 2u, 5u, 16u })
+    {
+        DepthRunTracker tracker(binSize,2);
+        for (const auto& read : reads)
+        {
+            tracker.addRead(read.first, read.second);
+        }
+        tracker.finishRegion();
+
+        MedianDepthTracker expected;
+        getExpectedBinnedHistogram(reads, binSize, expected);
+        checkHistogram(tracker.getDepthHistogram(), expected);
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/GenomeSegmentPlanner.hh"
+
+
+BOOST_AUTO_TEST_SUITE( GenomeSegmentPlanner_test_suite )
+
+
+BOOST_AUTO_TEST_CASE( test_cumulativeCost )
+{
+    // the last window is truncated to 5 positions:
+    WindowCostTrack costTrack(100, 125, 10);
+    BOOST_REQUIRE_EQUAL(costTrack.getWindowCount(), 3u);
+    BOOST_REQUIRE_EQUAL(costTrack.getWindowEndPos(2), 125);
+    costTrack.costs = { 10., 0., 5. };
+
+    BOOST_REQUIRE_CLOSE(costTrack.getTotalCost(), 15., 0.0001);
+    BOOST_REQUIRE_CLOSE(costTrack.getCumulativeCost(105), 5., 0.0001);
+    BOOST_REQUIRE_CLOSE(costTrack.getCumulativeCost(115), 10., 0.0001);
+    BOOST_REQUIRE_CLOSE(costTrack.getCumulativeCost(122), 12., 0.0001);
+
+    BOOST_REQUIRE_EQUAL(costTrack.getCumulativeCostPos(5.), 105);
+    BOOST_REQUIRE_EQUAL(costTrack.getCumulativeCostPos(12.), 122);
+    BOOST_REQUIRE_EQUAL(costTrack.getCumulativeCostPos(20.), 125);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_equalCostBoundaries )
+{
+    // a high cost window is split into more segments than the low cost windows:
+    WindowCostTrack costTrack(0, 400, 100);
+    costTrack.costs = { 1., 1., 4., 2. };
+
+    const auto allowAll([](pos_t) { return true; });
+    const std::vector<pos_t> expect = { 200, 250, 300 };
+    BOOST_REQUIRE(getSegmentBoundaries(costTrack, 4, 10, allowAll) == expect);
+
+    BOOST_REQUIRE(getSegmentBoundaries(costTrack, 1, 10, allowAll).empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_allowedCutBoundaries )
+{
+    WindowCostTrack costTrack(0, 400, 100);
+    costTrack.costs = { 1., 1., 1., 1. };
+
+    // boundaries move to the nearest allowed position:
+    const auto isCutAllowed([](pos_t pos) { return ((pos == 97) or (pos == 205) or (pos == 309)); });
+    const std::vector<pos_t> expect = { 97, 205, 309 };
+    std::vector<ShiftedSegmentBoundary> shiftedBoundaries;
+    BOOST_REQUIRE(getSegmentBoundaries(costTrack, 4, 10, isCutAllowed, &shiftedBoundaries) == expect);
+    BOOST_REQUIRE(shiftedBoundaries.empty());
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_widenedCutBoundaries )
+{
+    WindowCostTrack costTrack(0, 400, 100);
+    costTrack.costs = { 1., 1., 1., 1. };
+
+    // if no position is allowed within the maximum shift, the boundary moves to the nearest allowed position between
+    // the previous boundary and the next ideal boundary, and is only dropped if there is none:
+    const auto isCutAllowed([](pos_t pos) { return ((pos == 97) or (pos == 140) or (pos == 350)); });
+    const std::vector<pos_t> expect = { 97, 140, 350 };
+    std::vector<ShiftedSegmentBoundary> shiftedBoundaries;
+    BOOST_REQUIRE(getSegmentBoundaries(costTrack, 4, 10, isCutAllowed, &shiftedBoundaries) == expect);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries.size(), 2u);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries[0].idealPos, 200);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries[0].pos, 140);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries[1].idealPos, 300);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries[1].pos, 350);
+
+    const auto isOneCutAllowed([](pos_t pos) { return (pos == 97); });
+    const std::vector<pos_t> expectOne = { 97 };
+    shiftedBoundaries.clear();
+    BOOST_REQUIRE(getSegmentBoundaries(costTrack, 4, 10, isOneCutAllowed, &shiftedBoundaries) == expectOne);
+    BOOST_REQUIRE_EQUAL(shiftedBoundaries.size(), 2u);
+    BOOST_REQUIRE(shiftedBoundaries[0].isDropped());
+    BOOST_REQUIRE(shiftedBoundaries[1].isDropped());
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
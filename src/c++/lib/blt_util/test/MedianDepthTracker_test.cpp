@@ -110,5 +110,61 @@ BOOST_AUTO_TEST_CASE( test_MDT3 )
 }
 
 
+BOOST_AUTO_TEST_CASE( test_MDTWeighted )
+{
+    static const double eps(0.00001);
+
+    MedianDepthTracker t;
+
+    t.addObs(0,10);
+    t.addObs(1,5);
+    t.addObs(4,5);
+
+    BOOST_REQUIRE_CLOSE(t.getMedian(),2.5,eps);
+
+    t.addObs(4);
+
+    BOOST_REQUIRE_CLOSE(t.getMedian(),4.,eps);
+    BOOST_REQUIRE_EQUAL(t.getObsCount(),21u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_MDTOverflow )
+{
+    static const double eps(0.00001);
+
+    MedianDepthTracker t;
+
+    // test values above the dense histogram limit:
+    t.addObs(10);
+    t.addObs(1000000,2);
+
+    BOOST_REQUIRE_CLOSE(t.getMedian(),1000000.,eps);
+
+    t.addObs(20);
+
+    BOOST_REQUIRE_CLOSE(t.getMedian(),500010.,eps);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_MDTPercentile )
+{
+    MedianDepthTracker t;
+
+    BOOST_REQUIRE_EQUAL(t.getPercentile(0.5),0u);
+
+    t.addObs(0,100);
+    for (unsigned depth(1); depth<=100; ++depth)
+    {
+        t.addObs(depth);
+    }
+
+    BOOST_REQUIRE_EQUAL(t.getPercentile(0.),1u);
+    BOOST_REQUIRE_EQUAL(t.getPercentile(0.5),50u);
+    BOOST_REQUIRE_EQUAL(t.getPercentile(0.95),95u);
+    BOOST_REQUIRE_EQUAL(t.getPercentile(1.),100u);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -142,5 +142,26 @@ BOOST_AUTO_TEST_CASE( test_rangeMap_dataSizeBoundary )
     BOOST_REQUIRE_EQUAL(rm.getConstRef(8), 1);
 }
 
+BOOST_AUTO_TEST_CASE( test_rangeMap_size )
+{
+    RangeMap<int,int> rm(8);
+    BOOST_REQUIRE_EQUAL(rm.size(), 0u);
+
+    rm.getRef(3) += 1;
+    rm.getRef(5) += 1;
+    rm.getRef(20) += 1;
+    BOOST_REQUIRE_EQUAL(rm.size(), 3u);
+    BOOST_REQUIRE_EQUAL(rm.getMinKey(), 3);
+    BOOST_REQUIRE_EQUAL(rm.getMaxKey(), 20);
+    BOOST_REQUIRE(rm.capacity() >= 18u);
+
+    rm.eraseTo(5);
+    BOOST_REQUIRE_EQUAL(rm.size(), 1u);
+    BOOST_REQUIRE_EQUAL(rm.getMinKey(), 20);
+
+    rm.erase(20);
+    BOOST_REQUIRE_EQUAL(rm.size(), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,184 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "blt_util/blt_exception.hh"
+#include "test/TempPath.hh"
+
+#include <fstream>
+
+
+BOOST_AUTO_TEST_SUITE( ReferenceAnnotationTrack_test_suite )
+
+
+static
+std::string
+getTestContigSequence(
+    const unsigned length,
+    const unsigned seed)
+{
+    static const char bases[] = "ACGT";
+    std::string seq;
+    unsigned state(seed);
+    for (unsigned seqIndex(0); seqIndex < length; ++seqIndex)
+    {
+        state = state * 1103515245u + 12345u;
+        seq.push_back(bases[(state >> 16) % 4]);
+    }
+    return seq;
+}
+
+
+
+static
+std::vector<ReferenceAnnotation>
+getTestAnnotation(const std::string& seq)
+{
+    std::vector<ReferenceAnnotation> annotation(seq.size());
+    for (unsigned seqIndex(0); seqIndex < seq.size(); ++seqIndex)
+    {
+        annotation[seqIndex].setSnpHpolSize(1 + (seqIndex % 5));
+        annotation[seqIndex].setAnchor((seqIndex % 3) == 0);
+    }
+    return annotation;
+}
+
+
+
+static
+void
+writeTestTrack(
+    const std::string& filename,
+    const std::string& chr1Seq,
+    const std::string& chr2Seq)
+{
+    ReferenceAnnotationTrackWriter::contigs_t contigs;
+    contigs.emplace_back("chr1", chr1Seq.size());
+    contigs.emplace_back("chr2", chr2Seq.size());
+
+    ReferenceAnnotationTrackWriter writer(filename, contigs, 10, 3);
+    writer.writeContig("chr1", chr1Seq, getTestAnnotation(chr1Seq));
+    writer.writeContig("chr2", chr2Seq, getTestAnnotation(chr2Seq));
+    writer.close();
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_track_roundtrip )
+{
+    const TempFile trackFile("referenceAnnotation-%%%%-%%%%.bin");
+
+    const std::string chr1Seq(getTestContigSequence(1000, 1));
+    const std::string chr2Seq(getTestContigSequence(3, 2));
+    writeTestTrack(trackFile.name(), chr1Seq, chr2Seq);
+
+    const ReferenceAnnotationTrack track(trackFile.name());
+    BOOST_REQUIRE_EQUAL(track.getMaxRepeatUnitLength(), 10u);
+    BOOST_REQUIRE_EQUAL(track.getMinRepeatSpan(), 3u);
+    BOOST_REQUIRE(track.getContig("chr3").empty());
+
+    const ReferenceAnnotationContig chr1(track.getContig("chr1"));
+    BOOST_REQUIRE_EQUAL(chr1.size, 1000);
+    BOOST_REQUIRE_EQUAL(chr1.maxRepeatUnitLength, 10u);
+    for (pos_t pos(0); pos < chr1.size; ++pos)
+    {
+        BOOST_REQUIRE_EQUAL(chr1.data[pos].getSnpHpolSize(), 1u + (pos % 5));
+        BOOST_REQUIRE_EQUAL(chr1.data[pos].isAnchor(), ((pos % 3) == 0));
+    }
+
+    const ReferenceAnnotationContig chr2(track.getContig("chr2"));
+    BOOST_REQUIRE_EQUAL(chr2.size, 3);
+    BOOST_REQUIRE_EQUAL(chr2.blockChecksums[0], getReferenceBlockChecksum(chr2Seq.data(), 3));
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_track_checksum )
+{
+    const TempFile trackFile("referenceAnnotation-%%%%-%%%%.bin");
+
+    const std::string chr1Seq(getTestContigSequence(1000, 1));
+    writeTestTrack(trackFile.name(), chr1Seq, "ACG");
+    const ReferenceAnnotationTrack track(trackFile.name());
+
+    // segments of the original reference match, including the partial last block of the contig:
+    for (const pos_t beginPos : { 0, 100, 700 })
+    {
+        reference_contig_segment ref;
+        ref.set_offset(beginPos);
+        ref.seq() = chr1Seq.substr(beginPos);
+        ref.setAnnotation(track.getContig("chr1"));
+        BOOST_REQUIRE(isReferenceAnnotationChecksumMatch(ref));
+    }
+
+    // a segment of a different reference sequence does not match:
+    {
+        std::string alteredSeq(chr1Seq);
+        alteredSeq[600] = ((alteredSeq[600] == 'A') ? 'C' : 'A');
+        reference_contig_segment ref;
+        ref.set_offset(200);
+        ref.seq() = alteredSeq.substr(200, 600);
+        ref.setAnnotation(track.getContig("chr1"));
+        BOOST_REQUIRE(not isReferenceAnnotationChecksumMatch(ref));
+    }
+
+    // a difference in the partial last block of the contig is also found:
+    {
+        std::string alteredSeq(chr1Seq);
+        alteredSeq[999] = 'N';
+        reference_contig_segment ref;
+        ref.set_offset(700);
+        ref.seq() = alteredSeq.substr(700);
+        ref.setAnnotation(track.getContig("chr1"));
+        BOOST_REQUIRE(not isReferenceAnnotationChecksumMatch(ref));
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_track_truncated )
+{
+    const TempFile trackFile("referenceAnnotation-%%%%-%%%%.bin");
+
+    writeTestTrack(trackFile.name(), getTestContigSequence(1000, 1), "ACG");
+    boost::filesystem::resize_file(trackFile.path, boost::filesystem::file_size(trackFile.path) - 8);
+    BOOST_REQUIRE_THROW(ReferenceAnnotationTrack(trackFile.name()), blt_exception);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_track_corruptContigSize )
+{
+    const TempFile trackFile("referenceAnnotation-%%%%-%%%%.bin");
+
+    writeTestTrack(trackFile.name(), getTestContigSequence(1000, 1), "ACG");
+
+    // Overwrite the size of chr1 in the header, which follows the magic, version, repeat parameters, contig count
+    // and contig name. The corrupt size would overflow the contig data size calculation:
+    {
+        std::fstream fs(trackFile.name(), std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(8 + 4*4 + 4 + 4);
+        const uint64_t corruptSize(uint64_t(1) << 63);
+        fs.write(reinterpret_cast<const char*>(&corruptSize), sizeof(corruptSize));
+    }
+    BOOST_REQUIRE_THROW(ReferenceAnnotationTrack(trackFile.name()), blt_exception);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
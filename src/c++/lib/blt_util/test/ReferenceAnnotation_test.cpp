@@ -0,0 +1,62 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/ReferenceAnnotation.hh"
+
+
+BOOST_AUTO_TEST_SUITE( ReferenceAnnotation_test_suite )
+
+BOOST_AUTO_TEST_CASE( test_annotation_fields )
+{
+    ReferenceAnnotation annotation;
+    annotation.setSnpHpolSize(12);
+    annotation.setSTRPeriod(3);
+    annotation.setSTRRepeatCount(5);
+    annotation.setLeftEndOfSTR(true);
+    annotation.setAnchor(true);
+
+    BOOST_REQUIRE_EQUAL(annotation.getSnpHpolSize(), 12u);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRPeriod(), 3u);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRRepeatCount(), 5u);
+    BOOST_REQUIRE(annotation.isLeftEndOfSTR());
+    BOOST_REQUIRE(annotation.isAnchor());
+
+    // fields are independent:
+    annotation.setLeftEndOfSTR(false);
+    annotation.setSTRPeriod(7);
+    BOOST_REQUIRE_EQUAL(annotation.getSnpHpolSize(), 12u);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRPeriod(), 7u);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRRepeatCount(), 5u);
+    BOOST_REQUIRE(! annotation.isLeftEndOfSTR());
+    BOOST_REQUIRE(annotation.isAnchor());
+}
+
+BOOST_AUTO_TEST_CASE( test_annotation_saturation )
+{
+    ReferenceAnnotation annotation;
+    annotation.setSnpHpolSize(1000);
+    annotation.setSTRRepeatCount(1000);
+    BOOST_REQUIRE_EQUAL(annotation.getSnpHpolSize(), ReferenceAnnotation::MaxHpolSize);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRRepeatCount(), ReferenceAnnotation::MaxSTRRepeatCount);
+    BOOST_REQUIRE_EQUAL(annotation.getSTRPeriod(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
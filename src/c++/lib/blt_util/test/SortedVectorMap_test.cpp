@@ -0,0 +1,86 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "SortedVectorMap.hh"
+
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( test_SortedVectorMap )
+
+
+BOOST_AUTO_TEST_CASE( test_SortedVectorSet )
+{
+    SortedVectorSet<unsigned> vset;
+    BOOST_REQUIRE(vset.empty());
+
+    // mix in-order appends with out-of-order and repeated insertions:
+    for (const unsigned key : { 3u, 5u, 9u, 1u, 5u, 7u, 9u })
+    {
+        vset.insert(key);
+    }
+
+    BOOST_REQUIRE_EQUAL(vset.size(), 5u);
+    BOOST_REQUIRE(not vset.insert(7).second);
+    BOOST_REQUIRE(vset.insert(8).second);
+
+    const std::vector<unsigned> expect = { 1, 3, 5, 7, 8, 9 };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(vset.begin(), vset.end(), expect.begin(), expect.end());
+
+    BOOST_REQUIRE_EQUAL(vset.count(5), 1u);
+    BOOST_REQUIRE_EQUAL(vset.count(4), 0u);
+    BOOST_REQUIRE(vset.find(10) == vset.end());
+
+    vset.clear();
+    BOOST_REQUIRE(vset.empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_SortedVectorMap )
+{
+    SortedVectorMap<unsigned,std::string> vmap;
+
+    vmap[4] = "d";
+    vmap[2] = "b";
+    vmap[6] = "f";
+    vmap[4] = "dd";
+    vmap[1] = "a";
+
+    BOOST_REQUIRE_EQUAL(vmap.size(), 4u);
+
+    const std::vector<unsigned> expectKeys = { 1, 2, 4, 6 };
+    std::vector<unsigned> keys;
+    for (const auto& val : vmap)
+    {
+        keys.push_back(val.first);
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(keys.begin(), keys.end(), expectKeys.begin(), expectKeys.end());
+
+    const auto& cvmap(vmap);
+    const auto iter(cvmap.find(4));
+    BOOST_REQUIRE(iter != cvmap.end());
+    BOOST_REQUIRE_EQUAL(iter->second, "dd");
+    BOOST_REQUIRE(cvmap.find(3) == cvmap.end());
+    BOOST_REQUIRE_EQUAL(cvmap.count(6), 1u);
+    BOOST_REQUIRE_EQUAL(cvmap.count(7), 0u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
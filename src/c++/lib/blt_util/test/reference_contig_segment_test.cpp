@@ -0,0 +1,69 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_util/reference_contig_segment.hh"
+
+
+BOOST_AUTO_TEST_SUITE( reference_contig_segment_test_suite )
+
+BOOST_AUTO_TEST_CASE( test_segment_view )
+{
+    static const char contig[] = "ACGTNACGTA";
+
+    reference_contig_segment ref;
+    ref.set_offset(10);
+    ref.setView(contig + 2, 6);
+
+    BOOST_REQUIRE(ref.isView());
+    BOOST_REQUIRE_EQUAL(ref.end(), 16);
+    BOOST_REQUIRE_EQUAL(ref.get_base(9), 'N');
+    BOOST_REQUIRE_EQUAL(ref.get_base(10), 'G');
+    BOOST_REQUIRE_EQUAL(ref.get_base(15), 'G');
+    BOOST_REQUIRE_EQUAL(ref.get_base(16), 'N');
+
+    std::string substr;
+    ref.get_substring(11, 3, substr);
+    BOOST_REQUIRE_EQUAL(substr, "TNA");
+
+    // the slow path pads positions outside of the segment:
+    ref.get_substring(14, 4, substr);
+    BOOST_REQUIRE_EQUAL(substr, "CGNN");
+}
+
+BOOST_AUTO_TEST_CASE( test_segment_view_replaced_by_copy )
+{
+    static const char contig[] = "ACGT";
+
+    reference_contig_segment ref;
+    ref.setView(contig, 4);
+    ref.seq() = "TT";
+
+    BOOST_REQUIRE(! ref.isView());
+    BOOST_REQUIRE_EQUAL(ref.end(), 2);
+    BOOST_REQUIRE_EQUAL(ref.get_base(0), 'T');
+
+    ref.setView(contig, 4);
+    ref.clear();
+    BOOST_REQUIRE(! ref.isView());
+    BOOST_REQUIRE_EQUAL(ref.end(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include "errorAnalysisUtils.hh"
+
 #include "boost/serialization/level.hpp"
 #include "boost/serialization/map.hpp"
 
@@ -117,6 +119,15 @@ struct SingleSampleContextData;
 ///
 struct SingleSampleContextObservationPattern
 {
+    SingleSampleContextObservationPattern() = default;
+
+    SingleSampleContextObservationPattern(
+        const SingleSampleSingleStrandContextObservationPattern& initStrand0,
+        const SingleSampleSingleStrandContextObservationPattern& initStrand1)
+        : strand0(initStrand0),
+          strand1(initStrand1)
+    {}
+
     const SingleSampleSingleStrandContextObservationPattern&
     getStrand0Counts() const
     {
@@ -290,6 +301,26 @@ public:
     void
     merge(const SingleSampleContextData& in);
 
+    /// Add the number of context instances observed with \p pattern
+    ///
+    /// This is fastest when patterns are added in sorted order.
+    void
+    appendObservationPatternCount(
+        const SingleSampleContextObservationPattern& pattern,
+        const unsigned count)
+    {
+        appendMapValue(data, pattern, count);
+    }
+
+    /// Add reference allele observation counts at one basecall quality level
+    void
+    appendRefQualCount(
+        const uint16_t basecallErrorPhredProb,
+        const uint64_t count)
+    {
+        appendMapValue(refAlleleBasecallErrorPhredProbs, basecallErrorPhredProb, count);
+    }
+
     const_iterator
     begin() const
     {
@@ -396,6 +427,13 @@ public:
     void
     merge(const Dataset& in);
 
+    /// \return data for \p context, which is inserted if not already present
+    ContextData&
+    getContextData(const Context& context)
+    {
+        return getContextIterator(context)->second;
+    }
+
     void
     clear()
     {
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "errorAnalysisUtils.hh"
 #include "blt_util/RecordTracker.hh"
 
 #include "boost/serialization/array.hpp"
@@ -233,6 +234,17 @@ public:
     void
     merge(const SingleSampleNonVariantContextData& in);
 
+    /// Add the number of context instances observed with \p pattern
+    ///
+    /// This is fastest when patterns are added in sorted order.
+    void
+    appendObservationPatternCount(
+        const SingleSampleNonVariantContextObservationPattern& pattern,
+        const unsigned count)
+    {
+        appendMapValue(data, pattern, count);
+    }
+
     const_iterator
     begin() const
     {
@@ -374,6 +386,17 @@ public:
     void
     merge(const SingleSampleCandidateVariantContextData& in);
 
+    /// Add the number of context instances observed with \p pattern
+    ///
+    /// This is fastest when patterns are added in sorted order.
+    void
+    appendObservationPatternCount(
+        const SingleSampleCandidateVariantContextObservationPattern& pattern,
+        const unsigned count)
+    {
+        appendMapValue(data, pattern, count);
+    }
+
     const_iterator
     begin() const
     {
@@ -504,6 +527,13 @@ public:
     void
     merge(const Dataset& in);
 
+    /// \return data for \p context, which is inserted if not already present
+    ContextData&
+    getContextData(const Context& context)
+    {
+        return getContextIterator(context)->second;
+    }
+
     void
     clear()
     {
@@ -22,9 +22,9 @@
 ///
 
 #include "SequenceAlleleCounts.hh"
+#include "SequenceAlleleCountsColumnar.hh"
 #include "common/Exceptions.hh"
 #include "boost/archive/binary_iarchive.hpp"
-#include "boost/archive/binary_oarchive.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -46,7 +46,7 @@ merge(
             BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
         }
     }
-    _sampleName = in._sampleName;
+    if (!in._sampleName.empty()) _sampleName = in._sampleName;
     _bases.merge(in._bases);
     _indels.merge(in._indels);
 }
@@ -57,15 +57,7 @@ SequenceAlleleCounts::
 save(
     const char* filename) const
 {
-    using namespace boost::archive;
-
-    assert(nullptr != filename);
-    std::ofstream ofs(filename, std::ios::binary);
-    binary_oarchive oa(ofs);
-
-    oa << _sampleName;
-    oa << _bases;
-    oa << _indels;
+    saveColumnarSequenceAlleleCounts(*this, filename);
 }
 
 
@@ -77,15 +69,32 @@ load(
 {
     using namespace boost::archive;
 
+    assert(nullptr != filename);
+    if (isColumnarSequenceAlleleCountsFile(filename))
+    {
+        loadColumnarSequenceAlleleCounts(filename, *this);
+        return;
+    }
+
+    // read the original boost archive format:
     clear();
 
-    assert(nullptr != filename);
-    std::ifstream ifs(filename, std::ios::binary);
-    binary_iarchive ia(ifs);
+    try
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        binary_iarchive ia(ifs);
 
-    ia >> _sampleName;
-    ia >> _bases;
-    ia >> _indels;
+        ia >> _sampleName;
+        ia >> _bases;
+        ia >> _indels;
+    }
+    catch (const archive_exception& e)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Can't read sequence allele counts file '" << filename << "': " << e.what();
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
 }
 
 
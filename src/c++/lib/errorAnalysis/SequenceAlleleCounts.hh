@@ -82,9 +82,11 @@ struct SequenceAlleleCounts
         _sampleName = sampleName;
     }
 
+    /// Write counts to \p filename in columnar format (see SequenceAlleleCountsColumnar.hh)
     void
     save(const char* filename) const;
 
+    /// Read counts from \p filename in either columnar format or the original boost archive format
     void
     load(const char* filename);
 
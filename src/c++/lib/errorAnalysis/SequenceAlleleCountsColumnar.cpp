@@ -0,0 +1,927 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "SequenceAlleleCountsColumnar.hh"
+
+#include "common/Exceptions.hh"
+
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <sstream>
+
+
+namespace
+{
+
+const char formatMagic[8] = { 'S', 'A', 'C', 'C', 'O', 'L', 'M', 'N' };
+const uint32_t formatVersion(1);
+const uint32_t byteOrderMark(0x01020304);
+
+/// all columns are padded to this byte alignment:
+const uint64_t columnAlignment(8);
+
+/// number of count tables for each context, this is the same for both datasets
+const unsigned contextTableCount(2);
+
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t sampleNameSize;
+};
+
+
+/// Context header shared by the basecall and indel datasets
+///
+/// Each dataset uses a subset of the context key words, counters and sums.
+struct ContextHeader
+{
+    uint32_t key[2];
+    uint64_t counters[4];
+    double sums[2];
+};
+
+
+struct TableHeader
+{
+    /// number of key words for each row, or 0 if keys are variable width
+    uint32_t keyWidth;
+    uint32_t reserved;
+    uint64_t rowCount;
+    uint64_t keyWordCount;
+};
+
+
+void
+throwFormatError(
+    const std::string& filename,
+    const char* msg)
+{
+    using namespace illumina::common;
+
+    std::ostringstream oss;
+    oss << "Unexpected format in columnar sequence allele counts file '" << filename << "': " << msg;
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+}
+
+
+
+uint64_t
+getPaddedSize(const uint64_t size)
+{
+    return (((size + columnAlignment - 1) / columnAlignment) * columnAlignment);
+}
+
+
+
+/// Sequential reader of aligned columns from a memory-mapped file
+struct MappedFileReader
+{
+    explicit
+    MappedFileReader(const std::string& filename)
+        : _filename(filename)
+    {
+        try
+        {
+            _mapping = boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only);
+            _region = boost::interprocess::mapped_region(_mapping, boost::interprocess::read_only);
+        }
+        catch (const boost::interprocess::interprocess_exception& e)
+        {
+            throwFormatError(filename, e.what());
+        }
+        _ptr = static_cast<const char*>(_region.get_address());
+        _end = _ptr + _region.get_size();
+    }
+
+    /// \return pointer to the next column of \p count values of type T
+    template <typename T>
+    const T*
+    read(const uint64_t count = 1)
+    {
+        // check count before computing the column size so that a corrupt count can't overflow the size:
+        const uint64_t available(_end - _ptr);
+        if (count > (available / sizeof(T))) throwFormatError(_filename, "unexpected end of file");
+        const uint64_t size(getPaddedSize(sizeof(T)*count));
+        if (size > available) throwFormatError(_filename, "unexpected end of file");
+        const T* result(reinterpret_cast<const T*>(_ptr));
+        _ptr += size;
+        return result;
+    }
+
+    bool
+    isEnd() const
+    {
+        return (_ptr == _end);
+    }
+
+    const std::string&
+    getFilename() const
+    {
+        return _filename;
+    }
+
+private:
+    std::string _filename;
+    boost::interprocess::file_mapping _mapping;
+    boost::interprocess::mapped_region _region;
+    const char* _ptr = nullptr;
+    const char* _end = nullptr;
+};
+
+
+
+/// In-place view of one count table in a memory-mapped file
+struct CountTableView
+{
+    void
+    read(MappedFileReader& reader)
+    {
+        const TableHeader& header(*reader.read<TableHeader>());
+        keyWidth = header.keyWidth;
+        rowCount = header.rowCount;
+        if (keyWidth == 0)
+        {
+            keyOffsets = reader.read<uint64_t>(rowCount+1);
+        }
+        else
+        {
+            keyOffsets = nullptr;
+            if (header.keyWordCount != (rowCount*keyWidth)) throwFormatError(reader.getFilename(), "invalid table size");
+        }
+        keyWords = reader.read<uint32_t>(header.keyWordCount);
+        counts = reader.read<uint64_t>(rowCount);
+
+        if (keyWidth == 0)
+        {
+            if (keyOffsets[0] != 0) throwFormatError(reader.getFilename(), "invalid key offset");
+            for (uint64_t rowIndex(0); rowIndex<rowCount; ++rowIndex)
+            {
+                if (keyOffsets[rowIndex+1] < keyOffsets[rowIndex])
+                {
+                    throwFormatError(reader.getFilename(), "invalid key offset");
+                }
+            }
+            if (keyOffsets[rowCount] != header.keyWordCount) throwFormatError(reader.getFilename(), "invalid key offset");
+        }
+    }
+
+    const uint32_t*
+    keyBegin(const uint64_t rowIndex) const
+    {
+        return keyWords + ((keyWidth == 0) ? keyOffsets[rowIndex] : (rowIndex*keyWidth));
+    }
+
+    const uint32_t*
+    keyEnd(const uint64_t rowIndex) const
+    {
+        return keyWords + ((keyWidth == 0) ? keyOffsets[rowIndex+1] : ((rowIndex+1)*keyWidth));
+    }
+
+    uint32_t keyWidth = 0;
+    uint64_t rowCount = 0;
+    const uint64_t* keyOffsets = nullptr;
+    const uint32_t* keyWords = nullptr;
+    const uint64_t* counts = nullptr;
+};
+
+
+
+/// In-place view of one context in a memory-mapped file
+struct ContextView
+{
+    void
+    read(MappedFileReader& reader)
+    {
+        header = reader.read<ContextHeader>();
+        for (auto& table : tables)
+        {
+            table.read(reader);
+        }
+    }
+
+    bool
+    isKeyLess(const ContextView& rhs) const
+    {
+        return std::lexicographical_compare(
+                   std::begin(header->key), std::end(header->key),
+                   std::begin(rhs.header->key), std::end(rhs.header->key));
+    }
+
+    bool
+    isKeyEqual(const ContextView& rhs) const
+    {
+        return std::equal(std::begin(header->key), std::end(header->key), std::begin(rhs.header->key));
+    }
+
+    const ContextHeader* header = nullptr;
+    std::array<CountTableView, contextTableCount> tables;
+};
+
+
+
+/// In-memory count table used to write or merge tables
+struct CountTable
+{
+    void
+    clear(const uint32_t initKeyWidth)
+    {
+        keyWidth = initKeyWidth;
+        keyOffsets.clear();
+        keyWords.clear();
+        counts.clear();
+        if (keyWidth == 0) keyOffsets.push_back(0);
+    }
+
+    uint64_t
+    rowCount() const
+    {
+        return counts.size();
+    }
+
+    /// Add a row to the table, keys must be added in sorted order
+    ///
+    /// If the key is the same as the last row, the count is added to that row instead.
+    void
+    appendRow(
+        const uint32_t* keyBegin,
+        const uint32_t* keyEnd,
+        const uint64_t count)
+    {
+        assert((keyWidth == 0) || (static_cast<uint64_t>(keyEnd-keyBegin) == keyWidth));
+        if ((rowCount() > 0) && (static_cast<uint64_t>(keyEnd-keyBegin) == (keyWords.size() - lastKeyOffset())) &&
+            std::equal(keyBegin, keyEnd, lastKeyBegin()))
+        {
+            counts.back() += count;
+            return;
+        }
+
+        keyWords.insert(keyWords.end(), keyBegin, keyEnd);
+        if (keyWidth == 0) keyOffsets.push_back(keyWords.size());
+        counts.push_back(count);
+    }
+
+    void
+    appendRow(
+        const std::vector<uint32_t>& key,
+        const uint64_t count)
+    {
+        appendRow(key.data(), key.data()+key.size(), count);
+    }
+
+    uint32_t keyWidth = 0;
+    std::vector<uint64_t> keyOffsets;
+    std::vector<uint32_t> keyWords;
+    std::vector<uint64_t> counts;
+
+private:
+    uint64_t
+    lastKeyOffset() const
+    {
+        assert(rowCount() > 0);
+        return ((keyWidth == 0) ? keyOffsets[rowCount()-1] : ((rowCount()-1)*keyWidth));
+    }
+
+    const uint32_t*
+    lastKeyBegin() const
+    {
+        return (keyWords.data() + lastKeyOffset());
+    }
+};
+
+
+
+/// Sequential writer of aligned columns
+struct ColumnWriter
+{
+    explicit
+    ColumnWriter(const char* filename)
+        : _filename(filename),
+          _os(filename, std::ios::binary)
+    {
+        if (! _os) throwError("can't open file for writing");
+    }
+
+    template <typename T>
+    void
+    write(
+        const T* data,
+        const uint64_t count = 1)
+    {
+        static const char padding[columnAlignment] = {};
+
+        const uint64_t size(sizeof(T)*count);
+        if (size > 0) _os.write(reinterpret_cast<const char*>(data), size);
+        _os.write(padding, getPaddedSize(size) - size);
+        if (! _os) throwError("write failed");
+    }
+
+    void
+    writeTable(const CountTable& table)
+    {
+        TableHeader header;
+        header.keyWidth = table.keyWidth;
+        header.reserved = 0;
+        header.rowCount = table.rowCount();
+        header.keyWordCount = table.keyWords.size();
+        write(&header);
+        if (table.keyWidth == 0) write(table.keyOffsets.data(), table.keyOffsets.size());
+        write(table.keyWords.data(), table.keyWords.size());
+        write(table.counts.data(), table.counts.size());
+    }
+
+    void
+    writeContext(
+        const ContextHeader& header,
+        const std::array<CountTable, contextTableCount>& tables)
+    {
+        write(&header);
+        for (const auto& table : tables)
+        {
+            writeTable(table);
+        }
+    }
+
+    /// write a dataset context count placeholder to be updated later by setDatasetContextCount()
+    void
+    beginDataset()
+    {
+        _datasetPos = _os.tellp();
+        const uint64_t contextCount(0);
+        write(&contextCount);
+    }
+
+    void
+    setDatasetContextCount(const uint64_t contextCount)
+    {
+        const auto endPos(_os.tellp());
+        _os.seekp(_datasetPos);
+        write(&contextCount);
+        _os.seekp(endPos);
+    }
+
+    void
+    writeFileHeader(const std::string& sampleName)
+    {
+        FileHeader header;
+        std::memcpy(header.magic, formatMagic, sizeof(formatMagic));
+        header.version = formatVersion;
+        header.byteOrderMark = byteOrderMark;
+        header.sampleNameSize = sampleName.size();
+        write(&header);
+        write(sampleName.data(), sampleName.size());
+    }
+
+    void
+    close()
+    {
+        _os.close();
+        if (! _os) throwError("write failed");
+    }
+
+private:
+    void
+    throwError(const char* msg) const
+    {
+        using namespace illumina::common;
+
+        std::ostringstream oss;
+        oss << "Failed to write columnar sequence allele counts file '" << _filename << "': " << msg;
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    std::string _filename;
+    std::ofstream _os;
+    std::streampos _datasetPos;
+};
+
+
+
+/// \return sample name
+std::string
+readFileHeader(MappedFileReader& reader)
+{
+    const FileHeader& header(*reader.read<FileHeader>());
+    if (0 != std::memcmp(header.magic, formatMagic, sizeof(formatMagic)))
+    {
+        throwFormatError(reader.getFilename(), "unrecognized file header");
+    }
+    if (header.byteOrderMark != byteOrderMark) throwFormatError(reader.getFilename(), "unsupported byte order");
+    if (header.version != formatVersion)
+    {
+        std::ostringstream oss;
+        oss << "unsupported format version " << header.version << ", expected " << formatVersion;
+        throwFormatError(reader.getFilename(), oss.str().c_str());
+    }
+    const char* sampleName(reader.read<char>(header.sampleNameSize));
+    return std::string(sampleName, header.sampleNameSize);
+}
+
+
+
+/// Basecall observation patterns are encoded as the key word sequence:
+///
+/// [ref0, (qual+1, count)..., 0, ref1, (qual+1, count)..., 0]
+///
+/// ...where ref and (qual, count) are the reference and alternate allele counts for each strand. Ordering
+/// encoded patterns lexicographically by key word is the same as ordering the patterns themselves.
+void
+encodeBasecallPattern(
+    const BasecallCounts::SingleSampleContextObservationPattern& pattern,
+    std::vector<uint32_t>& key)
+{
+    key.clear();
+    for (const auto* strand : { &pattern.getStrand0Counts(), &pattern.getStrand1Counts() })
+    {
+        key.push_back(strand->refAlleleCount);
+        for (const auto& altCount : strand->altAlleleCount)
+        {
+            key.push_back(static_cast<uint32_t>(altCount.first) + 1);
+            key.push_back(altCount.second);
+        }
+        key.push_back(0);
+    }
+}
+
+
+
+BasecallCounts::SingleSampleContextObservationPattern
+decodeBasecallPattern(
+    const uint32_t* keyBegin,
+    const uint32_t* keyEnd,
+    const std::string& filename)
+{
+    using namespace BasecallCounts;
+
+    std::array<SingleSampleSingleStrandContextObservationPattern, 2> strands;
+    const uint32_t* keyPtr(keyBegin);
+    for (auto& strand : strands)
+    {
+        if (keyPtr == keyEnd) throwFormatError(filename, "invalid basecall pattern");
+        strand.refAlleleCount = *(keyPtr++);
+        while (true)
+        {
+            if (keyPtr == keyEnd) throwFormatError(filename, "invalid basecall pattern");
+            const uint32_t qualWord(*(keyPtr++));
+            if (qualWord == 0) break;
+            if (keyPtr == keyEnd) throwFormatError(filename, "invalid basecall pattern");
+            strand.altAlleleCount.emplace_hint(strand.altAlleleCount.end(), static_cast<uint16_t>(qualWord-1), *(keyPtr++));
+        }
+    }
+    if (keyPtr != keyEnd) throwFormatError(filename, "invalid basecall pattern");
+
+    return SingleSampleContextObservationPattern(strands[0], strands[1]);
+}
+
+
+
+void
+writeBasecallDataset(
+    const BasecallCounts::Dataset& dataset,
+    ColumnWriter& writer)
+{
+    writer.beginDataset();
+
+    uint64_t contextCount(0);
+    std::array<CountTable, contextTableCount> tables;
+    std::vector<uint32_t> key;
+    for (const auto& contextInfo : dataset)
+    {
+        const auto& context(contextInfo.first);
+        const auto& data(contextInfo.second);
+
+        ContextHeader header = {};
+        header.key[0] = context.repeatCount;
+        header.counters[0] = data.excludedRegionSkipped;
+        header.counters[1] = data.depthSkipped;
+        header.counters[2] = data.emptySkipped;
+        header.counters[3] = data.noiseSkipped;
+
+        tables[0].clear(1);
+        for (const auto& refQual : data.counts.getRefQuals())
+        {
+            key.assign(1, refQual.first);
+            tables[0].appendRow(key, refQual.second);
+        }
+
+        tables[1].clear(0);
+        for (const auto& patternInfo : data.counts)
+        {
+            encodeBasecallPattern(patternInfo.first, key);
+            tables[1].appendRow(key, patternInfo.second);
+        }
+
+        writer.writeContext(header, tables);
+        contextCount++;
+    }
+
+    writer.setDatasetContextCount(contextCount);
+}
+
+
+
+void
+writeIndelDataset(
+    const IndelCounts::Dataset& dataset,
+    ColumnWriter& writer)
+{
+    using namespace IndelCounts;
+
+    writer.beginDataset();
+
+    uint64_t contextCount(0);
+    std::array<CountTable, contextTableCount> tables;
+    std::vector<uint32_t> key;
+    for (const auto& contextInfo : dataset)
+    {
+        const auto& context(contextInfo.first);
+        const auto& data(contextInfo.second);
+
+        ContextHeader header = {};
+        header.key[0] = context.getRepeatPatternSize();
+        header.key[1] = context.getRepeatCount();
+        header.counters[0] = data.excludedRegionSkipped;
+        header.counters[1] = data.depthSkipped;
+        header.sums[0] = data.depthSupport.depth;
+        header.sums[1] = data.depthSupport.supportCount;
+
+        tables[0].clear(2);
+        for (const auto& patternInfo : data.nonVariantContextCounts)
+        {
+            const auto& pattern(patternInfo.first);
+            key = { pattern.depth, static_cast<uint32_t>(pattern.backgroundStatus) };
+            tables[0].appendRow(key, patternInfo.second);
+        }
+
+        tables[1].clear(2+INDEL_SIGNAL_TYPE::SIZE);
+        for (const auto& patternInfo : data.candidateVariantContextCounts)
+        {
+            const auto& pattern(patternInfo.first);
+            key.assign(1, pattern.refCount);
+            key.insert(key.end(), pattern.signalCounts.begin(), pattern.signalCounts.end());
+            key.push_back(static_cast<uint32_t>(pattern.variantStatus));
+            tables[1].appendRow(key, patternInfo.second);
+        }
+
+        writer.writeContext(header, tables);
+        contextCount++;
+    }
+
+    writer.setDatasetContextCount(contextCount);
+}
+
+
+
+void
+checkTableKeyWidth(
+    const CountTableView& table,
+    const uint32_t expectedKeyWidth,
+    const std::string& filename)
+{
+    if (table.keyWidth != expectedKeyWidth) throwFormatError(filename, "unexpected table key width");
+}
+
+
+
+void
+readBasecallDataset(
+    MappedFileReader& reader,
+    BasecallCounts::Dataset& dataset)
+{
+    using namespace BasecallCounts;
+
+    const uint64_t contextCount(*reader.read<uint64_t>());
+    ContextView contextView;
+    for (uint64_t contextIndex(0); contextIndex<contextCount; ++contextIndex)
+    {
+        contextView.read(reader);
+        checkTableKeyWidth(contextView.tables[0], 1, reader.getFilename());
+        checkTableKeyWidth(contextView.tables[1], 0, reader.getFilename());
+
+        const ContextHeader& header(*contextView.header);
+        Context context;
+        context.repeatCount = header.key[0];
+
+        ContextData& data(dataset.getContextData(context));
+        data.excludedRegionSkipped += header.counters[0];
+        data.depthSkipped += header.counters[1];
+        data.emptySkipped += header.counters[2];
+        data.noiseSkipped += header.counters[3];
+
+        const CountTableView& refQualTable(contextView.tables[0]);
+        for (uint64_t rowIndex(0); rowIndex<refQualTable.rowCount; ++rowIndex)
+        {
+            data.counts.appendRefQualCount(*refQualTable.keyBegin(rowIndex), refQualTable.counts[rowIndex]);
+        }
+
+        const CountTableView& patternTable(contextView.tables[1]);
+        for (uint64_t rowIndex(0); rowIndex<patternTable.rowCount; ++rowIndex)
+        {
+            data.counts.appendObservationPatternCount(
+                decodeBasecallPattern(patternTable.keyBegin(rowIndex), patternTable.keyEnd(rowIndex),
+                                      reader.getFilename()),
+                patternTable.counts[rowIndex]);
+        }
+    }
+}
+
+
+
+void
+readIndelDataset(
+    MappedFileReader& reader,
+    IndelCounts::Dataset& dataset)
+{
+    using namespace IndelCounts;
+
+    const uint64_t contextCount(*reader.read<uint64_t>());
+    ContextView contextView;
+    for (uint64_t contextIndex(0); contextIndex<contextCount; ++contextIndex)
+    {
+        contextView.read(reader);
+        checkTableKeyWidth(contextView.tables[0], 2, reader.getFilename());
+        checkTableKeyWidth(contextView.tables[1], 2+INDEL_SIGNAL_TYPE::SIZE, reader.getFilename());
+
+        const ContextHeader& header(*contextView.header);
+        const Context context(header.key[0], header.key[1]);
+
+        ContextData& data(dataset.getContextData(context));
+        data.excludedRegionSkipped += header.counters[0];
+        data.depthSkipped += header.counters[1];
+        data.depthSupport.depth += header.sums[0];
+        data.depthSupport.supportCount += header.sums[1];
+
+        const CountTableView& nonVariantTable(contextView.tables[0]);
+        SingleSampleNonVariantContextObservationPattern nonVariantPattern;
+        for (uint64_t rowIndex(0); rowIndex<nonVariantTable.rowCount; ++rowIndex)
+        {
+            const uint32_t* key(nonVariantTable.keyBegin(rowIndex));
+            nonVariantPattern.depth = key[0];
+            nonVariantPattern.backgroundStatus = static_cast<GENOTYPE_STATUS::genotype_t>(key[1]);
+            data.nonVariantContextCounts.appendObservationPatternCount(nonVariantPattern,
+                                                                      nonVariantTable.counts[rowIndex]);
+        }
+
+        const CountTableView& candidateTable(contextView.tables[1]);
+        SingleSampleCandidateVariantContextObservationPattern candidatePattern;
+        for (uint64_t rowIndex(0); rowIndex<candidateTable.rowCount; ++rowIndex)
+        {
+            const uint32_t* key(candidateTable.keyBegin(rowIndex));
+            candidatePattern.refCount = key[0];
+            std::copy(key+1, key+1+INDEL_SIGNAL_TYPE::SIZE, candidatePattern.signalCounts.begin());
+            candidatePattern.variantStatus = static_cast<GENOTYPE_STATUS::genotype_t>(key[1+INDEL_SIGNAL_TYPE::SIZE]);
+            data.candidateVariantContextCounts.appendObservationPatternCount(candidatePattern,
+                                                                            candidateTable.counts[rowIndex]);
+        }
+    }
+}
+
+
+
+/// Merge the sorted rows of several count tables into \p mergedTable
+void
+mergeCountTables(
+    const std::vector<const CountTableView*>& tables,
+    CountTable& mergedTable)
+{
+    assert(! tables.empty());
+    mergedTable.clear(tables.front()->keyWidth);
+
+    const unsigned tableCount(tables.size());
+    std::vector<uint64_t> rowIndex(tableCount,0);
+
+    // order table indices so that the table with the lowest current row key is on top of the heap:
+    auto isTableKeyGreater = [&](const unsigned lhs, const unsigned rhs)
+    {
+        return std::lexicographical_compare(
+                   tables[rhs]->keyBegin(rowIndex[rhs]), tables[rhs]->keyEnd(rowIndex[rhs]),
+                   tables[lhs]->keyBegin(rowIndex[lhs]), tables[lhs]->keyEnd(rowIndex[lhs]));
+    };
+    std::priority_queue<unsigned, std::vector<unsigned>, decltype(isTableKeyGreater)> tableHeap(isTableKeyGreater);
+
+    for (unsigned tableIndex(0); tableIndex<tableCount; ++tableIndex)
+    {
+        if (tables[tableIndex]->rowCount > 0) tableHeap.push(tableIndex);
+    }
+
+    while (! tableHeap.empty())
+    {
+        const unsigned tableIndex(tableHeap.top());
+        tableHeap.pop();
+
+        const CountTableView& table(*tables[tableIndex]);
+        uint64_t& tableRowIndex(rowIndex[tableIndex]);
+        mergedTable.appendRow(table.keyBegin(tableRowIndex), table.keyEnd(tableRowIndex), table.counts[tableRowIndex]);
+
+        tableRowIndex++;
+        if (tableRowIndex < table.rowCount) tableHeap.push(tableIndex);
+    }
+}
+
+
+
+/// Merge one dataset from all input files, the readers for all inputs must be positioned at the dataset start
+void
+mergeDataset(
+    std::vector<std::unique_ptr<MappedFileReader>>& readers,
+    ColumnWriter& writer)
+{
+    const unsigned inputCount(readers.size());
+
+    std::vector<uint64_t> remainingContextCount(inputCount);
+    std::vector<ContextView> contextViews(inputCount);
+    for (unsigned inputIndex(0); inputIndex<inputCount; ++inputIndex)
+    {
+        remainingContextCount[inputIndex] = *readers[inputIndex]->read<uint64_t>();
+        if (remainingContextCount[inputIndex] > 0) contextViews[inputIndex].read(*readers[inputIndex]);
+    }
+
+    writer.beginDataset();
+
+    uint64_t contextCount(0);
+    std::array<CountTable, contextTableCount> mergedTables;
+    std::vector<const CountTableView*> tables;
+    std::vector<unsigned> mergeInputs;
+    while (true)
+    {
+        // find all inputs with the lowest context key:
+        mergeInputs.clear();
+        for (unsigned inputIndex(0); inputIndex<inputCount; ++inputIndex)
+        {
+            if (remainingContextCount[inputIndex] == 0) continue;
+            if (! mergeInputs.empty())
+            {
+                const ContextView& minContext(contextViews[mergeInputs.front()]);
+                if (contextViews[inputIndex].isKeyLess(minContext))
+                {
+                    mergeInputs.clear();
+                }
+                else if (! contextViews[inputIndex].isKeyEqual(minContext))
+                {
+                    continue;
+                }
+            }
+            mergeInputs.push_back(inputIndex);
+        }
+
+        if (mergeInputs.empty()) break;
+
+        ContextHeader mergedHeader(*contextViews[mergeInputs.front()].header);
+        for (unsigned mergeIndex(1); mergeIndex<mergeInputs.size(); ++mergeIndex)
+        {
+            const ContextHeader& header(*contextViews[mergeInputs[mergeIndex]].header);
+            for (unsigned counterIndex(0); counterIndex<4; ++counterIndex)
+            {
+                mergedHeader.counters[counterIndex] += header.counters[counterIndex];
+            }
+            for (unsigned sumIndex(0); sumIndex<2; ++sumIndex)
+            {
+                mergedHeader.sums[sumIndex] += header.sums[sumIndex];
+            }
+        }
+
+        for (unsigned tableIndex(0); tableIndex<contextTableCount; ++tableIndex)
+        {
+            tables.clear();
+            for (const unsigned inputIndex : mergeInputs)
+            {
+                const CountTableView& table(contextViews[inputIndex].tables[tableIndex]);
+                if ((! tables.empty()) && (table.keyWidth != tables.front()->keyWidth))
+                {
+                    throwFormatError(readers[inputIndex]->getFilename(), "unexpected table key width");
+                }
+                tables.push_back(&table);
+            }
+            mergeCountTables(tables, mergedTables[tableIndex]);
+        }
+
+        writer.writeContext(mergedHeader, mergedTables);
+        contextCount++;
+
+        for (const unsigned inputIndex : mergeInputs)
+        {
+            remainingContextCount[inputIndex]--;
+            if (remainingContextCount[inputIndex] > 0) contextViews[inputIndex].read(*readers[inputIndex]);
+        }
+    }
+
+    writer.setDatasetContextCount(contextCount);
+}
+
+}
+
+
+
+bool
+isColumnarSequenceAlleleCountsFile(const char* filename)
+{
+    assert(nullptr != filename);
+    std::ifstream ifs(filename, std::ios::binary);
+    char magic[sizeof(formatMagic)];
+    if (! ifs.read(magic, sizeof(magic))) return false;
+    return (0 == std::memcmp(magic, formatMagic, sizeof(formatMagic)));
+}
+
+
+
+void
+saveColumnarSequenceAlleleCounts(
+    const SequenceAlleleCounts& counts,
+    const char* filename)
+{
+    assert(nullptr != filename);
+    ColumnWriter writer(filename);
+    writer.writeFileHeader(counts.getSampleName());
+    writeBasecallDataset(counts.getBaseCounts(), writer);
+    writeIndelDataset(counts.getIndelCounts(), writer);
+    writer.close();
+}
+
+
+
+void
+loadColumnarSequenceAlleleCounts(
+    const char* filename,
+    SequenceAlleleCounts& counts)
+{
+    assert(nullptr != filename);
+    counts.clear();
+
+    MappedFileReader reader(filename);
+    counts.setSampleName(readFileHeader(reader));
+    readBasecallDataset(reader, counts.getBasecallCounts());
+    readIndelDataset(reader, counts.getIndelCounts());
+    if (! reader.isEnd()) throwFormatError(filename, "unexpected data after end of file");
+}
+
+
+
+void
+mergeColumnarSequenceAlleleCountsFiles(
+    const std::vector<std::string>& inputFilenames,
+    const char* outputFilename)
+{
+    assert(nullptr != outputFilename);
+
+    std::vector<std::unique_ptr<MappedFileReader>> readers;
+    std::string sampleName;
+    for (const std::string& inputFilename : inputFilenames)
+    {
+        readers.emplace_back(new MappedFileReader(inputFilename));
+        const std::string inputSampleName(readFileHeader(*readers.back()));
+        if (inputSampleName.empty()) continue;
+        if (sampleName.empty())
+        {
+            sampleName = inputSampleName;
+        }
+        else if (sampleName != inputSampleName)
+        {
+            using namespace illumina::common;
+            std::ostringstream oss;
+            oss << "Attempted to merge SequenceAlleleCounts with different sample names: '" << sampleName << "' and '" << inputSampleName << "'";
+            BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+        }
+    }
+
+    ColumnWriter writer(outputFilename);
+    writer.writeFileHeader(sampleName);
+
+    // basecall dataset:
+    mergeDataset(readers, writer);
+
+    // indel dataset:
+    mergeDataset(readers, writer);
+
+    for (const auto& reader : readers)
+    {
+        if (! reader->isEnd()) throwFormatError(reader->getFilename(), "unexpected data after end of file");
+    }
+
+    writer.close();
+}
@@ -0,0 +1,69 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "SequenceAlleleCounts.hh"
+
+#include <string>
+#include <vector>
+
+
+/// \file
+/// \brief Columnar file format for SequenceAlleleCounts
+///
+/// The file starts with a versioned header and the sample name, followed by the basecall and indel datasets.
+/// Each dataset is a list of contexts in sorted order, where each context holds its skip counters and two count
+/// tables. Each table stores the sorted keys of its rows as 32-bit key words, and the row counts as a separate
+/// 64-bit count column. Keys are either fixed width, or variable width with a key offset column:
+///
+/// | dataset  | table 0                          | table 1                                                  |
+/// |----------|----------------------------------|----------------------------------------------------------|
+/// | basecall | reference basecall quality       | observation pattern (variable width)                    |
+/// | indel    | non-variant depth and status     | candidate variant ref count, signal counts and status   |
+///
+/// Every column is 8-byte aligned, so a file can be memory-mapped and read in place. Because all contexts and
+/// table rows are sorted, any number of files can be combined with a streaming k-way merge which only holds one
+/// merged context in memory at a time.
+///
+
+
+/// \return true if \p filename starts with the columnar format header
+bool
+isColumnarSequenceAlleleCountsFile(const char* filename);
+
+/// Write \p counts to \p filename in columnar format
+void
+saveColumnarSequenceAlleleCounts(
+    const SequenceAlleleCounts& counts,
+    const char* filename);
+
+/// Read \p counts from columnar format file \p filename
+void
+loadColumnarSequenceAlleleCounts(
+    const char* filename,
+    SequenceAlleleCounts& counts);
+
+/// Merge any number of columnar format files into a single columnar format output file
+///
+/// The result is the same as loading and merging all input files into one SequenceAlleleCounts object, but
+/// the inputs are memory-mapped and merged in a single streaming pass.
+void
+mergeColumnarSequenceAlleleCountsFiles(
+    const std::vector<std::string>& inputFilenames,
+    const char* outputFilename);
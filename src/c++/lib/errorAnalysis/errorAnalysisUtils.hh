@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
 
 
@@ -66,3 +67,25 @@ mergeMapKeys(
         }
     }
 }
+
+
+/// Add \p value to \p inputMap for \p key, assuming value is 0 if key is not present
+///
+/// This is equivalent to iterateMapValue, except that it takes constant time when keys are added in sorted order,
+/// such as when a map is read back from a sorted serialized form.
+template <typename K, typename V>
+void
+appendMapValue(
+    std::map<K, V>& inputMap,
+    const K& key,
+    const V& value)
+{
+    if (inputMap.empty() || (std::prev(inputMap.end())->first < key))
+    {
+        inputMap.emplace_hint(inputMap.end(), key, value);
+    }
+    else
+    {
+        inputMap[key] += value;
+    }
+}
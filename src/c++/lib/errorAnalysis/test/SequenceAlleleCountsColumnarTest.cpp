@@ -0,0 +1,370 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "errorAnalysis/SequenceAlleleCountsColumnar.hh"
+#include "common/Exceptions.hh"
+#include "test/TempPath.hh"
+
+#include "boost/archive/binary_oarchive.hpp"
+#include "boost/random/mersenne_twister.hpp"
+#include "boost/random/uniform_int_distribution.hpp"
+
+#include <cstring>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( SequenceAlleleCountsColumnar_test )
+
+
+/// temporary counts file name model
+static const char countsFileModel[] = "alleleCounts-%%%%-%%%%.bin";
+
+
+
+/// Fill \p counts with a reproducible pseudo-random set of basecall and indel observations
+static
+void
+getTestCounts(
+    const unsigned seed,
+    const std::string& sampleName,
+    SequenceAlleleCounts& counts)
+{
+    boost::random::mt19937 rng(seed);
+    auto getRandom = [&](const unsigned maxVal)
+    {
+        return boost::random::uniform_int_distribution<unsigned>(0, maxVal)(rng);
+    };
+
+    counts.clear();
+    counts.setSampleName(sampleName);
+
+    static const uint16_t quals[] = { 3, 10, 20, 30, 40 };
+
+    BasecallCounts::Dataset& bases(counts.getBasecallCounts());
+    for (unsigned instanceIndex(0); instanceIndex<200; ++instanceIndex)
+    {
+        BasecallCounts::Context context;
+        context.repeatCount = 1 + getRandom(3);
+
+        BasecallCounts::ContextInstanceObservation obs;
+        const unsigned refCount(1 + getRandom(5));
+        for (unsigned refIndex(0); refIndex<refCount; ++refIndex)
+        {
+            obs.addRefCount(getRandom(1) == 0, quals[2+getRandom(2)]);
+        }
+        const unsigned altCount(getRandom(3));
+        for (unsigned altIndex(0); altIndex<altCount; ++altIndex)
+        {
+            obs.addAltCount(getRandom(1) == 0, quals[getRandom(4)]);
+        }
+        bases.addContextInstanceObservation(context, obs);
+
+        switch (getRandom(9))
+        {
+        case 0:
+            bases.addExcludedRegionSkip(context);
+            break;
+        case 1:
+            bases.addDepthSkip(context);
+            break;
+        case 2:
+            bases.addEmptySkip(context);
+            break;
+        case 3:
+            bases.addNoiseSkip(context);
+            break;
+        default:
+            break;
+        }
+    }
+
+    IndelCounts::Dataset& indels(counts.getIndelCounts());
+    for (unsigned instanceIndex(0); instanceIndex<200; ++instanceIndex)
+    {
+        const IndelCounts::Context context(1 + getRandom(2), 1 + getRandom(5));
+        const auto status(static_cast<GENOTYPE_STATUS::genotype_t>(getRandom(GENOTYPE_STATUS::SIZE-1)));
+        if (getRandom(1) == 0)
+        {
+            IndelCounts::SingleSampleCandidateVariantContextObservationPattern candidate;
+            candidate.refCount = getRandom(20);
+            candidate.signalCounts[getRandom(IndelCounts::INDEL_SIGNAL_TYPE::SIZE-1)] = 1 + getRandom(4);
+            candidate.variantStatus = status;
+            indels.addCandidateVariantContextInstanceObservation(context, candidate, candidate.totalCount() + getRandom(3));
+        }
+        else
+        {
+            IndelCounts::SingleSampleNonVariantContextObservationPattern nonVariant;
+            nonVariant.depth = getRandom(30);
+            nonVariant.backgroundStatus = status;
+            indels.addNonVariantContextInstanceObservation(context, nonVariant);
+        }
+
+        switch (getRandom(9))
+        {
+        case 0:
+            indels.addExcludedRegionSkip(context);
+            break;
+        case 1:
+            indels.addDepthSkip(context);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+
+/// Write \p counts in the original boost archive format
+static
+void
+writeArchive(
+    const SequenceAlleleCounts& counts,
+    std::ostream& os)
+{
+    boost::archive::binary_oarchive oa(os);
+    oa << counts.getSampleName();
+    oa << counts.getBaseCounts();
+    oa << counts.getIndelCounts();
+}
+
+
+
+/// Compare two counts objects by their full original format serialization
+static
+void
+checkCountsEqual(
+    const SequenceAlleleCounts& result,
+    const SequenceAlleleCounts& expected)
+{
+    std::ostringstream resultStream;
+    writeArchive(result, resultStream);
+    std::ostringstream expectedStream;
+    writeArchive(expected, expectedStream);
+
+    BOOST_REQUIRE_EQUAL(result.getSampleName(), expected.getSampleName());
+    BOOST_REQUIRE(resultStream.str() == expectedStream.str());
+}
+
+
+
+static
+std::string
+readFile(const std::string& filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+
+
+static
+void
+writeFile(
+    const std::string& filename,
+    const std::string& data)
+{
+    std::ofstream ofs(filename, std::ios::binary);
+    ofs.write(data.data(), data.size());
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_roundtrip )
+{
+    const TempFile countsFile(countsFileModel);
+
+    SequenceAlleleCounts counts;
+    getTestCounts(1, "sample1", counts);
+    counts.save(countsFile.name().c_str());
+    BOOST_REQUIRE(isColumnarSequenceAlleleCountsFile(countsFile.name().c_str()));
+
+    SequenceAlleleCounts loadedCounts;
+    loadedCounts.load(countsFile.name().c_str());
+    checkCountsEqual(loadedCounts, counts);
+
+    // empty counts:
+    SequenceAlleleCounts emptyCounts;
+    emptyCounts.save(countsFile.name().c_str());
+    loadedCounts.load(countsFile.name().c_str());
+    checkCountsEqual(loadedCounts, emptyCounts);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_loadArchiveFormat )
+{
+    const TempFile countsFile(countsFileModel);
+
+    SequenceAlleleCounts counts;
+    getTestCounts(2, "sample1", counts);
+    {
+        std::ofstream ofs(countsFile.name(), std::ios::binary);
+        writeArchive(counts, ofs);
+    }
+    BOOST_REQUIRE(! isColumnarSequenceAlleleCountsFile(countsFile.name().c_str()));
+
+    SequenceAlleleCounts loadedCounts;
+    loadedCounts.load(countsFile.name().c_str());
+    checkCountsEqual(loadedCounts, counts);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_merge )
+{
+    static const unsigned inputCount(4);
+    std::vector<TempFile> inputFiles(inputCount);
+    std::vector<std::string> inputFilenames;
+
+    // the last input is empty, and one input has no sample name:
+    SequenceAlleleCounts expectedCounts;
+    for (unsigned inputIndex(0); inputIndex<inputCount; ++inputIndex)
+    {
+        SequenceAlleleCounts counts;
+        if ((inputIndex+1) < inputCount)
+        {
+            getTestCounts(10+inputIndex, ((inputIndex == 1) ? "" : "sample1"), counts);
+        }
+        counts.save(inputFiles[inputIndex].name().c_str());
+        inputFilenames.push_back(inputFiles[inputIndex].name());
+        expectedCounts.merge(counts);
+    }
+
+    const TempFile mergedFile(countsFileModel);
+    mergeColumnarSequenceAlleleCountsFiles(inputFilenames, mergedFile.name().c_str());
+
+    SequenceAlleleCounts mergedCounts;
+    mergedCounts.load(mergedFile.name().c_str());
+    BOOST_REQUIRE_EQUAL(mergedCounts.getSampleName(), "sample1");
+    checkCountsEqual(mergedCounts, expectedCounts);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_mergeSampleNameMismatch )
+{
+    using namespace illumina::common;
+
+    const TempFile countsFile1(countsFileModel);
+    const TempFile countsFile2(countsFileModel);
+
+    SequenceAlleleCounts counts1;
+    getTestCounts(1, "sample1", counts1);
+    counts1.save(countsFile1.name().c_str());
+    SequenceAlleleCounts counts2;
+    getTestCounts(2, "sample2", counts2);
+    counts2.save(countsFile2.name().c_str());
+
+    BOOST_REQUIRE_THROW(counts1.merge(counts2), GeneralException);
+
+    const TempFile mergedFile(countsFileModel);
+    const std::vector<std::string> inputFilenames = { countsFile1.name(), countsFile2.name() };
+    BOOST_REQUIRE_THROW(mergeColumnarSequenceAlleleCountsFiles(inputFilenames, mergedFile.name().c_str()),
+                        GeneralException);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_truncatedFile )
+{
+    using namespace illumina::common;
+
+    const TempFile countsFile(countsFileModel);
+    SequenceAlleleCounts counts;
+    getTestCounts(1, "sample1", counts);
+    counts.save(countsFile.name().c_str());
+    const std::string data(readFile(countsFile.name()));
+
+    const TempFile truncatedFile(countsFileModel);
+    const TempFile mergedFile(countsFileModel);
+    const std::vector<std::string> inputFilenames = { countsFile.name(), truncatedFile.name() };
+    SequenceAlleleCounts loadedCounts;
+    for (unsigned size(0); size<data.size(); ++size)
+    {
+        writeFile(truncatedFile.name(), data.substr(0, size));
+        BOOST_REQUIRE_THROW(loadedCounts.load(truncatedFile.name().c_str()), GeneralException);
+        BOOST_REQUIRE_THROW(mergeColumnarSequenceAlleleCountsFiles(inputFilenames, mergedFile.name().c_str()),
+                            GeneralException);
+    }
+
+    // extra data after the end of the file:
+    writeFile(truncatedFile.name(), data + std::string(8,'\0'));
+    BOOST_REQUIRE_THROW(loadedCounts.load(truncatedFile.name().c_str()), GeneralException);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_SequenceAlleleCountsColumnar_corruptFile )
+{
+    using namespace illumina::common;
+
+    const TempFile countsFile(countsFileModel);
+    SequenceAlleleCounts counts;
+    getTestCounts(1, "sample1", counts);
+    counts.save(countsFile.name().c_str());
+    const std::string data(readFile(countsFile.name()));
+
+    // offsets in the columnar format: file header (24 bytes), padded sample name, basecall context count
+    // (8 bytes), first context header (56 bytes), followed by the first table header:
+    static const unsigned versionOffset(8);
+    static const unsigned firstTableOffset(24 + 8 + 8 + 56);
+    static const unsigned rowCountOffset(firstTableOffset + 8);
+
+    auto checkCorruptValue = [&](const unsigned offset, const uint64_t value, const unsigned valueSize)
+    {
+        std::string corruptData(data);
+        std::memcpy(&corruptData[offset], &value, valueSize);
+
+        const TempFile corruptFile(countsFileModel);
+        writeFile(corruptFile.name(), corruptData);
+        SequenceAlleleCounts loadedCounts;
+        BOOST_REQUIRE_THROW(loadedCounts.load(corruptFile.name().c_str()), GeneralException);
+
+        const TempFile mergedFile(countsFileModel);
+        const std::vector<std::string> inputFilenames = { corruptFile.name() };
+        BOOST_REQUIRE_THROW(mergeColumnarSequenceAlleleCountsFiles(inputFilenames, mergedFile.name().c_str()),
+                            GeneralException);
+    };
+
+    // unsupported format version:
+    checkCorruptValue(versionOffset, 99, 4);
+
+    // table key width which doesn't match the key word count:
+    checkCorruptValue(firstTableOffset, 3, 4);
+
+    // row counts larger than the file:
+    checkCorruptValue(rowCountOffset, 0xFFFFFFFFFFFFFFF0ull, 8);
+
+    // a variable width table row count which would overflow the key offset column size:
+    uint64_t firstTableRowCount(0);
+    std::memcpy(&firstTableRowCount, &data[rowCountOffset], 8);
+    const unsigned secondTableOffset(firstTableOffset + 24 + (((firstTableRowCount*4)+7)/8)*8 + firstTableRowCount*8);
+    checkCorruptValue(secondTableOffset + 8, 0x2000000000000000ull, 8);
+
+    // a file with no recognized header is read in the original archive format:
+    checkCorruptValue(0, 0, 8);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
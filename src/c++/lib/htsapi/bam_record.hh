@@ -27,6 +27,7 @@
 #include "bam_seq.hh"
 
 #include <iosfwd>
+#include <utility>
 
 
 struct bam_record
@@ -71,6 +72,13 @@ struct bam_record
         return (*this);
     }
 
+    /// exchange record data with rhs without copying
+    void
+    swap(bam_record& rhs)
+    {
+        std::swap(_bp, rhs._bp);
+    }
+
 private:
     const bam_record&
     operator==(const bam_record& rhs);
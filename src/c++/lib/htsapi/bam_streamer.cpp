@@ -29,6 +29,7 @@
 #include <cassert>
 #include <cstdlib>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -48,6 +49,7 @@ bam_streamer(
       _hdr(nullptr),
       _hidx(nullptr),
       _hitr(nullptr),
+      _recordPtr(&_brec),
       _record_no(0),
       _stream_name(filename),
       _is_region(false)
@@ -111,7 +113,7 @@ bam_streamer(
 bam_streamer::
 ~bam_streamer()
 {
-    if (nullptr != _hitr) hts_itr_destroy(_hitr);
+    clearIterators();
     if (nullptr != _hidx) hts_idx_destroy(_hidx);
     if (nullptr != _hdr) bam_hdr_destroy(_hdr);
     if (nullptr != _hfp)
@@ -214,7 +216,7 @@ resetRegion(
     int beginPos,
     int endPos)
 {
-    if (nullptr != _hitr) hts_itr_destroy(_hitr);
+    clearIterators();
 
     _load_index();
 
@@ -241,12 +243,299 @@ resetRegion(
 
 
 
+bool
+bam_streamer::
+isCram() const
+{
+    return (hts_get_format(_hfp)->format == cram);
+}
+
+
+
+bool
+bam_streamer::
+getIndexMappedReadCount(
+    int referenceContigId,
+    uint64_t& mappedReadCount)
+{
+    mappedReadCount = 0;
+
+    // the CRAM index does not share the BAM/CSI index structure, so it can't be queried for read counts:
+    if (isCram()) return false;
+
+    _load_index();
+
+    uint64_t unmappedReadCount(0);
+    return (hts_idx_get_stat(_hidx, referenceContigId, &mappedReadCount, &unmappedReadCount) >= 0);
+}
+
+
+
+bool
+bam_streamer::
+estimateIndexedRegionSize(
+    int referenceContigId,
+    int beginPos,
+    int endPos,
+    uint64_t& compressedSize)
+{
+    compressedSize = 0;
+
+    // CRAM region queries do not produce chunk offsets:
+    if (isCram()) return false;
+
+    _load_index();
+
+    hts_itr_t* itr(sam_itr_queryi(_hidx,referenceContigId,beginPos,endPos));
+    if (itr == nullptr)
+    {
+        std::ostringstream oss;
+        oss << "Failed to fetch region: #" << referenceContigId << ":" << beginPos << "-" << endPos << " specified for BAM/CRAM file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    for (int chunkIndex(0); chunkIndex < itr->n_off; ++chunkIndex)
+    {
+        // the upper 48 bits of a virtual offset are the compressed block offset:
+        const uint64_t beginBlock(itr->off[chunkIndex].u >> 16);
+        const uint64_t endBlock(itr->off[chunkIndex].v >> 16);
+        compressedSize += std::max(endBlock - beginBlock, static_cast<uint64_t>(1));
+    }
+    hts_itr_destroy(itr);
+
+    return true;
+}
+
+
+
+void
+bam_streamer::
+clearIterators()
+{
+    if (nullptr != _hitr)
+    {
+        hts_itr_destroy(_hitr);
+        _hitr = nullptr;
+    }
+    if (nullptr != _hitrMulti)
+    {
+        hts_itr_multi_destroy(_hitrMulti);
+        _hitrMulti = nullptr;
+    }
+    _regionList.clear();
+    _regionListBuffer.clear();
+    _isRegionListIndexSet = false;
+}
+
+
+
+void
+bam_streamer::
+resetRegionList(
+    int referenceContigId,
+    const std::vector<known_pos_range2>& regions)
+{
+    clearIterators();
+
+    _load_index();
+
+    if ((referenceContigId < 0) or (referenceContigId >= _hdr->n_targets))
+    {
+        std::ostringstream oss;
+        oss << "Invalid region list (contig index: " << referenceContigId << ") specified for BAM/CRAM file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    if (regions.empty())
+    {
+        std::ostringstream oss;
+        oss << "Empty region list specified for BAM/CRAM file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    // htslib expects sorted non-overlapping intervals, so overlapping regions are merged here:
+    std::vector<hts_pair32_t> intervals;
+    for (const auto& region : regions)
+    {
+        if ((not intervals.empty()) and
+            ((region.begin_pos() < _regionList.back().begin_pos()) or (region.end_pos() < _regionList.back().end_pos())))
+        {
+            std::ostringstream oss;
+            oss << "Unsorted region list specified for BAM/CRAM file: '" << name() << "'";
+            throw blt_exception(oss.str().c_str());
+        }
+        _regionList.push_back(region);
+
+        if ((not intervals.empty()) and (region.begin_pos() <= static_cast<pos_t>(intervals.back().end)))
+        {
+            intervals.back().end = region.end_pos();
+        }
+        else
+        {
+            intervals.push_back({static_cast<uint32_t>(region.begin_pos()), static_cast<uint32_t>(region.end_pos())});
+        }
+    }
+
+    // the region list is owned by the iterator after this point:
+    hts_reglist_t* regionList(static_cast<hts_reglist_t*>(calloc(1, sizeof(hts_reglist_t))));
+    assert(nullptr != regionList);
+    regionList->reg = _hdr->target_name[referenceContigId];
+    regionList->tid = referenceContigId;
+    regionList->count = intervals.size();
+    regionList->intervals = static_cast<hts_pair32_t*>(malloc(intervals.size()*sizeof(hts_pair32_t)));
+    assert(nullptr != regionList->intervals);
+    std::copy(intervals.begin(), intervals.end(), regionList->intervals);
+    regionList->min_beg = intervals.front().beg;
+    regionList->max_end = intervals.back().end;
+
+    _hitrMulti = sam_itr_regions(_hidx, _hdr, regionList, 1);
+    if (_hitrMulti == nullptr)
+    {
+        hts_reglist_free(regionList, 1);
+        std::ostringstream oss;
+        oss << "Failed to fetch region list on contig #" << referenceContigId << " specified for BAM/CRAM file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+    _isRegionListStreamEnd = false;
+    _is_region = true;
+    _region.clear();
+
+    _is_record_set = false;
+    _record_no = 0;
+}
+
+
+
+void
+bam_streamer::
+resetRegionListIndex(const unsigned regionIndex)
+{
+    if ((nullptr == _hitrMulti) or (regionIndex >= _regionList.size()) or
+        (_isRegionListIndexSet and (regionIndex <= _regionListIndex)))
+    {
+        std::ostringstream oss;
+        oss << "Invalid region list index '" << regionIndex << "' specified for BAM/CRAM file: '" << name() << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+
+    _regionListIndex = regionIndex;
+    _isRegionListIndexSet = true;
+
+    // drop buffered records ending before the new region, no later region can overlap these. Records are sorted
+    // by start position rather than end position, so the buffer is scanned to prevent one long record from retaining
+    // all records which follow it. The buffer is already pruned to records overlapping this region while the
+    // previous region is read, so this scan is short:
+    const known_pos_range2& region(_regionList[regionIndex]);
+    unsigned keptRecordCount(0);
+    for (auto& record : _regionListBuffer)
+    {
+        if (bam_endpos(record.get_data()) <= region.begin_pos()) continue;
+        if (&record != &_regionListBuffer[keptRecordCount])
+        {
+            _regionListBuffer[keptRecordCount].swap(record);
+        }
+        keptRecordCount++;
+    }
+    _regionListBuffer.resize(keptRecordCount);
+    _regionListBufferIndex = 0;
+
+    {
+        std::ostringstream oss;
+        oss << target_id_to_name(_hitrMulti->reg_list[0].tid) << ':' << (region.begin_pos()+1) << '-' << region.end_pos();
+        _region = oss.str();
+    }
+
+    _is_record_set = false;
+    _record_no = 0;
+}
+
+
+
+void
+bam_streamer::
+popConsumedRegionListRecords()
+{
+    // consumed records are only kept if they could overlap the next region, the next region has the lowest begin
+    // position of all remaining regions:
+    const bool isLastRegion((_regionListIndex+1) >= _regionList.size());
+    while (_regionListBufferIndex > 0)
+    {
+        if (not isLastRegion)
+        {
+            const pos_t nextRegionBeginPos(_regionList[_regionListIndex+1].begin_pos());
+            if (bam_endpos(_regionListBuffer.front().get_data()) > nextRegionBeginPos) break;
+        }
+        _regionListBuffer.pop_front();
+        _regionListBufferIndex--;
+    }
+}
+
+
+
+bool
+bam_streamer::
+nextRegionListRecord()
+{
+    assert(_isRegionListIndexSet);
+
+    popConsumedRegionListRecords();
+
+    // records are returned with the same overlap criteria used by the htslib single region iterator:
+    const known_pos_range2& region(_regionList[_regionListIndex]);
+    while (true)
+    {
+        if (_regionListBufferIndex >= _regionListBuffer.size())
+        {
+            if (_isRegionListStreamEnd) break;
+
+            _regionListBuffer.emplace_back();
+            const int ret = sam_itr_multi_next(_hfp, _hitrMulti, _regionListBuffer.back()._bp);
+            if (ret < -1)
+            {
+                std::ostringstream oss;
+                oss << "Unexpected return value from htslib sam_itr_multi_next function '" << ret << "' while attempting to read BAM/CRAM file:\n";
+                report_state(oss);
+                throw blt_exception(oss.str().c_str());
+            }
+            if (ret < 0)
+            {
+                _regionListBuffer.pop_back();
+                _isRegionListStreamEnd = true;
+                break;
+            }
+        }
+
+        const bam_record& record(_regionListBuffer[_regionListBufferIndex]);
+        const bam1_t* recordPtr(record.get_data());
+        if (recordPtr->core.pos >= region.end_pos()) break;
+
+        _regionListBufferIndex++;
+        if (bam_endpos(recordPtr) > region.begin_pos())
+        {
+            _recordPtr = &record;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+
 bool
 bam_streamer::
 next()
 {
     if (nullptr == _hfp) return false;
 
+    if (nullptr != _hitrMulti)
+    {
+        _is_record_set = nextRegionListRecord();
+        if (_is_record_set) _record_no++;
+        return _is_record_set;
+    }
+
+    _recordPtr = &_brec;
+
     int ret;
     if (nullptr == _hitr)
     {
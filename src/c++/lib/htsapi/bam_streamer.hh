@@ -23,13 +23,16 @@
 
 #pragma once
 
+#include "blt_util/known_pos_range2.hh"
 #include "htsapi/bam_record.hh"
 #include "htsapi/sam_util.hh"
 
 #include "boost/utility.hpp"
 
+#include <deque>
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 
 /// Interface for any object which provides current record and file position for error reporting purposes
@@ -85,11 +88,56 @@ struct bam_streamer : public stream_state_reporter, public boost::noncopyable
         int beginPos,
         int endPos);
 
+    /// \brief Set a list of regions to iterate over in a single pass, this will fail if the alignment file is not indexed
+    ///
+    /// Records for all regions are read through one htslib multi-region iterator, so that regions sharing compressed
+    /// blocks are read without a new index seek or any repeated block decompression. After this call, each region
+    /// is selected for iteration with resetRegionListIndex().
+    ///
+    /// \param referenceContigId htslib zero-indexed contig id
+    /// \param regions list of regions sorted by begin and end position, regions may overlap
+    void
+    resetRegionList(
+        int referenceContigId,
+        const std::vector<known_pos_range2>& regions);
+
+    /// \brief Select the region to iterate over from the list set in resetRegionList()
+    ///
+    /// Every record overlapping the selected region is returned, including records already returned for a previous
+    /// region. Regions must be selected in increasing index order.
+    void
+    resetRegionListIndex(unsigned regionIndex);
+
+    /// \brief Get the number of mapped reads on a contig from the alignment file index
+    ///
+    /// \return false if the count is not recorded in the index, which is always the case for CRAM
+    bool
+    getIndexMappedReadCount(
+        int referenceContigId,
+        uint64_t& mappedReadCount);
+
+    /// \brief Estimate the compressed size of the records overlapping a region from the alignment file index
+    ///
+    /// The estimate is the total size of the compressed blocks spanned by the index chunks for the region, without
+    /// decoding any records. Chunks which begin and end within one compressed block are counted as size one, so that
+    /// a non-zero estimate always indicates that the region may contain records.
+    ///
+    /// \param referenceContigId htslib zero-indexed contig id
+    /// \param beginPos start position (zero-indexed, closed)
+    /// \param endPos end position (zero-indexed, open)
+    /// \return false if chunk offsets are not available from the index, which is always the case for CRAM
+    bool
+    estimateIndexedRegionSize(
+        int referenceContigId,
+        int beginPos,
+        int endPos,
+        uint64_t& compressedSize);
+
     bool next();
 
     const bam_record* get_record_ptr() const
     {
-        if (_is_record_set) return &_brec;
+        if (_is_record_set) return _recordPtr;
         else                return nullptr;
     }
 
@@ -117,15 +165,51 @@ struct bam_streamer : public stream_state_reporter, public boost::noncopyable
         return *(_hdr);
     }
 
+    /// \brief Get the number of records held to iterate over the region list, this is provided for testing
+    unsigned
+    getRegionListBufferSize() const
+    {
+        return _regionListBuffer.size();
+    }
+
 private:
     void _load_index();
 
+    bool
+    isCram() const;
+
+    void
+    clearIterators();
+
+    /// \brief Drop records from the front of the region list buffer which have been read for the current region and
+    /// can't overlap any later region
+    void
+    popConsumedRegionListRecords();
+
+    bool
+    nextRegionListRecord();
+
     bool _is_record_set;
     htsFile* _hfp;
     bam_hdr_t* _hdr;
     hts_idx_t* _hidx;
     hts_itr_t* _hitr;
     bam_record _brec;
+    const bam_record* _recordPtr;
+
+    /// region list iteration:
+    hts_itr_multi_t* _hitrMulti = nullptr;
+    std::vector<known_pos_range2> _regionList;
+    unsigned _regionListIndex = 0;
+    bool _isRegionListIndexSet = false;
+    bool _isRegionListStreamEnd = false;
+
+    /// records read from the multi-region iterator which may still overlap the current or later regions,
+    /// sorted by position. Records already read for the current region are dropped from the front of the buffer
+    /// once they end before the next region, so the buffer is limited to records overlapping adjacent regions
+    /// rather than all records of the current region.
+    std::deque<bam_record> _regionListBuffer;
+    unsigned _regionListBufferIndex = 0;
 
     // track for debug only:
     unsigned _record_no;
@@ -25,6 +25,7 @@
 #include "hts_streamer.hh"
 #include "common/Exceptions.hh"
 
+#include <cassert>
 #include <iostream>
 #include <sstream>
 
@@ -99,6 +100,21 @@ resetRegion(
 
 
 
+std::vector<std::string>
+hts_streamer::
+getIndexedChromNames() const
+{
+    assert(nullptr != _tidx);
+
+    int chromCount(0);
+    const char** chromNames(tbx_seqnames(_tidx, &chromCount));
+    std::vector<std::string> names(chromNames, chromNames + chromCount);
+    free(chromNames);
+    return names;
+}
+
+
+
 void
 hts_streamer::
 _load_index()
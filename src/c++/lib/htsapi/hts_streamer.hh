@@ -29,6 +29,7 @@
 #include "boost/utility.hpp"
 
 #include <string>
+#include <vector>
 
 
 /// \brief Stream records various htslib file types
@@ -64,6 +65,10 @@ struct hts_streamer : private boost::noncopyable
     resetRegion(
         const char* region);
 
+    /// \return names of all chromosomes with records in the file index, in index order
+    std::vector<std::string>
+    getIndexedChromNames() const;
+
 protected:
     /// \brief Load index if it hasn't been set already
     void
@@ -110,6 +110,30 @@ get_chrom_length(const std::string& fai_file,
 
 
 
+void
+getFastaChromSizes(
+    const std::string& ref_file,
+    std::vector<std::pair<std::string,unsigned>>& chromSizes)
+{
+    chromSizes.clear();
+    faidx_t* fai(fai_load(ref_file.c_str()));
+    if (nullptr == fai)
+    {
+        std::ostringstream oss;
+        oss << "Can't load index for reference file: '" << ref_file << "'";
+        throw blt_exception(oss.str().c_str());
+    }
+    const int chromCount(faidx_nseq(fai));
+    for (int chromIndex(0); chromIndex<chromCount; ++chromIndex)
+    {
+        const char* chromName(faidx_iseq(fai, chromIndex));
+        chromSizes.emplace_back(chromName, faidx_seq_len(fai, chromName));
+    }
+    fai_destroy(fai);
+}
+
+
+
 void
 get_region_seq(const std::string& ref_file,
                const std::string& fa_region,
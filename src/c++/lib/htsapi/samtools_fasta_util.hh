@@ -25,6 +25,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 /// retrieve a map of chromosome sizes from the fasta index
@@ -43,6 +45,14 @@ get_chrom_length(
     const std::string& chrom_name);
 
 
+/// retrieve the name and size of all chromosomes in the fasta index, in fasta order
+///
+void
+getFastaChromSizes(
+    const std::string& ref_file,
+    std::vector<std::pair<std::string,unsigned>>& chromSizes);
+
+
 /// get reference sequence from region
 void
 get_region_seq(
@@ -24,6 +24,8 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <algorithm>
+
 
 
 BOOST_AUTO_TEST_SUITE( bam_streamer_test_suite )
@@ -76,6 +78,132 @@ BOOST_AUTO_TEST_CASE( test_bam_streamer_cram_read )
     checkStream(stream, 2u);
 }
 
+static
+void
+checkRegionListStream(
+    bam_streamer& stream)
+{
+    const int32_t chromId(stream.target_name_to_id("chrA"));
+    const std::vector<known_pos_range2> regions = { {0,3}, {3,5}, {8,20} };
+    stream.resetRegionList(chromId, regions);
+
+    // reads overlapping more than one region are returned for each region:
+    stream.resetRegionListIndex(0);
+    checkStream(stream, 1u);
+    stream.resetRegionListIndex(1);
+    checkStream(stream, 2u);
+    stream.resetRegionListIndex(2);
+    checkStream(stream, 1u);
+
+    // region indices must increase:
+    BOOST_REQUIRE_THROW(stream.resetRegionListIndex(1), blt_exception);
+
+    // the stream can be returned to a single region:
+    stream.resetRegion("chrA");
+    checkStream(stream, 2u);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_bam_region_list )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+
+    bam_streamer stream(testBamPath.c_str(), nullptr);
+    checkRegionListStream(stream);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_cram_region_list )
+{
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    bam_streamer stream(testCramPath.c_str(), testRefPath.c_str());
+    checkRegionListStream(stream);
+}
+
+
+/// \return the number of mapped reads returned by the stream, and the largest region list buffer size while reading
+static
+unsigned
+countRegionListStream(
+    bam_streamer& stream,
+    unsigned& maxBufferSize)
+{
+    unsigned count(0);
+    while (stream.next())
+    {
+        maxBufferSize = std::max(maxBufferSize, stream.getRegionListBufferSize());
+        const bam_record& read(*(stream.get_record_ptr()));
+        if (! read.is_unmapped()) count++;
+    }
+    return count;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_region_list_buffer )
+{
+    const std::string testBamPath(std::string(DEMO_DATA_PATH) + "/NA12891_demo20.bam");
+
+    // find the expected read count of each region with the single region iterator:
+    bam_streamer stream(testBamPath.c_str(), nullptr);
+    const std::vector<std::string> regionStrings = { "demo20:1-2000", "demo20:4001-5000" };
+    std::vector<unsigned> expectedCounts;
+    for (const auto& regionString : regionStrings)
+    {
+        stream.resetRegion(regionString.c_str());
+        unsigned maxBufferSize(0);
+        expectedCounts.push_back(countRegionListStream(stream, maxBufferSize));
+    }
+    BOOST_REQUIRE(expectedCounts[0] > 100u);
+
+    // Two regions which are too far apart for any read to overlap both are read in one pass. Reads of the first
+    // region are dropped as they are read, so the buffer holds no more than the current and next read:
+    const int32_t chromId(stream.target_name_to_id("demo20"));
+    const std::vector<known_pos_range2> regions = { {0,2000}, {4000,5000} };
+    stream.resetRegionList(chromId, regions);
+    for (unsigned regionIndex(0); regionIndex < regions.size(); ++regionIndex)
+    {
+        stream.resetRegionListIndex(regionIndex);
+        unsigned maxBufferSize(0);
+        BOOST_REQUIRE_EQUAL(countRegionListStream(stream, maxBufferSize), expectedCounts[regionIndex]);
+        BOOST_REQUIRE(maxBufferSize <= 2u);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bam_streamer_index_metadata )
+{
+    const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+    const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+    const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+    {
+        bam_streamer stream(testBamPath.c_str(), nullptr);
+        uint64_t mappedReadCount(0);
+        BOOST_REQUIRE(stream.getIndexMappedReadCount(0, mappedReadCount));
+        BOOST_REQUIRE_EQUAL(mappedReadCount, 2u);
+
+        uint64_t compressedSize(0);
+        BOOST_REQUIRE(stream.estimateIndexedRegionSize(0, 0, 10, compressedSize));
+        BOOST_REQUIRE(compressedSize > 0);
+
+        // check that the stream is still usable after the index queries:
+        stream.resetRegion("chrB");
+        checkStream(stream, 2u);
+    }
+
+    {
+        bam_streamer stream(testCramPath.c_str(), testRefPath.c_str());
+        uint64_t mappedReadCount(0);
+        BOOST_REQUIRE(! stream.getIndexMappedReadCount(0, mappedReadCount));
+
+        uint64_t compressedSize(0);
+        BOOST_REQUIRE(! stream.estimateIndexedRegionSize(0, 0, 10, compressedSize));
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE( test_bam_streamer_cram_read_fail )
 {
     const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
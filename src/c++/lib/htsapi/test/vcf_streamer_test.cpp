@@ -248,5 +248,16 @@ BOOST_AUTO_TEST_CASE( test_vcf_streamer_region )
 }
 
 
+BOOST_AUTO_TEST_CASE( test_vcf_streamer_indexed_chrom_names )
+{
+    vcf_streamer vcfs(getTestpath(), nullptr);
+
+    const std::vector<std::string> chromNames(vcfs.getIndexedChromNames());
+    BOOST_REQUIRE_EQUAL(chromNames.size(), 2u);
+    BOOST_REQUIRE_EQUAL(chromNames[0], "chr1");
+    BOOST_REQUIRE_EQUAL(chromNames[1], "chr10");
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -38,7 +38,7 @@ getOptionsDescription(
     ("normal-align-file", po::value<AlignmentFileOptions::files_t>(),
      "normal sample alignment file in BAM or CRAM format (exactly one file required)")
     ("tumor-align-file", po::value<AlignmentFileOptions::files_t>(),
-     "tumor sample alignment file in BAM or CRAM format (exactly one file required)")
+     "tumor sample alignment file in BAM or CRAM format (at least one file required, each additional file is called as another tumor sample against the same normal sample. Candidate indels are pooled over all samples for read realignment, so a tumor's calls may differ from a separate run of its tumor/normal pair where the other tumors contribute candidate indels)")
     ;
     return desc;
 }
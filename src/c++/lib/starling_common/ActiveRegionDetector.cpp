@@ -58,6 +58,17 @@ ActiveRegionDetector::getReadBuffer(const unsigned sampleIndex)
     return _sampleActiveRegionDetector[sampleIndex]->getReadBuffer();
 }
 
+BufferUsage
+ActiveRegionDetector::getReadBufferUsage() const
+{
+    BufferUsage usage;
+    for (const auto& sampleDetector : _sampleActiveRegionDetector)
+    {
+        usage.add(sampleDetector->_readBuffer.getBufferUsage());
+    }
+    return usage;
+}
+
 ActiveRegionId
 ActiveRegionDetector::getActiveRegionId(const pos_t pos) const
 {
@@ -217,6 +228,7 @@ ActiveRegionDetector::closeActiveRegion()
                                                         _aligner, _sampleActiveRegionDetector[sampleIndex]->getReadBuffer(),
                                                         _indelBuffer, _candidateSnvBuffer);
             activeRegionProcessor.processHaplotypes();
+            _assemblyCount += activeRegionProcessor.isAssemblyRun();
         }
         else
         {
@@ -228,6 +240,7 @@ ActiveRegionDetector::closeActiveRegion()
                                                             _aligner, _sampleActiveRegionDetector[sampleIndex]->getReadBuffer(),
                                                             _indelBuffer, _candidateSnvBuffer);
                 activeRegionProcessor.processHaplotypes();
+                _assemblyCount += activeRegionProcessor.isAssemblyRun();
                 normalHaplotypes = activeRegionProcessor.getSelectedHaplotypes();
             }
             else
@@ -238,6 +251,7 @@ ActiveRegionDetector::closeActiveRegion()
                                                             _indelBuffer, _candidateSnvBuffer);
                 activeRegionProcessor.addHaplotypesToExclude(normalHaplotypes);
                 activeRegionProcessor.processHaplotypes();
+                _assemblyCount += activeRegionProcessor.isAssemblyRun();
             }
         }
     }
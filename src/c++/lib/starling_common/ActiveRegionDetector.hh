@@ -100,6 +100,15 @@ public:
 
     /// Clear the position to active region map
     void clearPosToActiveRegionIdMapUpToPos(const pos_t pos);
+
+    /// Gets the summed occupancy of all sample read buffers
+    BufferUsage getReadBufferUsage() const;
+
+    /// \return total number of assembler runs over all samples and active regions closed by this detector
+    unsigned long getAssemblyCount() const
+    {
+        return _assemblyCount;
+    }
 private:
     const reference_contig_segment& _ref;
     const unsigned _sampleCount;
@@ -115,6 +124,7 @@ private:
     ActiveRegion _synchronizedActiveRegion;
     RangeMap<pos_t, ActiveRegionId> _posToActiveRegionIdMap;
     pos_t _prevActiveRegionEnd = -1;
+    unsigned long _assemblyCount = 0;
 
     SampleActiveRegionDetector& getSampleActiveRegionDetector(unsigned sampleIndex);
     unsigned getPloidy(const unsigned sampleIndex, const ActiveRegion activeRegion) const;
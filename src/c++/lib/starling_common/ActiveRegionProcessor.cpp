@@ -194,6 +194,7 @@ bool ActiveRegionProcessor::generateHaplotypesWithAssembly()
     assembleOption.minCoverage = MinAssemblyCoverage;
 
     // perform assembly
+    _isAssemblyRun = true;
     runIterativeAssembler(assembleOption, reads, assemblyReadOutput, contigs);
 
     unsigned totalNumReadsUsedInAssembly(0);
@@ -103,6 +103,12 @@ public:
     /// Gets selected haplotypes
     const std::vector<std::string>& getSelectedHaplotypes() const;
 
+    /// \return true if haplotypes were generated by running the assembler
+    bool isAssemblyRun() const
+    {
+        return _isAssemblyRun;
+    }
+
 private:
     const known_pos_range2 _posRange;
 
@@ -127,6 +133,8 @@ private:
     /// Total number of reads eligible for the haplotype generation process
     unsigned _numReadsUsedToGenerateHaplotypes;
 
+    bool _isAssemblyRun = false;
+
     IndelBuffer& _indelBuffer;
     CandidateSnvBuffer& _candidateSnvBuffer;
 
@@ -267,3 +267,23 @@ bool ActiveRegionReadBuffer::isCandidateVariant(const pos_t pos) const
 
     return false;
 }
+
+BufferUsage ActiveRegionReadBuffer::getBufferUsage() const
+{
+    BufferUsage usage;
+    usage.items = _readBufferRange.size();
+
+    // fixed-size storage:
+    usage.bytes = sizeof(ActiveRegionReadBuffer);
+    usage.bytes += (_variantCounter.capacity() + _depth.capacity()) * sizeof(unsigned);
+    usage.bytes += _alignIdToAlignInfo.capacity() * sizeof(AlignInfo);
+    usage.bytes += _variantInfo.capacity() * (sizeof(std::vector<VariantType>) + (MaxBufferSize * sizeof(VariantType)));
+    usage.bytes += _insertSeqBuffer.capacity() * (sizeof(std::vector<std::string>) + (MaxBufferSize * sizeof(std::string)));
+
+    for (const auto& alignIds : _positionToAlignIds)
+    {
+        usage.entries += alignIds.size();
+        usage.bytes += sizeof(alignIds) + (alignIds.capacity() * sizeof(align_id_t));
+    }
+    return usage;
+}
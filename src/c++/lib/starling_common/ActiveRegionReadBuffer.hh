@@ -24,6 +24,7 @@
 #pragma once
 
 #include <vector>
+#include "appstats/BufferUsage.hh"
 #include "blt_util/reference_contig_segment.hh"
 #include "blt_util/known_pos_range2.hh"
 #include "starling_types.hh"
@@ -209,6 +210,11 @@ public:
         return (getDepth(pos) == 0u);
     }
 
+    /// Gets buffer occupancy
+    /// \return buffered position count, read observation count and estimated bytes, including the fixed-size
+    /// per-read storage
+    BufferUsage getBufferUsage() const;
+
 private:
     enum VariantType
     {
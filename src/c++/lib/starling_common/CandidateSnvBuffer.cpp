@@ -112,6 +112,17 @@ bool CandidateSnvBuffer::empty() const
     return true;
 }
 
+BufferUsage CandidateSnvBuffer::getBufferUsage() const
+{
+    BufferUsage usage;
+    for (const auto& sampleBuffer : _candidateSnvBuffer)
+    {
+        usage.items += sampleBuffer.size();
+        usage.bytes += sampleBuffer.capacity() * sizeof(HaplotypeIdAndCountRatio);
+    }
+    return usage;
+}
+
 void CandidateSnvBuffer::clearUpToPos(const unsigned sampleIndex, const pos_t pos)
 {
     _candidateSnvBuffer[sampleIndex].eraseTo(pos);
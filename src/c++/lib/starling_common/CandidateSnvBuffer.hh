@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstdint>
+#include <appstats/BufferUsage.hh>
 #include <blt_util/blt_types.hh>
 #include <blt_util/seq_util.hh>
 #include <blt_util/RangeMap.hh>
@@ -91,6 +92,10 @@ public:
     /// Returns true if no candidate SNV exists in any sample
     bool empty() const;
 
+    /// Gets buffer occupancy
+    /// \return candidate SNV position count summed over all samples and estimated bytes
+    BufferUsage getBufferUsage() const;
+
     /// Clear all candidate SNVs up to the specified position
     /// \param sampleIndex sample index
     /// \param pos position
@@ -24,6 +24,7 @@
 
 #include "HtsMergeStreamer.hh"
 #include "common/Exceptions.hh"
+#include "starling_common/starling_ref_seq.hh"
 
 #include "boost/optional.hpp"
 
@@ -97,6 +98,49 @@ resetRegion(const std::string& region)
 {
     assert(! region.empty());
 
+    _regionListChrom.clear();
+    _regionListRanges.clear();
+    resetStreams(region);
+}
+
+
+
+void
+HtsMergeStreamer::
+resetRegionList(
+    const std::string& chrom,
+    const std::vector<known_pos_range2>& regionRanges)
+{
+    assert(! chrom.empty());
+    assert(! regionRanges.empty());
+
+    _regionListChrom = chrom;
+    _regionListRanges = regionRanges;
+    for (auto& bamStreamer : _data._bam)
+    {
+        bamStreamer->resetRegionList(bamStreamer->target_name_to_id(chrom.c_str()), regionRanges);
+    }
+}
+
+
+
+void
+HtsMergeStreamer::
+resetRegionListIndex(const unsigned regionIndex)
+{
+    assert(regionIndex < _regionListRanges.size());
+
+    resetStreams(getSamtoolsRegionString(_regionListChrom, _regionListRanges[regionIndex]), regionIndex);
+}
+
+
+
+void
+HtsMergeStreamer::
+resetStreams(
+    const std::string& region,
+    const int regionListIndex)
+{
     _region = region;
     _isStreamBegin = false;
     _isStreamEnd = false;
@@ -108,7 +152,15 @@ resetRegion(const std::string& region)
         const auto& orderData(_order[streamIndex]);
         if (orderData.htsType == HTS_TYPE::BAM)
         {
-            getHtsStreamer(streamIndex, _data._bam).resetRegion(region.c_str());
+            bam_streamer& bamStreamer(getHtsStreamer(streamIndex, _data._bam));
+            if (regionListIndex >= 0)
+            {
+                bamStreamer.resetRegionListIndex(regionListIndex);
+            }
+            else
+            {
+                bamStreamer.resetRegion(region.c_str());
+            }
         }
         else if (orderData.htsType == HTS_TYPE::BED)
         {
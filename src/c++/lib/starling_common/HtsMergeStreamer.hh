@@ -24,6 +24,7 @@
 #pragma once
 
 #include "blt_util/blt_types.hh"
+#include "blt_util/known_pos_range2.hh"
 #include "htsapi/bam_streamer.hh"
 #include "htsapi/bed_streamer.hh"
 #include "htsapi/vcf_streamer.hh"
@@ -160,6 +161,24 @@ struct HtsMergeStreamer
     void
     resetRegion(const std::string& region);
 
+    /// Reset the streamer to a sorted list of regions on one chromosome
+    ///
+    /// Alignment records for the complete region list are read in a single pass, which avoids an index seek
+    /// for every region when many small nearby regions are scanned. Each region is then scanned in order by
+    /// calling resetRegionListIndex().
+    ///
+    /// \param[in] regionRanges list of regions sorted by begin and end position, regions may overlap
+    void
+    resetRegionList(
+        const std::string& chrom,
+        const std::vector<known_pos_range2>& regionRanges);
+
+    /// Reset the region over which all files are scanned to a member of the current region list
+    ///
+    /// Region indices must be provided in increasing order.
+    void
+    resetRegionListIndex(const unsigned regionIndex);
+
 
     /// Advances to the next HTS record in the merged stream
     ///
@@ -347,6 +366,13 @@ private:
     void
     queueItem(const unsigned orderIndex);
 
+    /// \param[in] regionListIndex if non-negative, alignment files are reset to this index of the current
+    ///                            region list instead of to region
+    void
+    resetStreams(
+        const std::string& region,
+        const int regionListIndex = -1);
+
     /// attempt to queue an item from the same order
     /// as the head of the queue:
     void
@@ -359,6 +385,8 @@ private:
     /////// data:
     std::string _referenceFilename;
     std::string _region;
+    std::string _regionListChrom;
+    std::vector<known_pos_range2> _regionListRanges;
     HtsData _data;
     std::vector<OrderData> _order;
 
@@ -317,6 +317,39 @@ clearIndelsAtPosition(const pos_t pos)
 
 
 
+BufferUsage
+IndelBuffer::
+getBufferUsage() const
+{
+    BufferUsage usage;
+    for (const auto& val : _indelBuffer)
+    {
+        const IndelData& indelData(val.second);
+        usage.items++;
+        usage.bytes += sizeof(indel_buffer_data_t::value_type);
+
+        const unsigned sampleCount(indelData.getSampleCount());
+        for (unsigned sampleIndex(0); sampleIndex < sampleCount; ++sampleIndex)
+        {
+            const IndelSampleData& sampleData(indelData.getSampleData(sampleIndex));
+            const uint64_t readIdCount(
+                sampleData.tier1_map_read_ids.size() +
+                sampleData.tier2_map_read_ids.size() +
+                sampleData.submap_read_ids.size() +
+                sampleData.noise_read_ids.size() +
+                sampleData.suboverlap_tier1_read_ids.size() +
+                sampleData.suboverlap_tier2_read_ids.size());
+            const uint64_t scoreCount(sampleData.read_path_lnp.size());
+            usage.entries += readIdCount + scoreCount;
+            usage.bytes += sizeof(IndelSampleData) + (readIdCount * sizeof(align_id_t)) +
+                           (scoreCount * sizeof(IndelSampleData::score_t::value_type));
+        }
+    }
+    return usage;
+}
+
+
+
 static
 void
 dump_range(
@@ -24,6 +24,7 @@
 #pragma once
 
 
+#include "appstats/BufferUsage.hh"
 #include "blt_util/depth_buffer.hh"
 #include "starling_common/indel.hh"
 #include "starling_common/min_count_binom_gte_cache.hh"
@@ -190,6 +191,10 @@ struct IndelBuffer
         return _indelBuffer.empty();
     }
 
+    /// \return buffered indel count, read evidence entries over all samples and estimated bytes
+    BufferUsage
+    getBufferUsage() const;
+
     // debug dumpers:
     void
     dumpPosition(
@@ -44,8 +44,10 @@ insertAlt(
     const score_t a)
 {
     const unsigned ais(static_cast<unsigned>(alt_indel.size()));
-    if (ais < 2)
+    if (ais < maxAltIndelCount)
     {
+        // allocate the full list up front, read scores are long-lived and stored per read:
+        if (ais == 0) alt_indel.reserve(maxAltIndelCount);
         alt_indel.push_back(std::make_pair(indelKey,a));
     }
     else
@@ -25,6 +25,7 @@
 
 #include "blt_util/LogValuePair.hh"
 #include "blt_util/reference_contig_segment.hh"
+#include "blt_util/SortedVectorMap.hh"
 #include "starling_common/AlleleReportInfo.hh"
 #include "starling_common/indel_align_type.hh"
 #include "starling_common/IndelKey.hh"
@@ -36,7 +37,6 @@
 #include <iosfwd>
 #include <map>
 #include <string>
-#include <set>
 #include <vector>
 
 
@@ -96,6 +96,7 @@ struct ReadPathScores
 //    score_t alt;
 
     // store up to 2 highest scoring alternate indels
+    static const unsigned maxAltIndelCount = 2;
     typedef std::vector<std::pair<IndelKey,score_t> > alt_indel_t;
     alt_indel_t alt_indel;
 
@@ -246,7 +247,10 @@ struct IndelSampleData
     // tier2 mapping criteria. All other (non-noise) observations are
     // categorized as submapped
     //
-    typedef std::set<align_id_t> evidence_t;
+    // read ids are mostly added in increasing order, so all read evidence is stored in flat sorted vectors,
+    // which avoids a tree node per read at high depth:
+    //
+    typedef SortedVectorSet<align_id_t> evidence_t;
     evidence_t tier1_map_read_ids;
     evidence_t tier2_map_read_ids;
     evidence_t submap_read_ids;
@@ -259,7 +263,7 @@ struct IndelSampleData
     // enumerates support for the indel among all reads
     // which cross an indel breakpoint by a sufficient margin after
     // re-alignment:
-    typedef std::map<align_id_t,ReadPathScores> score_t;
+    typedef SortedVectorMap<align_id_t,ReadPathScores> score_t;
     score_t read_path_lnp;
 
     // the reads which cross an indel breakpoint, but not by enough
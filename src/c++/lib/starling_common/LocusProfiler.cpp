@@ -0,0 +1,104 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Attributes variant calling cost to fixed-size genome windows
+///
+
+#include "starling_common/LocusProfiler.hh"
+
+#include "common/Exceptions.hh"
+
+#include <cassert>
+
+#include <iomanip>
+#include <sstream>
+
+
+
+LocusProfiler::
+LocusProfiler(
+    const std::string& outputFile,
+    const unsigned windowSize,
+    const double minSeconds,
+    RunStatsManager& statsManager)
+    : _os(outputFile.c_str()),
+      _windowSize(windowSize),
+      _minSeconds(minSeconds),
+      _statsManager(statsManager)
+{
+    assert(windowSize > 0);
+
+    if (! _os)
+    {
+        std::ostringstream oss;
+        oss << "Can't open output file: '" << outputFile << "'";
+        BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+    }
+
+    _os << std::setprecision(4);
+    LocusProfileWindow::writeBedHeader(_os);
+}
+
+
+
+void
+LocusProfiler::
+flush(const std::string& chrom)
+{
+    if (_windows.empty()) return;
+
+    const double ticksPerSecond(_clockCalibration.getTicksPerSecond());
+
+    LocusProfileWindow window;
+    window.chrom = chrom;
+    for (const auto& windowVal : _windows)
+    {
+        const WindowData& windowData(windowVal.second);
+        window.seconds = ((ticksPerSecond > 0) ? (windowData.ticks / ticksPerSecond) : 0.);
+        window.beginPos = windowVal.first * _windowSize;
+        window.endPos = window.beginPos + _windowSize;
+        window.realignedReads = windowData.realignedReads;
+        window.scoredAlignments = windowData.scoredAlignments;
+        window.assemblies = windowData.assemblies;
+
+        // windows below threshold may still reach it when merged with the same window from another segment:
+        _statsManager.addLocusProfileWindow(window);
+        if (window.seconds < _minSeconds) continue;
+        window.writeBedRecord(_os);
+    }
+    _os.flush();
+
+    _windows.clear();
+}
+
+
+
+void
+setLocusProfileStatsOptions(
+    const bam_header_info& referenceHeaderInfo,
+    const double minSeconds,
+    RunStatsManager& statsManager)
+{
+    std::vector<std::string> chromOrder;
+    for (const auto& chromInfo : referenceHeaderInfo.chrom_data)
+    {
+        chromOrder.push_back(chromInfo.label);
+    }
+    statsManager.setLocusProfileOptions(chromOrder, minSeconds);
+}
@@ -0,0 +1,149 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Attributes variant calling cost to fixed-size genome windows
+///
+
+#pragma once
+
+#include "appstats/RunStatsManager.hh"
+#include "blt_util/blt_types.hh"
+#include "htsapi/bam_header_info.hh"
+
+#include "boost/utility.hpp"
+
+#include <fstream>
+#include <map>
+#include <string>
+
+
+/// \brief Accumulates processing time and realignment/assembly workload over fixed-size genome windows
+///
+/// Windows which reach the time threshold are written to a BED file, so that the most expensive parts of the genome
+/// can be found after a run. All windows are recorded in the run stats, so that segment results can be combined by
+/// MergeRunStats before the threshold is applied.
+///
+struct LocusProfiler : private boost::noncopyable
+{
+    /// \param[in] outputFile BED output filename
+    /// \param[in] windowSize genome window size
+    /// \param[in] minSeconds minimum processing time required to report a window
+    LocusProfiler(
+        const std::string& outputFile,
+        const unsigned windowSize,
+        const double minSeconds,
+        RunStatsManager& statsManager);
+
+    void
+    addTicks(
+        const pos_t pos,
+        const uint64_t ticks)
+    {
+        getWindow(pos).ticks += ticks;
+    }
+
+    /// Add one read with scoredAlignmentCount candidate alignments scored during realignment
+    void
+    addRealignedRead(
+        const pos_t pos,
+        const unsigned scoredAlignmentCount)
+    {
+        if (scoredAlignmentCount == 0) return;
+        WindowData& window(getWindow(pos));
+        window.realignedReads++;
+        window.scoredAlignments += scoredAlignmentCount;
+    }
+
+    void
+    addAssemblies(
+        const pos_t pos,
+        const unsigned long assemblyCount)
+    {
+        if (assemblyCount == 0) return;
+        getWindow(pos).assemblies += assemblyCount;
+    }
+
+    /// Report all windows reaching the time threshold on chrom, and clear all windows
+    void
+    flush(const std::string& chrom);
+
+private:
+    struct WindowData
+    {
+        uint64_t ticks = 0;
+        unsigned long realignedReads = 0;
+        unsigned long scoredAlignments = 0;
+        unsigned long assemblies = 0;
+    };
+
+    WindowData&
+    getWindow(const pos_t pos)
+    {
+        const pos_t windowIndex((pos >= 0) ? (pos / _windowSize) : 0);
+        return _windows[windowIndex];
+    }
+
+    std::ofstream _os;
+    const pos_t _windowSize;
+    const double _minSeconds;
+    RunStatsManager& _statsManager;
+    StageTimerClockCalibration _clockCalibration;
+
+    /// windows in the current region, keyed on window index
+    std::map<pos_t,WindowData> _windows;
+};
+
+
+
+/// Set the locus profile reference chromosome order and report threshold in the run stats
+///
+/// \param[in] referenceHeaderInfo alignment file header providing the reference chromosome order
+/// \param[in] minSeconds minimum processing time required to report a window
+void
+setLocusProfileStatsOptions(
+    const bam_header_info& referenceHeaderInfo,
+    const double minSeconds,
+    RunStatsManager& statsManager);
+
+
+
+/// Attribute stage timer ticks to the window containing pos for the lifetime of this object
+///
+/// The profiler may be null, in which case nothing is recorded.
+struct LocusProfileTimeScoper : private boost::noncopyable
+{
+    LocusProfileTimeScoper(
+        LocusProfiler* profilerPtr,
+        const pos_t pos)
+        : _profilerPtr(profilerPtr),
+          _pos(pos),
+          _startTicks((nullptr == profilerPtr) ? 0 : getStageTimerTicks())
+    {}
+
+    ~LocusProfileTimeScoper()
+    {
+        if (nullptr == _profilerPtr) return;
+        _profilerPtr->addTicks(_pos, (getStageTimerTicks() - _startTicks));
+    }
+
+private:
+    LocusProfiler* _profilerPtr;
+    const pos_t _pos;
+    const uint64_t _startTicks;
+};
@@ -0,0 +1,232 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Periodically reports variant calling progress to a status file or FIFO
+///
+
+#include "starling_common/ProgressReporter.hh"
+
+#include "common/Exceptions.hh"
+
+#include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+/// \return current resident set size of this process, or zero if this can't be found
+static
+uint64_t
+getResidentBytes()
+{
+#ifdef __linux__
+    std::ifstream ifs("/proc/self/statm");
+    uint64_t totalPages(0), residentPages(0);
+    if (ifs >> totalPages >> residentPages)
+    {
+        return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+
+
+ProgressReporter::
+ProgressReporter(
+    const std::string& outputFile,
+    const double intervalSeconds)
+    : _outputFile(outputFile),
+      _interval(std::chrono::duration_cast<ProgressClock::duration>(std::chrono::duration<double>(intervalSeconds))),
+      _startTime(ProgressClock::now()),
+      _nextReportTime(_startTime + _interval),
+      _lastReportTime(_startTime)
+{
+    assert(not outputFile.empty());
+    assert(intervalSeconds > 0);
+
+#ifndef _WIN32
+    struct stat fileStat;
+    _isFifo = ((stat(_outputFile.c_str(), &fileStat) == 0) and S_ISFIFO(fileStat.st_mode));
+    if (_isFifo)
+    {
+        signal(SIGPIPE, SIG_IGN);
+        return;
+    }
+#endif
+
+    // write an initial record to a status file, so that an unusable path is found immediately:
+
+    std::ofstream ofs(_outputFile.c_str());
+    if (! ofs)
+    {
+        std::ostringstream oss;
+        oss << "Can't open output file: '" << _outputFile << "'";
+        BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+    }
+    writeRecord(ofs, _chrom, _pos, 0, 0, 0., 0., _bufferState, getResidentBytes(), false);
+}
+
+
+
+ProgressReporter::
+~ProgressReporter()
+{
+    try
+    {
+        writeReport(true);
+    }
+    catch (...)
+    {
+        // progress reporting failures should not interrupt shutdown
+    }
+
+#ifndef _WIN32
+    if (_fifoFd >= 0) close(_fifoFd);
+#endif
+}
+
+
+
+void
+ProgressReporter::
+updatePosition(
+    const std::string& chrom,
+    const pos_t pos)
+{
+    if (chrom == _chrom)
+    {
+        if (pos > _pos) _baseCount += (pos - _pos);
+    }
+    else
+    {
+        _chrom = chrom;
+    }
+    _pos = pos;
+}
+
+
+
+void
+ProgressReporter::
+report(const ProgressBufferState& bufferState)
+{
+    _bufferState = bufferState;
+    writeReport(false);
+}
+
+
+
+void
+ProgressReporter::
+writeRecord(
+    std::ostream& os,
+    const std::string& chrom,
+    const pos_t pos,
+    const uint64_t readCount,
+    const uint64_t baseCount,
+    const double elapsedSeconds,
+    const double basesPerSecond,
+    const ProgressBufferState& bufferState,
+    const uint64_t rssBytes,
+    const bool isComplete)
+{
+    // contig names can't include quote or escape characters, so no escaping is needed here:
+    os << std::fixed << std::setprecision(2)
+       << "{\"chrom\":\"" << chrom << "\""
+       << ",\"pos\":" << (pos+1)
+       << ",\"readsConsumed\":" << readCount
+       << ",\"basesProcessed\":" << baseCount
+       << ",\"elapsedSeconds\":" << elapsedSeconds
+       << ",\"basesPerSecond\":" << basesPerSecond
+       << ",\"bufferedReads\":" << bufferState.reads
+       << ",\"bufferedMb\":" << (bufferState.bytes/1e6)
+       << ",\"rssMb\":" << (rssBytes/1e6)
+       << ",\"isComplete\":" << (isComplete ? "true" : "false")
+       << "}\n";
+}
+
+
+
+void
+ProgressReporter::
+writeReport(const bool isComplete)
+{
+    const ProgressClock::time_point now(ProgressClock::now());
+    const double elapsedSeconds(std::chrono::duration<double>(now - _startTime).count());
+    const double intervalSeconds(std::chrono::duration<double>(now - _lastReportTime).count());
+    const double basesPerSecond((intervalSeconds > 0) ? ((_baseCount - _lastReportBaseCount) / intervalSeconds) : 0.);
+
+    std::ostringstream oss;
+    writeRecord(oss, _chrom, _pos, _readCount, _baseCount, elapsedSeconds, basesPerSecond, _bufferState,
+                getResidentBytes(), isComplete);
+    writeOutput(oss.str());
+
+    _lastReportTime = now;
+    _lastReportBaseCount = _baseCount;
+    _nextReportTime = now + _interval;
+}
+
+
+
+void
+ProgressReporter::
+writeOutput(const std::string& record)
+{
+#ifndef _WIN32
+    if (_isFifo)
+    {
+        // records are dropped rather than blocking the caller when no reader is attached:
+        if (_fifoFd < 0)
+        {
+            _fifoFd = open(_outputFile.c_str(), (O_WRONLY | O_NONBLOCK));
+            if (_fifoFd < 0) return;
+        }
+        const ssize_t writeSize(write(_fifoFd, record.data(), record.size()));
+        if ((writeSize < 0) and (errno == EPIPE))
+        {
+            // the reader has detached, so reopen the FIFO for the next record:
+            close(_fifoFd);
+            _fifoFd = -1;
+        }
+        return;
+    }
+#endif
+
+    // write the record to a temporary file and rename, so that readers never find a partial record:
+    const std::string tmpFile(_outputFile + ".tmp");
+    {
+        std::ofstream ofs(tmpFile.c_str());
+        if (! ofs) return;
+        ofs << record;
+        if (! ofs) return;
+    }
+    std::rename(tmpFile.c_str(), _outputFile.c_str());
+}
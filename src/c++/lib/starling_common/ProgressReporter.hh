@@ -0,0 +1,138 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Periodically reports variant calling progress to a status file or FIFO
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include "boost/utility.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+
+/// Buffer occupancy summary included in each progress report
+struct ProgressBufferState
+{
+    /// reads buffered over all samples
+    uint64_t reads = 0;
+
+    /// estimated bytes used by all tracked buffers
+    uint64_t bytes = 0;
+};
+
+
+
+/// \brief Writes a one-line JSON progress record at a fixed time interval
+///
+/// Progress is updated from the existing periodic buffer sampling point of the position processor, so the
+/// only per-read cost is a counter increment, and the clock is only queried at each sample. The buffer state is
+/// only collected by the caller when isReportDue() shows that a record will be written.
+///
+/// If the output path is a FIFO, each record is written to it as one line, and records are discarded while
+/// no reader is attached. SIGPIPE is ignored in this case, so that a reader detaching can't end the run.
+/// Otherwise the output file is atomically replaced by each new record, so that a reader always finds one
+/// complete record.
+///
+struct ProgressReporter : private boost::noncopyable
+{
+private:
+    typedef std::chrono::steady_clock ProgressClock;
+
+public:
+    /// \param[in] outputFile status file or FIFO path
+    /// \param[in] intervalSeconds minimum time between progress records
+    ProgressReporter(
+        const std::string& outputFile,
+        const double intervalSeconds);
+
+    /// write a final record marking the run as complete
+    ~ProgressReporter();
+
+    void
+    addRead()
+    {
+        _readCount++;
+    }
+
+    /// Update the current position
+    ///
+    /// \param[in] pos zero-indexed position reached by the position processor
+    void
+    updatePosition(
+        const std::string& chrom,
+        const pos_t pos);
+
+    /// \return true if the report interval has elapsed, so that a progress record should be written with report()
+    bool
+    isReportDue() const
+    {
+        return (ProgressClock::now() >= _nextReportTime);
+    }
+
+    /// Write a progress record for the current position
+    void
+    report(const ProgressBufferState& bufferState);
+
+    /// Write one progress record in JSON format as a single line
+    static
+    void
+    writeRecord(
+        std::ostream& os,
+        const std::string& chrom,
+        const pos_t pos,
+        const uint64_t readCount,
+        const uint64_t baseCount,
+        const double elapsedSeconds,
+        const double basesPerSecond,
+        const ProgressBufferState& bufferState,
+        const uint64_t rssBytes,
+        const bool isComplete);
+
+private:
+    void
+    writeReport(const bool isComplete);
+
+    void
+    writeOutput(const std::string& record);
+
+    const std::string _outputFile;
+    const ProgressClock::duration _interval;
+    bool _isFifo = false;
+
+    /// FIFO file descriptor, this is held open while a reader is attached
+    int _fifoFd = -1;
+
+    const ProgressClock::time_point _startTime;
+    ProgressClock::time_point _nextReportTime;
+    ProgressClock::time_point _lastReportTime;
+
+    uint64_t _readCount = 0;
+    uint64_t _baseCount = 0;
+    uint64_t _lastReportBaseCount = 0;
+
+    std::string _chrom;
+    pos_t _pos = 0;
+    ProgressBufferState _bufferState;
+};
@@ -0,0 +1,143 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Downsamples input reads to keep read buffering within a memory budget
+///
+
+#include "starling_common/ReadThrottler.hh"
+
+#include "common/Exceptions.hh"
+
+#include <cassert>
+
+#include <algorithm>
+#include <sstream>
+
+
+
+/// throttling starts when the buffer memory estimate reaches this fraction of the budget:
+static const double throttleStartFraction(0.75);
+
+
+
+ReadThrottler::
+ReadThrottler(
+    const uint64_t budgetBytes,
+    const std::string& outputFile,
+    RunStatsManager& statsManager)
+    : _budgetBytes(budgetBytes),
+      _statsManager(statsManager)
+{
+    assert(budgetBytes > 0);
+
+    if (outputFile.empty()) return;
+
+    _osPtr.reset(new std::ofstream(outputFile.c_str()));
+    if (! *_osPtr)
+    {
+        std::ostringstream oss;
+        oss << "Can't open output file: '" << outputFile << "'";
+        BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+    }
+
+    *_osPtr << "#chrom\tstart\tend\tthrottledReads\n";
+}
+
+
+
+double
+ReadThrottler::
+getKeepFraction() const
+{
+    const double startBytes(_budgetBytes * throttleStartFraction);
+    if (_bufferedBytes <= startBytes) return 1.;
+    if (_bufferedBytes >= _budgetBytes) return 0.;
+    return ((_budgetBytes - _bufferedBytes) / (_budgetBytes - startBytes));
+}
+
+
+
+bool
+ReadThrottler::
+isThrottled(
+    const char* readName,
+    const std::string& chrom,
+    const pos_t beginPos,
+    const pos_t endPos)
+{
+    const double keepFraction(getKeepFraction());
+    if (keepFraction >= 1.) return false;
+    if (getReadNameHashFraction(readName) < keepFraction) return false;
+
+    const bool isRegionExtended((_regionReads > 0) and (chrom == _regionChrom) and (beginPos <= _regionEndPos));
+    if (isRegionExtended)
+    {
+        _regionEndPos = std::max(_regionEndPos, endPos);
+    }
+    else
+    {
+        flush();
+        _regionChrom = chrom;
+        _regionBeginPos = beginPos;
+        _regionEndPos = endPos;
+    }
+    _regionReads++;
+    return true;
+}
+
+
+
+void
+ReadThrottler::
+flush()
+{
+    if (_regionReads == 0) return;
+
+    if (_osPtr)
+    {
+        *_osPtr << _regionChrom
+                << '\t' << _regionBeginPos
+                << '\t' << _regionEndPos
+                << '\t' << _regionReads
+                << '\n';
+        _osPtr->flush();
+    }
+    _statsManager.addThrottledRegion(_regionReads);
+    _regionReads = 0;
+}
+
+
+
+double
+ReadThrottler::
+getReadNameHashFraction(const char* readName)
+{
+    assert(nullptr != readName);
+
+    // 64-bit FNV-1a:
+    uint64_t hash(UINT64_C(14695981039346656037));
+    for (const char* namePtr(readName); *namePtr != '\0'; ++namePtr)
+    {
+        hash ^= static_cast<unsigned char>(*namePtr);
+        hash *= UINT64_C(1099511628211);
+    }
+
+    // use the high 53 bits so that the result is exactly representable:
+    return ((hash >> 11) * (1.0 / (UINT64_C(1) << 53)));
+}
@@ -0,0 +1,113 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Downsamples input reads to keep read buffering within a memory budget
+///
+
+#pragma once
+
+#include "appstats/RunStatsManager.hh"
+#include "blt_util/blt_types.hh"
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+
+/// \brief Deterministically downsamples input reads when buffered read data approaches a memory budget
+///
+/// The buffer memory estimate is the read and basecall buffer usage found by the most recent full buffer scan,
+/// plus the approximate cost of each read inserted since that scan. Throttling starts once this estimate reaches
+/// a fixed fraction of the budget, and the fraction of reads retained falls linearly from one to zero as the
+/// estimate rises from this point to the full budget.
+///
+/// Each read is retained if a hash of its name is below the current keep fraction, so the result is reproducible.
+/// Both reads of a pair have the same hash, but the keep fraction may change between reading the two mates, so
+/// the pair is split whenever the keep fraction crosses the hash value in between. Contiguous genome intervals
+/// where reads are dropped are written to an optional BED file and counted in the run stats.
+///
+struct ReadThrottler : private boost::noncopyable
+{
+    /// \param[in] budgetBytes buffered read memory budget
+    /// \param[in] outputFile optional BED output filename of throttled regions, no output is written if empty
+    ReadThrottler(
+        const uint64_t budgetBytes,
+        const std::string& outputFile,
+        RunStatsManager& statsManager);
+
+    /// Reset the buffer memory estimate to the result of a full buffer scan
+    void
+    setBufferedBytes(const uint64_t bytes)
+    {
+        _bufferedBytes = bytes;
+    }
+
+    /// Add the approximate cost of a newly buffered read to the buffer memory estimate
+    void
+    addBufferedBytes(const uint64_t bytes)
+    {
+        _bufferedBytes += bytes;
+    }
+
+    /// \return fraction of reads retained at the current buffer memory estimate
+    double
+    getKeepFraction() const;
+
+    /// Test whether a read should be dropped to stay within the memory budget
+    ///
+    /// \param[in] readName read name used to make a reproducible downsampling decision
+    /// \param[in] beginPos zero-indexed start of the read alignment
+    /// \param[in] endPos zero-indexed end of the read alignment (exclusive)
+    ///
+    /// \return true if the read should be dropped
+    bool
+    isThrottled(
+        const char* readName,
+        const std::string& chrom,
+        const pos_t beginPos,
+        const pos_t endPos);
+
+    /// Report the current throttled region, if any
+    void
+    flush();
+
+    /// \return hash value of readName scaled to [0,1)
+    ///
+    /// This is a fixed hash function so that downsampling decisions do not depend on the standard library.
+    static
+    double
+    getReadNameHashFraction(const char* readName);
+
+private:
+    const uint64_t _budgetBytes;
+    std::unique_ptr<std::ofstream> _osPtr;
+    RunStatsManager& _statsManager;
+
+    uint64_t _bufferedBytes = 0;
+
+    /// the current throttled region, this is extended until a throttled read is found beyond its end
+    std::string _regionChrom;
+    pos_t _regionBeginPos = 0;
+    pos_t _regionEndPos = 0;
+    unsigned long _regionReads = 0;
+};
@@ -0,0 +1,202 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "ReferenceAnnotationUtil.hh"
+#include "ReferenceRepeatFinder.hh"
+
+#include <cassert>
+
+#include <algorithm>
+
+
+
+/// add the SNP homopolymer size for all contig positions
+///
+/// This follows get_snp_hpol_size, using the length of the homopolymer runs ending immediately
+/// before and starting immediately after each position.
+static
+void
+addSnpHpolSize(
+    const std::string& seq,
+    std::vector<ReferenceAnnotation>& annotation)
+{
+    const pos_t contigSize(seq.size());
+
+    // length of homopolymer run ending at each position:
+    std::vector<unsigned> leftRunSize(contigSize);
+    for (pos_t pos(0); pos<contigSize; ++pos)
+    {
+        leftRunSize[pos] = (((pos>0) and (seq[pos] == seq[pos-1])) ? leftRunSize[pos-1]+1 : 1);
+    }
+
+    unsigned rightRunSize(0);
+    for (pos_t pos(contigSize-1); pos>=0; --pos)
+    {
+        char upBase('N');
+        unsigned upSize(0);
+        if ((pos>0) and (seq[pos-1] != 'N'))
+        {
+            upBase = seq[pos-1];
+            upSize = leftRunSize[pos-1];
+        }
+
+        char downBase('N');
+        unsigned downSize(0);
+        if (((pos+1)<contigSize) and (seq[pos+1] != 'N'))
+        {
+            downBase = seq[pos+1];
+            downSize = rightRunSize;
+        }
+
+        annotation[pos].setSnpHpolSize(1+((upBase==downBase) ? upSize+downSize : std::max(upSize, downSize)));
+
+        // update to the length of the run starting at pos:
+        rightRunSize = ((((pos+1)<contigSize) and (seq[pos] == seq[pos+1])) ? rightRunSize+1 : 1);
+    }
+}
+
+
+
+/// add the STR period, left-end flag and repeat count for all contig positions
+///
+/// For pattern size k, two k-mers at positions a and a+k match when the bases at a+i and a+i+k match
+/// for all i<k. searchForSTR finds that a base at pos is in an STR if any k-mer starting in
+/// [pos-2k+1,pos] matches the k-mer k bases downstream. By tracking the run of matching bases at
+/// distance k, this test can be made for all positions in a single pass for each pattern size.
+static
+void
+addSTRContext(
+    const std::string& seq,
+    std::vector<ReferenceAnnotation>& annotation)
+{
+    const pos_t contigSize(seq.size());
+
+    // positions outside of the contig are treated as 'N', as in reference_contig_segment::get_base()
+    static const pos_t padSize(2*ReferenceAnnotation::MaxSTRPeriod+2);
+    std::string paddedSeq(padSize, 'N');
+    paddedSeq += seq;
+    paddedSeq += std::string(padSize, 'N');
+    auto base = [&](const pos_t pos)
+    {
+        return paddedSeq[pos+padSize];
+    };
+
+    // the run of matching bases is only needed up to the maximum reported repeat count:
+    static const unsigned maxMatchRunSize(ReferenceAnnotation::MaxSTRPeriod*(ReferenceAnnotation::MaxSTRRepeatCount+1));
+    static_assert(maxMatchRunSize <= 255, "Unexpected max STR match run size");
+
+    // matchRunSize[pos+padSize] is the count of consecutive bases starting from pos which match the base
+    // patternSize positions downstream:
+    std::vector<uint8_t> matchRunSize(paddedSeq.size(), 0);
+
+    for (unsigned patternSize(1); patternSize<=ReferenceAnnotation::MaxSTRPeriod; ++patternSize)
+    {
+        const pos_t k(patternSize);
+        const pos_t firstPos(-2*k);
+        const pos_t endPos(contigSize+k);
+        assert((firstPos+padSize) >= 0);
+        assert((endPos+k+padSize) <= static_cast<pos_t>(paddedSeq.size()));
+
+        unsigned runSize(0);
+        for (pos_t pos(endPos-1); pos>=firstPos; --pos)
+        {
+            runSize = ((base(pos) == base(pos+k)) ? std::min(runSize+1, maxMatchRunSize) : 0);
+            matchRunSize[pos+padSize] = runSize;
+        }
+
+        // true if the k-mer at pos matches the k-mer at pos+k:
+        auto isKmerMatch = [&](const pos_t pos)
+        {
+            return (matchRunSize[pos+padSize] >= k);
+        };
+
+        pos_t lastKmerMatchPos(firstPos-1);
+        for (pos_t pos(firstPos); pos<contigSize; ++pos)
+        {
+            if (isKmerMatch(pos)) lastKmerMatchPos = pos;
+            if (pos < 0) continue;
+
+            ReferenceAnnotation& posAnnotation(annotation[pos]);
+            if (posAnnotation.getSTRPeriod() != 0) continue;
+
+            // test if any k-mer starting in [pos-2k+1,pos] matches the k-mer k positions downstream
+            if (lastKmerMatchPos < (pos-2*k+1)) continue;
+
+            posAnnotation.setSTRPeriod(patternSize);
+
+            // test for the left end of the STR, following searchForSTR and isLeftEndOfSTR
+            const bool isLeftEnd((isKmerMatch(pos) or isKmerMatch(pos-k)) and (base(pos-1) != base(pos+k-1)));
+            if (not isLeftEnd) continue;
+
+            posAnnotation.setLeftEndOfSTR(true);
+
+            // repeat count following getLeftShiftedSTRRepeatCount, where additional repeats are only counted
+            // if they start within the contig
+            const unsigned maxRepeatCount(1+(contigSize-1-pos)/k);
+            posAnnotation.setSTRRepeatCount(std::min(maxRepeatCount, 1+matchRunSize[pos+padSize]/patternSize));
+        }
+    }
+}
+
+
+
+/// add the anchor flag for all contig positions by streaming ReferenceRepeatFinder over the contig
+static
+void
+addAnchor(
+    const reference_contig_segment& contig,
+    const unsigned maxRepeatUnitLength,
+    const unsigned minRepeatSpan,
+    std::vector<ReferenceAnnotation>& annotation)
+{
+    const pos_t contigSize(contig.end());
+    if (contigSize == 0) return;
+
+    // each anchor flag is final once the repeat finder has been updated 2*maxRepeatUnitLength positions ahead,
+    // so the buffer only needs to exceed this distance:
+    const unsigned bufferSize(4*maxRepeatUnitLength);
+    ReferenceRepeatFinder repeatFinder(contig, maxRepeatUnitLength, bufferSize, minRepeatSpan);
+
+    repeatFinder.initRepeatSpan(0);
+    for (pos_t pos(0); pos<contigSize; ++pos)
+    {
+        repeatFinder.updateRepeatSpan(pos + maxRepeatUnitLength*2u);
+        annotation[pos].setAnchor(repeatFinder.isAnchor(pos));
+    }
+}
+
+
+
+void
+computeReferenceAnnotation(
+    const reference_contig_segment& contig,
+    const unsigned maxRepeatUnitLength,
+    const unsigned minRepeatSpan,
+    std::vector<ReferenceAnnotation>& annotation)
+{
+    assert(contig.get_offset() == 0);
+    assert(not contig.isAnnotated());
+
+    const std::string& seq(contig.seq());
+    annotation.assign(seq.size(), ReferenceAnnotation());
+
+    addSnpHpolSize(seq, annotation);
+    addSTRContext(seq, annotation);
+    addAnchor(contig, maxRepeatUnitLength, minRepeatSpan, annotation);
+}
@@ -0,0 +1,43 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "blt_util/ReferenceAnnotation.hh"
+#include "blt_util/reference_contig_segment.hh"
+
+#include <vector>
+
+
+/// \brief Compute the annotation track for a full contig
+///
+/// Each annotation value reproduces the result of the corresponding context function (get_snp_hpol_size,
+/// searchForSTR, getLeftShiftedSTRRepeatCount and ReferenceRepeatFinder::isAnchor) evaluated with the
+/// full contig as the reference segment.
+///
+/// \param[in] contig the full contig sequence, the segment offset must be zero
+/// \param[in] maxRepeatUnitLength ReferenceRepeatFinder max repeat unit length used for the anchor flag
+/// \param[in] minRepeatSpan ReferenceRepeatFinder min repeat span used for the anchor flag
+/// \param[out] annotation annotation for each position of contig
+void
+computeReferenceAnnotation(
+    const reference_contig_segment& contig,
+    const unsigned maxRepeatUnitLength,
+    const unsigned minRepeatSpan,
+    std::vector<ReferenceAnnotation>& annotation);
@@ -23,8 +23,18 @@
 
 #include "ReferenceRepeatFinder.hh"
 
+#include <algorithm>
+
 void ReferenceRepeatFinder::updateRepeatSpan(pos_t pos)
 {
+    // with an anchor track, streaming updates are only required for positions where anchors are not read from
+    // the track
+    if (_isUseAnnotation)
+    {
+        if ((pos >= _streamingSkipBeginPos) and (pos < _streamingSkipEndPos)) return;
+        if (pos == _streamingSkipEndPos) resetRepeatSpan(pos-1);
+    }
+
     // calculate repeat counter
     auto base(_ref.get_base(pos));
     auto posIndex(pos % _maxBufferSize);
@@ -57,20 +67,61 @@ void ReferenceRepeatFinder::updateRepeatSpan(pos_t pos)
     }
 }
 
+void ReferenceRepeatFinder::resetRepeatSpan(pos_t pos)
+{
+    auto posIndex(pos % _maxBufferSize);
+    for (auto repeatUnitLength(1u); repeatUnitLength<=_maxRepeatUnitLength; ++repeatUnitLength)
+    {
+        auto repeatUnitIndex(repeatUnitLength-1);
+        _repeatSpan[posIndex][repeatUnitIndex] = repeatUnitLength;
+    }
+}
+
+void ReferenceRepeatFinder::setAnnotationRange(pos_t initPos)
+{
+    _isUseAnnotation = isAnnotationCompatible();
+    if (not _isUseAnnotation) return;
+
+    // The anchor status of pos is final once the streaming computation has been updated through
+    // pos+2*_maxRepeatUnitLength, and the streaming computation matches the whole contig computation once it has
+    // been updated from at least pos-2*_maxRepeatUnitLength+1. Bases outside of the segment are read as 'N' by the
+    // streaming computation, so these bounds are applied at each segment end unless it is also the contig end.
+    const pos_t contextSize(2*_maxRepeatUnitLength);
+    const pos_t contigSize(_ref.getAnnotationContig().size);
+
+    _annotationBeginPos = initPos;
+    if (_ref.get_offset() > 0)
+    {
+        _annotationBeginPos = std::max(_annotationBeginPos, _ref.get_offset() + contextSize - 1);
+    }
+
+    _annotationEndPos = contigSize;
+    if (_ref.end() < contigSize)
+    {
+        _annotationEndPos = std::min(_annotationEndPos, _ref.end() - contextSize);
+    }
+
+    // streaming updates are required to finalize all positions before the track range, and restart far enough
+    // ahead of the end of the track range to match the whole contig computation:
+    _streamingSkipBeginPos = _annotationBeginPos + contextSize;
+    _streamingSkipEndPos = _annotationEndPos - contextSize + 1;
+    if (_streamingSkipEndPos <= _streamingSkipBeginPos)
+    {
+        // the track range is too small to skip any streaming updates, so there is no benefit to using it:
+        _isUseAnnotation = false;
+    }
+}
+
 void ReferenceRepeatFinder::initRepeatSpan(pos_t pos)
 {
+    setAnnotationRange(pos);
+
     pos_t minPos = pos - 2*_maxRepeatUnitLength + 1;
     if (minPos < _ref.get_offset())
         minPos = _ref.get_offset();
 
-    auto posIndex(minPos % _maxBufferSize);
-
     // initialize _repeatSpan for minPos
-    for (auto repeatUnitLength(1u); repeatUnitLength<=_maxRepeatUnitLength; ++repeatUnitLength)
-    {
-        auto repeatUnitIndex(repeatUnitLength-1);
-        _repeatSpan[posIndex][repeatUnitIndex] = repeatUnitLength;
-    }
+    resetRepeatSpan(minPos);
 
     // Update repeatSpan information up to pos + _maxRepeatUnitLength*2 - 1
     for (pos_t initPos(minPos); initPos < (pos_t)(pos + _maxRepeatUnitLength*2u); ++initPos)
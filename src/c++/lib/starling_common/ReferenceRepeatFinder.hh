@@ -53,6 +53,10 @@ public:
     /// \return true if pos is an anchor position, false otherwise
     bool isAnchor(pos_t pos) const
     {
+        if (_isUseAnnotation and (pos >= _annotationBeginPos) and (pos < _annotationEndPos))
+        {
+            return _ref.getAnnotation(pos).isAnchor();
+        }
         return _isAnchor[pos % _maxBufferSize];
     }
 
@@ -65,6 +69,21 @@ public:
     void updateRepeatSpan(pos_t pos);
 
 private:
+    /// Set the anchor track range and streaming update schedule for a repeat finder initialized at initPos
+    void setAnnotationRange(pos_t initPos);
+
+    /// Reset _repeatSpan to record no repeats ending at pos
+    void resetRepeatSpan(pos_t pos);
+
+    /// \return true if the reference has a precomputed anchor track matching this object's parameters
+    bool isAnnotationCompatible() const
+    {
+        if (not _ref.isAnnotated()) return false;
+        const auto& annotation(_ref.getAnnotationContig());
+        return ((annotation.maxRepeatUnitLength == _maxRepeatUnitLength) and
+                (annotation.minRepeatSpan == _minRepeatSpan));
+    }
+
     const reference_contig_segment& _ref;
     const unsigned _maxRepeatUnitLength;
     const unsigned _maxBufferSize;
@@ -79,4 +98,19 @@ private:
     /// the position is within a repeat
     std::vector<std::vector<unsigned>> _repeatSpan;
     std::vector<bool> _isAnchor;
+
+    /// If true, anchor positions in [_annotationBeginPos,_annotationEndPos) are read from the reference annotation
+    /// track
+    ///
+    /// Anchor status computed from the whole contig only matches the streaming computation where the bases the
+    /// streaming computation depends on are the same, so the streaming computation is still used for positions
+    /// close to the initialization position or to either end of the reference segment.
+    bool _isUseAnnotation = false;
+    pos_t _annotationBeginPos = 0;
+    pos_t _annotationEndPos = 0;
+
+    /// With an anchor track, streaming updates are skipped for positions in [_streamingSkipBeginPos,
+    /// _streamingSkipEndPos), and the streaming computation is restarted at _streamingSkipEndPos
+    pos_t _streamingSkipBeginPos = 0;
+    pos_t _streamingSkipEndPos = 0;
 };
@@ -0,0 +1,521 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "starling_common/ReplayBundle.hh"
+
+#include "blt_util/log.hh"
+#include "common/Exceptions.hh"
+#include "htsapi/bam_dumper.hh"
+#include "htsapi/bam_streamer.hh"
+
+#include "boost/filesystem.hpp"
+
+#include "htslib/bgzf.h"
+#include "htslib/faidx.h"
+#include "htslib/kseq.h"
+#include "htslib/tbx.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+
+namespace
+{
+
+const char* bundleArgsFilename("args.txt");
+const char* bundleReplayDirname("replay");
+
+/// option values starting with this token are relative to the bundle directory
+const std::string bundleDirToken("@BUNDLE_DIR@");
+
+const std::string replayBundleOptionName("replay-bundle");
+
+/// options which are not written to the bundle
+const std::set<std::string> droppedOptions =
+{
+    "capture-replay-bundle", "replay-bundle", "replay-iterations", "ref-slice-offset",
+    "ref-annotation", "ref-image"
+};
+
+/// alignment file options, the region is copied from each file to a new BAM file
+const std::set<std::string> alignmentOptions =
+{
+    "align-file", "normal-align-file", "tumor-align-file"
+};
+
+/// tabix indexed input options, the region is copied from each file to a new indexed file
+const std::set<std::string> tabixSliceOptions =
+{
+    "candidate-indel-input-vcf", "force-output-vcf", "ploidy-region-vcf", "noise-vcf", "call-regions-bed",
+    "nocompress-bed"
+};
+
+/// other input file options, each file is copied to the bundle
+const std::set<std::string> copiedFileOptions =
+{
+    "indel-error-models-file", "theta-file", "snv-scoring-model-file", "indel-scoring-model-file",
+    "somatic-snv-scoring-model-file", "somatic-indel-scoring-model-file", "chrom-depth-file",
+    "strelka-chrom-depth-file", "noise-track-file"
+};
+
+/// output file options, these are redirected to the bundle replay directory
+const std::set<std::string> outputFileOptions =
+{
+    "gvcf-output-prefix", "somatic-snv-file", "somatic-indel-file", "somatic-callable-regions-file",
+    "realigned-output-prefix", "stats-file", "locus-profile-file", "throttled-regions-file", "progress-file"
+};
+
+}
+
+
+
+/// \return label for the calling mode, this is written to each bundle so that it is replayed by the same caller
+static
+const char*
+getCallingModeLabel(const bool isSomaticCallingMode)
+{
+    return (isSomaticCallingMode ? "somatic" : "germline");
+}
+
+
+
+/// \return the final path component of filename, or the empty string if filename ends in a directory separator
+///
+/// This is used instead of boost::filesystem::path::filename() so that output prefixes ending in a separator are
+/// preserved.
+static
+std::string
+getBasename(const std::string& filename)
+{
+    const auto separatorPos(filename.find_last_of('/'));
+    if (separatorPos == std::string::npos) return filename;
+    return filename.substr(separatorPos+1);
+}
+
+
+
+/// \return the name of file fileIndex in the bundle for an input option
+static
+std::string
+getBundleFilename(
+    const std::string& key,
+    const unsigned fileIndex,
+    const std::string& suffix)
+{
+    std::ostringstream oss;
+    oss << key << '.' << fileIndex << suffix;
+    return oss.str();
+}
+
+
+
+/// \return suffix of filename which should be retained in the bundle copy, so that file type detection is unchanged
+static
+std::string
+getFileSuffix(const std::string& filename)
+{
+    static const std::vector<std::string> suffixes = { ".vcf.gz", ".bed.gz", ".gz" };
+    for (const auto& suffix : suffixes)
+    {
+        if ((filename.size() >= suffix.size()) and
+            (filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0))
+        {
+            return suffix;
+        }
+    }
+    return boost::filesystem::path(filename).extension().string();
+}
+
+
+
+/// Copy all reads from alignmentFilename intersecting the streamer region to a new indexed BAM file
+static
+void
+writeAlignmentSlice(
+    const starling_base_options& opt,
+    const AnalysisRegionInfo& regionInfo,
+    const std::string& alignmentFilename,
+    const std::string& sliceFilename)
+{
+    {
+        bam_streamer readStream(alignmentFilename.c_str(), opt.getAlignmentReferenceFilename().c_str(),
+                                regionInfo.streamerRegion.c_str());
+        bam_dumper sliceWriter(sliceFilename.c_str(), readStream.get_header());
+        while (readStream.next())
+        {
+            sliceWriter.put_record(readStream.get_record_ptr()->get_data());
+        }
+        sliceWriter.close();
+    }
+
+    if (sam_index_build(sliceFilename.c_str(), 0) != 0)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Failed to build index for BAM file: '" << sliceFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+}
+
+
+
+/// Write the reference sequence of the analysis region to a new indexed fasta file
+///
+/// The contig is given its original name, and begins at refRegionRange.begin_pos() of the original contig.
+static
+void
+writeReferenceSlice(
+    const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
+    const AnalysisRegionInfo& regionInfo,
+    const std::string& sliceFilename)
+{
+    reference_contig_segment ref;
+    setRefSegment(opt, dopt, regionInfo.regionChrom, regionInfo.refRegionRange, ref);
+
+    std::string seq;
+    ref.get_substring(ref.get_offset(), (ref.end() - ref.get_offset()), seq);
+
+    {
+        std::ofstream sliceStream(sliceFilename);
+        if (not sliceStream)
+        {
+            using namespace illumina::common;
+            std::ostringstream oss;
+            oss << "Can't open output file: '" << sliceFilename << "'";
+            BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+        }
+
+        static const std::string::size_type lineSize(60);
+        sliceStream << '>' << regionInfo.regionChrom << '\n';
+        for (std::string::size_type linePos(0); linePos < seq.size(); linePos += lineSize)
+        {
+            sliceStream << seq.substr(linePos, lineSize) << '\n';
+        }
+    }
+
+    if (fai_build(sliceFilename.c_str()) != 0)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Failed to build index for fasta file: '" << sliceFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+}
+
+
+
+/// Copy the header and all records intersecting the streamer region from a tabix indexed file to a new indexed
+/// file
+static
+void
+writeTabixSlice(
+    const AnalysisRegionInfo& regionInfo,
+    const std::string& inputFilename,
+    const std::string& sliceFilename)
+{
+    using namespace illumina::common;
+
+    htsFile* inputFile(hts_open(inputFilename.c_str(), "r"));
+    if (nullptr == inputFile)
+    {
+        std::ostringstream oss;
+        oss << "Failed to open hts file: '" << inputFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    tbx_t* inputIndex(tbx_index_load(inputFilename.c_str()));
+    if (nullptr == inputIndex)
+    {
+        hts_close(inputFile);
+        std::ostringstream oss;
+        oss << "Failed to load index for hts file: '" << inputFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    BGZF* sliceFile(bgzf_open(sliceFilename.c_str(), "w"));
+    if (nullptr == sliceFile)
+    {
+        tbx_destroy(inputIndex);
+        hts_close(inputFile);
+        std::ostringstream oss;
+        oss << "Can't open output file: '" << sliceFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    kstring_t line = {0,0,0};
+    bool isWriteError(false);
+    auto writeLine = [&]()
+    {
+        if ((bgzf_write(sliceFile, line.s, line.l) < 0) or (bgzf_write(sliceFile, "\n", 1) < 0))
+        {
+            isWriteError = true;
+        }
+    };
+
+    // copy header:
+    const int metaChar(inputIndex->conf.meta_char);
+    while (hts_getline(inputFile, KS_SEP_LINE, &line) >= 0)
+    {
+        if ((line.l == 0) or (line.s[0] != metaChar)) break;
+        writeLine();
+    }
+
+    // copy records, a region which is not found in the index has no records:
+    hts_itr_t* regionIter(tbx_itr_querys(inputIndex, regionInfo.streamerRegion.c_str()));
+    if (nullptr != regionIter)
+    {
+        while (tbx_itr_next(inputFile, inputIndex, regionIter, &line) >= 0)
+        {
+            writeLine();
+        }
+        tbx_itr_destroy(regionIter);
+    }
+
+    const tbx_conf_t indexConf(inputIndex->conf);
+    free(line.s);
+    tbx_destroy(inputIndex);
+    hts_close(inputFile);
+    if ((bgzf_close(sliceFile) != 0) or isWriteError)
+    {
+        std::ostringstream oss;
+        oss << "Failed to write file: '" << sliceFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    if (tbx_index_build(sliceFilename.c_str(), 0, &indexConf) != 0)
+    {
+        std::ostringstream oss;
+        oss << "Failed to build index for file: '" << sliceFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+}
+
+
+
+std::vector<CommandLineOption>
+getCommandLineOptions(const boost::program_options::parsed_options& parsed)
+{
+    std::vector<CommandLineOption> options;
+    for (const auto& option : parsed.options)
+    {
+        options.push_back({option.string_key, option.value});
+    }
+    return options;
+}
+
+
+
+void
+captureReplayBundle(
+    const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
+    const AnalysisRegionInfo& regionInfo)
+{
+    namespace bfs = boost::filesystem;
+
+    const bfs::path bundleDir(opt.captureBundleDir);
+    bfs::create_directories(bundleDir / bundleReplayDirname);
+
+    std::map<std::string, unsigned> optionFileCount;
+    auto getNextBundleFilename = [&](const std::string& key, const std::string& suffix)
+    {
+        return getBundleFilename(key, optionFileCount[key]++, suffix);
+    };
+
+    std::vector<std::string> bundleArgs;
+    for (const auto& option : opt.commandLineOptions)
+    {
+        const std::string& key(option.key);
+        if (droppedOptions.count(key)) continue;
+
+        bundleArgs.push_back("--" + key);
+        if (key == "ref")
+        {
+            static const std::string referenceSliceFilename("reference.fa");
+            writeReferenceSlice(opt, dopt, regionInfo, (bundleDir / referenceSliceFilename).string());
+            bundleArgs.push_back(bundleDirToken + "/" + referenceSliceFilename);
+            bundleArgs.push_back("--ref-slice-offset");
+            bundleArgs.push_back(std::to_string(regionInfo.refRegionRange.begin_pos()));
+            continue;
+        }
+
+        for (const auto& value : option.values)
+        {
+            std::string bundleFilename;
+            if (alignmentOptions.count(key))
+            {
+                bundleFilename = getNextBundleFilename(key, ".bam");
+                writeAlignmentSlice(opt, regionInfo, value, (bundleDir / bundleFilename).string());
+            }
+            else if (tabixSliceOptions.count(key))
+            {
+                bundleFilename = getNextBundleFilename(key, getFileSuffix(value));
+                writeTabixSlice(regionInfo, value, (bundleDir / bundleFilename).string());
+            }
+            else if (copiedFileOptions.count(key))
+            {
+                bundleFilename = getNextBundleFilename(key, getFileSuffix(value));
+                bfs::copy_file(value, (bundleDir / bundleFilename), bfs::copy_option::overwrite_if_exists);
+            }
+            else if (outputFileOptions.count(key))
+            {
+                bundleFilename = std::string(bundleReplayDirname) + "/" + getBasename(value);
+            }
+            else
+            {
+                bundleArgs.push_back(value);
+                continue;
+            }
+            bundleArgs.push_back(bundleDirToken + "/" + bundleFilename);
+        }
+    }
+
+    const std::string argsFilename((bundleDir / bundleArgsFilename).string());
+    std::ofstream argsStream(argsFilename);
+    if (not argsStream)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Can't open output file: '" << argsFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+    argsStream << getCallingModeLabel(opt.isSomaticCallingMode) << '\n';
+    for (const auto& arg : bundleArgs)
+    {
+        argsStream << arg << '\n';
+    }
+
+    log_os << "INFO: Wrote replay bundle for region '" << opt.regions.front() << "' to '" << opt.captureBundleDir << "'\n";
+}
+
+
+
+/// \return the bundle arguments from the args file in bundleDir, with bundle paths expanded
+static
+std::vector<std::string>
+readBundleArgs(
+    const bool isSomaticCallingMode,
+    const std::string& bundleDir)
+{
+    using namespace illumina::common;
+
+    const std::string argsFilename((boost::filesystem::path(bundleDir) / bundleArgsFilename).string());
+    std::ifstream argsStream(argsFilename);
+    if (not argsStream)
+    {
+        std::ostringstream oss;
+        oss << "Can't open replay bundle arguments file: '" << argsFilename << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    std::string bundleCallingMode;
+    std::getline(argsStream, bundleCallingMode);
+    if (bundleCallingMode != getCallingModeLabel(isSomaticCallingMode))
+    {
+        std::ostringstream oss;
+        oss << "Replay bundle '" << bundleDir << "' was captured in " << bundleCallingMode
+            << " calling mode, which does not match the current " << getCallingModeLabel(isSomaticCallingMode)
+            << " calling mode";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    std::vector<std::string> args;
+    std::string arg;
+    while (std::getline(argsStream, arg))
+    {
+        if (arg.compare(0, bundleDirToken.size(), bundleDirToken) == 0)
+        {
+            arg.replace(0, bundleDirToken.size(), bundleDir);
+        }
+        args.push_back(arg);
+    }
+    return args;
+}
+
+
+
+ReplayBundleCommandLine::
+ReplayBundleCommandLine(
+    const bool isSomaticCallingMode,
+    int argc,
+    char* argv[])
+{
+    const std::string optionArg("--" + replayBundleOptionName);
+    const std::string optionAssignPrefix(optionArg + "=");
+
+    std::string bundleDir;
+    std::vector<std::string> otherArgs;
+    for (int argIndex(1); argIndex < argc; ++argIndex)
+    {
+        const std::string arg(argv[argIndex]);
+        if ((arg == optionArg) and ((argIndex+1) < argc))
+        {
+            bundleDir = argv[++argIndex];
+        }
+        else if (arg.compare(0, optionAssignPrefix.size(), optionAssignPrefix) == 0)
+        {
+            bundleDir = arg.substr(optionAssignPrefix.size());
+        }
+        else
+        {
+            otherArgs.push_back(arg);
+        }
+    }
+
+    if (argc > 0) _args.push_back(argv[0]);
+    if (not bundleDir.empty())
+    {
+        // options given on the command line replace any bundle option with the same name:
+        std::set<std::string> otherKeys;
+        for (const auto& arg : otherArgs)
+        {
+            if (arg.compare(0, 2, "--") != 0) continue;
+            otherKeys.insert(arg.substr(2, arg.find('=') - 2));
+        }
+
+        bool isSkipOption(false);
+        for (const auto& arg : readBundleArgs(isSomaticCallingMode, bundleDir))
+        {
+            if (arg.compare(0, 2, "--") == 0)
+            {
+                isSkipOption = (otherKeys.count(arg.substr(2)) != 0);
+            }
+            if (not isSkipOption) _args.push_back(arg);
+        }
+        _args.insert(_args.end(), otherArgs.begin(), otherArgs.end());
+    }
+    else
+    {
+        for (int argIndex(1); argIndex < argc; ++argIndex)
+        {
+            _args.push_back(argv[argIndex]);
+        }
+    }
+
+    for (auto& arg : _args)
+    {
+        _argv.push_back(&arg[0]);
+    }
+    _argv.push_back(nullptr);
+}
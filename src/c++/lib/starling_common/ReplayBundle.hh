@@ -0,0 +1,91 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Capture and replay of self-contained single region input bundles
+///
+/// A replay bundle is a directory holding all inputs required to call one analysis region: the region's reads
+/// from each alignment file as a BAM file, the reference sequence slice used for the region, slices of all
+/// indexed VCF/BED inputs, copies of all other input files such as models, and the command line options
+/// rewritten to refer to these copies. Output options are rewritten to the 'replay' subdirectory of the bundle.
+///
+/// A bundle is captured by adding the capture option to a variant calling command line for a single region, and
+/// replayed by giving the bundle directory to the same variant caller. Replay can repeat the region any number of
+/// times for profiling.
+///
+
+#pragma once
+
+#include "starling_common/starling_base_shared.hh"
+#include "starling_common/starling_ref_seq.hh"
+
+#include "boost/program_options.hpp"
+
+#include <string>
+#include <vector>
+
+
+/// \return all options of a parsed command line in command line order, these are recorded so that command lines
+///         can be rewritten for replay bundles
+std::vector<CommandLineOption>
+getCommandLineOptions(const boost::program_options::parsed_options& parsed);
+
+
+
+/// Write a replay bundle for regionInfo to opt.captureBundleDir
+void
+captureReplayBundle(
+    const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
+    const AnalysisRegionInfo& regionInfo);
+
+
+
+/// \brief Command line arguments with the options of a replay bundle substituted for the replay bundle option
+///
+/// If the replay bundle option is not given, the arguments are unchanged. Otherwise the bundle options are
+/// followed by all other arguments given on the command line, so that options such as the replay iteration count
+/// can be added to the bundle options. A bundle option is dropped if an option of the same name is given on the
+/// command line.
+///
+struct ReplayBundleCommandLine
+{
+    /// \param[in] isSomaticCallingMode calling mode of the current variant caller, this must match the calling mode
+    ///                                 of the bundle
+    ReplayBundleCommandLine(
+        const bool isSomaticCallingMode,
+        int argc,
+        char* argv[]);
+
+    int
+    argc() const
+    {
+        // the argument vector is terminated by an additional null pointer:
+        return static_cast<int>(_argv.size()-1);
+    }
+
+    char**
+    argv()
+    {
+        return _argv.data();
+    }
+
+private:
+    std::vector<std::string> _args;
+    std::vector<char*> _argv;
+};
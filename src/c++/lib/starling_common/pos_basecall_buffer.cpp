@@ -83,3 +83,25 @@ update_read_pos_ranksum(
     auto& posdata(_pdata.getRef(pos));
     posdata.readPositionRankSum.add_observation(is_reference,read_pos);
 }
+
+
+
+BufferUsage
+pos_basecall_buffer::
+getBufferUsage() const
+{
+    BufferUsage usage;
+    usage.bytes = _pdata.capacity() * sizeof(snp_pos_info);
+    if (_pdata.empty()) return usage;
+
+    for (pos_t pos(_pdata.getMinKey()); pos <= _pdata.getMaxKey(); ++pos)
+    {
+        if (not _pdata.isKeyPresent(pos)) continue;
+        const snp_pos_info& pi(_pdata.getConstRef(pos));
+        const uint64_t callCount(pi.calls.size() + pi.tier2_calls.size());
+        usage.items++;
+        usage.entries += callCount;
+        usage.bytes += callCount * sizeof(base_call);
+    }
+    return usage;
+}
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "appstats/BufferUsage.hh"
 #include "blt_common/snp_pos_info.hh"
 #include "blt_util/blt_types.hh"
 #include "blt_util/RangeMap.hh"
@@ -165,6 +166,10 @@ struct pos_basecall_buffer
         return _pdata.empty();
     }
 
+    /// \return buffered position count, basecall count and estimated bytes
+    BufferUsage
+    getBufferUsage() const;
+
     void
     dump(std::ostream& os) const;
 
@@ -63,6 +63,10 @@ get_starling_base_option_parser(
     core_opt.add_options()
     ("ref", po::value(&opt.referenceFilename),
      "fasta reference sequence, samtools index file must be present (required)")
+    ("ref-annotation", po::value(&opt.referenceAnnotationFilename),
+     "precomputed reference annotation track for the fasta reference, created by CreateReferenceAnnotation (optional)")
+    ("ref-image", po::value(&opt.referenceImageFilename),
+     "memory-mapped image of the fasta reference, created by CreateReferenceImage. The image is shared by all processes on a host and is also used to decode CRAM input (optional)")
     ("region", po::value<regions_t>(),
      "samtools formatted region, eg. 'chr1:20-30'. May be supplied more than once but regions must not overlap. At least one entry required.")
     ;
@@ -119,6 +123,22 @@ get_starling_base_option_parser(
      "Maximum allowed read depth per sample (prior to realignment). Input reads which would exceed this depth are filtered out.  (default: no limit)")
     ("max-sample-read-buffer", po::value(&opt.maxBufferedReads)->default_value(opt.maxBufferedReads),
      "Maximum reads buffered for each sample")
+    ("memory-budget-mb", po::value(&opt.memoryBudgetMb)->default_value(opt.memoryBudgetMb),
+     "Approximate memory budget in megabytes for buffered read data over all samples. As the budget is approached, input reads are deterministically downsampled by read name. Set to zero to disable.")
+    ("throttled-regions-file", po::value(&opt.throttledRegionsFilename),
+     "Write a BED file of regions where input reads are downsampled to stay within the memory budget")
+    ("progress-file", po::value(&opt.progressFilename),
+     "Periodically write a one-line JSON progress record with the current position, reads consumed, bases processed per second, buffer sizes and RSS. If the path is a FIFO each record is written to it, otherwise the file is replaced by each record.")
+    ("progress-interval-seconds", po::value(&opt.progressIntervalSeconds)->default_value(opt.progressIntervalSeconds),
+     "Minimum time between progress records")
+    ("capture-replay-bundle", po::value(&opt.captureBundleDir),
+     "Instead of calling variants, write a self-contained replay bundle for the analysis region to this directory. The bundle contains the region's reads, reference slice, input VCF/BED slices, model files and options. Exactly one region must be given.")
+    ("replay-bundle", po::value<std::string>(),
+     "Call variants from the replay bundle in this directory. Other options given on the command line are added to the bundle options, output is written to the 'replay' subdirectory of the bundle.")
+    ("replay-iterations", po::value(&opt.replayIterations)->default_value(opt.replayIterations),
+     "Number of times to call all analysis regions, this is used to profile replay bundles")
+    ("ref-slice-offset", po::value(&opt.referenceSliceOffset)->default_value(opt.referenceSliceOffset),
+     "Zero-indexed contig position of the first base of each fasta reference contig, this is set for the reference slice of a replay bundle")
     ("min-qscore", po::value(&opt.minBasecallErrorPhredProb)->default_value(opt.minBasecallErrorPhredProb),
      "Don't use a basecall for SNV calling if qscore is below this value.")
     ("min-mapping-quality", po::value(&opt.minMappingErrorPhredProb)->default_value(opt.minMappingErrorPhredProb),
@@ -129,6 +149,16 @@ get_starling_base_option_parser(
     other_opt.add_options()
     ("stats-file", po::value(&opt.segmentStatsFilename),
      "Write runtime stats to file")
+    ("hardware-counters", po::value(&opt.isHardwareCounters)->zero_tokens(),
+     "Record cycles, instructions, last-level cache misses and branch misses for each timed stage in the runtime stats file. This requires Linux perf_event access, and is skipped without error where counters are not available. Counts are scaled up when counters are shared with other perf_event users, and the fraction of time the counters were running is reported.")
+    ("buffer-usage-stats", po::value(&opt.isBufferUsageStats)->zero_tokens(),
+     "Record the peak estimated memory use of each major buffer, and the locus where it occurred, in the runtime stats file. Buffer contents are periodically scanned to find these peaks.")
+    ("locus-profile-file", po::value(&opt.locusProfileFilename),
+     "Write a BED file of genome windows which are expensive to process, listing the processing time and realignment/assembly workload of each window. All windows are also recorded in the runtime stats file, so that windows split between genome segments can be merged before the report threshold is applied.")
+    ("locus-profile-window-size", po::value(&opt.locusProfileWindowSize)->default_value(opt.locusProfileWindowSize),
+     "Genome window size used for the locus profile")
+    ("locus-profile-min-seconds", po::value(&opt.locusProfileMinSeconds)->default_value(opt.locusProfileMinSeconds),
+     "Minimum processing time for a window to be reported in the locus profile")
     ("report-evs-features", po::value(&opt.isReportEVSFeatures)->zero_tokens(),
      "Report empirical variant scoring (EVS) training features in VCF output")
     ("indel-error-models-file", po::value<std::vector<std::string>>(&opt.indelErrorModelFilenames),
@@ -139,6 +169,8 @@ get_starling_base_option_parser(
      "Static indel error model name. If no indel error model file is provided a hard-coded model can be selected with this argument instead. Current options are ('adaptiveDefault','logLinear'). This option is ignored when at least one indel error models file is provided.")
     ("call-regions-bed",  po::value(&opt.callRegionsBedFilename),
      "Bed file describing regions to call. No output will be provided outside of these regions. (must be bgzip compressed and tabix indexed).")
+    ("single-pass-call-regions", po::value(&opt.isSinglePassCallRegions)->zero_tokens(),
+     "Stream all call regions within each analysis region from the alignment files in a single pass, instead of seeking to each call region separately. Recommended for call region files with many small regions.")
     ;
 
     po::options_description new_opt("Shared small-variant options");
@@ -181,6 +213,24 @@ finalize_starling_base_options(
         }
     }
 
+    if (not opt.referenceAnnotationFilename.empty())
+    {
+        std::string errorMsg;
+        if (checkAndStandardizeRequiredInputFilePath(opt.referenceAnnotationFilename, "reference annotation", errorMsg))
+        {
+            pinfo.usage(errorMsg.c_str());
+        }
+    }
+
+    if (not opt.referenceImageFilename.empty())
+    {
+        std::string errorMsg;
+        if (checkAndStandardizeRequiredInputFilePath(opt.referenceImageFilename, "reference image", errorMsg))
+        {
+            pinfo.usage(errorMsg.c_str());
+        }
+    }
+
     // set analysis regions:
     if (vm.count("region"))
     {
@@ -225,6 +275,43 @@ finalize_starling_base_options(
         opt.is_max_input_depth=true;
     }
 
+    if (opt.isLocusProfile())
+    {
+        if (opt.locusProfileWindowSize == 0)
+        {
+            pinfo.usage("Locus profile window size must be greater than zero");
+        }
+        if (opt.locusProfileMinSeconds < 0)
+        {
+            pinfo.usage("Locus profile minimum seconds must not be negative");
+        }
+    }
+
+    if ((not opt.throttledRegionsFilename.empty()) and (not opt.isMemoryBudget()))
+    {
+        pinfo.usage("Throttled regions file requires a memory budget");
+    }
+
+    if (opt.isProgressReport() and (not (opt.progressIntervalSeconds > 0)))
+    {
+        pinfo.usage("Progress interval must be greater than zero");
+    }
+
+    if (opt.isCaptureReplayBundle() and (opt.regions.size() != 1))
+    {
+        pinfo.usage("Replay bundle capture requires exactly one region");
+    }
+
+    if (opt.replayIterations == 0)
+    {
+        pinfo.usage("Replay iterations must be greater than zero");
+    }
+
+    if (opt.referenceSliceOffset < 0)
+    {
+        pinfo.usage("Reference slice offset must not be negative");
+    }
+
     for (const auto& indelErrorModelFilename : opt.indelErrorModelFilenames)
     {
         checkOptionalInputFile(pinfo, indelErrorModelFilename, "indel error models");
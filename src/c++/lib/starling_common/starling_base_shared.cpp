@@ -20,6 +20,8 @@
 #include "starling_common/starling_base_shared.hh"
 
 #include "blt_util/math_util.hh"
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "blt_util/ReferenceImage.hh"
 #include "calibration/IndelErrorModel.hh"
 #include "htsapi/bam_streamer.hh"
 #include "starling_common/AlleleGroupGenotype.hh"
@@ -64,6 +66,16 @@ starling_base_deriv_options(const starling_base_options& opt)
         correctMappingLogPrior=std::log(1.7e-10);
     }
 
+    if (not opt.referenceAnnotationFilename.empty())
+    {
+        _referenceAnnotationTrack.reset(new ReferenceAnnotationTrack(opt.referenceAnnotationFilename));
+    }
+
+    if (not opt.referenceImageFilename.empty())
+    {
+        _referenceImage.reset(new ReferenceImage(opt.referenceImageFilename));
+    }
+
     // register post-call stages:
     //
 
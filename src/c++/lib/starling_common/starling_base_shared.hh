@@ -40,6 +40,14 @@ enum { STRELKA_MAX_READ_SIZE = 25000 };
 typedef std::vector<std::string> regions_t;
 
 
+/// A single option from the command line, with all values given for this option occurrence
+struct CommandLineOption
+{
+    std::string key;
+    std::vector<std::string> values;
+};
+
+
 struct starling_base_options : public blt_options
 {
     typedef blt_options base_t;
@@ -88,6 +96,19 @@ struct starling_base_options : public blt_options
 
     std::string referenceFilename;
 
+    /// optional precomputed reference annotation track (see CreateReferenceAnnotation)
+    std::string referenceAnnotationFilename;
+
+    /// optional uppercased single-line-per-contig copy of the fasta reference (see CreateReferenceImage)
+    std::string referenceImageFilename;
+
+    /// \return reference file used to decode CRAM input, this is the reference image when one is provided
+    const std::string&
+    getAlignmentReferenceFilename() const
+    {
+        return (referenceImageFilename.empty() ? referenceFilename : referenceImageFilename);
+    }
+
     // list of chromosome regions to be analyzed
     regions_t regions;
 
@@ -211,6 +232,28 @@ struct starling_base_options : public blt_options
     /// Stores runtime stats
     std::string segmentStatsFilename;
 
+    /// Attribute hardware performance counters to the timed variant calling stages in runtime stats, where
+    /// counters are available
+    bool isHardwareCounters = false;
+
+    /// Record the peak memory use of each major buffer in runtime stats
+    bool isBufferUsageStats = false;
+
+    bool
+    isLocusProfile() const
+    {
+        return (not locusProfileFilename.empty());
+    }
+
+    /// Optional BED output of genome windows which are expensive to process
+    std::string locusProfileFilename;
+
+    /// Window size used to accumulate processing cost for the locus profile
+    unsigned locusProfileWindowSize = 10000;
+
+    /// Minimum processing time for a window to be reported in the locus profile
+    double locusProfileMinSeconds = 1.0;
+
     bool
     isMaxBufferedReads() const
     {
@@ -222,6 +265,53 @@ struct starling_base_options : public blt_options
     /// set to zero to disable limit
     unsigned maxBufferedReads = 100000;
 
+    bool
+    isMemoryBudget() const
+    {
+        return (memoryBudgetMb != 0);
+    }
+
+    /// approximate memory budget for buffered read and basecall data, input reads are downsampled
+    /// as this budget is approached
+    ///
+    /// set to zero to disable limit
+    unsigned memoryBudgetMb = 0;
+
+    /// Optional BED output of regions where input reads are downsampled to stay within the memory budget
+    std::string throttledRegionsFilename;
+
+    bool
+    isProgressReport() const
+    {
+        return (not progressFilename.empty());
+    }
+
+    /// Optional status file or FIFO which receives periodic progress records
+    std::string progressFilename;
+
+    /// Minimum time between progress records
+    double progressIntervalSeconds = 10.;
+
+    bool
+    isCaptureReplayBundle() const
+    {
+        return (not captureBundleDir.empty());
+    }
+
+    /// Optional output directory for a replay bundle of the analysis region. When this is set the bundle is
+    /// written instead of calling variants.
+    std::string captureBundleDir;
+
+    /// Number of times all analysis regions are called, repeated calls are used to profile replay bundles
+    unsigned replayIterations = 1;
+
+    /// Offset of the fasta reference sequence within each contig, this is non-zero only when the fasta reference
+    /// is a slice of the full reference, as written to replay bundles
+    pos_t referenceSliceOffset = 0;
+
+    /// All options of the command line in command line order, these are used to write replay bundles
+    std::vector<CommandLineOption> commandLineOptions;
+
     bool isBasecallQualAdjustedForMapq = true;
 
     bool useTier2Evidence = false;
@@ -254,6 +344,11 @@ struct starling_base_options : public blt_options
     /// Optional bedfile to specify which regions should be called in the genome
     std::string callRegionsBedFilename;
 
+    /// If true, all call regions within each analysis region are streamed from the alignment files in a single pass,
+    /// instead of seeking to each call region separately. This is intended for call region sets with many small
+    /// regions, such as exome targets.
+    bool isSinglePassCallRegions = false;
+
     /// If true, the original read alignment with soft-clipped edges is scored and chosen as the
     /// final alignment if it has the highest score.
     ///
@@ -280,6 +375,8 @@ struct starling_sample_options
 
 struct IndelErrorModel;
 struct GenotypePriorSet;
+struct ReferenceAnnotationTrack;
+struct ReferenceImage;
 
 
 /// \brief Parameters deterministically derived from the input options
@@ -312,6 +409,20 @@ struct starling_base_deriv_options : public blt_deriv_options, private boost::no
         return *_indelGenotypePriors;
     }
 
+    /// \return the precomputed reference annotation track, or nullptr if no track has been provided
+    const ReferenceAnnotationTrack*
+    getReferenceAnnotationTrack() const
+    {
+        return _referenceAnnotationTrack.get();
+    }
+
+    /// \return the memory-mapped reference image, or nullptr if no image has been provided
+    const ReferenceImage*
+    getReferenceImage() const
+    {
+        return _referenceImage.get();
+    }
+
 protected:
     unsigned
     addPostCallStage(
@@ -340,6 +451,8 @@ public:
 private:
     std::unique_ptr<IndelErrorModel> _indelErrorModel;
     std::unique_ptr<GenotypePriorSet> _indelGenotypePriors;
+    std::unique_ptr<ReferenceAnnotationTrack> _referenceAnnotationTrack;
+    std::unique_ptr<ReferenceImage> _referenceImage;
 
     std::vector<unsigned> _postCallStage;
 };
@@ -256,6 +256,25 @@ starling_pos_processor_base(
     // this can safely be called after initializing _sample above
     resetActiveRegionDetector();
 
+    if (_opt.isLocusProfile())
+    {
+        _locusProfilerPtr.reset(
+            new LocusProfiler(_opt.locusProfileFilename, _opt.locusProfileWindowSize,
+                              _opt.locusProfileMinSeconds, _statsManager));
+    }
+
+    if (_opt.isMemoryBudget())
+    {
+        static const uint64_t bytesPerMb(1024*1024);
+        _readThrottlerPtr.reset(
+            new ReadThrottler(_opt.memoryBudgetMb * bytesPerMb, _opt.throttledRegionsFilename, _statsManager));
+    }
+
+    if (_opt.isProgressReport())
+    {
+        _progressReporterPtr.reset(new ProgressReporter(_opt.progressFilename, _opt.progressIntervalSeconds));
+    }
+
     if (_opt.is_all_sites())
     {
         // pre-calculate qscores for sites with no observations:
@@ -340,6 +359,14 @@ update_largest_total_indel_ref_span_per_read(const unsigned is)
 starling_pos_processor_base::
 ~starling_pos_processor_base()
 {
+    if (_locusProfilerPtr)
+    {
+        _locusProfilerPtr->flush(_chromName);
+    }
+    if (_readThrottlerPtr)
+    {
+        _readThrottlerPtr->flush();
+    }
 }
 
 
@@ -364,6 +391,13 @@ resetRegionBase(
     const known_pos_range2& reportRange)
 {
     reset();
+
+    // windows are accumulated over all regions on a chromosome, so that windows spanning several regions
+    // are only reported once:
+    if (_locusProfilerPtr and (chromName != _chromName))
+    {
+        _locusProfilerPtr->flush(_chromName);
+    }
     _chromName = chromName;
     _reportRange = reportRange;
 
@@ -521,6 +555,20 @@ is_estimated_depth_range_ge_than(
 
 
 
+bool
+starling_pos_processor_base::
+isReadThrottled(
+    const bam_record& br,
+    const alignment& al)
+{
+    if (not _readThrottlerPtr) return false;
+
+    return _readThrottlerPtr->isThrottled(br.qname(), _chromName, al.pos,
+                                          (al.pos + static_cast<pos_t>(ALIGNPATH::apath_ref_length(al.path))));
+}
+
+
+
 boost::optional<align_id_t>
 starling_pos_processor_base::
 insert_read(
@@ -589,6 +637,16 @@ insert_read(
         const starling_read* sread_ptr(rbuff.get_read(*retval));
         assert(nullptr!=sread_ptr);
 
+        if (_readThrottlerPtr)
+        {
+            // approximate the cost of the read and the basecalls it will add to the pileup:
+            _readThrottlerPtr->addBufferedBytes(sread_ptr->getEstimatedBytes() + (br.read_size() * sizeof(base_call)));
+        }
+        if (_progressReporterPtr)
+        {
+            _progressReporterPtr->addRead();
+        }
+
         // update depth-buffer for the whole read:
         load_read_in_depth_buffer(sread_ptr->get_full_segment(),sampleIndex);
 
@@ -749,8 +807,13 @@ align_pos(const pos_t pos)
 
             try
             {
-                realignAndScoreRead(_opt, _dopt, sif.sampleOptions, _ref, realign_buffer_range, sampleIndex,
-                                    rseg, getIndelBuffer());
+                const unsigned scoredAlignmentCount(
+                    realignAndScoreRead(_opt, _dopt, sif.sampleOptions, _ref, realign_buffer_range, sampleIndex,
+                                        rseg, getIndelBuffer()));
+                if (_locusProfilerPtr)
+                {
+                    _locusProfilerPtr->addRealignedRead(pos, scoredAlignmentCount);
+                }
             }
             catch (...)
             {
@@ -784,6 +847,75 @@ set_head_pos(const pos_t pos)
 
 
 
+void
+starling_pos_processor_base::
+updateBufferUsage(const pos_t pos)
+{
+    // the buffers are only scanned for progress reporting when a record will be written:
+    bool isProgressReportDue(false);
+    if (_progressReporterPtr)
+    {
+        _progressReporterPtr->updatePosition(_chromName, pos);
+        isProgressReportDue = _progressReporterPtr->isReportDue();
+    }
+    if (not (_opt.isBufferUsageStats or _readThrottlerPtr or isProgressReportDue)) return;
+
+    const unsigned sampleCount(getSampleCount());
+    BufferUsage readUsage;
+    BufferUsage basecallUsage;
+    for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
+    {
+        const sample_info& sif(sample(sampleIndex));
+        readUsage.add(sif.readBuffer.getBufferUsage());
+        basecallUsage.add(sif.basecallBuffer.getBufferUsage());
+    }
+
+    if (_readThrottlerPtr)
+    {
+        // the fixed slot capacity of the basecall buffer is excluded, because it is not reduced by dropping reads:
+        _readThrottlerPtr->setBufferedBytes(readUsage.bytes + (basecallUsage.entries * sizeof(base_call)));
+    }
+
+    // the remaining buffers are only required for buffer usage stats and progress reports:
+    if (not (_opt.isBufferUsageStats or isProgressReportDue)) return;
+
+    const BufferUsage indelUsage(getIndelBuffer().getBufferUsage());
+    const BufferUsage candidateSnvUsage(_candidateSnvBuffer.getBufferUsage());
+    const BufferUsage variantPipelineUsage(getVariantPipelineBufferUsage());
+
+    if (_opt.isBufferUsageStats)
+    {
+        _statsManager.updateBufferUsage(TRACKED_BUFFER::READ, readUsage, _chromName, pos);
+        _statsManager.updateBufferUsage(TRACKED_BUFFER::BASECALL, basecallUsage, _chromName, pos);
+        _statsManager.updateBufferUsage(TRACKED_BUFFER::INDEL, indelUsage, _chromName, pos);
+        _statsManager.updateBufferUsage(TRACKED_BUFFER::CANDIDATE_SNV, candidateSnvUsage, _chromName, pos);
+        _statsManager.updateBufferUsage(TRACKED_BUFFER::VARIANT_PIPELINE, variantPipelineUsage, _chromName, pos);
+    }
+
+    uint64_t totalBytes(readUsage.bytes + basecallUsage.bytes + indelUsage.bytes + candidateSnvUsage.bytes +
+                        variantPipelineUsage.bytes);
+    if (is_active_region_detector_enabled())
+    {
+        const BufferUsage activeRegionReadUsage(getActiveRegionDetector().getReadBufferUsage());
+        if (_opt.isBufferUsageStats)
+        {
+            _statsManager.updateBufferUsage(TRACKED_BUFFER::ACTIVE_REGION_READ, activeRegionReadUsage, _chromName,
+                                            pos);
+        }
+        totalBytes += activeRegionReadUsage.bytes;
+    }
+
+    if (isProgressReportDue)
+    {
+        ProgressBufferState bufferState;
+        bufferState.reads = readUsage.items;
+        bufferState.bytes = totalBytes;
+        _progressReporterPtr->report(bufferState);
+    }
+}
+
+
+
 void
 starling_pos_processor_base::
 process_pos(const int stage_no,
@@ -797,6 +929,8 @@ process_pos(const int stage_no,
 
     if (empty()) return;
 
+    const LocusProfileTimeScoper profileScoper(_locusProfilerPtr.get(), pos);
+
     const unsigned sampleCount(getSampleCount());
 
     if        (stage_no==STAGE::HEAD)
@@ -804,13 +938,26 @@ process_pos(const int stage_no,
         initializeSplicedReadSegmentsAtPos(pos);
         if (is_active_region_detector_enabled())
         {
-            _getActiveRegionDetector().updateEndPosition(pos);
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::ACTIVE_REGION);
+            ActiveRegionDetector& activeRegionDetector(_getActiveRegionDetector());
+            const unsigned long lastAssemblyCount(activeRegionDetector.getAssemblyCount());
+            activeRegionDetector.updateEndPosition(pos);
+            if (_locusProfilerPtr)
+            {
+                _locusProfilerPtr->addAssemblies(pos, (activeRegionDetector.getAssemblyCount() - lastAssemblyCount));
+            }
         }
     }
     else if (stage_no==STAGE::READ_BUFFER)
     {
-        align_pos(pos);
-        pileup_pos_reads(pos);
+        {
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::REALIGN);
+            align_pos(pos);
+        }
+        {
+            const StageTimeScoper stageScoper(getStageTimer(), TIMED_STAGE::PILEUP);
+            pileup_pos_reads(pos);
+        }
         write_reads(pos);
 
         if (is_active_region_detector_enabled())
@@ -910,6 +1057,15 @@ process_pos(const int stage_no,
     }
     else if (stage_no==STAGE::POST_CALL)
     {
+        // buffer contents turn over on the scale of a read length, so sampling their usage at a much shorter
+        // interval finds the peaks. Each sample scans the buffer contents, so this is skipped unless buffer usage is
+        // required:
+        static const pos_t bufferUsageSampleInterval(32);
+        if (isBufferUsageRequired() and ((pos % bufferUsageSampleInterval) == 0))
+        {
+            updateBufferUsage(pos);
+        }
+
         for (unsigned sampleIndex(0); sampleIndex<sampleCount; ++sampleIndex)
         {
             sample_info& sif(sample(sampleIndex));
@@ -42,6 +42,9 @@
 #include "starling_common/starling_read_buffer.hh"
 #include "starling_common/starling_streams_base.hh"
 #include "starling_common/ActiveRegionDetector.hh"
+#include "starling_common/LocusProfiler.hh"
+#include "starling_common/ProgressReporter.hh"
+#include "starling_common/ReadThrottler.hh"
 
 
 #include "boost/utility.hpp"
@@ -129,6 +132,14 @@ struct starling_pos_processor_base : public pos_processor_base, private boost::n
         const unsigned depth,
         const unsigned sample_no) const;
 
+    /// test whether an input read should be dropped to keep read buffering within the memory budget
+    ///
+    /// This is always false unless a memory budget is set.
+    bool
+    isReadThrottled(
+        const bam_record& br,
+        const alignment& al);
+
     /// insert read into read buffer
     ///
     /// \return true if the alignment is accepted into the buffer (alignments can fail a number of quality checks --
@@ -604,8 +615,34 @@ private:
         return true;
     }
 
+    /// \return occupancy of the loci buffered in the derived variant caller's output pipeline
+    virtual
+    BufferUsage
+    getVariantPipelineBufferUsage() const
+    {
+        return BufferUsage();
+    }
+
+    /// \return true if buffer occupancy is required for buffer usage stats, the memory budget or progress reporting
+    bool
+    isBufferUsageRequired() const
+    {
+        return (_opt.isBufferUsageStats or _readThrottlerPtr or _progressReporterPtr);
+    }
+
+    /// record the occupancy of all tracked buffers in RunStats if enabled, and update the memory budget and
+    /// progress reporting
+    void
+    updateBufferUsage(const pos_t pos);
+
 protected:
 
+    StageTimer&
+    getStageTimer()
+    {
+        return _statsManager.getStageTimer();
+    }
+
     bool
     is_forced_output_pos(const pos_t pos) const
     {
@@ -658,6 +695,15 @@ protected:
 
     PileupCleaner _pileupCleaner;
 
+    /// optional per-window processing cost tracker, null unless a locus profile is requested
+    std::unique_ptr<LocusProfiler> _locusProfilerPtr;
+
+    /// optional input read downsampler, null unless a memory budget is set
+    std::unique_ptr<ReadThrottler> _readThrottlerPtr;
+
+    /// optional progress status writer, null unless a progress file is requested
+    std::unique_ptr<ProgressReporter> _progressReporterPtr;
+
 private:
     IndelBuffer _indelBuffer;
     CandidateSnvBuffer _candidateSnvBuffer;
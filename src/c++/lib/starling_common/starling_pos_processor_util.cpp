@@ -133,6 +133,48 @@ getSubRegionsFromBedTrack(
 
 
 
+void
+getCallSubRegionInfo(
+    const std::string& callRegionsBedFilename,
+    const AnalysisRegionInfo& regionInfo,
+    const unsigned supplementalRegionBorderSize,
+    std::vector<AnalysisRegionInfo>& subRegionInfoList)
+{
+    std::vector<known_pos_range2> subRegionRanges;
+    getSubRegionsFromBedTrack(callRegionsBedFilename, regionInfo.regionChrom, regionInfo.regionRange, subRegionRanges);
+
+    subRegionInfoList.resize(subRegionRanges.size());
+    const unsigned subRegionCount(subRegionRanges.size());
+    for (unsigned subRegionIndex(0); subRegionIndex < subRegionCount; ++subRegionIndex)
+    {
+        const known_pos_range2& subRegionRange(subRegionRanges[subRegionIndex]);
+        getStrelkaAnalysisRegionInfo(regionInfo.regionChrom, subRegionRange.begin_pos(), subRegionRange.end_pos(),
+                                     supplementalRegionBorderSize, subRegionInfoList[subRegionIndex]);
+    }
+}
+
+
+
+void
+resetCallSubRegionList(
+    const std::string& regionChrom,
+    const std::vector<AnalysisRegionInfo>& subRegionInfoList,
+    HtsMergeStreamer& streamData,
+    ReferenceSegmentCache& refCache)
+{
+    std::vector<known_pos_range2> streamerRanges;
+    std::vector<known_pos_range2> refRanges;
+    for (const auto& subRegionInfo : subRegionInfoList)
+    {
+        streamerRanges.push_back(subRegionInfo.streamerRegionRange);
+        refRanges.push_back(subRegionInfo.refRegionRange);
+    }
+    streamData.resetRegionList(regionChrom, streamerRanges);
+    refCache.resetRegionList(regionChrom, refRanges);
+}
+
+
+
 /// This means 'valid' in the sense of what the code can handle right
 /// now. Specifically, '=' are not supported.
 ///
@@ -426,6 +468,12 @@ processInputReadAlignment(
             return;
         }
 
+        if (posProcessor.isReadThrottled(read, readAlignment))
+        {
+            readCounts.subsample_filter++;
+            return;
+        }
+
         // normalize/left-shift the input alignment
         const rc_segment_bam_seq refBamSeq(ref);
         const bam_seq readBamSeq(read.get_bam_read());
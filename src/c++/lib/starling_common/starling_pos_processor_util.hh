@@ -60,6 +60,28 @@ getSubRegionsFromBedTrack(
     std::vector<known_pos_range2>& subRegionRanges);
 
 
+/// Get the analysis region info for each call sub-region of an analysis region
+///
+/// \param[in] regionInfo analysis region info for the input genome segment
+/// \param[out] subRegionInfoList analysis region info for each sub-region found by getSubRegionsFromBedTrack
+void
+getCallSubRegionInfo(
+    const std::string& callRegionsBedFilename,
+    const AnalysisRegionInfo& regionInfo,
+    const unsigned supplementalRegionBorderSize,
+    std::vector<AnalysisRegionInfo>& subRegionInfoList);
+
+
+/// Set the region list of streamData and refCache to the list of call sub-regions, so that all sub-regions are
+/// streamed from the alignment files in a single pass
+void
+resetCallSubRegionList(
+    const std::string& regionChrom,
+    const std::vector<AnalysisRegionInfo>& subRegionInfoList,
+    HtsMergeStreamer& streamData,
+    ReferenceSegmentCache& refCache);
+
+
 /// Handles input read alignments -- reads are parsed, their indels
 /// are extracted and the reads/indels are buffered to posProcessor
 ///
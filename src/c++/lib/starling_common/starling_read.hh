@@ -140,6 +140,16 @@ struct starling_read : private boost::noncopyable
         return get_segment(0);
     }
 
+    /// \return approximate heap and object size of this read
+    ///
+    /// This only accounts for data fixed when the read is created, so it does not change if the read is realigned.
+    uint64_t
+    getEstimatedBytes() const
+    {
+        return (sizeof(starling_read) + sizeof(bam1_t) + get_brp()->m_data +
+                (_exonInfo.capacity() * sizeof(read_segment)));
+    }
+
 private:
     friend struct read_segment;
 
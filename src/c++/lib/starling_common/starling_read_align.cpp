@@ -2022,7 +2022,7 @@ normalizeInputAlignmentIndels(
 
 
 
-void
+unsigned
 realignAndScoreRead(
     const starling_base_options& opt,
     const starling_base_deriv_options& dopt,
@@ -2042,9 +2042,9 @@ realignAndScoreRead(
     const alignment& inputAlignment(rseg.getInputAlignment());
     assert (! inputAlignment.empty());
 
-    if (! inputAlignment.is_realignable(opt.maxIndelSize)) return;
+    if (! inputAlignment.is_realignable(opt.maxIndelSize)) return 0;
 
-    if (! check_for_candidate_indel_overlap(realign_buffer_range, rseg, indelBuffer)) return;
+    if (! check_for_candidate_indel_overlap(realign_buffer_range, rseg, indelBuffer)) return 0;
 
     alignment normalizedInputAlignment(normalizeInputAlignmentIndels(rseg));
 
@@ -2059,7 +2059,7 @@ realignAndScoreRead(
     // skip if normalizedInputAlignment has negative start position
     // note this won't come from the read mapper in most cases, but rarely
     // the normalization process could do this
-    if (normalizedInputAlignment.pos<0) return;
+    if (normalizedInputAlignment.pos<0) return 0;
 
     // run recursive alignment search starting from normalizedInputAlignment,
     // produce a list of candidate alignments from this search
@@ -2123,4 +2123,6 @@ realignAndScoreRead(
     scoreCandidateAlignmentsAndIndels(opt, dopt, sample_opt, ref,
                                       rseg, indelBuffer, sampleId, cal_set, is_incomplete_search,
                                       isTestSoftClippedInputAligned, softClippedInputAlignment);
+
+    return cal_set.size();
 }
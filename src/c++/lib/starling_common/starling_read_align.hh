@@ -45,7 +45,9 @@
 /// \param realign_buffer_range The range (in reference coordinates) in which the read is allowed to realign
 ///          (due to buffering constraints)
 ///
-void
+/// \return The number of candidate alignments scored, zero if the read was not realigned
+///
+unsigned
 realignAndScoreRead(
     const starling_base_options& opt,
     const starling_base_deriv_options& dopt,
@@ -156,6 +156,23 @@ clear_iter(
 
 
 
+BufferUsage
+starling_read_buffer::
+getBufferUsage() const
+{
+    BufferUsage usage;
+    for (const auto& val : _read_data)
+    {
+        const starling_read& sread(*(val.second));
+        usage.items++;
+        usage.entries += sread.get_full_segment().read_size();
+        usage.bytes += sizeof(read_data_t::value_type) + sread.getEstimatedBytes();
+    }
+    return usage;
+}
+
+
+
 void
 starling_read_buffer::
 dump_pos(const pos_t pos,
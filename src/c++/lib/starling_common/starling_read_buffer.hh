@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "appstats/BufferUsage.hh"
 #include "starling_common/starling_read.hh"
 
 #include "boost/utility.hpp"
@@ -160,6 +161,10 @@ struct starling_read_buffer : private boost::noncopyable
         return _pos_group.empty();
     }
 
+    /// \return buffered read count, read bases and estimated bytes
+    BufferUsage
+    getBufferUsage() const;
+
 private:
     typedef std::map<align_id_t,starling_read*> read_data_t;
     typedef std::pair<align_id_t,seg_id_t> segment_t;
@@ -23,15 +23,145 @@
 
 #include "starling_common/starling_ref_seq.hh"
 
+#include "blt_util/ReferenceAnnotationTrack.hh"
+#include "blt_util/ReferenceImage.hh"
+#include "blt_util/seq_util.hh"
 #include "common/Exceptions.hh"
 #include "htsapi/samtools_fasta_util.hh"
 #include "htsapi/bam_header_util.hh"
 
+#include <algorithm>
+
+
+
+/// Set ref to the range segment of the memory-mapped reference image
+///
+/// Range handling follows the fasta index query used for the standard reference: the segment is truncated
+/// at the end of the contig. Where the segment only contains standardized bases the segment is a view of the
+/// image, otherwise the segment is copied out and standardized.
+static
+void
+setRefSegmentFromImage(
+    const starling_base_options& opt,
+    const ReferenceImage& referenceImage,
+    const std::string& chrom,
+    const known_pos_range2& range,
+    reference_contig_segment& ref)
+{
+    pos_t contigSize(0);
+    const char* contigSeq(referenceImage.getContig(chrom, contigSize));
+    if (nullptr == contigSeq)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Reference image '" << opt.referenceImageFilename
+            << "' does not contain contig '" << chrom << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    const pos_t beginPos(std::min(range.begin_pos(), contigSize));
+    const pos_t endPos(std::max(beginPos, std::min(range.end_pos(), contigSize)));
+    const char* segmentSeq(contigSeq + beginPos);
+    const pos_t segmentSize(endPos - beginPos);
+
+    bool isStandardized(true);
+    for (pos_t segmentIndex(0); segmentIndex < segmentSize; ++segmentIndex)
+    {
+        if (not is_valid_base(segmentSeq[segmentIndex]))
+        {
+            isStandardized = false;
+            break;
+        }
+    }
+
+    if (isStandardized)
+    {
+        ref.setView(segmentSeq, segmentSize);
+    }
+    else
+    {
+        std::string& seq(ref.seq());
+        seq.assign(segmentSeq, segmentSize);
+        standardize_ref_seq(opt.referenceImageFilename.c_str(), chrom.c_str(), seq, beginPos);
+    }
+}
+
+
+
+/// Set seq to the standardized reference sequence of [beginPos,endPos) on chrom from the fasta reference
+///
+/// The fasta reference may be a slice of the full contig starting at the reference slice offset, as used in
+/// replay bundles (see ReplayBundle.hh).
+static
+void
+getFastaRefSeq(
+    const starling_base_options& opt,
+    const std::string& chrom,
+    const pos_t beginPos,
+    const pos_t endPos,
+    std::string& seq)
+{
+    if (beginPos < opt.referenceSliceOffset)
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Requested reference range '" << chrom << ":" << (beginPos+1) << "-" << endPos
+            << "' begins before the reference slice offset: " << opt.referenceSliceOffset;
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+
+    // note: the ref function below takes closed-closed endpoints, so we subtract one from endPos
+    get_standardized_region_seq(opt.referenceFilename, chrom, (beginPos - opt.referenceSliceOffset),
+                                (endPos - opt.referenceSliceOffset)-1, seq);
+}
+
+
+
+/// Attach the precomputed annotation track for chrom to ref, if a track has been provided
+///
+/// The reference sequence checksums stored in the track are checked against the sequence of ref.
+static
+void
+setRefSegmentAnnotation(
+    const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
+    const std::string& chrom,
+    reference_contig_segment& ref)
+{
+    ReferenceAnnotationContig annotation;
+    const ReferenceAnnotationTrack* annotationTrackPtr(dopt.getReferenceAnnotationTrack());
+    if (annotationTrackPtr != nullptr)
+    {
+        annotation = annotationTrackPtr->getContig(chrom);
+        if (annotation.empty() or (ref.end() > annotation.size))
+        {
+            using namespace illumina::common;
+            std::ostringstream oss;
+            oss << "Reference annotation track '" << opt.referenceAnnotationFilename
+                << "' is inconsistent with reference fasta '" << opt.referenceFilename
+                << "' for contig '" << chrom << "'";
+            BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+        }
+    }
+    ref.setAnnotation(annotation);
+
+    if (not isReferenceAnnotationChecksumMatch(ref))
+    {
+        using namespace illumina::common;
+        std::ostringstream oss;
+        oss << "Reference annotation track '" << opt.referenceAnnotationFilename
+            << "' was computed from a reference sequence which does not match reference '"
+            << opt.referenceFilename << "' for contig '" << chrom << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+}
+
 
 
 void
 setRefSegment(
     const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
     const std::string& chrom,
     const known_pos_range2& range,
     reference_contig_segment& ref)
@@ -39,8 +169,99 @@ setRefSegment(
     assert(! chrom.empty());
 
     ref.set_offset(range.begin_pos());
-    // note: the ref function below takes closed-closed endpoints, so we subtract one from endPos
-    get_standardized_region_seq(opt.referenceFilename, chrom, range.begin_pos(), range.end_pos()-1, ref.seq());
+
+    const ReferenceImage* referenceImagePtr(dopt.getReferenceImage());
+    if (referenceImagePtr != nullptr)
+    {
+        setRefSegmentFromImage(opt, *referenceImagePtr, chrom, range, ref);
+    }
+    else
+    {
+        getFastaRefSeq(opt, chrom, range.begin_pos(), range.end_pos(), ref.seq());
+    }
+
+    setRefSegmentAnnotation(opt, dopt, chrom, ref);
+}
+
+
+
+/// the reference is read in one piece for regions separated by no more than this gap:
+static const pos_t maxRefGroupGap(10000);
+
+/// limit the memory used for the reference of a group of regions:
+static const pos_t maxRefGroupSize(4000000);
+
+
+
+void
+ReferenceSegmentCache::
+resetRegionList(
+    const std::string& chrom,
+    const std::vector<known_pos_range2>& refRanges)
+{
+    assert(! chrom.empty());
+
+    // note that the current group sequence is retained until the next group is loaded, because it may still be
+    // in use for the last region of the previous list:
+    _chrom = chrom;
+    _refRanges = refRanges;
+    _regionGroupIndex.clear();
+    _groupRanges.clear();
+    _isGroupLoaded = false;
+
+    for (const auto& refRange : _refRanges)
+    {
+        if (not _groupRanges.empty())
+        {
+            known_pos_range2& groupRange(_groupRanges.back());
+            assert(refRange.begin_pos() >= groupRange.begin_pos());
+            if ((refRange.begin_pos() <= (groupRange.end_pos() + maxRefGroupGap)) and
+                ((refRange.end_pos() - groupRange.begin_pos()) <= maxRefGroupSize))
+            {
+                groupRange.set_end_pos(std::max(groupRange.end_pos(), refRange.end_pos()));
+                _regionGroupIndex.push_back(_groupRanges.size()-1);
+                continue;
+            }
+        }
+        _regionGroupIndex.push_back(_groupRanges.size());
+        _groupRanges.push_back(refRange);
+    }
+}
+
+
+
+void
+ReferenceSegmentCache::
+setRefSegment(
+    const unsigned regionIndex,
+    reference_contig_segment& ref)
+{
+    assert(regionIndex < _refRanges.size());
+    const known_pos_range2& refRange(_refRanges[regionIndex]);
+
+    if (_dopt.getReferenceImage() != nullptr)
+    {
+        ::setRefSegment(_opt, _dopt, _chrom, refRange, ref);
+        return;
+    }
+
+    const unsigned groupIndex(_regionGroupIndex[regionIndex]);
+    const known_pos_range2& groupRange(_groupRanges[groupIndex]);
+    if ((not _isGroupLoaded) or (groupIndex != _loadedGroupIndex))
+    {
+        getFastaRefSeq(_opt, _chrom, groupRange.begin_pos(), groupRange.end_pos(), _groupSeq);
+        _isGroupLoaded = true;
+        _loadedGroupIndex = groupIndex;
+    }
+
+    // the group sequence is truncated at the end of the contig in the same way as a single segment:
+    const pos_t groupSeqEndPos(groupRange.begin_pos() + static_cast<pos_t>(_groupSeq.size()));
+    const pos_t beginPos(std::min(refRange.begin_pos(), groupSeqEndPos));
+    const pos_t endPos(std::max(beginPos, std::min(refRange.end_pos(), groupSeqEndPos)));
+
+    ref.set_offset(refRange.begin_pos());
+    ref.setView(_groupSeq.data() + (beginPos - groupRange.begin_pos()), (endPos - beginPos));
+    setRefSegmentAnnotation(_opt, _dopt, _chrom, ref);
 }
 
 
@@ -27,17 +27,72 @@
 #include "blt_util/known_pos_range2.hh"
 #include "htsapi/bam_header_info.hh"
 
+#include "boost/utility.hpp"
+
 #include <string>
+#include <vector>
 
 
+/// Load the reference sequence for a region into ref
+///
+/// If a reference annotation track has been provided, the track for chrom is also attached to ref.
 void
 setRefSegment(
     const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
     const std::string& chrom,
     const known_pos_range2& range,
     reference_contig_segment& ref);
 
 
+/// \brief Load reference segments for a sorted list of nearby regions on one chromosome
+///
+/// Loading each segment with setRefSegment reopens the fasta index and reads the sequence separately. Here
+/// nearby regions are grouped so that the reference is read once per group, and the segment for each region
+/// is set as a view into the sequence of its group. When a reference image is available the segments are
+/// views of the image, so no group sequence is read.
+///
+/// Each region segment matches the segment loaded by setRefSegment for the same range.
+struct ReferenceSegmentCache : private boost::noncopyable
+{
+    ReferenceSegmentCache(
+        const starling_base_options& opt,
+        const starling_base_deriv_options& dopt)
+        : _opt(opt), _dopt(dopt)
+    {}
+
+    /// \param[in] refRanges reference range of each region, sorted by begin position
+    void
+    resetRegionList(
+        const std::string& chrom,
+        const std::vector<known_pos_range2>& refRanges);
+
+    /// Set ref to the segment of region regionIndex from the current region list
+    ///
+    /// The segment is valid until a region from a different group is set, so this should only be called once the
+    /// previous segment is no longer in use.
+    void
+    setRefSegment(
+        const unsigned regionIndex,
+        reference_contig_segment& ref);
+
+private:
+    const starling_base_options& _opt;
+    const starling_base_deriv_options& _dopt;
+
+    std::string _chrom;
+    std::vector<known_pos_range2> _refRanges;
+
+    /// index of the group each region belongs to:
+    std::vector<unsigned> _regionGroupIndex;
+    std::vector<known_pos_range2> _groupRanges;
+
+    bool _isGroupLoaded = false;
+    unsigned _loadedGroupIndex = 0;
+    std::string _groupSeq;
+};
+
+
 struct AnalysisRegionInfo
 {
     /// Chrom string from region parse
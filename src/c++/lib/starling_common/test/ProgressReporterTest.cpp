@@ -0,0 +1,47 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "starling_common/ProgressReporter.hh"
+
+#include "boost/test/unit_test.hpp"
+
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( ProgressReporter_test_suite )
+
+
+BOOST_AUTO_TEST_CASE( test_writeRecord )
+{
+    ProgressBufferState bufferState;
+    bufferState.reads = 10;
+    bufferState.bytes = 2500000;
+
+    std::ostringstream oss;
+    ProgressReporter::writeRecord(oss, "chr1", 999, 100, 2000, 1.5, 1000., bufferState, 50000000, false);
+
+    // positions are reported 1-indexed, and each record is a single line:
+    static const std::string expect(
+        "{\"chrom\":\"chr1\",\"pos\":1000,\"readsConsumed\":100,\"basesProcessed\":2000,\"elapsedSeconds\":1.50,"
+        "\"basesPerSecond\":1000.00,\"bufferedReads\":10,\"bufferedMb\":2.50,\"rssMb\":50.00,\"isComplete\":false}\n");
+    BOOST_REQUIRE_EQUAL(oss.str(), expect);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "starling_common/ReadThrottler.hh"
+
+#include "boost/test/unit_test.hpp"
+
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( ReadThrottler_test_suite )
+
+
+BOOST_AUTO_TEST_CASE( test_readNameHashFraction )
+{
+    // the hash is fixed, so the same value is found for every run:
+    const double hashFraction(ReadThrottler::getReadNameHashFraction("read1"));
+    BOOST_REQUIRE_EQUAL(hashFraction, ReadThrottler::getReadNameHashFraction("read1"));
+    BOOST_REQUIRE(hashFraction >= 0.);
+    BOOST_REQUIRE(hashFraction < 1.);
+
+    BOOST_REQUIRE(hashFraction != ReadThrottler::getReadNameHashFraction("read2"));
+}
+
+
+BOOST_AUTO_TEST_CASE( test_keepFraction )
+{
+    RunStatsManager statsManager("");
+    ReadThrottler throttler(1000, "", statsManager);
+
+    BOOST_REQUIRE_EQUAL(throttler.getKeepFraction(), 1.);
+    throttler.addBufferedBytes(750);
+    BOOST_REQUIRE_EQUAL(throttler.getKeepFraction(), 1.);
+    throttler.addBufferedBytes(125);
+    BOOST_REQUIRE_CLOSE(throttler.getKeepFraction(), 0.5, 0.0001);
+    throttler.addBufferedBytes(125);
+    BOOST_REQUIRE_EQUAL(throttler.getKeepFraction(), 0.);
+
+    throttler.setBufferedBytes(0);
+    BOOST_REQUIRE_EQUAL(throttler.getKeepFraction(), 1.);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_isThrottled )
+{
+    RunStatsManager statsManager("");
+    ReadThrottler throttler(1000, "", statsManager);
+
+    // no reads are throttled below the budget:
+    BOOST_REQUIRE(not throttler.isThrottled("read1", "chr1", 100, 200));
+
+    // a read is retained if its hash fraction is less than the keep fraction:
+    throttler.setBufferedBytes(875);
+    unsigned throttledCount(0);
+    for (unsigned readIndex(0); readIndex < 1000; ++readIndex)
+    {
+        const std::string readName("read" + std::to_string(readIndex));
+        const bool isThrottled(throttler.isThrottled(readName.c_str(), "chr1", 100, 200));
+        BOOST_REQUIRE_EQUAL(isThrottled, (ReadThrottler::getReadNameHashFraction(readName.c_str()) >= 0.5));
+
+        // the same decision is made for both reads of a pair:
+        BOOST_REQUIRE_EQUAL(isThrottled, throttler.isThrottled(readName.c_str(), "chr1", 300, 400));
+        if (isThrottled) throttledCount++;
+    }
+    BOOST_REQUIRE(throttledCount > 400);
+    BOOST_REQUIRE(throttledCount < 600);
+
+    // all reads are throttled at the budget:
+    throttler.setBufferedBytes(1000);
+    BOOST_REQUIRE(throttler.isThrottled("read1", "chr1", 100, 200));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
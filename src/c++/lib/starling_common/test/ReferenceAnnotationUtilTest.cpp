@@ -0,0 +1,238 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "blt_common/ref_context.hh"
+#include "starling_common/ReferenceAnnotationUtil.hh"
+#include "starling_common/ReferenceRepeatFinder.hh"
+
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( ReferenceAnnotationUtil_test_suite )
+
+
+/// generate a repetitive random sequence from a small alphabet
+static
+std::string
+getTestSequence(
+    const unsigned length,
+    const std::string& alphabet,
+    const unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<unsigned> baseDist(0, alphabet.size()-1);
+    std::uniform_int_distribution<unsigned> repeatDist(0, 9);
+
+    std::string seq;
+    while (seq.size() < length)
+    {
+        // occasionally copy a recent section of the sequence to create STRs:
+        const unsigned repeatType(repeatDist(gen));
+        if ((repeatType < 3) and (seq.size() > 8))
+        {
+            const unsigned period(1+repeatType*3);
+            const std::string unit(seq.substr(seq.size()-period));
+            for (unsigned repeatIndex(0); repeatIndex <= repeatDist(gen); ++repeatIndex) seq += unit;
+        }
+        else
+        {
+            seq.push_back(alphabet[baseDist(gen)]);
+        }
+    }
+    seq.resize(length);
+    return seq;
+}
+
+
+
+static
+void
+testContigAnnotation(const std::string& seq)
+{
+    reference_contig_segment contig;
+    contig.seq() = seq;
+
+    std::vector<ReferenceAnnotation> annotation;
+    computeReferenceAnnotation(contig, 10, 3, annotation);
+    BOOST_REQUIRE_EQUAL(annotation.size(), seq.size());
+
+    const pos_t contigSize(seq.size());
+    for (pos_t pos(0); pos<contigSize; ++pos)
+    {
+        const ReferenceAnnotation& posAnnotation(annotation[pos]);
+        const unsigned expectedHpolSize(std::min(get_snp_hpol_size(pos, contig), ReferenceAnnotation::MaxHpolSize));
+        BOOST_REQUIRE_EQUAL(posAnnotation.getSnpHpolSize(), expectedHpolSize);
+
+        unsigned expectedPeriod(0);
+        bool expectedIsLeftEnd(false);
+        for (unsigned patternSize(1); patternSize<=ReferenceAnnotation::MaxSTRPeriod; ++patternSize)
+        {
+            bool isBaseInSTR(false);
+            searchForSTR(patternSize, pos, isBaseInSTR, expectedIsLeftEnd, contig);
+            if (isBaseInSTR)
+            {
+                expectedPeriod = patternSize;
+                break;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(posAnnotation.getSTRPeriod(), expectedPeriod);
+        if (expectedPeriod == 0) continue;
+
+        BOOST_REQUIRE_EQUAL(posAnnotation.isLeftEndOfSTR(), expectedIsLeftEnd);
+        if (not expectedIsLeftEnd) continue;
+
+        const unsigned expectedRepeatCount(std::min(getLeftShiftedSTRRepeatCount(expectedPeriod, pos, contig),
+                                                    ReferenceAnnotation::MaxSTRRepeatCount));
+        BOOST_REQUIRE_EQUAL(posAnnotation.getSTRRepeatCount(), expectedRepeatCount);
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_contig_annotation )
+{
+    testContigAnnotation("");
+    testContigAnnotation("A");
+    testContigAnnotation("NNNNNACACACACNNNNN");
+    testContigAnnotation(std::string(100,'A') + "C" + std::string(20,'A'));
+    testContigAnnotation(getTestSequence(5000, "AC", 1));
+    testContigAnnotation(getTestSequence(5000, "ACGT", 2));
+    testContigAnnotation(getTestSequence(5000, "ACGTN", 3));
+}
+
+
+
+/// test that anchor positions read through an annotated segment match those computed by the streaming repeat
+/// finder, following the ActiveRegionReadBuffer repeat finder update pattern through the end of the segment
+static
+void
+testAnnotatedSegmentAnchors(
+    const std::string& seq,
+    const pos_t segmentBeginPos,
+    const pos_t segmentEndPos,
+    const pos_t initPos)
+{
+    static const unsigned maxRepeatUnitLength(10);
+    static const unsigned minRepeatSpan(3);
+
+    reference_contig_segment contig;
+    contig.seq() = seq;
+    std::vector<ReferenceAnnotation> annotation;
+    computeReferenceAnnotation(contig, maxRepeatUnitLength, minRepeatSpan, annotation);
+
+    ReferenceAnnotationContig annotationContig;
+    annotationContig.data = annotation.data();
+    annotationContig.size = annotation.size();
+    annotationContig.maxRepeatUnitLength = maxRepeatUnitLength;
+    annotationContig.minRepeatSpan = minRepeatSpan;
+
+    reference_contig_segment ref;
+    ref.set_offset(segmentBeginPos);
+    ref.seq() = seq.substr(segmentBeginPos, segmentEndPos-segmentBeginPos);
+
+    reference_contig_segment annotatedRef(ref);
+    annotatedRef.setAnnotation(annotationContig);
+    BOOST_REQUIRE(annotatedRef.isAnnotated());
+
+    const unsigned bufferSize(100);
+    ReferenceRepeatFinder repeatFinder(ref, maxRepeatUnitLength, bufferSize, minRepeatSpan);
+    ReferenceRepeatFinder annotatedRepeatFinder(annotatedRef, maxRepeatUnitLength, bufferSize, minRepeatSpan);
+
+    repeatFinder.initRepeatSpan(initPos);
+    annotatedRepeatFinder.initRepeatSpan(initPos);
+    for (pos_t pos(initPos); pos<segmentEndPos; ++pos)
+    {
+        const pos_t updatePos(pos + 2*maxRepeatUnitLength);
+        repeatFinder.updateRepeatSpan(updatePos);
+        annotatedRepeatFinder.updateRepeatSpan(updatePos);
+        BOOST_REQUIRE_MESSAGE(annotatedRepeatFinder.isAnchor(pos) == repeatFinder.isAnchor(pos),
+                              "Anchor mismatch at pos " << pos);
+    }
+}
+
+
+
+/// test that reference context values computed through an annotated segment match those computed directly
+BOOST_AUTO_TEST_CASE( test_annotated_segment )
+{
+    static const unsigned maxRepeatUnitLength(10);
+    static const unsigned minRepeatSpan(3);
+
+    const std::string seq(getTestSequence(3000, "ACGT", 4));
+
+    reference_contig_segment contig;
+    contig.seq() = seq;
+    std::vector<ReferenceAnnotation> annotation;
+    computeReferenceAnnotation(contig, maxRepeatUnitLength, minRepeatSpan, annotation);
+
+    ReferenceAnnotationContig annotationContig;
+    annotationContig.data = annotation.data();
+    annotationContig.size = annotation.size();
+    annotationContig.maxRepeatUnitLength = maxRepeatUnitLength;
+    annotationContig.minRepeatSpan = minRepeatSpan;
+
+    const pos_t segmentBeginPos(500);
+    const pos_t segmentEndPos(2500);
+    reference_contig_segment ref;
+    ref.set_offset(segmentBeginPos);
+    ref.seq() = seq.substr(segmentBeginPos, segmentEndPos-segmentBeginPos);
+
+    reference_contig_segment annotatedRef(ref);
+    annotatedRef.setAnnotation(annotationContig);
+    BOOST_REQUIRE(annotatedRef.isAnnotated());
+
+    for (pos_t pos(segmentBeginPos-10); pos<(segmentEndPos+10); ++pos)
+    {
+        BOOST_REQUIRE_EQUAL(get_snp_hpol_size(pos, annotatedRef), get_snp_hpol_size(pos, ref));
+    }
+
+    testAnnotatedSegmentAnchors(seq, segmentBeginPos, segmentEndPos, segmentBeginPos+10);
+}
+
+
+
+/// test annotated anchor positions at segment ends, including repeats which extend beyond the segment
+BOOST_AUTO_TEST_CASE( test_annotated_segment_anchor_edges )
+{
+    const std::string seq(getTestSequence(3000, "ACGT", 5));
+
+    // initialization at the segment start, at the contig start, and with the segment extending to the contig end:
+    testAnnotatedSegmentAnchors(seq, 500, 2500, 500);
+    testAnnotatedSegmentAnchors(seq, 0, 2500, 0);
+    testAnnotatedSegmentAnchors(seq, 500, 3000, 520);
+    testAnnotatedSegmentAnchors(seq, 0, 3000, 100);
+
+    // segment too small to use the annotation:
+    testAnnotatedSegmentAnchors(seq, 1000, 1060, 1000);
+
+    // repeats crossing each segment end, which are truncated in the segment but not in the annotation:
+    std::string repeatSeq(seq);
+    repeatSeq.replace(480, 40, std::string(40, 'A'));
+    for (unsigned repeatIndex(0); repeatIndex<10; ++repeatIndex)
+    {
+        repeatSeq.replace(2470+repeatIndex*6, 6, "ACGTTG");
+    }
+    testAnnotatedSegmentAnchors(repeatSeq, 500, 2500, 500);
+    testAnnotatedSegmentAnchors(repeatSeq, 500, 2500, 510);
+    testAnnotatedSegmentAnchors(repeatSeq, 500, 2500, 2400);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
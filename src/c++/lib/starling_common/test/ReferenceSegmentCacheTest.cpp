@@ -0,0 +1,136 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "starling_common/starling_ref_seq.hh"
+#include "test/starling_base_options_test.hh"
+#include "test/TempPath.hh"
+
+#include "htslib/faidx.h"
+
+#include <fstream>
+
+
+BOOST_AUTO_TEST_SUITE( ReferenceSegmentCache_test_suite )
+
+
+/// Temporary indexed fasta reference
+struct TempReference
+{
+    explicit
+    TempReference(const std::vector<std::pair<std::string, unsigned>>& contigs)
+        : dir("refSegmentCache-%%%%-%%%%")
+    {
+        static const char bases[] = "ACGTNacgt";
+        {
+            std::ofstream fastaStream(name());
+            unsigned state(1);
+            for (const auto& contig : contigs)
+            {
+                fastaStream << '>' << contig.first << '\n';
+                for (unsigned pos(0); pos < contig.second; ++pos)
+                {
+                    state = state * 1103515245u + 12345u;
+                    fastaStream << bases[(state >> 16) % 9];
+                    if (((pos+1) % 60) == 0) fastaStream << '\n';
+                }
+                fastaStream << '\n';
+            }
+        }
+        BOOST_REQUIRE_EQUAL(fai_build(name().c_str()), 0);
+    }
+
+    std::string
+    name() const
+    {
+        return dir.getFilename("reference.fa");
+    }
+
+    const TempDir dir;
+};
+
+
+
+static
+void
+checkSegmentsMatch(
+    const reference_contig_segment& expected,
+    const reference_contig_segment& ref)
+{
+    BOOST_REQUIRE_EQUAL(ref.get_offset(), expected.get_offset());
+    BOOST_REQUIRE_EQUAL(ref.end(), expected.end());
+    std::string expectedSeq, seq;
+    expected.get_substring(expected.get_offset(), (expected.end() - expected.get_offset()), expectedSeq);
+    ref.get_substring(ref.get_offset(), (ref.end() - ref.get_offset()), seq);
+    BOOST_REQUIRE_EQUAL(seq, expectedSeq);
+}
+
+
+
+/// test that each cached segment matches the segment loaded directly by setRefSegment
+static
+void
+checkRegionList(
+    const starling_base_options& opt,
+    const starling_base_deriv_options& dopt,
+    ReferenceSegmentCache& cache,
+    const std::string& chrom,
+    const std::vector<known_pos_range2>& refRanges)
+{
+    cache.resetRegionList(chrom, refRanges);
+    for (unsigned regionIndex(0); regionIndex < refRanges.size(); ++regionIndex)
+    {
+        reference_contig_segment ref;
+        cache.setRefSegment(regionIndex, ref);
+
+        reference_contig_segment expected;
+        setRefSegment(opt, dopt, chrom, refRanges[regionIndex], expected);
+        checkSegmentsMatch(expected, ref);
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE( test_ReferenceSegmentCache )
+{
+    const TempReference reference({ {"chr1", 6000000}, {"chr2", 1000} });
+
+    starling_base_options_test opt;
+    opt.referenceFilename = reference.name();
+    const starling_base_deriv_options dopt(opt);
+    ReferenceSegmentCache cache(opt, dopt);
+
+    // nearby and overlapping regions are read in one group, regions separated by a large gap are not:
+    checkRegionList(opt, dopt, cache, "chr1", { {0,100}, {50,300}, {5000,6000}, {100000,101000} });
+
+    // groups are limited in size, and regions are truncated at the contig end:
+    std::vector<known_pos_range2> refRanges;
+    for (unsigned regionIndex(0); regionIndex < 7; ++regionIndex)
+    {
+        const pos_t beginPos(regionIndex*900000);
+        refRanges.emplace_back(beginPos, beginPos+1000000);
+    }
+    checkRegionList(opt, dopt, cache, "chr1", refRanges);
+
+    // the cache is reset for a new chromosome:
+    checkRegionList(opt, dopt, cache, "chr2", { {0,10}, {900,1100} });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
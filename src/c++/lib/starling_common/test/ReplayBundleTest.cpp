@@ -0,0 +1,86 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "starling_common/ReplayBundle.hh"
+#include "test/TempPath.hh"
+
+#include "boost/test/unit_test.hpp"
+
+#include <fstream>
+
+
+BOOST_AUTO_TEST_SUITE( ReplayBundle_test_suite )
+
+
+/// Temporary bundle directory with a germline bundle arguments file
+struct TempBundleDir
+{
+    TempBundleDir()
+        : dir("replayBundle-%%%%-%%%%")
+    {
+        std::ofstream argsStream(dir.getFilename("args.txt"));
+        argsStream << "germline\n--ref\n@BUNDLE_DIR@/reference.fa\n--stats-file\n@BUNDLE_DIR@/replay/stats.xml\n"
+                   << "--region\nchr1:1-100\n";
+    }
+
+    const TempDir dir;
+};
+
+
+static
+std::vector<std::string>
+getArgs(ReplayBundleCommandLine& commandLine)
+{
+    return std::vector<std::string>(commandLine.argv(), commandLine.argv() + commandLine.argc());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_noBundle )
+{
+    std::vector<std::string> args = { "starling2", "--region", "chr1:1-100" };
+    std::vector<char*> argv;
+    for (auto& arg : args) argv.push_back(&arg[0]);
+
+    ReplayBundleCommandLine commandLine(false, argv.size(), argv.data());
+    BOOST_REQUIRE(getArgs(commandLine) == args);
+}
+
+
+BOOST_AUTO_TEST_CASE( test_bundleArgs )
+{
+    const TempBundleDir bundleDir;
+    const std::string bundlePath(bundleDir.dir.name());
+
+    std::vector<std::string> args = { "starling2", "--stats-file", "stats.xml", "--replay-bundle", bundlePath };
+    std::vector<char*> argv;
+    for (auto& arg : args) argv.push_back(&arg[0]);
+
+    // bundle paths are expanded, and the stats file option given on the command line replaces the bundle option:
+    ReplayBundleCommandLine commandLine(false, argv.size(), argv.data());
+    const std::vector<std::string> expectArgs = { "starling2", "--ref", bundlePath + "/reference.fa", "--region",
+                                                  "chr1:1-100", "--stats-file", "stats.xml"
+                                                };
+    BOOST_REQUIRE(getArgs(commandLine) == expectArgs);
+    BOOST_REQUIRE(commandLine.argv()[commandLine.argc()] == nullptr);
+
+    // the bundle calling mode must match:
+    BOOST_REQUIRE_THROW(ReplayBundleCommandLine(true, argv.size(), argv.data()), std::exception);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
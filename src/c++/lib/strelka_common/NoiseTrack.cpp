@@ -0,0 +1,302 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "NoiseTrack.hh"
+
+#include "TrackFileUtil.hh"
+
+#include "common/Exceptions.hh"
+
+#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+#include <sstream>
+
+
+static const char headerMagic[8] = {'S','T','R','K','N','O','I','S'};
+static const char trailerMagic[8] = {'S','T','R','K','N','I','D','X'};
+static const uint32_t formatVersion(1);
+static const uint32_t byteOrderMark(0x01020304);
+
+const unsigned NoiseTrackWriter::maxBlockSiteCount(4096);
+
+
+
+static
+void
+throwTrackError(
+    const std::string& filename,
+    const char* msg)
+{
+    using namespace illumina::common;
+    std::ostringstream oss;
+    oss << "Noise track file '" << filename << "': " << msg;
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+}
+
+
+
+NoiseTrackWriter::
+NoiseTrackWriter(
+    const std::string& filename)
+    : _filename(filename),
+      _ofs(filename, std::ios::binary)
+{
+    if (not _ofs) throwTrackError(filename, "can't open file for writing");
+
+    _ofs.write(headerMagic, sizeof(headerMagic));
+    writeTrackValue(_ofs, formatVersion);
+    writeTrackValue(_ofs, byteOrderMark);
+}
+
+
+
+void
+NoiseTrackWriter::
+addSite(
+    const std::string& chrom,
+    const pos_t pos,
+    const SiteNoise& sn)
+{
+    assert(not _isClosed);
+    assert(pos >= 0);
+
+    if (chrom != _chrom)
+    {
+        writeBlock();
+        for (const auto& chromIndex : _index)
+        {
+            if (chromIndex.first == chrom)
+            {
+                std::ostringstream oss;
+                oss << "sites from chromosome '" << chrom << "' are not contiguous in the input";
+                throwTrackError(_filename, oss.str().c_str());
+            }
+        }
+        _chrom = chrom;
+        _index.emplace_back(chrom, std::vector<BlockInfo>());
+    }
+
+    if (not _blockSites.empty())
+    {
+        const pos_t lastPos(_blockSites.back().first);
+        if (pos < lastPos)
+        {
+            std::ostringstream oss;
+            oss << "sites are not sorted at position " << chrom << ":" << (pos+1);
+            throwTrackError(_filename, oss.str().c_str());
+        }
+        if (pos == lastPos)
+        {
+            _blockSites.back().second = sn;
+            return;
+        }
+    }
+    else if ((not _index.back().second.empty()) && (pos <= _index.back().second.back().lastPos))
+    {
+        // check order and duplicates against the previous block of this chromosome:
+        std::ostringstream oss;
+        oss << "sites are not sorted at position " << chrom << ":" << (pos+1);
+        throwTrackError(_filename, oss.str().c_str());
+    }
+
+    _blockSites.emplace_back(pos, sn);
+    if (_blockSites.size() >= maxBlockSiteCount) writeBlock();
+}
+
+
+
+void
+NoiseTrackWriter::
+writeBlock()
+{
+    if (_blockSites.empty()) return;
+
+    std::vector<unsigned char> payload;
+    appendTrackVarint(_blockSites.size(), payload);
+    pos_t previousPos(_blockSites.front().first);
+    for (const auto& site : _blockSites)
+    {
+        appendTrackVarint(site.first - previousPos, payload);
+        appendTrackVarint(site.second.total, payload);
+        appendTrackVarint(site.second.noise, payload);
+        appendTrackVarint(site.second.noise2, payload);
+        previousPos = site.first;
+    }
+
+    BlockInfo block;
+    block.firstPos = _blockSites.front().first;
+    block.lastPos = _blockSites.back().first;
+    block.offset = _ofs.tellp();
+    _index.back().second.push_back(block);
+
+    if (not writeCompressedTrackBlock(payload, _ofs))
+    {
+        throwTrackError(_filename, "block compression failed");
+    }
+
+    _blockSites.clear();
+}
+
+
+
+void
+NoiseTrackWriter::
+close()
+{
+    if (_isClosed) return;
+    writeBlock();
+
+    const uint64_t indexOffset(_ofs.tellp());
+    writeTrackValue(_ofs, static_cast<uint32_t>(_index.size()));
+    for (const auto& chromIndex : _index)
+    {
+        writeTrackValue(_ofs, static_cast<uint32_t>(chromIndex.first.size()));
+        _ofs.write(chromIndex.first.data(), chromIndex.first.size());
+        writeTrackValue(_ofs, static_cast<uint32_t>(chromIndex.second.size()));
+        for (const BlockInfo& block : chromIndex.second)
+        {
+            writeTrackValue(_ofs, block.firstPos);
+            writeTrackValue(_ofs, block.lastPos);
+            writeTrackValue(_ofs, block.offset);
+        }
+    }
+
+    writeTrackValue(_ofs, indexOffset);
+    _ofs.write(trailerMagic, sizeof(trailerMagic));
+    _ofs.close();
+    if (not _ofs) throwTrackError(_filename, "failed to write file");
+    _isClosed = true;
+}
+
+
+
+NoiseTrackReader::
+NoiseTrackReader(
+    const std::string& filename)
+    : _filename(filename),
+      _ifs(filename, std::ios::binary)
+{
+    if (not _ifs) throwTrackError(filename, "can't open file");
+
+    char magic[8];
+    uint32_t version(0);
+    uint32_t bom(0);
+    _ifs.read(magic, sizeof(magic));
+    readTrackValue(_ifs, version);
+    readTrackValue(_ifs, bom);
+    if ((not _ifs) || (0 != std::memcmp(magic, headerMagic, sizeof(magic))))
+    {
+        throwTrackError(filename, "not a noise track file");
+    }
+    if (version != formatVersion) throwTrackError(filename, "unsupported noise track format version");
+    if (bom != byteOrderMark) throwTrackError(filename, "noise track was written with a different byte order");
+
+    // read the trailer and index:
+    static const uint64_t headerSize(sizeof(headerMagic) + sizeof(formatVersion) + sizeof(byteOrderMark));
+    static const uint64_t trailerSize(sizeof(_indexOffset) + sizeof(trailerMagic));
+    _ifs.seekg(0, std::ios::end);
+    const std::streamoff fileSize(_ifs.tellg());
+    if ((not _ifs) || (fileSize < static_cast<std::streamoff>(headerSize + trailerSize)))
+    {
+        throwTrackError(filename, "missing index trailer, the file may be truncated");
+    }
+    const uint64_t indexEndOffset(fileSize - trailerSize);
+    _ifs.seekg(indexEndOffset);
+    readTrackValue(_ifs, _indexOffset);
+    _ifs.read(magic, sizeof(magic));
+    if ((not _ifs) || (0 != std::memcmp(magic, trailerMagic, sizeof(magic))))
+    {
+        throwTrackError(filename, "missing index trailer, the file may be truncated");
+    }
+
+    if (not readTrackIndex(_ifs, headerSize, _indexOffset, indexEndOffset, _index))
+    {
+        throwTrackError(filename, "corrupt or truncated index");
+    }
+}
+
+
+
+void
+NoiseTrackReader::
+readBlock(
+    const BlockInfo& block,
+    NoiseTrackSites& blockSites)
+{
+    blockSites.clear();
+
+    _ifs.seekg(block.offset);
+    if (not readCompressedTrackBlock(_ifs, (_indexOffset - block.offset), _compressedBuffer, _blockBuffer))
+    {
+        throwTrackError(_filename, "unexpected end of block or block decompression failed");
+    }
+
+    const unsigned char* ptr(_blockBuffer.data());
+    const unsigned char* endPtr(ptr + _blockBuffer.size());
+    uint64_t siteCount(0);
+    bool isValid(readTrackVarint(ptr, endPtr, siteCount));
+    pos_t pos(block.firstPos);
+    for (uint64_t siteIndex(0); isValid && (siteIndex < siteCount); ++siteIndex)
+    {
+        uint64_t delta(0), total(0), noise(0), noise2(0);
+        isValid = (readTrackVarint(ptr, endPtr, delta) && readTrackVarint(ptr, endPtr, total) &&
+                   readTrackVarint(ptr, endPtr, noise) && readTrackVarint(ptr, endPtr, noise2));
+        pos += delta;
+        SiteNoise sn;
+        sn.total = total;
+        sn.noise = noise;
+        sn.noise2 = noise2;
+        blockSites.emplace_back(pos, sn);
+    }
+    if (not isValid) throwTrackError(_filename, "corrupt block");
+}
+
+
+
+void
+NoiseTrackReader::
+getRegionSites(
+    const std::string& chrom,
+    const known_pos_range2& range,
+    NoiseTrackSites& sites)
+{
+    sites.clear();
+
+    const auto chromIter(_index.find(chrom));
+    if (chromIter == _index.end()) return;
+    const std::vector<BlockInfo>& blocks(chromIter->second);
+
+    // find the first block which could intersect the range:
+    auto blockIter(std::lower_bound(blocks.begin(), blocks.end(), range.begin_pos(),
+                                    [](const BlockInfo& block, const pos_t pos)
+    {
+        return (block.lastPos < pos);
+    }));
+
+    for (; blockIter != blocks.end(); ++blockIter)
+    {
+        if (blockIter->firstPos >= range.end_pos()) break;
+        readBlock(*blockIter, _blockSites);
+        for (const auto& site : _blockSites)
+        {
+            if (range.is_pos_intersect(site.first)) sites.push_back(site);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Binary block-compressed noise track format
+///
+/// A noise track holds the per-site noise summary of a noise panel in a compact form which can be range-queried
+/// directly, as an alternative to parsing every record of the panel VCF.
+///
+/// The file is written in native byte order and is laid out as:
+/// 1. header: magic, format version and byte order mark
+/// 2. a series of blocks, each holding up to maxBlockSiteCount consecutive sites from one chromosome. Each block is
+///    stored as its uncompressed and compressed sizes followed by the zlib compressed block payload. The payload
+///    contains the site count, then for each site the position delta from the previous site in the block (or
+///    from the block's first position) followed by the SiteNoise counts, all as LEB128 variable length integers.
+/// 3. index: for each chromosome the name followed by the first position, last position and file offset of each
+///    block
+/// 4. trailer: the file offset of the index and a final magic value
+///
+
+#pragma once
+
+#include "strelka_common/SiteNoise.hh"
+#include "strelka_common/TrackFileUtil.hh"
+#include "blt_util/blt_types.hh"
+#include "blt_util/known_pos_range2.hh"
+
+#include "boost/utility.hpp"
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/// Noise track sites are returned as (zero-indexed position, site noise) pairs sorted by position
+typedef std::vector<std::pair<pos_t, SiteNoise>> NoiseTrackSites;
+
+
+
+/// \brief Write a binary noise track
+///
+/// Sites must be added in position order for each chromosome, and all sites of one chromosome must be added
+/// together. If a site is added twice at the same position the last value is kept.
+///
+struct NoiseTrackWriter : private boost::noncopyable
+{
+    explicit
+    NoiseTrackWriter(
+        const std::string& filename);
+
+    /// \param pos zero-indexed site position
+    void
+    addSite(
+        const std::string& chrom,
+        const pos_t pos,
+        const SiteNoise& sn);
+
+    /// Write any remaining sites and the index, this must be called to produce a valid track
+    void
+    close();
+
+    static const unsigned maxBlockSiteCount;
+
+private:
+    void
+    writeBlock();
+
+    struct BlockInfo
+    {
+        pos_t firstPos;
+        pos_t lastPos;
+        uint64_t offset;
+    };
+
+    std::string _filename;
+    std::ofstream _ofs;
+
+    /// chromosome block index in the order chromosomes were written
+    std::vector<std::pair<std::string, std::vector<BlockInfo>>> _index;
+
+    std::string _chrom;
+    NoiseTrackSites _blockSites;
+    bool _isClosed = false;
+};
+
+
+
+/// \brief Range query access to a binary noise track
+///
+struct NoiseTrackReader : private boost::noncopyable
+{
+    explicit
+    NoiseTrackReader(
+        const std::string& filename);
+
+    /// \brief Get all sites of \p chrom in \p range
+    ///
+    /// \param[out] sites sites in range sorted by position, empty if \p chrom is not in the track
+    void
+    getRegionSites(
+        const std::string& chrom,
+        const known_pos_range2& range,
+        NoiseTrackSites& sites);
+
+    const std::string&
+    getFilename() const
+    {
+        return _filename;
+    }
+
+private:
+    typedef TrackBlockInfo BlockInfo;
+
+    void
+    readBlock(
+        const BlockInfo& block,
+        NoiseTrackSites& blockSites);
+
+    std::string _filename;
+    std::ifstream _ifs;
+    TrackIndex _index;
+
+    /// file offset of the block index, blocks end before this offset
+    uint64_t _indexOffset = 0;
+
+    /// reused buffers for block decompression:
+    std::vector<unsigned char> _compressedBuffer;
+    std::vector<unsigned char> _blockBuffer;
+    NoiseTrackSites _blockSites;
+};
@@ -25,6 +25,8 @@
 
 #include "starling_common/SampleSetSummary.hh"
 
+#include <cassert>
+
 
 namespace STRELKA_SAMPLE_TYPE
 {
@@ -59,26 +61,51 @@ get_char_label(const unsigned i)
         return '?';
     }
 }
+
+/// \return the sample index of tumor \p tumorSampleIndex out of the (possibly several) tumors called against the normal
+inline
+unsigned
+getTumorSampleIndex(
+    const unsigned tumorSampleIndex)
+{
+    return (TUMOR + tumorSampleIndex);
+}
 }
 
 
 // same thing, but easier to pass around as an argument:
 //
+// In multi-tumor mode each additional tumor sample follows the first at sample index
+// STRELKA_SAMPLE_TYPE::getTumorSampleIndex(tumorSampleIndex), and shares the TUMOR label and prefix.
+//
 struct StrelkaSampleSetSummary : public SampleSetSummary
 {
-    StrelkaSampleSetSummary() : SampleSetSummary() {}
+    explicit
+    StrelkaSampleSetSummary(
+        const unsigned tumorSampleCount = 1)
+        : SampleSetSummary()
+        , _tumorSampleCount(tumorSampleCount)
+    {
+        assert(_tumorSampleCount > 0);
+    }
 
     unsigned
     size() const override
     {
-        return STRELKA_SAMPLE_TYPE::SIZE;
+        return STRELKA_SAMPLE_TYPE::TUMOR + _tumorSampleCount;
+    }
+
+    unsigned
+    getTumorSampleCount() const
+    {
+        return _tumorSampleCount;
     }
 
     const char*
     get_label(
         const unsigned i) const override
     {
-        return STRELKA_SAMPLE_TYPE::get_label(i);
+        return STRELKA_SAMPLE_TYPE::get_label(getSampleType(i));
     }
 
     const char*
@@ -88,7 +115,7 @@ struct StrelkaSampleSetSummary : public SampleSetSummary
     {
         using namespace STRELKA_SAMPLE_TYPE;
 
-        switch (static_cast<index_t>(i))
+        switch (static_cast<index_t>(getSampleType(i)))
         {
         case NORMAL:
             return (is_tier1 ? "n1-" : "n2-");
@@ -98,4 +125,16 @@ struct StrelkaSampleSetSummary : public SampleSetSummary
             return "?" "?-";
         }
     }
+
+private:
+    /// \return the sample type of sample index \p i, mapping all tumor samples to TUMOR
+    unsigned
+    getSampleType(
+        const unsigned i) const
+    {
+        using namespace STRELKA_SAMPLE_TYPE;
+        return (((i > TUMOR) and (i < size())) ? static_cast<unsigned>(TUMOR) : i);
+    }
+
+    unsigned _tumorSampleCount;
 };
@@ -0,0 +1,175 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "TrackFileUtil.hh"
+
+#include "zlib.h"
+
+#include <algorithm>
+
+
+/// size of the uncompressed and compressed size fields at the start of each block
+static const uint64_t blockSizeFieldsSize(2*sizeof(uint32_t));
+
+
+
+void
+appendTrackVarint(
+    uint64_t val,
+    std::vector<unsigned char>& buffer)
+{
+    while (val >= 0x80)
+    {
+        buffer.push_back(static_cast<unsigned char>(val | 0x80));
+        val >>= 7;
+    }
+    buffer.push_back(static_cast<unsigned char>(val));
+}
+
+
+
+bool
+readTrackVarint(
+    const unsigned char*& ptr,
+    const unsigned char* endPtr,
+    uint64_t& val)
+{
+    val = 0;
+    for (unsigned shift(0); ptr < endPtr; shift += 7)
+    {
+        const unsigned char byte(*ptr++);
+        val |= (static_cast<uint64_t>(byte & 0x7F) << shift);
+        if (not (byte & 0x80)) return true;
+        if (shift > 56) return false;
+    }
+    return false;
+}
+
+
+
+bool
+writeCompressedTrackBlock(
+    const std::vector<unsigned char>& payload,
+    std::ostream& os)
+{
+    uLongf compressedSize(compressBound(payload.size()));
+    std::vector<unsigned char> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, payload.data(), payload.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+        return false;
+    }
+
+    writeTrackValue(os, static_cast<uint32_t>(payload.size()));
+    writeTrackValue(os, static_cast<uint32_t>(compressedSize));
+    os.write(reinterpret_cast<const char*>(compressed.data()), compressedSize);
+    return true;
+}
+
+
+
+bool
+readCompressedTrackBlock(
+    std::istream& is,
+    const uint64_t maxBlockSize,
+    std::vector<unsigned char>& compressedBuffer,
+    std::vector<unsigned char>& payload)
+{
+    // zlib cannot compress by more than this factor:
+    static const uint64_t maxCompressionRatio(1032);
+
+    uint32_t payloadSize(0);
+    uint32_t compressedSize(0);
+    readTrackValue(is, payloadSize);
+    readTrackValue(is, compressedSize);
+    if (not is) return false;
+    if (compressedSize > (maxBlockSize - std::min(maxBlockSize, blockSizeFieldsSize))) return false;
+    if (payloadSize > (compressedSize * maxCompressionRatio)) return false;
+    compressedBuffer.resize(compressedSize);
+    is.read(reinterpret_cast<char*>(compressedBuffer.data()), compressedSize);
+    if (not is) return false;
+
+    payload.resize(payloadSize);
+    uLongf uncompressedSize(payloadSize);
+    return ((uncompress(payload.data(), &uncompressedSize, compressedBuffer.data(), compressedSize) == Z_OK) &&
+            (uncompressedSize == payloadSize));
+}
+
+
+
+/// \return the number of bytes between the current position of \p is and \p endOffset
+static
+uint64_t
+getRemainingSize(
+    std::istream& is,
+    const uint64_t endOffset)
+{
+    const std::streamoff pos(is.tellg());
+    if ((pos < 0) || (static_cast<uint64_t>(pos) > endOffset)) return 0;
+    return (endOffset - pos);
+}
+
+
+
+bool
+readTrackIndex(
+    std::istream& is,
+    const uint64_t headerSize,
+    const uint64_t indexOffset,
+    const uint64_t indexEndOffset,
+    TrackIndex& index)
+{
+    static const uint64_t blockRecordSize(2*sizeof(pos_t) + sizeof(uint64_t));
+    static const uint64_t minChromRecordSize(2*sizeof(uint32_t));
+
+    index.clear();
+    if ((indexOffset < headerSize) || (indexOffset > indexEndOffset)) return false;
+
+    is.seekg(indexOffset);
+    uint32_t chromCount(0);
+    readTrackValue(is, chromCount);
+    if ((not is) || (chromCount > (getRemainingSize(is, indexEndOffset) / minChromRecordSize))) return false;
+
+    for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex)
+    {
+        uint32_t nameSize(0);
+        readTrackValue(is, nameSize);
+        if ((not is) || (nameSize > getRemainingSize(is, indexEndOffset))) return false;
+        std::string chrom(nameSize, '\0');
+        is.read(&chrom[0], nameSize);
+
+        uint32_t blockCount(0);
+        readTrackValue(is, blockCount);
+        if ((not is) || (blockCount > (getRemainingSize(is, indexEndOffset) / blockRecordSize))) return false;
+        if (index.count(chrom)) return false;
+
+        std::vector<TrackBlockInfo>& blocks(index[chrom]);
+        blocks.resize(blockCount);
+        for (unsigned blockIndex(0); blockIndex < blockCount; ++blockIndex)
+        {
+            TrackBlockInfo& block(blocks[blockIndex]);
+            readTrackValue(is, block.firstPos);
+            readTrackValue(is, block.lastPos);
+            readTrackValue(is, block.offset);
+            if (not is) return false;
+            if ((block.firstPos < 0) || (block.lastPos < block.firstPos)) return false;
+            if ((blockIndex > 0) && (block.firstPos <= blocks[blockIndex-1].lastPos)) return false;
+            if ((block.offset < headerSize) || (block.offset > (indexOffset - blockSizeFieldsSize))) return false;
+        }
+    }
+    return (getRemainingSize(is, indexEndOffset) == 0);
+}
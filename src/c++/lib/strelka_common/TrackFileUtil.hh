@@ -0,0 +1,133 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+/// \file
+/// \brief Low-level helpers shared by the binary block-compressed track formats
+///
+
+#pragma once
+
+#include "blt_util/blt_types.hh"
+
+#include <cstdint>
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/// write \p val to \p os in native byte order
+template <typename T>
+void
+writeTrackValue(
+    std::ostream& os,
+    const T& val)
+{
+    os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+
+
+/// read \p val from \p is in native byte order
+template <typename T>
+void
+readTrackValue(
+    std::istream& is,
+    T& val)
+{
+    is.read(reinterpret_cast<char*>(&val), sizeof(T));
+}
+
+
+
+/// append \p val to \p buffer as a LEB128 variable length integer
+void
+appendTrackVarint(
+    uint64_t val,
+    std::vector<unsigned char>& buffer);
+
+
+
+/// read a LEB128 variable length integer from \p ptr, advancing \p ptr past the value
+///
+/// \return false if the buffer ends before the value is complete
+bool
+readTrackVarint(
+    const unsigned char*& ptr,
+    const unsigned char* endPtr,
+    uint64_t& val);
+
+
+
+/// write \p payload to \p os as its uncompressed and compressed sizes followed by the zlib compressed payload
+///
+/// \return false if compression fails
+bool
+writeCompressedTrackBlock(
+    const std::vector<unsigned char>& payload,
+    std::ostream& os);
+
+
+
+/// read a block written by writeCompressedTrackBlock from the current position of \p is
+///
+/// \param[in] maxBlockSize number of bytes available to the block in the file, the block sizes are checked against
+///                         this before any buffers are allocated
+/// \param[in,out] compressedBuffer reusable buffer for the compressed block
+/// \param[out] payload uncompressed block payload
+/// \return false if the block is truncated, its sizes are invalid or decompression fails
+bool
+readCompressedTrackBlock(
+    std::istream& is,
+    const uint64_t maxBlockSize,
+    std::vector<unsigned char>& compressedBuffer,
+    std::vector<unsigned char>& payload);
+
+
+
+/// Position range and file offset of one compressed block of a track
+struct TrackBlockInfo
+{
+    pos_t firstPos;
+    pos_t lastPos;
+    uint64_t offset;
+};
+
+/// Blocks of each chromosome in a track, sorted by position
+typedef std::map<std::string, std::vector<TrackBlockInfo>> TrackIndex;
+
+
+
+/// \brief Read the chromosome block index written at \p indexOffset of a track file
+///
+/// All counts and sizes in the index are checked against the file size before they are used to allocate memory, and
+/// each block is checked to be sorted and to fall between the file header and the index.
+///
+/// \param[in] headerSize size of the file header which precedes the first block
+/// \param[in] indexEndOffset file offset where the index ends
+/// \param[out] index block index of each chromosome
+/// \return false if the index is truncated or inconsistent
+bool
+readTrackIndex(
+    std::istream& is,
+    const uint64_t headerSize,
+    const uint64_t indexOffset,
+    const uint64_t indexEndOffset,
+    TrackIndex& index);
@@ -0,0 +1,224 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "strelka_common/NoiseTrack.hh"
+#include "common/Exceptions.hh"
+#include "test/TempPath.hh"
+
+#include <cstring>
+
+#include <fstream>
+#include <iterator>
+
+
+BOOST_AUTO_TEST_SUITE( NoiseTrack_test )
+
+
+static
+SiteNoise
+getSiteNoise(
+    const unsigned total,
+    const unsigned noise,
+    const unsigned noise2)
+{
+    SiteNoise sn;
+    sn.total = total;
+    sn.noise = noise;
+    sn.noise2 = noise2;
+    return sn;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_NoiseTrack_roundtrip )
+{
+    const TempFile trackFile("noiseTrack-%%%%-%%%%.bin");
+
+    // write enough sites to fill several blocks on the first chromosome:
+    const unsigned chr1SiteCount(NoiseTrackWriter::maxBlockSiteCount*2 + 10);
+    {
+        NoiseTrackWriter writer(trackFile.name());
+        for (unsigned siteIndex(0); siteIndex < chr1SiteCount; ++siteIndex)
+        {
+            writer.addSite("chr1", siteIndex*3, getSiteNoise(100, siteIndex%100, siteIndex%7));
+        }
+        writer.addSite("chr2", 1000, getSiteNoise(10, 1, 0));
+        // a repeated position replaces the previous site:
+        writer.addSite("chr2", 1000, getSiteNoise(10, 2, 1));
+        writer.addSite("chr2", 70000, getSiteNoise(20, 3, 2));
+        writer.close();
+    }
+
+    NoiseTrackReader reader(trackFile.name());
+    NoiseTrackSites sites;
+
+    // query a range spanning a block boundary:
+    const pos_t beginPos((NoiseTrackWriter::maxBlockSiteCount-5)*3);
+    reader.getRegionSites("chr1", known_pos_range2(beginPos, beginPos+31), sites);
+    BOOST_REQUIRE_EQUAL(sites.size(), 11u);
+    for (unsigned siteIndex(0); siteIndex < sites.size(); ++siteIndex)
+    {
+        const unsigned expectedSiteIndex(NoiseTrackWriter::maxBlockSiteCount-5+siteIndex);
+        BOOST_REQUIRE_EQUAL(sites[siteIndex].first, static_cast<pos_t>(expectedSiteIndex*3));
+        BOOST_REQUIRE_EQUAL(sites[siteIndex].second.total, 100u);
+        BOOST_REQUIRE_EQUAL(sites[siteIndex].second.noise, expectedSiteIndex%100);
+        BOOST_REQUIRE_EQUAL(sites[siteIndex].second.noise2, expectedSiteIndex%7);
+    }
+
+    reader.getRegionSites("chr1", known_pos_range2(0, chr1SiteCount*3), sites);
+    BOOST_REQUIRE_EQUAL(sites.size(), chr1SiteCount);
+
+    reader.getRegionSites("chr2", known_pos_range2(0, 70000), sites);
+    BOOST_REQUIRE_EQUAL(sites.size(), 1u);
+    BOOST_REQUIRE_EQUAL(sites[0].first, 1000);
+    BOOST_REQUIRE_EQUAL(sites[0].second.noise, 2u);
+    BOOST_REQUIRE_EQUAL(sites[0].second.noise2, 1u);
+
+    reader.getRegionSites("chr3", known_pos_range2(0, 70000), sites);
+    BOOST_REQUIRE(sites.empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_NoiseTrack_unsorted_input )
+{
+    const TempFile trackFile("noiseTrack-%%%%-%%%%.bin");
+
+    NoiseTrackWriter writer(trackFile.name());
+    writer.addSite("chr1", 1000, getSiteNoise(10, 1, 0));
+    BOOST_REQUIRE_THROW(writer.addSite("chr1", 999, getSiteNoise(10, 1, 0)), illumina::common::GeneralException);
+
+    writer.addSite("chr2", 10, getSiteNoise(10, 1, 0));
+    BOOST_REQUIRE_THROW(writer.addSite("chr1", 2000, getSiteNoise(10, 1, 0)), illumina::common::GeneralException);
+}
+
+
+static
+std::string
+readFileContents(
+    const std::string& filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+
+static
+void
+writeFileContents(
+    const std::string& filename,
+    const std::string& contents)
+{
+    std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+    ofs.write(contents.data(), contents.size());
+}
+
+
+/// \return a copy of \p contents with the value at \p offset replaced by \p val
+template <typename T>
+static
+std::string
+getPatchedContents(
+    std::string contents,
+    const uint64_t offset,
+    const T val)
+{
+    BOOST_REQUIRE_LE(offset + sizeof(T), contents.size());
+    std::memcpy(&contents[offset], &val, sizeof(T));
+    return contents;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_NoiseTrack_corrupt_file )
+{
+    using namespace illumina::common;
+
+    const TempFile trackFile("noiseTrack-%%%%-%%%%.bin");
+    {
+        NoiseTrackWriter writer(trackFile.name());
+        writer.addSite("chr1", 10, getSiteNoise(10, 1, 0));
+        writer.addSite("chr1", 20, getSiteNoise(10, 2, 0));
+        writer.addSite("chr2", 30, getSiteNoise(10, 3, 1));
+        writer.close();
+    }
+    const std::string contents(readFileContents(trackFile.name()));
+    const known_pos_range2 range(0, 100);
+    NoiseTrackSites sites;
+
+    // every truncated file is rejected when it is opened:
+    for (unsigned size(0); size < contents.size(); ++size)
+    {
+        writeFileContents(trackFile.name(), contents.substr(0, size));
+        BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+    }
+
+    // layout of the index: chromCount, then for each chromosome nameSize, name, blockCount and the block records
+    uint64_t indexOffset(0);
+    std::memcpy(&indexOffset, &contents[contents.size() - 16], sizeof(indexOffset));
+    const uint64_t chromCountOffset(indexOffset);
+    const uint64_t nameSizeOffset(chromCountOffset + sizeof(uint32_t));
+    const uint64_t blockCountOffset(nameSizeOffset + sizeof(uint32_t) + 4);
+    const uint64_t blockOffsetOffset(blockCountOffset + sizeof(uint32_t) + 2*sizeof(pos_t));
+
+    // counts and sizes which do not fit in the file are rejected before they are used:
+    for (const uint32_t badCount : { 3u, 1000u, 0xFFFFFFFFu })
+    {
+        writeFileContents(trackFile.name(), getPatchedContents(contents, chromCountOffset, badCount));
+        BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+        writeFileContents(trackFile.name(), getPatchedContents(contents, nameSizeOffset, badCount));
+        BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+        writeFileContents(trackFile.name(), getPatchedContents(contents, blockCountOffset, badCount));
+        BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+    }
+
+    // a block offset outside of the block section is rejected:
+    for (const uint64_t badOffset : { uint64_t(0), indexOffset, ~uint64_t(0) })
+    {
+        writeFileContents(trackFile.name(), getPatchedContents(contents, blockOffsetOffset, badOffset));
+        BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+    }
+
+    // an index offset outside of the file is rejected:
+    writeFileContents(trackFile.name(), getPatchedContents(contents, contents.size() - 16, ~uint64_t(0)));
+    BOOST_REQUIRE_THROW(NoiseTrackReader reader(trackFile.name()), GeneralException);
+
+    // block sizes which do not fit before the index are rejected when the block is read:
+    const uint64_t blockOffset(16);
+    for (const uint32_t badSize : { 0xFFFFFFFFu, static_cast<uint32_t>(indexOffset) })
+    {
+        writeFileContents(trackFile.name(), getPatchedContents(contents, blockOffset + sizeof(uint32_t), badSize));
+        NoiseTrackReader reader(trackFile.name());
+        BOOST_REQUIRE_THROW(reader.getRegionSites("chr1", range, sites), GeneralException);
+    }
+    writeFileContents(trackFile.name(), getPatchedContents(contents, blockOffset, 0xFFFFFFFFu));
+    {
+        NoiseTrackReader reader(trackFile.name());
+        BOOST_REQUIRE_THROW(reader.getRegionSites("chr1", range, sites), GeneralException);
+    }
+
+    // the unmodified file is still readable:
+    writeFileContents(trackFile.name(), contents);
+    NoiseTrackReader reader(trackFile.name());
+    reader.getRegionSites("chr1", range, sites);
+    BOOST_REQUIRE_EQUAL(sites.size(), 2u);
+    reader.getRegionSites("chr2", range, sites);
+    BOOST_REQUIRE_EQUAL(sites.size(), 1u);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
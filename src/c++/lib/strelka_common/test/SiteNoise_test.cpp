@@ -19,7 +19,7 @@
 
 #include "boost/test/unit_test.hpp"
 
-#include "SiteNoise.hh"
+#include "strelka_common/SiteNoise.hh"
 
 
 BOOST_AUTO_TEST_SUITE( SiteNoise_test )
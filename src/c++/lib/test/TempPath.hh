@@ -0,0 +1,94 @@
+//
+// Strelka - Small Variant Caller
+// Copyright (c) 2009-2018 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Temporary files and directories for unit tests
+///
+
+#pragma once
+
+#include "boost/filesystem.hpp"
+#include "boost/utility.hpp"
+
+#include <string>
+
+
+/// \brief A unique path in the system temporary directory, the file at this path is removed when the test completes
+///
+/// The file itself is not created.
+///
+struct TempFile : private boost::noncopyable
+{
+    /// \param[in] model unique file name model, each '%' is replaced by a random hex digit
+    explicit
+    TempFile(const std::string& model = "strelkaTest-%%%%-%%%%")
+        : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(model))
+    {}
+
+    ~TempFile()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    }
+
+    std::string
+    name() const
+    {
+        return path.string();
+    }
+
+    const boost::filesystem::path path;
+};
+
+
+
+/// \brief A unique directory created in the system temporary directory, the directory and its contents are removed
+/// when the test completes
+///
+struct TempDir : private boost::noncopyable
+{
+    /// \param[in] model unique directory name model, each '%' is replaced by a random hex digit
+    explicit
+    TempDir(const std::string& model = "strelkaTest-%%%%-%%%%")
+        : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(model))
+    {
+        boost::filesystem::create_directories(path);
+    }
+
+    ~TempDir()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(path, ec);
+    }
+
+    std::string
+    name() const
+    {
+        return path.string();
+    }
+
+    /// \return path of the file called filename in this directory
+    std::string
+    getFilename(const std::string& filename) const
+    {
+        return (path / filename).string();
+    }
+
+    const boost::filesystem::path path;
+};
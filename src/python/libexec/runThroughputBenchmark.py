@@ -0,0 +1,747 @@
+#!/usr/bin/env python2
+#
+# Strelka - Small Variant Caller
+# Copyright (c) 2009-2018 Illumina, Inc.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+#
+"""
+End-to-end throughput benchmark for the germline and somatic variant callers
+
+Synthetic paired-end BAM files are simulated from the demo reference at a
+configurable depth, read length, variant density and indel/STR content. The
+starling2 and strelka2 binaries are then run directly on these files (without
+the pyflow workflow), and the reads/sec, bases/sec and peak RSS of each run are
+written to a JSON result file. If a baseline result file is given, the run fails
+when throughput or memory has regressed beyond the given tolerance.
+"""
+
+import os,sys
+
+scriptDir=os.path.abspath(os.path.dirname(__file__))
+pythonLibDir=os.path.abspath(os.path.join(scriptDir,"@THIS_RELATIVE_PYTHON_LIBDIR@"))
+sys.path.append(pythonLibDir)
+
+import bisect
+import json
+import random
+import re
+import subprocess
+import time
+
+from workflowUtil import checkDir, checkFile, ensureDir, exeFile
+
+
+
+def getOptions() :
+
+    from optparse import OptionParser
+
+    usage = "usage: %prog [options] --outputDir DIR"
+    parser = OptionParser(usage=usage, description=__doc__.strip())
+
+    defaultConfigDir=os.path.abspath(os.path.join(scriptDir,"@THIS_RELATIVE_CONFIGDIR@"))
+    defaultReferenceFasta=os.path.abspath(os.path.join(scriptDir,"@THIS_RELATIVE_DEMODIR@","strelka","data","demo20.fa"))
+
+    parser.add_option("--outputDir", type="string", metavar="DIR",
+                      help="directory for simulated input, caller output and the benchmark result (required)")
+    parser.add_option("--resultFile", type="string", metavar="FILE",
+                      help="JSON benchmark result file (default: OUTPUTDIR/throughputBenchmark.json)")
+    parser.add_option("--mode", type="choice", choices=["germline","somatic","all"], default="all",
+                      help="callers to benchmark: germline, somatic or all (default: %default)")
+    parser.add_option("--referenceFasta", type="string", metavar="FILE", default=defaultReferenceFasta,
+                      help="samtools-indexed reference fasta, only the first contig is used (default: %default)")
+    parser.add_option("--referenceTileCount", type="int", metavar="N", default=100,
+                      help="build the simulated contig from this many diverged copies of the reference contig, so that "
+                           "the small demo reference can be scaled to a useful benchmark size (default: %default)")
+    parser.add_option("--depth", type="float", default=30,
+                      help="mean read depth of each simulated sample (default: %default)")
+    parser.add_option("--readLength", type="int", default=100,
+                      help="simulated read length (default: %default)")
+    parser.add_option("--snvDensity", type="float", default=0.001,
+                      help="germline SNVs per reference base (default: %default)")
+    parser.add_option("--indelDensity", type="float", default=0.0002,
+                      help="germline indels per reference base (default: %default)")
+    parser.add_option("--strIndelFraction", type="float", default=0.5,
+                      help="fraction of indels placed in short tandem repeat tracts as repeat unit expansions or "
+                           "contractions (default: %default)")
+    parser.add_option("--somaticDensity", type="float", default=0.0001,
+                      help="somatic SNVs and indels per reference base in the tumor sample (default: %default)")
+    parser.add_option("--tumorPurity", type="float", default=0.6,
+                      help="tumor sample purity (default: %default)")
+    parser.add_option("--seed", type="int", default=1,
+                      help="random seed used for all simulated input (default: %default)")
+    parser.add_option("--repeatCount", type="int", default=1,
+                      help="run each caller this many times, reporting the fastest run time and the largest peak "
+                           "RSS (default: %default)")
+    parser.add_option("--baselineFile", type="string", metavar="FILE",
+                      help="JSON result file from a previous benchmark run with the same simulation parameters. If "
+                           "given, the benchmark fails if throughput or peak RSS have regressed relative to this "
+                           "baseline.")
+    parser.add_option("--maxThroughputLoss", type="float", default=0.1,
+                      help="maximum fractional reads/sec reduction relative to the baseline (default: %default)")
+    parser.add_option("--maxRssGrowth", type="float", default=0.1,
+                      help="maximum fractional peak RSS increase relative to the baseline (default: %default)")
+    parser.add_option("--libexecDir", type="string", metavar="DIR", default=scriptDir,
+                      help="directory containing the starling2, strelka2 and samtools binaries (default: %default)")
+    parser.add_option("--configDir", type="string", metavar="DIR", default=defaultConfigDir,
+                      help="directory containing the indel error and scoring model files (default: %default)")
+
+    (options,args) = parser.parse_args()
+
+    if len(args) != 0 :
+        parser.print_help()
+        sys.exit(2)
+
+    # validate input:
+    if options.outputDir is None :
+        parser.print_help()
+        sys.exit(2)
+
+    def checkRange(name, value, minValue, maxValue = None) :
+        if (value < minValue) or ((maxValue is not None) and (value > maxValue)) :
+            parser.error("Invalid --%s value: %s" % (name, str(value)))
+
+    checkRange("referenceTileCount", options.referenceTileCount, 1)
+    checkRange("depth", options.depth, 0.1)
+    checkRange("readLength", options.readLength, 30, 1000)
+    checkRange("snvDensity", options.snvDensity, 0, 0.05)
+    checkRange("indelDensity", options.indelDensity, 0, 0.05)
+    checkRange("strIndelFraction", options.strIndelFraction, 0, 1)
+    checkRange("somaticDensity", options.somaticDensity, 0, 0.05)
+    checkRange("tumorPurity", options.tumorPurity, 0, 1)
+    checkRange("repeatCount", options.repeatCount, 1)
+    checkRange("maxThroughputLoss", options.maxThroughputLoss, 0, 1)
+    checkRange("maxRssGrowth", options.maxRssGrowth, 0)
+
+    options.outputDir = os.path.abspath(options.outputDir)
+    if options.resultFile is None :
+        options.resultFile = os.path.join(options.outputDir, "throughputBenchmark.json")
+
+    checkFile(options.referenceFasta, "reference fasta")
+    checkFile(options.referenceFasta + ".fai", "reference fasta index")
+    checkDir(options.libexecDir, "libexec")
+    checkDir(options.configDir, "config")
+    if options.baselineFile is not None :
+        checkFile(options.baselineFile, "baseline result")
+
+    return (options,args)
+
+
+
+def getSimulationParameters(options) :
+    """
+    all options which change the simulated input, benchmark results are only comparable if these are the same
+    """
+    keys = ("referenceTileCount", "depth", "readLength", "snvDensity", "indelDensity", "strIndelFraction",
+            "somaticDensity", "tumorPurity", "seed")
+    params = dict((key, getattr(options, key)) for key in keys)
+    params["reference"] = os.path.basename(options.referenceFasta)
+    return params
+
+
+
+def readFirstFastaContig(fastaFile) :
+    """
+    return (name, sequence) for the first contig in fastaFile, with sequence in upper case
+    """
+    name = None
+    seq = []
+    for line in open(fastaFile) :
+        if line.startswith(">") :
+            if name is not None : break
+            name = line[1:].split()[0]
+            continue
+        seq.append(line.strip().upper())
+
+    if name is None :
+        raise Exception("No contig found in reference fasta '%s'" % (fastaFile))
+    return (name, "".join(seq))
+
+
+
+bases = "ACGT"
+
+
+def getOtherBase(rng, base) :
+    while True :
+        altBase = rng.choice(bases)
+        if altBase != base : return altBase
+
+
+def getRandomSequence(rng, length) :
+    return "".join(rng.choice(bases) for _ in range(length))
+
+
+def writeTiledReference(options, rng, contigName, contigSeq, fastaFile) :
+    """
+    write a reference containing a single contig built from diverged copies of contigSeq
+
+    Each copy has 1% of its bases substituted, so that reads from the simulated contig remain uniquely
+    placeable while keeping the repeat and GC content of the source contig.
+    """
+    tiles = []
+    for _ in range(options.referenceTileCount) :
+        tile = list(contigSeq)
+        for _ in range(len(tile) // 100) :
+            pos = rng.randrange(len(tile))
+            if tile[pos] in bases : tile[pos] = getOtherBase(rng, tile[pos])
+        tiles.append("".join(tile))
+    seq = "".join(tiles)
+
+    ofp = open(fastaFile, "w")
+    ofp.write(">%s\n" % (contigName))
+    lineSize = 60
+    for pos in range(0, len(seq), lineSize) :
+        ofp.write(seq[pos:pos+lineSize] + "\n")
+    ofp.close()
+
+    return seq
+
+
+
+def getStrTracts(seq, minTractLength = 8) :
+    """
+    return (start, unitLength, tractLength) for each homopolymer or dinucleotide tract in seq of at least
+    minTractLength bases
+    """
+    tracts = []
+    for unitLength in (1, 2) :
+        pos = 0
+        while pos + unitLength < len(seq) :
+            end = pos + unitLength
+            while (end < len(seq)) and (seq[end] == seq[end-unitLength]) :
+                end += 1
+            tractLength = end - pos
+            if (tractLength >= minTractLength) and ((unitLength == 1) or (seq[pos] != seq[pos+1])) :
+                tracts.append((pos, unitLength, tractLength - (tractLength % unitLength)))
+            pos = max(pos + 1, end - unitLength + 1)
+    return tracts
+
+
+
+class VariantSimulator(object) :
+    """
+    simulate non-overlapping SNVs and indels, each variant is a (pos, refLength, altSeq) tuple
+    """
+
+    def __init__(self, rng, refSeq) :
+        self.rng = rng
+        self.refSeq = refSeq
+        self.strTracts = getStrTracts(refSeq)
+        self.isUsed = bytearray(len(refSeq))
+
+
+    def _reserve(self, pos, refLength) :
+        """
+        reserve the reference range of a new variant plus one base of padding on each side
+        """
+        begin = max(0, pos - 1)
+        end = min(len(self.refSeq), pos + refLength + 1)
+        if (pos < 1) or (end >= len(self.refSeq)) : return False
+        if any(self.isUsed[begin:end]) : return False
+        for i in range(begin, end) : self.isUsed[i] = 1
+        return True
+
+
+    def _getSnv(self) :
+        pos = self.rng.randrange(len(self.refSeq))
+        refBase = self.refSeq[pos]
+        if refBase not in bases : return None
+        if not self._reserve(pos, 1) : return None
+        return (pos, 1, getOtherBase(self.rng, refBase))
+
+
+    def _getStrIndel(self) :
+        if len(self.strTracts) == 0 : return None
+        (start, unitLength, tractLength) = self.rng.choice(self.strTracts)
+        unitCount = self.rng.randint(1, 2)
+        indelLength = unitLength * unitCount
+        if (self.rng.random() < 0.5) and (indelLength < tractLength) :
+            variant = (start, indelLength, "")
+        else :
+            variant = (start, 0, self.refSeq[start:start+indelLength])
+        if not self._reserve(start, tractLength) : return None
+        return variant
+
+
+    def _getIndel(self, strFraction) :
+        if self.rng.random() < strFraction :
+            return self._getStrIndel()
+
+        indelLength = min(int(self.rng.expovariate(0.3)) + 1, 20)
+        pos = self.rng.randrange(len(self.refSeq))
+        if self.rng.random() < 0.5 :
+            variant = (pos, indelLength, "")
+        else :
+            variant = (pos, 0, getRandomSequence(self.rng, indelLength))
+        if not self._reserve(pos, variant[1]) : return None
+        return variant
+
+
+    def getVariants(self, snvDensity, indelDensity, strFraction) :
+        variants = []
+        maxAttempts = 10
+        for _ in range(int(snvDensity * len(self.refSeq))) :
+            for _ in range(maxAttempts) :
+                variant = self._getSnv()
+                if variant is not None :
+                    variants.append(variant)
+                    break
+        for _ in range(int(indelDensity * len(self.refSeq))) :
+            for _ in range(maxAttempts) :
+                variant = self._getIndel(strFraction)
+                if variant is not None :
+                    variants.append(variant)
+                    break
+        return variants
+
+
+
+class Haplotype(object) :
+    """
+    a haplotype sequence with the alignment of each haplotype segment to the reference
+
+    Each segment is (cigarOp, hapStart, hapLength, refStart, refLength). 'M' segments are aligned, and may
+    include SNVs, 'I' segments are inserted haplotype sequence, and 'D' segments are deleted reference
+    sequence with zero haplotype length.
+    """
+
+    def __init__(self, refSeq, variants) :
+        seq = []
+        self.segments = []
+        hapPos = 0
+        refPos = 0
+
+        def addSegment(op, hapLength, refLength) :
+            if (op == 'M') and (len(self.segments) > 0) and (self.segments[-1][0] == 'M') :
+                last = self.segments.pop()
+                self.segments.append(('M', last[1], last[2] + hapLength, last[3], last[4] + refLength))
+            else :
+                self.segments.append((op, hapPos, hapLength, refPos, refLength))
+
+        for (pos, refLength, altSeq) in sorted(variants) :
+            if pos > refPos :
+                seq.append(refSeq[refPos:pos])
+                addSegment('M', pos - refPos, pos - refPos)
+                hapPos += pos - refPos
+                refPos = pos
+            if (refLength == 1) and (len(altSeq) == 1) :
+                seq.append(altSeq)
+                addSegment('M', 1, 1)
+            elif refLength == 0 :
+                seq.append(altSeq)
+                addSegment('I', len(altSeq), 0)
+            else :
+                assert(len(altSeq) == 0)
+                addSegment('D', 0, refLength)
+            hapPos += len(altSeq)
+            refPos += refLength
+
+        if refPos < len(refSeq) :
+            seq.append(refSeq[refPos:])
+            addSegment('M', len(refSeq) - refPos, len(refSeq) - refPos)
+
+        self.seq = "".join(seq)
+        self.segmentHapStarts = [segment[1] for segment in self.segments]
+
+
+    def getAlignment(self, hapStart, length) :
+        """
+        return (refPos, cigarString) for the haplotype range [hapStart,hapStart+length), or None if the range
+        does not contain an aligned base
+
+        Insertions at either edge of the range are soft-clipped and deletions at either edge are dropped.
+        """
+        segmentIndex = bisect.bisect_right(self.segmentHapStarts, hapStart) - 1
+
+        cigar = []
+        refPos = None
+        hapPos = hapStart
+        hapEnd = hapStart + length
+        pendingDeletion = 0
+        while hapPos < hapEnd :
+            (op, segmentHapStart, segmentHapLength, segmentRefStart, segmentRefLength) = self.segments[segmentIndex]
+            segmentIndex += 1
+            if op == 'D' :
+                if refPos is not None : pendingDeletion += segmentRefLength
+                continue
+            overlap = min(hapEnd, segmentHapStart + segmentHapLength) - hapPos
+            if overlap <= 0 : continue
+            if op == 'M' :
+                if refPos is None :
+                    refPos = segmentRefStart + (hapPos - segmentHapStart)
+                if pendingDeletion > 0 :
+                    cigar.append((pendingDeletion, 'D'))
+                    pendingDeletion = 0
+            else :
+                op = 'I' if refPos is not None else 'S'
+            cigar.append((overlap, op))
+            hapPos += overlap
+
+        if refPos is None : return None
+
+        # convert a trailing insertion to a soft-clip:
+        if cigar[-1][1] == 'I' :
+            cigar[-1] = (cigar[-1][0], 'S')
+        return (refPos, "".join("%i%s" % opLength for opLength in cigar))
+
+
+
+
+
+def getAlignmentRefEnd(refPos, cigar) :
+    """
+    return the reference end position of an alignment
+    """
+    for (length, op) in re.findall(r"(\d+)([MIDS])", cigar) :
+        if op in "MD" : refPos += int(length)
+    return refPos
+
+
+
+def simulateSample(options, rng, samtoolsBin, contigName, refSeq, haplotypeWeights, sampleName, bamFile) :
+    """
+    simulate a coordinate sorted and indexed paired-end BAM file from a set of weighted haplotypes
+
+    \\return the number of simulated reads
+    """
+    readLength = options.readLength
+    fragmentMean = max(readLength + 50, 350)
+    fragmentSd = 50
+    basecallErrorRate = 0.002
+    qual = chr(33 + 35)
+    errorQual = chr(33 + 12)
+
+    totalWeight = float(sum(weight for (_, weight) in haplotypeWeights))
+    cumulativeWeights = []
+    cumulativeWeight = 0.0
+    for (_, weight) in haplotypeWeights :
+        cumulativeWeight += weight / totalWeight
+        cumulativeWeights.append(cumulativeWeight)
+
+    def getRead(seq) :
+        seq = list(seq)
+        quals = [qual] * len(seq)
+        pos = int(rng.expovariate(basecallErrorRate))
+        while pos < len(seq) :
+            seq[pos] = getOtherBase(rng, seq[pos])
+            quals[pos] = errorQual
+            pos += 1 + int(rng.expovariate(basecallErrorRate))
+        return ("".join(seq), "".join(quals))
+
+    pairCount = int(options.depth * len(refSeq) / (2 * readLength))
+    records = []
+    for pairIndex in range(pairCount) :
+        haplotypeIndex = bisect.bisect_left(cumulativeWeights, rng.random())
+        haplotype = haplotypeWeights[min(haplotypeIndex, len(haplotypeWeights) - 1)][0]
+        fragmentLength = max(readLength, int(rng.gauss(fragmentMean, fragmentSd)))
+        if fragmentLength > len(haplotype.seq) : continue
+        fragmentStart = rng.randrange(len(haplotype.seq) - fragmentLength + 1)
+        fragmentEnd = fragmentStart + fragmentLength
+
+        alignment1 = haplotype.getAlignment(fragmentStart, readLength)
+        alignment2 = haplotype.getAlignment(fragmentEnd - readLength, readLength)
+        if (alignment1 is None) or (alignment2 is None) : continue
+
+        (seq1, qual1) = getRead(haplotype.seq[fragmentStart:fragmentStart+readLength])
+        (seq2, qual2) = getRead(haplotype.seq[fragmentEnd-readLength:fragmentEnd])
+
+        (pos1, cigar1) = alignment1
+        (pos2, cigar2) = alignment2
+        templateLength = getAlignmentRefEnd(pos2, cigar2) - pos1
+
+        # randomly assign the forward strand read to read1 or read2:
+        isRead1Forward = (rng.random() < 0.5)
+        flag1 = 99 if isRead1Forward else 163
+        flag2 = 147 if isRead1Forward else 83
+        qname = "%s:%i" % (sampleName, pairIndex)
+        records.append((pos1, "%s\t%i\t%s\t%i\t60\t%s\t=\t%i\t%i\t%s\t%s\n" %
+                        (qname, flag1, contigName, pos1 + 1, cigar1, pos2 + 1, templateLength, seq1, qual1)))
+        records.append((pos2, "%s\t%i\t%s\t%i\t60\t%s\t=\t%i\t%i\t%s\t%s\n" %
+                        (qname, flag2, contigName, pos2 + 1, cigar2, pos1 + 1, -templateLength, seq2, qual2)))
+
+    records.sort(key=lambda record : record[0])
+
+    proc = subprocess.Popen([samtoolsBin, "view", "-b", "-o", bamFile, "-"], stdin=subprocess.PIPE,
+                            universal_newlines=True)
+    proc.stdin.write("@HD\tVN:1.4\tSO:coordinate\n")
+    proc.stdin.write("@SQ\tSN:%s\tLN:%i\n" % (contigName, len(refSeq)))
+    proc.stdin.write("@RG\tID:%s\tSM:%s\n" % (sampleName, sampleName))
+    for (_, line) in records :
+        proc.stdin.write(line)
+    proc.stdin.close()
+    if proc.wait() != 0 :
+        raise Exception("Failed to write simulated BAM file '%s'" % (bamFile))
+    subprocess.check_call([samtoolsBin, "index", bamFile])
+
+    return len(records)
+
+
+
+def simulateInput(options, samtoolsBin) :
+    """
+    simulate the reference and the normal and tumor sample BAM files
+
+    \\return dictionary of simulated input information
+    """
+    rng = random.Random(options.seed)
+    (contigName, contigSeq) = readFirstFastaContig(options.referenceFasta)
+
+    inputDir = os.path.join(options.outputDir, "input")
+    ensureDir(inputDir)
+
+    if options.referenceTileCount == 1 :
+        referenceFasta = options.referenceFasta
+        refSeq = contigSeq
+    else :
+        referenceFasta = os.path.join(inputDir, "reference.fa")
+        refSeq = writeTiledReference(options, rng, contigName, contigSeq, referenceFasta)
+        subprocess.check_call([samtoolsBin, "faidx", referenceFasta])
+
+    variantSimulator = VariantSimulator(rng, refSeq)
+    germlineVariants = variantSimulator.getVariants(options.snvDensity, options.indelDensity,
+                                                    options.strIndelFraction)
+
+    # assign germline variants to haplotypes, one third are homozygous:
+    haplotypeVariants = ([], [])
+    for variant in germlineVariants :
+        hapSelect = rng.randrange(3)
+        if hapSelect != 1 : haplotypeVariants[0].append(variant)
+        if hapSelect != 0 : haplotypeVariants[1].append(variant)
+
+    # somatic variants are split evenly between snvs and indels:
+    somaticVariants = variantSimulator.getVariants(options.somaticDensity / 2, options.somaticDensity / 2,
+                                                   options.strIndelFraction)
+
+    haplotypes = [Haplotype(refSeq, variants) for variants in haplotypeVariants]
+    somaticHaplotype = Haplotype(refSeq, haplotypeVariants[0] + somaticVariants)
+
+    purity = options.tumorPurity
+    sampleHaplotypeWeights = {
+        "normal" : [(haplotypes[0], 1.0), (haplotypes[1], 1.0)],
+        "tumor" : [(haplotypes[0], 1.0 - purity), (somaticHaplotype, purity), (haplotypes[1], 1.0)]
+    }
+
+    sampleInfo = {}
+    for sampleName in ("normal", "tumor") :
+        bamFile = os.path.join(inputDir, sampleName + ".bam")
+        readCount = simulateSample(options, rng, samtoolsBin, contigName, refSeq,
+                                   sampleHaplotypeWeights[sampleName], sampleName, bamFile)
+        sampleInfo[sampleName] = { "bamFile" : bamFile, "readCount" : readCount }
+
+    return {
+        "referenceFasta" : referenceFasta,
+        "contigName" : contigName,
+        "contigLength" : len(refSeq),
+        "germlineVariantCount" : len(germlineVariants),
+        "somaticVariantCount" : len(somaticVariants),
+        "samples" : sampleInfo
+    }
+
+
+
+def getGermlineCommand(options, inputInfo, runDir) :
+    """
+    starling2 command line following the arguments used by the germline workflow
+    """
+    cmd = [os.path.join(options.libexecDir, exeFile("starling2"))]
+    cmd.extend(["--region", "%s:1-%i" % (inputInfo["contigName"], inputInfo["contigLength"])])
+    cmd.extend(["--ref", inputInfo["referenceFasta"]])
+    cmd.extend(["--max-indel-size", "49"])
+    cmd.extend(["--min-mapping-quality", "20"])
+    cmd.extend(["--gvcf-output-prefix", os.path.join(runDir, "")])
+    cmd.extend(["--gvcf-min-gqx", "15"])
+    cmd.extend(["--gvcf-min-homref-gqx", "15"])
+    cmd.extend(["--gvcf-max-snv-strand-bias", "10"])
+    cmd.append("--enable-read-backed-phasing")
+    cmd.extend(["--stats-file", os.path.join(runDir, "runStats.xml")])
+    cmd.extend(["--align-file", inputInfo["samples"]["normal"]["bamFile"]])
+    cmd.extend(["--indel-error-models-file", os.path.join(options.configDir, "indelErrorModel.json")])
+    cmd.extend(["--theta-file", os.path.join(options.configDir, "theta.json")])
+    return cmd
+
+
+
+def getSomaticCommand(options, inputInfo, runDir) :
+    """
+    strelka2 command line following the arguments used by the somatic workflow
+    """
+    cmd = [os.path.join(options.libexecDir, exeFile("strelka2"))]
+    cmd.extend(["--region", "%s:1-%i" % (inputInfo["contigName"], inputInfo["contigLength"])])
+    cmd.extend(["--ref", inputInfo["referenceFasta"]])
+    cmd.extend(["--max-indel-size", "49"])
+    cmd.extend(["--min-mapping-quality", "20"])
+    cmd.extend(["--somatic-snv-rate", "0.0001"])
+    cmd.extend(["--shared-site-error-rate", "5e-10"])
+    cmd.extend(["--shared-site-error-strand-bias-fraction", "0.0"])
+    cmd.extend(["--somatic-indel-rate", "1e-06"])
+    cmd.extend(["--shared-indel-error-factor", "2.2"])
+    cmd.extend(["--tier2-min-mapping-quality", "0"])
+    cmd.extend(["--strelka-snv-max-filtered-basecall-frac", "0.4"])
+    cmd.extend(["--strelka-snv-max-spanning-deletion-frac", "0.75"])
+    cmd.extend(["--strelka-snv-min-qss-ref", "15"])
+    cmd.extend(["--strelka-indel-max-window-filtered-basecall-frac", "0.3"])
+    cmd.extend(["--strelka-indel-min-qsi-ref", "40"])
+    cmd.extend(["--ssnv-contam-tolerance", "0.15"])
+    cmd.extend(["--indel-contam-tolerance", "0.15"])
+    cmd.extend(["--somatic-snv-scoring-model-file", os.path.join(options.configDir, "somaticSNVScoringModels.json")])
+    cmd.extend(["--somatic-indel-scoring-model-file", os.path.join(options.configDir, "somaticIndelScoringModels.json")])
+    cmd.extend(["--normal-align-file", inputInfo["samples"]["normal"]["bamFile"]])
+    cmd.extend(["--tumor-align-file", inputInfo["samples"]["tumor"]["bamFile"]])
+    cmd.extend(["--somatic-snv-file", os.path.join(runDir, "somatic.snvs.vcf")])
+    cmd.extend(["--somatic-indel-file", os.path.join(runDir, "somatic.indels.vcf")])
+    cmd.extend(["--somatic-callable-regions-file", os.path.join(runDir, "callable.bed")])
+    cmd.extend(["--stats-file", os.path.join(runDir, "runStats.xml")])
+    cmd.extend(["--indel-error-models-file", os.path.join(options.configDir, "indelErrorModel.json")])
+    cmd.extend(["--theta-file", os.path.join(options.configDir, "theta.json")])
+    return cmd
+
+
+
+def runTimedCommand(cmd, logFile) :
+    """
+    run cmd to completion
+
+    \\return (wallSeconds, cpuSeconds, peakRssKb) for the completed process
+    """
+    logFp = open(logFile, "w")
+    startTime = time.time()
+    proc = subprocess.Popen(cmd, stdout=logFp, stderr=subprocess.STDOUT)
+    (_, status, usage) = os.wait4(proc.pid, 0)
+    wallSeconds = time.time() - startTime
+    logFp.close()
+
+    # the process has already been reaped by wait4, so record its status on the Popen object:
+    proc.returncode = status
+    if status != 0 :
+        raise Exception("Benchmark command failed with status %i, see log file '%s'\nCommand: %s" %
+                        (status, logFile, " ".join(cmd)))
+
+    # ru_maxrss is reported in kilobytes on linux:
+    return (wallSeconds, usage.ru_utime + usage.ru_stime, usage.ru_maxrss)
+
+
+
+def runCallerBenchmark(options, callerName, cmdFunc, inputInfo, sampleNames) :
+    """
+    \\return dictionary of throughput results for one caller
+    """
+    runDir = os.path.join(options.outputDir, callerName)
+    ensureDir(runDir)
+    cmd = cmdFunc(options, inputInfo, runDir)
+
+    readCount = sum(inputInfo["samples"][sampleName]["readCount"] for sampleName in sampleNames)
+    baseCount = readCount * options.readLength
+
+    runs = []
+    for repeatIndex in range(options.repeatCount) :
+        logFile = os.path.join(runDir, "run%i.log" % (repeatIndex))
+        runs.append(runTimedCommand(cmd, logFile))
+
+    wallSeconds = min(run[0] for run in runs)
+    cpuSeconds = min(run[1] for run in runs)
+    peakRssKb = max(run[2] for run in runs)
+
+    return {
+        "command" : " ".join(cmd),
+        "readCount" : readCount,
+        "baseCount" : baseCount,
+        "wallSeconds" : wallSeconds,
+        "cpuSeconds" : cpuSeconds,
+        "readsPerSecond" : readCount / wallSeconds,
+        "basesPerSecond" : baseCount / wallSeconds,
+        "peakRssKb" : peakRssKb
+    }
+
+
+
+def checkBaseline(options, result) :
+    """
+    compare result to the baseline result file
+
+    \\return list of regression descriptions, empty if there is no regression
+    """
+    baseline = json.load(open(options.baselineFile))
+    if baseline["simulationParameters"] != result["simulationParameters"] :
+        raise Exception("Baseline result file '%s' was generated with different simulation parameters" %
+                        (options.baselineFile))
+
+    regressions = []
+    for (callerName, callerResult) in result["callers"].items() :
+        if callerName not in baseline["callers"] : continue
+        baselineResult = baseline["callers"][callerName]
+
+        minReadsPerSecond = baselineResult["readsPerSecond"] * (1.0 - options.maxThroughputLoss)
+        if callerResult["readsPerSecond"] < minReadsPerSecond :
+            regressions.append("%s throughput %.1f reads/sec is below the baseline of %.1f reads/sec" %
+                               (callerName, callerResult["readsPerSecond"], baselineResult["readsPerSecond"]))
+
+        maxPeakRssKb = baselineResult["peakRssKb"] * (1.0 + options.maxRssGrowth)
+        if callerResult["peakRssKb"] > maxPeakRssKb :
+            regressions.append("%s peak RSS %i kB is above the baseline of %i kB" %
+                               (callerName, callerResult["peakRssKb"], baselineResult["peakRssKb"]))
+    return regressions
+
+
+
+def main() :
+
+    (options,args) = getOptions()
+
+    ensureDir(options.outputDir)
+    samtoolsBin = os.path.join(options.libexecDir, exeFile("samtools"))
+    checkFile(samtoolsBin, "samtools binary")
+
+    inputInfo = simulateInput(options, samtoolsBin)
+
+    result = {
+        "simulationParameters" : getSimulationParameters(options),
+        "input" : {
+            "contigLength" : inputInfo["contigLength"],
+            "germlineVariantCount" : inputInfo["germlineVariantCount"],
+            "somaticVariantCount" : inputInfo["somaticVariantCount"],
+            "normalReadCount" : inputInfo["samples"]["normal"]["readCount"],
+            "tumorReadCount" : inputInfo["samples"]["tumor"]["readCount"]
+        },
+        "callers" : {}
+    }
+
+    if options.mode in ("germline", "all") :
+        result["callers"]["germline"] = runCallerBenchmark(options, "germline", getGermlineCommand, inputInfo,
+                                                           ["normal"])
+    if options.mode in ("somatic", "all") :
+        result["callers"]["somatic"] = runCallerBenchmark(options, "somatic", getSomaticCommand, inputInfo,
+                                                          ["normal", "tumor"])
+
+    ofp = open(options.resultFile, "w")
+    json.dump(result, ofp, indent=4, sort_keys=True)
+    ofp.write("\n")
+    ofp.close()
+
+    for (callerName, callerResult) in sorted(result["callers"].items()) :
+        sys.stderr.write("%s\treads/sec: %.1f\tbases/sec: %.1f\tpeakRssKb: %i\n" %
+                         (callerName, callerResult["readsPerSecond"], callerResult["basesPerSecond"],
+                          callerResult["peakRssKb"]))
+
+    if options.baselineFile is not None :
+        regressions = checkBaseline(options, result)
+        for regression in regressions :
+            sys.stderr.write("PERFORMANCE REGRESSION: %s\n" % (regression))
+        if len(regressions) > 0 :
+            sys.exit(1)
+
+
+main()